@@ -177,6 +177,32 @@ modelbox::Status CheckImageStride(const std::string &pix_fmt,
   return modelbox::STATUS_OK;
 }
 
+modelbox::Status GetImageRowStep(const std::shared_ptr<modelbox::Buffer> &img,
+                                 size_t row_bytes, int32_t height,
+                                 size_t &step) {
+  step = row_bytes;
+  int32_t width_stride = 0;
+  if (img->Get("width_stride", width_stride) && width_stride > 0) {
+    step = (size_t)width_stride;
+  }
+
+  if (step < row_bytes) {
+    return {modelbox::STATUS_INVALID,
+            "width_stride[" + std::to_string(step) +
+                "] is less than row bytes[" + std::to_string(row_bytes) +
+                "], width_stride is in bytes"};
+  }
+
+  if (height > 0 && step * (height - 1) + row_bytes > img->GetBytes()) {
+    return {modelbox::STATUS_INVALID,
+            "image bytes[" + std::to_string(img->GetBytes()) +
+                "] is less than width_stride[" + std::to_string(step) +
+                "] * height[" + std::to_string(height) + "]"};
+  }
+
+  return modelbox::STATUS_OK;
+}
+
 #ifdef ACL_ENABLE
 
 modelbox::Status InitDvppChannel(
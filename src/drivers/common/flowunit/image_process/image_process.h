@@ -86,6 +86,20 @@ modelbox::Status CheckImageStride(const std::string &pix_fmt,
                                   int32_t img_height_stride,
                                   int32_t expect_h_align, size_t img_size);
 
+/**
+ * @brief Get row step of a packed image, width_stride meta is the row pitch in
+ * bytes, e.g. width * 3 for rgb, width for nv12.
+ * @param img image buffer
+ * @param row_bytes bytes of one row without padding
+ * @param height image height
+ * @param step row step in bytes, row_bytes when width_stride is not set
+ * @return STATUS_INVALID if width_stride is less than row_bytes, or image is
+ * too small for the stride
+ */
+modelbox::Status GetImageRowStep(const std::shared_ptr<modelbox::Buffer> &img,
+                                 size_t row_bytes, int32_t height,
+                                 size_t &step);
+
 #ifdef ACL_ENABLE
 
 const int32_t ASCEND_WIDTH_ALIGN = 16;
@@ -93,7 +93,7 @@ modelbox::Status ImageRotateFlowUnitBase::Process(
     output_buffer->CopyMeta(buffer);
     output_buffer->Set("width", output_width);
     output_buffer->Set("height", output_height);
-    output_buffer->Set("width_stride", output_width);
+    output_buffer->Set("width_stride", output_width * 3);
     output_buffer->Set("height_stride", output_height);
     output_bufs->PushBack(output_buffer);
   }
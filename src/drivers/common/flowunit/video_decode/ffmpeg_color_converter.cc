@@ -24,32 +24,43 @@ using namespace modelbox;
 
 modelbox::Status FfmpegColorConverter::CvtColor(
     const std::shared_ptr<AVFrame> &src_frame, uint8_t *out_frame_data,
-    AVPixelFormat out_pix_fmt) {
+    AVPixelFormat out_pix_fmt, int32_t out_width, int32_t out_height) {
   if (!SupportCvtPixFmt(out_pix_fmt)) {
     return STATUS_INVALID;
   }
 
   auto &width = src_frame->width;
   auto &height = src_frame->height;
-  if (width_ != width || height != height_) {
-    width_ = width;
-    height_ = height;
-    auto ret = InitSwsCtx(width, height, (AVPixelFormat)src_frame->format,
+  auto src_pix_fmt = (AVPixelFormat)src_frame->format;
+  out_width = out_width > 0 ? out_width : width;
+  out_height = out_height > 0 ? out_height : height;
+  if (width_ != width || height != height_ || src_pix_fmt_ != src_pix_fmt ||
+      dest_width_ != out_width || dest_height_ != out_height ||
+      dest_pix_fmt_ != out_pix_fmt) {
+    auto ret = InitSwsCtx(width, height, src_pix_fmt, out_width, out_height,
                           out_pix_fmt);
     if (ret != STATUS_SUCCESS) {
       return ret;
     }
+
+    width_ = width;
+    height_ = height;
+    src_pix_fmt_ = src_pix_fmt;
+    dest_width_ = out_width;
+    dest_height_ = out_height;
+    dest_pix_fmt_ = out_pix_fmt;
   }
 
   int32_t linesize[4];
-  GetLineSize(out_pix_fmt, width, linesize, 4);
+  GetLineSize(out_pix_fmt, out_width, linesize, 4);
   uint8_t *data[4] = {0};
   data[0] = out_frame_data;
+  auto plane_size = out_width * out_height;
   if (out_pix_fmt == AVPixelFormat::AV_PIX_FMT_NV12) {
-    data[1] = out_frame_data + width * height;  // For UV plane
+    data[1] = out_frame_data + plane_size;  // For UV plane
   } else if (out_pix_fmt == AVPixelFormat::AV_PIX_FMT_YUV420P) {
-    data[1] = out_frame_data + width * height;  // For U plane
-    data[2] = data[1] + width * height / 4;     // For V plane
+    data[1] = out_frame_data + plane_size;  // For U plane
+    data[2] = data[1] + plane_size / 4;     // For V plane
   }
 
   auto ffmpeg_ret = sws_scale(sws_ctx_.get(), src_frame->data,
@@ -76,9 +87,13 @@ bool FfmpegColorConverter::SupportCvtPixFmt(AVPixelFormat pix_fmt) {
 
 Status FfmpegColorConverter::InitSwsCtx(int32_t width, int32_t height,
                                         AVPixelFormat src_pix_fmt,
+                                        int32_t dest_width, int32_t dest_height,
                                         AVPixelFormat dest_pix_fmt) {
-  auto sws_ctx = sws_getContext(width, height, src_pix_fmt, width, height,
-                                dest_pix_fmt, 0, nullptr, nullptr, nullptr);
+  /* scale and convert in one pass, flags only matter when scaling */
+  int flags = (width == dest_width && height == dest_height) ? 0 : SWS_BILINEAR;
+  auto sws_ctx =
+      sws_getContext(width, height, src_pix_fmt, dest_width, dest_height,
+                     dest_pix_fmt, flags, nullptr, nullptr, nullptr);
   if (sws_ctx == nullptr) {
     auto fmt_name = std::to_string(dest_pix_fmt);
     auto name_c = av_get_pix_fmt_name(dest_pix_fmt);
@@ -90,9 +105,9 @@ Status FfmpegColorConverter::InitSwsCtx(int32_t width, int32_t height,
       pix_fmt_name = "unknown";
     }
 
-    MBLOG_ERROR << "Failed to create sws_ctx for [f:" << fmt_name
-                << " w:" << width << " h:" << height << "]->[f:" << pix_fmt_name
-                << " w:" << width << " h:" << height << "]";
+    MBLOG_ERROR << "Failed to create sws_ctx for [f:" << pix_fmt_name
+                << " w:" << width << " h:" << height << "]->[f:" << fmt_name
+                << " w:" << dest_width << " h:" << dest_height << "]";
     return STATUS_FAULT;
   }
 
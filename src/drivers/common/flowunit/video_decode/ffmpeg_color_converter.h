@@ -29,14 +29,25 @@ extern "C" {
 
 class FfmpegColorConverter {
  public:
+  /**
+   * @brief Convert frame color, scale at the same time when out size is set
+   * @param src_frame source frame
+   * @param out_frame_data output data, packed planes of out size
+   * @param out_pix_fmt output pixel format
+   * @param out_width output width, 0 means same as source
+   * @param out_height output height, 0 means same as source
+   * @return convert result
+   */
   modelbox::Status CvtColor(const std::shared_ptr<AVFrame> &src_frame,
-                          uint8_t *out_frame_data, AVPixelFormat out_pix_fmt);
+                          uint8_t *out_frame_data, AVPixelFormat out_pix_fmt,
+                          int32_t out_width = 0, int32_t out_height = 0);
 
  private:
   bool SupportCvtPixFmt(AVPixelFormat pix_fmt);
 
   modelbox::Status InitSwsCtx(int32_t width, int32_t height,
-                            AVPixelFormat src_pix_fmt, AVPixelFormat dest_pix_fmt);
+                            AVPixelFormat src_pix_fmt, int32_t dest_width,
+                            int32_t dest_height, AVPixelFormat dest_pix_fmt);
 
   modelbox::Status GetLineSize(AVPixelFormat pix_fmt, int32_t width,
                              int32_t linesize[4], int32_t linesize_size);
@@ -48,6 +59,10 @@ class FfmpegColorConverter {
   std::shared_ptr<SwsContext> sws_ctx_;
   int32_t width_{0};
   int32_t height_{0};
+  AVPixelFormat src_pix_fmt_{AV_PIX_FMT_NONE};
+  int32_t dest_width_{0};
+  int32_t dest_height_{0};
+  AVPixelFormat dest_pix_fmt_{AV_PIX_FMT_NONE};
 };
 
 #endif  // MODELBOX_FLOWUNIT_FFMPEG_COLOR_CONVERTER_H_
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "frame_sampler.h"
+
+#include <modelbox/base/log.h>
+
+namespace videodecode {
+
+modelbox::Status FrameSampler::Init(
+    const std::shared_ptr<modelbox::Configuration> &opts) {
+  auto mode = opts->GetString("sample_mode", "none");
+  if (mode == "none") {
+    mode_ = SampleMode::NONE;
+  } else if (mode == "fps") {
+    auto fps = opts->GetDouble("sample_fps", 0);
+    if (fps <= 0) {
+      MBLOG_ERROR << "sample_fps should be greater than 0, but is " << fps;
+      return modelbox::STATUS_BADCONF;
+    }
+
+    mode_ = SampleMode::FPS;
+    period_ms_ = 1000.0 / fps;
+  } else if (mode == "interval") {
+    interval_ = opts->GetInt32("sample_interval", 0);
+    if (interval_ <= 0) {
+      MBLOG_ERROR << "sample_interval should be greater than 0, but is "
+                  << interval_;
+      return modelbox::STATUS_BADCONF;
+    }
+
+    mode_ = SampleMode::INTERVAL;
+  } else if (mode == "key_frame") {
+    mode_ = SampleMode::KEY_FRAME;
+  } else {
+    MBLOG_ERROR << "Not support sample mode " << mode;
+    return modelbox::STATUS_BADCONF;
+  }
+
+  return modelbox::STATUS_OK;
+}
+
+SampleMode FrameSampler::GetMode() const { return mode_; }
+
+uint64_t FrameSampler::GetFrameCount() const { return frame_count_; }
+
+bool FrameSampler::Sample(bool key_frame, double timestamp_ms) {
+  auto index = frame_count_++;
+  switch (mode_) {
+    case SampleMode::INTERVAL:
+      return index % interval_ == 0;
+
+    case SampleMode::KEY_FRAME:
+      return key_frame;
+
+    case SampleMode::FPS:
+      if (!started_ || timestamp_ms < next_sample_ms_ - period_ms_) {
+        /* first frame or timestamp jumps back, restart sampling */
+        started_ = true;
+        next_sample_ms_ = timestamp_ms + period_ms_;
+        return true;
+      }
+
+      if (timestamp_ms < next_sample_ms_) {
+        return false;
+      }
+
+      next_sample_ms_ += period_ms_;
+      if (next_sample_ms_ <= timestamp_ms) {
+        /* source is slower than target, do not burst to catch up */
+        next_sample_ms_ = timestamp_ms + period_ms_;
+      }
+      return true;
+
+    default:
+      return true;
+  }
+}
+
+}  // namespace videodecode
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MODELBOX_FLOWUNIT_FRAME_SAMPLER_H_
+#define MODELBOX_FLOWUNIT_FRAME_SAMPLER_H_
+
+#include <modelbox/base/configuration.h>
+#include <modelbox/base/status.h>
+
+#include <string>
+
+namespace videodecode {
+
+enum class SampleMode { NONE, FPS, INTERVAL, KEY_FRAME };
+
+/**
+ * @brief Decide which decoded frames are sent downstream
+ */
+class FrameSampler {
+ public:
+  /**
+   * @brief Read sample_mode, sample_fps and sample_interval options
+   * @param opts flowunit configuration
+   * @return STATUS_BADCONF when options are invalid
+   */
+  modelbox::Status Init(const std::shared_ptr<modelbox::Configuration> &opts);
+
+  SampleMode GetMode() const;
+
+  /**
+   * @brief Frames passed to Sample so far
+   */
+  uint64_t GetFrameCount() const;
+
+  /**
+   * @brief Whether frame should be kept
+   * @param key_frame frame is key frame
+   * @param timestamp_ms frame timestamp in millisecond
+   * @return true if keep the frame
+   */
+  bool Sample(bool key_frame, double timestamp_ms);
+
+ private:
+  SampleMode mode_{SampleMode::NONE};
+  double period_ms_{0};
+  int32_t interval_{1};
+  uint64_t frame_count_{0};
+  bool started_{false};
+  double next_sample_ms_{0};
+};
+
+}  // namespace videodecode
+
+#endif  // MODELBOX_FLOWUNIT_FRAME_SAMPLER_H_
@@ -37,6 +37,15 @@ std::map<std::string, std::function<size_t(int32_t width, int32_t height)>>
                                 {"rgb", RGBBufferSize},
                                 {"bgr", RGBBufferSize}};
 
+int32_t NV12WidthStride(int32_t width) { return width; }
+
+int32_t RGBWidthStride(int32_t width) { return width * 3; }
+
+std::map<std::string, std::function<int32_t(int32_t width)>>
+    g_pix_fmt_to_width_stride = {{"nv12", NV12WidthStride},
+                                 {"rgb", RGBWidthStride},
+                                 {"bgr", RGBWidthStride}};
+
 const std::set<std::string> g_supported_pix_fmt = {"nv12", "rgb", "bgr"};
 const std::map<std::string, AVPixelFormat> g_av_pix_fmt_map = {
     {"nv12", AVPixelFormat::AV_PIX_FMT_NV12},
@@ -55,6 +64,18 @@ modelbox::Status GetBufferSize(int32_t width, int32_t height,
   return modelbox::STATUS_SUCCESS;
 }
 
+modelbox::Status GetWidthStride(int32_t width, const std::string &pix_fmt,
+                              int32_t &width_stride) {
+  auto iter = g_pix_fmt_to_width_stride.find(pix_fmt);
+  if (iter == g_pix_fmt_to_width_stride.end()) {
+    MBLOG_ERROR << "Not support pix fmt " << pix_fmt;
+    return modelbox::STATUS_NOTSUPPORT;
+  }
+
+  width_stride = iter->second(width);
+  return modelbox::STATUS_SUCCESS;
+}
+
 void UpdateStatsInfo(std::shared_ptr<modelbox::DataContext> &ctx, int32_t width,
                      int32_t height) {
   auto stats = ctx->GetStatistics();
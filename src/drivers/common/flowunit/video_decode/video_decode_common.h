@@ -44,6 +44,10 @@ extern const std::map<std::string, AVPixelFormat> g_av_pix_fmt_map;
 modelbox::Status GetBufferSize(int32_t width, int32_t height,
                              const std::string &pix_fmt, size_t &size);
 
+/* width_stride is the row pitch in bytes */
+modelbox::Status GetWidthStride(int32_t width, const std::string &pix_fmt,
+                              int32_t &width_stride);
+
 void UpdateStatsInfo(std::shared_ptr<modelbox::DataContext> &ctx, int32_t width,
                      int32_t height);
 }  // namespace videodecode
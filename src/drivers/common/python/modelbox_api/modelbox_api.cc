@@ -376,11 +376,12 @@ py::object BufferToPyObject(modelbox::Buffer &buffer) {
   throw std::runtime_error("invalid type");
 }
 
-typedef bool (*pInterTypeToPyTypeFunc)(std::size_t hash_code, Any *value,
-                                       py::object &ret);
+typedef bool (*pInterTypeToPyTypeFunc)(std::size_t hash_code,
+                                       const Any *value, py::object &ret);
 
 template <typename InterTyper, typename PyType>
-bool InterTypeToPyType(std::size_t hash_code, Any *value, py::object &ret) {
+bool InterTypeToPyType(std::size_t hash_code, const Any *value,
+                       py::object &ret) {
   if (typeid(InterTyper).hash_code() == hash_code) {
     auto *data = any_cast<InterTyper>(value);
     if (data == nullptr) {
@@ -394,7 +395,8 @@ bool InterTypeToPyType(std::size_t hash_code, Any *value, py::object &ret) {
 }
 
 template <typename InterTyper, typename PyType>
-bool InterTypeToPyListType(std::size_t hash_code, Any *value, py::object &ret) {
+bool InterTypeToPyListType(std::size_t hash_code, const Any *value,
+                           py::object &ret) {
   if (typeid(std::vector<InterTyper>).hash_code() == hash_code) {
     auto *data = any_cast<std::vector<InterTyper>>(value);
     if (data == nullptr) {
@@ -412,7 +414,7 @@ bool InterTypeToPyListType(std::size_t hash_code, Any *value, py::object &ret) {
 }
 
 template <typename InterTyper, typename PyType>
-bool InterTypeToPyListInListType(std::size_t hash_code, Any *value,
+bool InterTypeToPyListInListType(std::size_t hash_code, const Any *value,
                                  py::object &ret) {
   if (typeid(std::vector<std::vector<InterTyper>>).hash_code() == hash_code) {
     auto *data = any_cast<std::vector<std::vector<InterTyper>>>(value);
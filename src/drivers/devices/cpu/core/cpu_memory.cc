@@ -18,11 +18,19 @@
 #include "modelbox/device/cpu/cpu_memory.h"
 
 #include <securec.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include "modelbox/base/collector.h"
 #include "modelbox/base/os.h"
 
 namespace modelbox {
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+constexpr int kMpolPreferred = 1;
+
 CpuMemory::CpuMemory(const std::shared_ptr<Device> &device,
                      const std::shared_ptr<DeviceMemoryManager> &mem_mgr,
                      std::shared_ptr<void> device_mem_ptr, size_t size)
@@ -59,7 +67,28 @@ Status CpuMemory::Verify() const {
 
 CpuMemoryPool::CpuMemoryPool() {}
 
-Status CpuMemoryPool::Init() {
+Status CpuMemoryPool::Init(const std::shared_ptr<Configuration> &config) {
+  std::string hugepage = "none";
+  if (config != nullptr) {
+    hugepage = config->GetString("hugepage", hugepage);
+    numa_bind_ = config->GetBool("numa-bind", false);
+  }
+
+  if (hugepage == "transparent") {
+    hugepage_mode_ = HUGEPAGE_TRANSPARENT;
+  } else if (hugepage == "explicit") {
+    hugepage_mode_ = HUGEPAGE_EXPLICIT;
+  } else if (hugepage != "none") {
+    MBLOG_WARN << "invalid hugepage mode " << hugepage << ", use none";
+    hugepage = "none";
+  }
+
+  use_mmap_ = (hugepage_mode_ != HUGEPAGE_NONE) || numa_bind_;
+  if (use_mmap_) {
+    MBLOG_INFO << "cpu memory pool, hugepage: " << hugepage
+               << ", numa-bind: " << numa_bind_;
+  }
+
   auto status = InitSlabCache();
   if (!status) {
     return {status, "init mempool failed."};
@@ -80,6 +109,10 @@ void CpuMemoryPool::OnTimer() {
 }
 
 void *CpuMemoryPool::MemAlloc(size_t size) {
+  if (use_mmap_ && size >= kHugePageSize) {
+    return MapAlloc(size);
+  }
+
   auto cpu_mem_ptr = (uint8_t *)malloc(size);
   if (cpu_mem_ptr == nullptr) {
     MBLOG_ERROR << "cpu_mem_ptr is null";
@@ -87,7 +120,87 @@ void *CpuMemoryPool::MemAlloc(size_t size) {
   return cpu_mem_ptr;
 }
 
-void CpuMemoryPool::MemFree(void *ptr) { free(ptr); }
+void CpuMemoryPool::MemFree(void *ptr) {
+  if (use_mmap_) {
+    std::unique_lock<std::mutex> lock(map_lock_);
+    auto itr = map_mem_.find(ptr);
+    if (itr != map_mem_.end()) {
+      auto map_size = itr->second;
+      map_mem_.erase(itr);
+      lock.unlock();
+      munmap(ptr, map_size);
+      return;
+    }
+  }
+
+  free(ptr);
+}
+
+void *CpuMemoryPool::MapAlloc(size_t size) {
+  void *ptr = MAP_FAILED;
+  size_t map_size = size;
+  const int prot = PROT_READ | PROT_WRITE;
+  const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#ifdef MAP_HUGETLB
+  if (hugepage_mode_ == HUGEPAGE_EXPLICIT && hugetlb_failed_ == false) {
+    map_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    ptr = mmap(nullptr, map_size, prot, flags | MAP_HUGETLB, -1, 0);
+    if (ptr == MAP_FAILED && hugetlb_failed_.exchange(true) == false) {
+      MBLOG_WARN << "mmap explicit huge page failed, " << strerror(errno)
+                 << ", fallback to transparent huge page";
+    }
+  }
+#endif
+
+  if (ptr == MAP_FAILED) {
+    map_size = size;
+    ptr = mmap(nullptr, map_size, prot, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+      MBLOG_ERROR << "mmap cpu memory failed, size " << size << ", "
+                  << strerror(errno);
+      return nullptr;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (hugepage_mode_ != HUGEPAGE_NONE) {
+      madvise(ptr, map_size, MADV_HUGEPAGE);
+    }
+#endif
+  }
+
+  if (numa_bind_) {
+    BindNumaNode(ptr, map_size);
+  }
+
+  std::unique_lock<std::mutex> lock(map_lock_);
+  map_mem_[ptr] = map_size;
+  return ptr;
+}
+
+void CpuMemoryPool::BindNumaNode(void *ptr, size_t size) {
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return;
+  }
+
+  const size_t bits_per_mask = sizeof(unsigned long) * 8;
+  unsigned long nodemask[4] = {0};
+  if (node >= sizeof(nodemask) * 8) {
+    return;
+  }
+
+  /* pages are not touched yet, prefer node of the allocating worker */
+  nodemask[node / bits_per_mask] |= 1UL << (node % bits_per_mask);
+  if (syscall(SYS_mbind, ptr, size, kMpolPreferred, nodemask,
+              sizeof(nodemask) * 8 + 1, 0) != 0) {
+    MBLOG_DEBUG << "bind memory to numa node " << node << " failed, "
+                << strerror(errno);
+  }
+#endif
+}
 
 CpuMemoryManager::CpuMemoryManager(const std::string &device_id)
     : DeviceMemoryManager(device_id) {
@@ -100,7 +213,9 @@ CpuMemoryManager::~CpuMemoryManager() {
   mem_pool_->UnregisterCollector("cpu");
 }
 
-Status CpuMemoryManager::Init() { return mem_pool_->Init(); }
+Status CpuMemoryManager::Init(const std::shared_ptr<Configuration> &config) {
+  return mem_pool_->Init(config);
+}
 
 std::shared_ptr<DeviceMemory> CpuMemoryManager::MakeDeviceMemory(
     const std::shared_ptr<Device> &device, std::shared_ptr<void> mem_ptr,
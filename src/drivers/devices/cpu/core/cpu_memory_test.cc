@@ -0,0 +1,108 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "modelbox/device/cpu/cpu_memory.h"
+
+#include <securec.h>
+
+#include <fstream>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "modelbox/base/configuration.h"
+#include "modelbox/base/log.h"
+
+namespace modelbox {
+
+static std::shared_ptr<Configuration> HugePageConfig(
+    const std::string &hugepage, const std::string &numa_bind) {
+  ConfigurationBuilder builder;
+  auto config = builder.Build();
+  config->SetProperty("hugepage", hugepage);
+  config->SetProperty("numa-bind", numa_bind);
+  return config;
+}
+
+static int HugePageNumber() {
+  int number = 0;
+  std::ifstream nr_hugepages("/proc/sys/vm/nr_hugepages");
+  if (!(nr_hugepages >> number)) {
+    return 0;
+  }
+
+  return number;
+}
+
+TEST(CpuMemoryPoolTest, HugePageConfig) {
+  CpuMemoryPool default_pool;
+  ASSERT_TRUE(default_pool.Init());
+  EXPECT_EQ(default_pool.GetHugePageMode(), HUGEPAGE_NONE);
+  EXPECT_FALSE(default_pool.IsNumaBind());
+
+  CpuMemoryPool transparent_pool;
+  ASSERT_TRUE(transparent_pool.Init(HugePageConfig("transparent", "true")));
+  EXPECT_EQ(transparent_pool.GetHugePageMode(), HUGEPAGE_TRANSPARENT);
+  EXPECT_TRUE(transparent_pool.IsNumaBind());
+
+  CpuMemoryPool explicit_pool;
+  ASSERT_TRUE(explicit_pool.Init(HugePageConfig("explicit", "false")));
+  EXPECT_EQ(explicit_pool.GetHugePageMode(), HUGEPAGE_EXPLICIT);
+  EXPECT_FALSE(explicit_pool.IsNumaBind());
+
+  CpuMemoryPool invalid_pool;
+  ASSERT_TRUE(invalid_pool.Init(HugePageConfig("huge", "false")));
+  EXPECT_EQ(invalid_pool.GetHugePageMode(), HUGEPAGE_NONE);
+}
+
+TEST(CpuMemoryPoolTest, HugePageAlloc) {
+  const size_t size = 5 * 1024 * 1024;
+  for (const auto &mode : {"none", "transparent", "explicit"}) {
+    CpuMemoryPool pool;
+    ASSERT_TRUE(pool.Init(HugePageConfig(mode, "true")));
+    auto *ptr = static_cast<uint8_t *>(pool.MemAlloc(size));
+    ASSERT_NE(ptr, nullptr) << "mode " << mode;
+    memset_s(ptr, size, 0x5a, size);
+    EXPECT_EQ(ptr[size - 1], 0x5a);
+    pool.MemFree(ptr);
+
+    auto *small_ptr = pool.MemAlloc(1024);
+    ASSERT_NE(small_ptr, nullptr);
+    pool.MemFree(small_ptr);
+  }
+}
+
+TEST(CpuMemoryPoolTest, HugePageFallback) {
+  if (HugePageNumber() > 0) {
+    MBLOG_INFO << "huge pages are reserved, skip fallback test";
+    return;
+  }
+
+  /* no explicit huge page reserved, mapping falls back to normal pages */
+  const size_t size = 3 * 1024 * 1024;
+  CpuMemoryPool pool;
+  ASSERT_TRUE(pool.Init(HugePageConfig("explicit", "false")));
+  auto *ptr = static_cast<uint8_t *>(pool.MemAlloc(size));
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_TRUE(pool.IsHugeTlbFallback());
+  memset_s(ptr, size, 0x5a, size);
+  pool.MemFree(ptr);
+
+  ptr = static_cast<uint8_t *>(pool.MemAlloc(size));
+  ASSERT_NE(ptr, nullptr);
+  pool.MemFree(ptr);
+}
+
+}  // namespace modelbox
@@ -84,9 +84,14 @@ std::vector<std::string> CPUFactory::GetDeviceList() {
   return cpuIds;
 }
 
+void CPUFactory::SetDeviceConfig(
+    const std::shared_ptr<Configuration> &config) {
+  config_ = config;
+}
+
 std::shared_ptr<Device> CPUFactory::CreateDevice(const std::string &device_id) {
   auto mem_mgr = std::make_shared<CpuMemoryManager>(device_id);
-  auto status = mem_mgr->Init();
+  auto status = mem_mgr->Init(config_);
   if (!status) {
     StatusError = status;
     return nullptr;
@@ -22,6 +22,9 @@
 #include <modelbox/base/memory_pool.h>
 #include <modelbox/base/timer.h>
 
+#include <mutex>
+#include <unordered_map>
+
 extern modelbox::Timer *GetTimer();
 
 namespace modelbox {
@@ -62,13 +65,26 @@ class CpuMemory : public DeviceMemory {
   Status Verify() const override;
 };
 
+enum CpuHugePageMode {
+  HUGEPAGE_NONE,
+  HUGEPAGE_TRANSPARENT,
+  HUGEPAGE_EXPLICIT,
+};
+
 class CpuMemoryPool : public MemoryPoolBase {
  public:
   CpuMemoryPool();
 
   virtual ~CpuMemoryPool();
 
-  Status Init();
+  /**
+   * @brief Init memory pool
+   * @param config cpu device config, support keys:
+   *   hugepage: none, transparent or explicit, huge page backing large slabs
+   *   numa-bind: bind large slabs to numa node of allocating thread
+   * @return init result
+   */
+  Status Init(const std::shared_ptr<Configuration> &config = nullptr);
 
   virtual void *MemAlloc(size_t size);
 
@@ -76,8 +92,36 @@ class CpuMemoryPool : public MemoryPoolBase {
 
   virtual void OnTimer();
 
+  /**
+   * @brief Get huge page mode in use
+   * @return huge page mode
+   */
+  CpuHugePageMode GetHugePageMode() const { return hugepage_mode_; }
+
+  /**
+   * @brief Whether large slabs are bound to numa node
+   * @return numa bind or not
+   */
+  bool IsNumaBind() const { return numa_bind_; }
+
+  /**
+   * @brief Whether explicit huge page failed and fell back to transparent
+   * @return fallback or not
+   */
+  bool IsHugeTlbFallback() const { return hugetlb_failed_; }
+
  private:
+  void *MapAlloc(size_t size);
+
+  void BindNumaNode(void *ptr, size_t size);
+
   std::shared_ptr<TimerTask> flush_timer_;
+  CpuHugePageMode hugepage_mode_{HUGEPAGE_NONE};
+  bool numa_bind_{false};
+  bool use_mmap_{false};
+  std::atomic<bool> hugetlb_failed_{false};
+  std::mutex map_lock_;
+  std::unordered_map<void *, size_t> map_mem_;
 };
 
 class CpuMemoryManager : public DeviceMemoryManager {
@@ -88,9 +132,10 @@ class CpuMemoryManager : public DeviceMemoryManager {
 
   /**
    * @brief Init memory manager
+   * @param config cpu device config
    * @return init result
    */
-  Status Init();
+  Status Init(const std::shared_ptr<Configuration> &config = nullptr);
 
   /**
    * @brief Create a specified memory container
@@ -47,6 +47,10 @@ class CPUFactory : public DeviceFactory {
   const std::string GetDeviceFactoryType();
   std::vector<std::string> GetDeviceList();
   std::shared_ptr<Device> CreateDevice(const std::string &device_id);
+  void SetDeviceConfig(const std::shared_ptr<Configuration> &config) override;
+
+ private:
+  std::shared_ptr<Configuration> config_;
 };
 
 class CPUDesc : public DeviceDesc {
@@ -20,33 +20,78 @@
 #include <modelbox/base/log.h>
 
 constexpr int32_t CLASS_BACKGROUND = -1;
+// keep confidence filter a little loose, exact check is done on box score
+constexpr float CONFIDENCE_THRESHOLD_MARGIN = 0.01f;
+
+size_t YoloFilterScalar(const float *data, size_t count, float threshold,
+                        uint32_t *index) {
+  size_t num = 0;
+  for (size_t i = 0; i < count; ++i) {
+    index[num] = (uint32_t)i;
+    num += data[i] >= threshold ? 1 : 0;
+  }
+
+  return num;
+}
+
+static YoloFilterFunc SelectYoloFilter() {
+  auto avx2 = GetYoloFilterAVX2();
+  if (avx2 != nullptr) {
+    return avx2;
+  }
+
+  return YoloFilterScalar;
+}
+
+YoloHelper::YoloHelper(const YoloParam &param) : param_{param} {
+  // box score = sigmoid(confidence) * class score, class score <= 1, so a
+  // cell whose confidence is below logit(min score threshold) is dropped
+  // without computing class scores
+  confidence_threshold_ = -INFINITY;
+  if (param_.score_threshold_.empty()) {
+    return;
+  }
 
-void YoloHelper::GetBoundingBox(
-    const float *single_layer_result, size_t layer_index,
-    std::function<void(float x, float y, float w, float h, float box_score,
-                       int category)> const &save_box_func) {
+  auto min_score = *std::min_element(param_.score_threshold_.begin(),
+                                     param_.score_threshold_.end());
+  if (min_score > 0 && min_score < 1) {
+    confidence_threshold_ =
+        static_cast<float>(log(min_score / (1. - min_score))) -
+        CONFIDENCE_THRESHOLD_MARGIN;
+  }
+}
+
+void YoloHelper::GetBoundingBox(const float *single_layer_result,
+                                size_t layer_index,
+                                std::vector<BoundingBox> &box_list) {
+  static const YoloFilterFunc filter = SelectYoloFilter();
   auto output_width = param_.layer_wh_[2 * layer_index];
   auto output_height = param_.layer_wh_[2 * layer_index + 1];
   auto step = output_height * output_width;
   auto anchor_size = (5 + param_.class_num_) * output_height * output_width;
   auto anchor_num = param_.anchor_num_[layer_index];
+  std::vector<uint32_t> candidates(step);
   int category = 0;
   float score = 0;
   for (size_t anchor_index = 0; anchor_index < anchor_num; ++anchor_index) {
     auto anchor_data = single_layer_result + anchor_index * anchor_size;
-    for (int32_t h = 0; h < output_height; ++h) {
-      for (int32_t w = 0; w < output_width; ++w) {
-        auto confidence = Sigmoid(anchor_data[4 * step + h * output_width + w]);
-        auto score_data = anchor_data + 5 * step + h * output_width + w;
-        GetCategoryAndScore(score_data, step, param_.class_num_, category,
-                            score);
-        if (category == CLASS_BACKGROUND) {
-          continue;
-        }
-
-        GetOneBoundingBox(anchor_data, category, score * confidence,
-                          layer_index, step, h, w, anchor_index, save_box_func);
+    auto confidence_data = anchor_data + 4 * step;
+    auto count = filter(confidence_data, step, confidence_threshold_,
+                        candidates.data());
+    for (size_t i = 0; i < count; ++i) {
+      auto offset = candidates[i];
+      int32_t h = offset / output_width;
+      int32_t w = offset % output_width;
+      auto confidence = Sigmoid(confidence_data[offset]);
+      auto score_data = anchor_data + 5 * step + offset;
+      GetCategoryAndScore(score_data, step, param_.class_num_, category,
+                          score);
+      if (category == CLASS_BACKGROUND) {
+        continue;
       }
+
+      GetOneBoundingBox(anchor_data, category, score * confidence,
+                        layer_index, step, h, w, anchor_index, box_list);
     }
   }
 }
@@ -83,8 +128,7 @@ void YoloHelper::GetOneBoundingBox(
     const float *anchor_data, int32_t category, float box_score,
     size_t layer_index, int32_t step, int32_t feature_map_h,
     int32_t feature_map_w, size_t anchor_index,
-    std::function<void(float x, float y, float w, float h, float box_score,
-                       int32_t category)> const &save_box_func) {
+    std::vector<BoundingBox> &box_list) {
   if (box_score < param_.score_threshold_[category]) {
     return;
   }
@@ -120,7 +164,7 @@ void YoloHelper::GetOneBoundingBox(
 
   if (box_w > 0 && box_h > 0 && box_x < param_.input_width_ &&
       box_y < param_.input_height_) {
-    save_box_func(box_x, box_y, box_w, box_h, box_score, category);
+    box_list.emplace_back(box_x, box_y, box_w, box_h, category, box_score);
   }
 }
 
@@ -133,4 +177,76 @@ size_t YoloHelper::GetAnchorBiasesOffset(size_t layer_index,
 
   offset += anchor_index * 2;
   return offset;
-}
\ No newline at end of file
+}
+
+void YoloHelper::NMS(std::vector<BoundingBox> &box_list,
+                     std::vector<BoundingBox> &result) {
+  std::stable_sort(box_list.begin(), box_list.end(),
+                   [](const BoundingBox &box1, const BoundingBox &box2) {
+                     return box1.score_ > box2.score_;
+                   });
+
+  // boxes of different category never overlap, suppress in each bucket
+  std::vector<std::vector<uint32_t>> buckets(param_.class_num_);
+  for (size_t i = 0; i < box_list.size(); ++i) {
+    buckets[box_list[i].category_].push_back((uint32_t)i);
+  }
+
+  std::vector<uint8_t> suppressed(box_list.size(), 0);
+  for (auto &bucket : buckets) {
+    NMSCategory(box_list, bucket, suppressed);
+  }
+
+  for (size_t i = 0; i < box_list.size(); ++i) {
+    if (suppressed[i] == 0) {
+      result.push_back(box_list[i]);
+    }
+  }
+}
+
+void YoloHelper::NMSCategory(const std::vector<BoundingBox> &box_list,
+                             const std::vector<uint32_t> &bucket,
+                             std::vector<uint8_t> &suppressed) {
+  auto size = bucket.size();
+  if (size < 2) {
+    return;
+  }
+
+  std::vector<float> x1(size), y1(size), x2(size), y2(size), area(size);
+  for (size_t i = 0; i < size; ++i) {
+    const auto &box = box_list[bucket[i]];
+    x1[i] = box.x_;
+    y1[i] = box.y_;
+    x2[i] = box.x_ + box.w_;
+    y2[i] = box.y_ + box.h_;
+    area[i] = box.w_ * box.h_;
+  }
+
+  float threshold = param_.nms_threshold_[box_list[bucket[0]].category_];
+  std::vector<uint8_t> removed(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    if (removed[i]) {
+      continue;
+    }
+
+    // branch free, so compiler can vectorize iou of box i to the rest
+    for (size_t j = i + 1; j < size; ++j) {
+      float left = std::max(x1[i], x1[j]);
+      float right = std::min(x2[i], x2[j]);
+      float top = std::max(y1[i], y1[j]);
+      float down = std::min(y2[i], y2[j]);
+      float inter_w = right - left;
+      float inter_h = down - top;
+      float inter_area = inter_w * inter_h;
+      float union_area = area[i] + area[j] - inter_area;
+      removed[j] |= (uint8_t)(inter_w > 0 && inter_h > 0 &&
+                              inter_area >= threshold * union_area);
+    }
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    if (removed[i]) {
+      suppressed[bucket[i]] = 1;
+    }
+  }
+}
@@ -18,14 +18,29 @@
 #ifndef MODELBOX_FLOWUNIT_YOLO_HELPER_H
 #define MODELBOX_FLOWUNIT_YOLO_HELPER_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <algorithm>
 #include <cmath>
-#include <functional>
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
+class BoundingBox {
+ public:
+  float x_;
+  float y_;
+  float w_;
+  float h_;
+  int32_t category_;
+  float score_;
+
+  BoundingBox(float x, float y, float w, float h, int32_t category, float score)
+      : x_(x), y_(y), w_(w), h_(h), category_(category), score_(score) {}
+  ~BoundingBox() {}
+};
+
 class YoloParam {
  public:
   int32_t input_width_;
@@ -40,26 +55,48 @@ class YoloParam {
   bool scale_to_input;
 };
 
+/**
+ * @brief Collect index of values >= threshold
+ * @param data input values
+ * @param count value number
+ * @param threshold threshold to compare
+ * @param index output index, at least count elements
+ * @return number of index written
+ */
+using YoloFilterFunc = size_t (*)(const float *data, size_t count,
+                                  float threshold, uint32_t *index);
+
+size_t YoloFilterScalar(const float *data, size_t count, float threshold,
+                        uint32_t *index);
+
+/**
+ * @brief Avx2 filter, only valid when cpu supports avx2
+ * @return nullptr when not built for x86_64
+ */
+YoloFilterFunc GetYoloFilterAVX2();
+
 class YoloHelper {
  public:
-  YoloHelper(const YoloParam &param) : param_{param} {}
+  YoloHelper(const YoloParam &param);
 
   virtual ~YoloHelper() = default;
 
-  void GetBoundingBox(
-      const float *single_layer_result, size_t layer_index,
-      std::function<void(float x, float y, float w, float h, float box_score,
-                         int category)> const &save_box_func);
-
-  template <class T>
-  void Sort(std::vector<T> &box_list,
-            std::function<bool(const T &box1, const T &box2)> const &compare);
-
-  template <class T>
-  void NMS(
-      std::vector<T> &src_box_list, std::vector<T> &dst_box_list,
-      std::function<bool(const T &box1, const T &box2,
-                         std::vector<float> &nms_threshold)> const &overlap);
+  /**
+   * @brief Decode boxes of one output layer
+   * @param single_layer_result layer data, anchor * (5 + class) * h * w
+   * @param layer_index index of layer
+   * @param box_list decoded boxes are appended
+   */
+  void GetBoundingBox(const float *single_layer_result, size_t layer_index,
+                      std::vector<BoundingBox> &box_list);
+
+  /**
+   * @brief Sort boxes by score and suppress overlapped box of same category
+   * @param box_list boxes of one image, will be sorted
+   * @param result boxes kept, in score order
+   */
+  void NMS(std::vector<BoundingBox> &box_list,
+           std::vector<BoundingBox> &result);
 
  private:
   inline float Sigmoid(float x) {
@@ -69,50 +106,21 @@ class YoloHelper {
   void GetCategoryAndScore(const float *input, int32_t step, int32_t class_num,
                            int32_t &category, float &score);
 
-  void GetOneBoundingBox(
-      const float *anchor_data, int32_t category, float box_score,
-      size_t layer_index, int32_t step, int32_t feature_map_h,
-      int32_t feature_map_w, size_t anchor_index,
-      std::function<void(float x, float y, float w, float h, float box_score,
-                         int32_t category)> const &save_box_func);
+  void GetOneBoundingBox(const float *anchor_data, int32_t category,
+                         float box_score, size_t layer_index, int32_t step,
+                         int32_t feature_map_h, int32_t feature_map_w,
+                         size_t anchor_index,
+                         std::vector<BoundingBox> &box_list);
 
   size_t GetAnchorBiasesOffset(size_t layer_index, size_t anchor_index);
 
+  void NMSCategory(const std::vector<BoundingBox> &box_list,
+                   const std::vector<uint32_t> &bucket,
+                   std::vector<uint8_t> &suppressed);
+
   YoloParam param_;
+  // raw confidence below this can not reach any score threshold
+  float confidence_threshold_;
 };
 
-template <class T>
-void YoloHelper::Sort(
-    std::vector<T> &box_list,
-    std::function<bool(const T &box1, const T &box2)> const &compare) {
-  std::sort(box_list.begin(), box_list.end(), compare);
-}
-
-template <class T>
-void YoloHelper::NMS(
-    std::vector<T> &src_box_list, std::vector<T> &dst_box_list,
-    std::function<bool(const T &box1, const T &box2,
-                       std::vector<float> &nms_threshold)> const &overlap) {
-  auto size = src_box_list.size();
-  std::unordered_set<size_t> set;
-  for (size_t i = 0; i < size; ++i) {
-    if (set.find(i) != set.end()) {
-      // Has been tested
-      continue;
-    }
-
-    dst_box_list.push_back(src_box_list[i]);
-    // Find box that overlap >= threshold
-    for (size_t j = i + 1; j < size; ++j) {
-      if (set.find(j) != set.end()) {
-        continue;
-      }
-
-      if (overlap(src_box_list[i], src_box_list[j], param_.nms_threshold_)) {
-        set.insert(j);  // Will not access this box next time
-      }
-    }
-  }
-}
-
 #endif  // MODELBOX_FLOWUNIT_YOLO_HELPER_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "yolo_helper.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+static size_t YoloFilterAVX2(const float *data, size_t count, float threshold,
+                             uint32_t *index) {
+  auto threshold_vec = _mm256_set1_ps(threshold);
+  size_t num = 0;
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    auto value = _mm256_loadu_ps(data + i);
+    auto mask = (uint32_t)_mm256_movemask_ps(
+        _mm256_cmp_ps(value, threshold_vec, _CMP_GE_OQ));
+    /* most cells are background, skip 8 of them with one test */
+    while (mask != 0) {
+      index[num++] = (uint32_t)(i + __builtin_ctz(mask));
+      mask &= mask - 1;
+    }
+  }
+
+  auto tail_num = YoloFilterScalar(data + i, count - i, threshold, index + num);
+  for (size_t n = num; n < num + tail_num; ++n) {
+    index[n] += (uint32_t)i;
+  }
+
+  return num + tail_num;
+}
+
+YoloFilterFunc GetYoloFilterAVX2() {
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("avx2")) {
+    return nullptr;
+  }
+
+  return YoloFilterAVX2;
+}
+#else
+YoloFilterFunc GetYoloFilterAVX2() { return nullptr; }
+#endif
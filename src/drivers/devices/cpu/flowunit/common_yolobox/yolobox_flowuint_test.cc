@@ -140,4 +140,53 @@ TEST_F(CommonYoloboxFlowUintTest, Process) {
   EXPECT_EQ(flow->Wait(3 * 1000), STATUS_TIMEDOUT);
 }
 
+TEST(CommonYoloboxTest, NMS) {
+  YoloParam param;
+  param.class_num_ = 2;
+  param.score_threshold_ = {0.5, 0.5};
+  param.nms_threshold_ = {0.45, 0.45};
+  YoloHelper helper(param);
+
+  std::vector<BoundingBox> boxes{{0, 0, 10, 10, 0, 0.7},
+                                 {1, 1, 10, 10, 0, 0.9},
+                                 {1, 1, 10, 10, 1, 0.8},
+                                 {20, 20, 10, 10, 0, 0.6}};
+  std::vector<BoundingBox> result;
+  helper.NMS(boxes, result);
+  ASSERT_EQ(result.size(), 3);
+  EXPECT_FLOAT_EQ(result[0].score_, 0.9);
+  EXPECT_EQ(result[1].category_, 1);
+  EXPECT_FLOAT_EQ(result[2].x_, 20);
+}
+
+TEST(CommonYoloboxTest, FilterAVX2) {
+  auto filter_avx2 = GetYoloFilterAVX2();
+  if (filter_avx2 == nullptr) {
+    GTEST_SKIP();
+  }
+
+  const float threshold = 0.5;
+  std::vector<float> data(67);
+  for (size_t i = 0; i < data.size(); ++i) {
+    // values below, equal to and above threshold, some lanes all below
+    data[i] = (i % 3 == 0) ? threshold : (i % 7 == 0 ? 0.9 : 0.1);
+    if (i >= 16 && i < 24) {
+      data[i] = -1;
+    }
+  }
+
+  for (size_t count : {0, 1, 7, 8, 9, 15, 24, 33, 67}) {
+    std::vector<uint32_t> index_scalar(count + 1);
+    std::vector<uint32_t> index_avx2(count + 1);
+    auto num_scalar =
+        YoloFilterScalar(data.data(), count, threshold, index_scalar.data());
+    auto num_avx2 =
+        filter_avx2(data.data(), count, threshold, index_avx2.data());
+    ASSERT_EQ(num_avx2, num_scalar) << "count " << count;
+    index_scalar.resize(num_scalar);
+    index_avx2.resize(num_avx2);
+    EXPECT_EQ(index_avx2, index_scalar) << "count " << count;
+  }
+}
+
 }  // namespace modelbox
@@ -98,6 +98,8 @@ modelbox::Status YoloboxFlowUnit::Open(
   }
 
   yolo_helper_ = std::make_shared<YoloHelper>(param);
+  pool_ = std::make_shared<modelbox::ThreadPool>(0);
+  pool_->SetName("Yolobox");
   auto desc = GetFlowUnitDesc();
   auto input_list = desc->GetFlowUnitInput();
   for (auto &input : input_list) {
@@ -149,28 +151,18 @@ modelbox::Status YoloboxFlowUnit::ReadTensorData(
   return modelbox::STATUS_OK;
 }
 
-bool Comp(const BoundingBox &box1, const BoundingBox &box2) {
-  return box1.score_ > box2.score_;
-}
-
-bool Overlap(const BoundingBox &box1, const BoundingBox &box2,
-             std::vector<float> &nms_threshold) {
-  if (box1.category_ != box2.category_) {
-    return false;
-  }
-
-  float threshold = nms_threshold[box1.category_];
-  float left = std::max(box1.x_, box2.x_);
-  float right = std::min(box1.x_ + box1.w_, box2.x_ + box2.w_);
-  float top = std::max(box1.y_, box2.y_);
-  float down = std::min(box1.y_ + box1.h_, box2.y_ + box2.h_);
-  if (left >= right or top >= down) {
-    return 0.0f;
+void YoloboxFlowUnit::DetectBoxes(
+    const std::vector<std::shared_ptr<modelbox::Buffer>> &tensors,
+    std::vector<BoundingBox> &boxes) {
+  std::vector<BoundingBox> detected_boxes;
+  for (size_t tensor_index = 0; tensor_index < tensors.size();
+       ++tensor_index) {
+    auto &tensor = tensors[tensor_index];
+    yolo_helper_->GetBoundingBox((const float *)tensor->ConstData(),
+                                 tensor_index, detected_boxes);
   }
 
-  float inter_area = (right - left) * (down - top);
-  float union_area = (box1.w_ * box1.h_ + box2.w_ * box2.h_ - inter_area);
-  return inter_area >= threshold * union_area;
+  yolo_helper_->NMS(detected_boxes, boxes);
 }
 
 modelbox::Status YoloboxFlowUnit::SendBoxData(
@@ -208,28 +200,17 @@ modelbox::Status YoloboxFlowUnit::Process(
     return ret;
   }
 
-  std::vector<std::vector<BoundingBox>> detected_boxes_mul_batch;
-  for (size_t batch_index = 0; batch_index < tensor_data.size();
-       ++batch_index) {
-    std::vector<BoundingBox> detected_boxes_single_batch;
-    auto &tensors_in_one_batch = tensor_data[batch_index];
-    for (size_t tensor_index = 0; tensor_index < tensors_in_one_batch.size();
-         ++tensor_index) {
-      auto &tensor = tensors_in_one_batch[tensor_index];
-      yolo_helper_->GetBoundingBox(
-          (const float *)tensor->ConstData(), tensor_index,
-          [&detected_boxes_single_batch](float x, float y, float w, float h,
-                                         float box_score, int category) {
-            detected_boxes_single_batch.emplace_back(x, y, w, h, category,
-                                                     box_score);
-          });
-    }
-
-    yolo_helper_->Sort<BoundingBox>(detected_boxes_single_batch, Comp);
-    std::vector<BoundingBox> final_boxes;
-    yolo_helper_->NMS<BoundingBox>(detected_boxes_single_batch, final_boxes,
-                                   Overlap);
-    detected_boxes_mul_batch.push_back(final_boxes);
+  // decode batch elements in parallel, the first one on current thread
+  std::vector<std::vector<BoundingBox>> detected_boxes_mul_batch(
+      tensor_data.size());
+  ret = pool_->ParallelFor(tensor_data.size(), [&](size_t batch_index) {
+    DetectBoxes(tensor_data[batch_index],
+                detected_boxes_mul_batch[batch_index]);
+    return modelbox::STATUS_OK;
+  });
+  if (!ret) {
+    MBLOG_ERROR << "detect boxes failed, " << ret;
+    return ret;
   }
 
   ret = SendBoxData(detected_boxes_mul_batch, data_ctx);
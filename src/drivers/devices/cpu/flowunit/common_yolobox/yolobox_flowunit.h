@@ -19,6 +19,7 @@
 
 #include <modelbox/base/device.h>
 #include <modelbox/base/status.h>
+#include <modelbox/base/thread_pool.h>
 #include <modelbox/flow.h>
 
 #include <algorithm>
@@ -30,20 +31,6 @@
 #include "modelbox/flowunit.h"
 #include "yolo_helper.h"
 
-class BoundingBox {
- public:
-  float x_;
-  float y_;
-  float w_;
-  float h_;
-  int32_t category_;
-  float score_;
-
-  BoundingBox(float x, float y, float w, float h, int32_t category, float score)
-      : x_(x), y_(y), w_(w), h_(h), category_(category), score_(score) {}
-  ~BoundingBox() {}
-};
-
 constexpr const char *FLOWUNIT_NAME = "yolov3_postprocess";
 constexpr const char *FLOWUNIT_TYPE = "cpu";
 constexpr const char *FLOWUNIT_DESC = "A cpu yolobox flowunit";
@@ -84,6 +71,10 @@ class YoloboxFlowUnit : public modelbox::FlowUnit {
       std::vector<std::vector<std::shared_ptr<modelbox::Buffer>>> &tensor_data,
       std::shared_ptr<modelbox::DataContext> &data_ctx);
 
+  void DetectBoxes(
+      const std::vector<std::shared_ptr<modelbox::Buffer>> &tensors,
+      std::vector<BoundingBox> &boxes);
+
   modelbox::Status SendBoxData(
       std::vector<std::vector<BoundingBox>> &box_data,
       std::shared_ptr<modelbox::DataContext> &data_ctx);
@@ -91,6 +82,7 @@ class YoloboxFlowUnit : public modelbox::FlowUnit {
   std::shared_ptr<YoloHelper> yolo_helper_;
   std::vector<std::string> input_name_list_;
   std::vector<std::string> output_name_list_;
+  std::shared_ptr<modelbox::ThreadPool> pool_;
 };
 
 class YoloboxFlowUnitDesc : public modelbox::FlowUnitDesc {
@@ -16,6 +16,7 @@
 
 #include "cv_crop_flowunit.h"
 #include <securec.h>
+#include "image_process.h"
 #include "modelbox/flowunit.h"
 #include "modelbox/flowunit_api_helper.h"
 
@@ -24,6 +25,8 @@ CVCropFlowUnit::~CVCropFlowUnit(){};
 
 modelbox::Status CVCropFlowUnit::Open(
     const std::shared_ptr<modelbox::Configuration> &opts) {
+  zero_copy_ = opts->GetBool("zero_copy", false);
+  MBLOG_DEBUG << "crop zero copy " << zero_copy_;
   return modelbox::STATUS_OK;
 }
 modelbox::Status CVCropFlowUnit::Close() { return modelbox::STATUS_OK; }
@@ -57,25 +60,9 @@ modelbox::Status CVCropFlowUnit::Process(
   }
 
   auto output_bufs = ctx->Output("out_image");
-
-  std::vector<size_t> shape_vector;
-  int32_t channel = RGB_CHANNLES;
-  for (size_t i = 0; i < input_img_bufs->Size(); ++i) {
-    auto bbox = static_cast<const RoiBox *>(input_box_bufs->ConstBufferData(i));
-    int32_t crop_width = bbox->w;
-    int32_t crop_height = bbox->h;
-    shape_vector.push_back(crop_width * crop_height * channel * sizeof(u_char));
-  }
-
-  output_bufs->Build(shape_vector);
-
-  output_bufs->CopyMeta(input_img_bufs);
-
   for (size_t i = 0; i < input_img_bufs->Size(); ++i) {
     int32_t width;
     int32_t height;
-    int32_t width_dest;
-    int32_t height_dest;
     int32_t channel;
     std::string pix_fmt;
 
@@ -107,40 +94,76 @@ modelbox::Status CVCropFlowUnit::Process(
 
     channel = RGB_CHANNLES;
 
-    void *input_data = const_cast<void *>(input_img_bufs->ConstBufferData(i));
-    cv::Mat img_data(cv::Size(width, height), CV_8UC3, input_data);
-    MBLOG_DEBUG << "ori image : cols " << img_data.cols << " rows "
-                << img_data.rows << " channel " << img_data.channels();
+    if (width <= 0 || height <= 0) {
+      auto errMsg = "input image size " + std::to_string(width) + "x" +
+                    std::to_string(height) + " is invalid";
+      MBLOG_ERROR << errMsg;
+      return {modelbox::STATUS_INVALID, errMsg};
+    }
+
+    size_t step = 0;
+    auto ret = imageprocess::GetImageRowStep(
+        img_buffer, (size_t)width * channel, height, step);
+    if (!ret) {
+      MBLOG_ERROR << "input image is invalid, " << ret.WrapErrormsgs();
+      return ret;
+    }
 
     auto bbox = static_cast<const RoiBox *>(input_box_bufs->ConstBufferData(i));
 
     MBLOG_DEBUG << "crop bbox :  " << bbox->x << " " << bbox->y << " "
                 << bbox->w << " " << bbox->h;
 
-    cv::Rect my_roi(bbox->x, bbox->y, bbox->w, bbox->h);
-    cv::Mat cropped;
-    cropped = img_data(my_roi);
-    auto img_dest = std::make_shared<cv::Mat>();
-    cropped.copyTo(*img_dest);
-    size_t size_bytes = img_dest->total() * img_dest->elemSize();
-    auto output_buffer = output_bufs->At(i);
-    output_buffer->BuildFromHost(img_dest->data, size_bytes,
-                                 [img_dest](void *ptr) {
-                                   /* Only capture pkt */
-                                 });
-
-    width_dest = img_dest->cols;
-    height_dest = img_dest->rows;
-    output_buffer->Set("width", width_dest);
-    output_buffer->Set("height", height_dest);
-    output_buffer->Set("width_stride", width_dest);
-    output_buffer->Set("height_stride", height_dest);
+    if (bbox->x < 0 || bbox->y < 0 || bbox->w <= 0 || bbox->h <= 0 ||
+        bbox->x + bbox->w > width || bbox->y + bbox->h > height) {
+      auto errMsg = "crop box is out of image " + std::to_string(width) + "x" +
+                    std::to_string(height);
+      MBLOG_ERROR << errMsg;
+      return {modelbox::STATUS_INVALID, errMsg};
+    }
+
+    std::shared_ptr<modelbox::Buffer> output_buffer;
+    size_t crop_row_bytes = (size_t)bbox->w * channel;
+    size_t crop_offset = bbox->y * step + (size_t)bbox->x * channel;
+    auto crop_stride = (int32_t)crop_row_bytes;
+    if (zero_copy_) {
+      // crop is a view into input image, rows keep the stride of input
+      auto crop_mem = img_buffer->GetDeviceMemory()->Cut(
+          crop_offset, step * (bbox->h - 1) + crop_row_bytes);
+      if (crop_mem == nullptr) {
+        MBLOG_ERROR << "cut crop memory failed";
+        return modelbox::STATUS_FAULT;
+      }
+
+      crop_mem->SetContentMutable(false);
+      output_buffer = std::make_shared<modelbox::Buffer>(crop_mem);
+      crop_stride = (int32_t)step;
+    } else {
+      output_buffer = std::make_shared<modelbox::Buffer>(GetBindDevice());
+      ret = output_buffer->Build(crop_row_bytes * bbox->h);
+      if (!ret) {
+        MBLOG_ERROR << "build output buffer failed, " << ret;
+        return ret;
+      }
+
+      void *input_data = const_cast<void *>(img_buffer->ConstData());
+      cv::Mat img_data(cv::Size(width, height), CV_8UC3, input_data, step);
+      cv::Mat img_dest(bbox->h, bbox->w, CV_8UC3, output_buffer->MutableData());
+      img_data(cv::Rect(bbox->x, bbox->y, bbox->w, bbox->h)).copyTo(img_dest);
+    }
+
+    output_buffer->CopyMeta(img_buffer);
+    output_buffer->Set("width", bbox->w);
+    output_buffer->Set("height", bbox->h);
+    output_buffer->Set("width_stride", crop_stride);
+    output_buffer->Set("height_stride", bbox->h);
     output_buffer->Set("channel", channel);
     output_buffer->Set("pix_fmt", pix_fmt);
     output_buffer->Set("type", modelbox::ModelBoxDataType::MODELBOX_UINT8);
-    output_buffer->Set("shape", std::vector<size_t>{(size_t)height_dest,
-                                                    (size_t)width_dest, 3});
+    output_buffer->Set("shape", std::vector<size_t>{(size_t)bbox->h,
+                                                    (size_t)bbox->w, 3});
     output_buffer->Set("layout", std::string("hwc"));
+    output_bufs->PushBack(output_buffer);
   }
 
   return modelbox::STATUS_OK;
@@ -153,6 +176,9 @@ MODELBOX_FLOWUNIT(CVCropFlowUnit, desc) {
   desc.AddFlowUnitInput(modelbox::FlowUnitInput("in_region", FLOWUNIT_TYPE));
   desc.AddFlowUnitOutput(
       modelbox::FlowUnitOutput("out_image", FLOWUNIT_TYPE));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "zero_copy", "bool", false, "false",
+      "output crop as a view into input image with its width_stride"));
   desc.SetFlowType(modelbox::NORMAL);
   desc.SetInputContiguous(false);
   desc.SetDescription(FLOWUNIT_DESC);
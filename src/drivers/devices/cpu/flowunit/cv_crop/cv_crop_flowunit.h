@@ -67,6 +67,9 @@ class CVCropFlowUnit : public modelbox::FlowUnit {
 
   /* run when processing data */
   modelbox::Status Process(std::shared_ptr<modelbox::DataContext> data_ctx);
+
+ private:
+  bool zero_copy_{false};
 };
 
 #endif  // MODELBOX_FLOWUNIT_CV_CROP_FLOWUNIT_CPU_H_
@@ -202,12 +202,15 @@ Status CVCropFlowUnitTest::AddMockFlowUnit() {
           MBLOG_ERROR << "meta don't have key channel";
         }
 
-        auto input_data =
-            static_cast<const uchar*>(input_buf->ConstBufferData(i));
-
-        cv::Mat img_data(cv::Size(width, height), CV_8UC3);
-        memcpy_s(img_data.data, img_data.total() * img_data.elemSize(),
-                 input_data, input_buf->At(i)->GetBytes());
+        // width_stride is the row pitch in bytes
+        int32_t width_stride = width * channels;
+        input_buf->At(i)->Get("width_stride", width_stride);
+        size_t step = width_stride;
+
+        auto input_data = const_cast<void*>(input_buf->ConstBufferData(i));
+        cv::Mat img_data =
+            cv::Mat(cv::Size(width, height), CV_8UC3, input_data, step)
+                .clone();
         std::string name =
             std::string(TEST_DATA_DIR) + "/test" + std::to_string(i) + ".jpg";
         cv::imwrite(name.c_str(), img_data);
@@ -224,6 +227,33 @@ Status CVCropFlowUnitTest::AddMockFlowUnit() {
   return STATUS_OK;
 }
 
+static void CheckCropResult() {
+  for (size_t i = 0; i < 5; i++) {
+    for (size_t j = 0; j < 2; j++) {
+      std::string expected_file_path = std::string(TEST_ASSETS) +
+                                       "/crop_result_" + std::to_string(j) +
+                                       ".jpg";
+      cv::Mat expected_img = cv::imread(expected_file_path);
+
+      std::string crop_result_file_path = std::string(TEST_DATA_DIR) + "/test" +
+                                          std::to_string(2 * i + j) + ".jpg";
+      cv::Mat crop_result_img = cv::imread(crop_result_file_path);
+
+      int result_data_size =
+          crop_result_img.total() * crop_result_img.elemSize();
+      int expected_data_size = expected_img.total() * expected_img.elemSize();
+      EXPECT_EQ(result_data_size, expected_data_size);
+
+      int ret =
+          memcmp(crop_result_img.data, expected_img.data, result_data_size);
+      EXPECT_EQ(ret, 0);
+
+      auto rmret = remove(crop_result_file_path.c_str());
+      EXPECT_EQ(rmret, 0);
+    }
+  }
+}
+
 TEST_F(CVCropFlowUnitTest, InitUnit) {
   const std::string test_lib_dir = TEST_DRIVER_DIR;
   std::string toml_content = R"(
@@ -253,30 +283,32 @@ TEST_F(CVCropFlowUnitTest, InitUnit) {
     MBLOG_DEBUG << "filePath: " << elem;
   }
 
-  for (size_t i = 0; i < 5; i++) {
-    for (size_t j = 0; j < 2; j++) {
-      std::string expected_file_path = std::string(TEST_ASSETS) +
-                                       "/crop_result_" + std::to_string(j) +
-                                       ".jpg";
-      cv::Mat expected_img = cv::imread(expected_file_path);
-
-      std::string crop_result_file_path = std::string(TEST_DATA_DIR) + "/test" +
-                                          std::to_string(2 * i + j) + ".jpg";
-      cv::Mat crop_result_img = cv::imread(crop_result_file_path);
+  CheckCropResult();
+}
 
-      int result_data_size =
-          crop_result_img.total() * crop_result_img.elemSize();
-      int expected_data_size = expected_img.total() * expected_img.elemSize();
-      EXPECT_EQ(result_data_size, expected_data_size);
+TEST_F(CVCropFlowUnitTest, ZeroCopy) {
+  const std::string test_lib_dir = TEST_DRIVER_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"([graph]
+    graphconf = '''digraph demo {
+          test_0_1_cv_crop[type=flowunit, flowunit=test_0_1_cv_crop, device=cpu, deviceid=0, label="<Out_img> | <Out_box>", batch_size=10]
+          cv_crop[type=flowunit, flowunit=crop, device=cpu, deviceid=0, label="<in_image> | <in_region> | <out_image>", batch_size=10, zero_copy=true]
+          test_1_0_cv_crop[type=flowunit, flowunit=test_1_0_cv_crop, device=cpu, deviceid=0, label="<In_img>", batch_size=10]
+          test_0_1_cv_crop:Out_img  -> cv_crop:in_image
+          test_0_1_cv_crop:Out_box -> cv_crop:in_region
+          cv_crop:out_image -> test_1_0_cv_crop:In_img
+        }'''
+    format = "graphviz"
+  )";
 
-      int ret =
-          memcmp(crop_result_img.data, expected_img.data, result_data_size);
-      EXPECT_EQ(ret, 0);
+  auto ret =
+      GetDriverFlow()->BuildAndRun("CVCropZeroCopy", toml_content, 3 * 1000);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
 
-      auto rmret = remove(crop_result_file_path.c_str());
-      EXPECT_EQ(rmret, 0);
-    }
-  }
+  CheckCropResult();
 }
 
 }  // namespace modelbox
\ No newline at end of file
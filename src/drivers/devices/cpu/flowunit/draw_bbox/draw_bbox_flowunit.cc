@@ -16,6 +16,7 @@
 
 #include "draw_bbox_flowunit.h"
 #include <securec.h>
+#include "image_process.h"
 #include "modelbox/flowunit.h"
 #include "modelbox/flowunit_api_helper.h"
 
@@ -55,65 +56,65 @@ modelbox::Status DrawBBoxFlowUnit::Process(
   }
 
   auto output_bufs = ctx->Output("out_image");
-
-  std::vector<size_t> shape;
-  for (size_t i = 0; i < input2_bufs->Size(); ++i) {
-    shape.emplace_back(input2_bufs->At(i)->GetBytes());
-  }
-
-  output_bufs->Build(shape);
   MBLOG_INFO << "begin process batch";
   for (size_t i = 0; i < input1_bufs->Size(); ++i) {
     // get bboxes
     size_t num_bboxes = input1_bufs->At(i)->GetBytes() / sizeof(BBox);
+    auto bboxs = static_cast<const BBox *>(input1_bufs->ConstBufferData(i));
 
     MBLOG_INFO << "num_bboxes: " << num_bboxes;
 
-    std::vector<std::shared_ptr<BBox>> bboxs;
-    for (size_t j = 0; j < num_bboxes; ++j) {
-      std::shared_ptr<BBox> b = std::make_shared<BBox>();
-      memcpy_s(
-          b.get(), sizeof(BBox),
-          (const char *)(input1_bufs->ConstBufferData(i)) + (sizeof(BBox) * j),
-          sizeof(BBox));
-      bboxs.push_back(b);
+    // draw on input memory when no one else holds it
+    auto output_buffer = input2_bufs->At(i)->CopyOnWrite();
+    if (output_buffer == nullptr) {
+      auto errMsg = "copy image " + std::to_string(i) + " failed";
+      MBLOG_ERROR << errMsg;
+      return {modelbox::STATUS_NOMEM, errMsg};
     }
 
     // get images
-    int32_t width, height, channel, rate_den, rate_num;
-    input2_bufs->At(i)->Get("width", width);
-    input2_bufs->At(i)->Get("height", height);
-    input2_bufs->At(i)->Get("channel", channel);
-    input2_bufs->At(i)->Get("rate_den", rate_den);
-    input2_bufs->At(i)->Get("rate_num", rate_num);
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t channel = 0;
+    output_buffer->Get("width", width);
+    output_buffer->Get("height", height);
+    output_buffer->Get("channel", channel);
     std::string pix_fmt = "rgb";
-    input2_bufs->At(i)->Get("pix_fmt", pix_fmt);
+    output_buffer->Get("pix_fmt", pix_fmt);
 
     MBLOG_INFO << "w:" << width << ",h:" << height << ",c:" << channel;
 
-    cv::Mat image(height, width, CV_8UC3);
-    memcpy_s(image.data, image.total() * image.elemSize(),
-             input2_bufs->ConstBufferData(i), input2_bufs->At(i)->GetBytes());
+    if (width <= 0 || height <= 0) {
+      auto errMsg = "input image size " + std::to_string(width) + "x" +
+                    std::to_string(height) + " is invalid";
+      MBLOG_ERROR << errMsg;
+      return {modelbox::STATUS_INVALID, errMsg};
+    }
+
+    size_t step = 0;
+    auto ret = imageprocess::GetImageRowStep(output_buffer, (size_t)width * 3,
+                                             height, step);
+    if (!ret) {
+      MBLOG_ERROR << "input image is invalid, " << ret.WrapErrormsgs();
+      return ret;
+    }
+
+    cv::Mat image(height, width, CV_8UC3, output_buffer->MutableData(), step);
     MBLOG_INFO << "end get images";
 
     // draw bboxes
-    for (auto &b : bboxs) {
-      MBLOG_DEBUG << "draw bbox : has box " << b->x << " " << b->y << " "
-                  << b->w << " " << b->h << " " << b->score << " "
-                  << b->category;
-      cv::rectangle(image, cv::Point(b->x, b->y),
-                    cv::Point(b->x + b->w, b->y + b->h), cv::Scalar(255, 0, 0),
-                    5, 8, 0);
+    for (size_t j = 0; j < num_bboxes; ++j) {
+      auto &b = bboxs[j];
+      MBLOG_DEBUG << "draw bbox : has box " << b.x << " " << b.y << " " << b.w
+                  << " " << b.h << " " << b.score << " " << b.category;
+      cv::rectangle(image, cv::Point(b.x, b.y), cv::Point(b.x + b.w, b.y + b.h),
+                    cv::Scalar(255, 0, 0), 5, 8, 0);
     }
 
-    // output data
-    auto output_buffer = output_bufs->At(i);
-    auto output_data = output_buffer->MutableData();
-    memcpy_s(output_data, output_buffer->GetBytes(), image.data,
-             image.total() * image.elemSize());
+    // output data, other meta like rate_den is kept from input
     output_buffer->Set("width", width);
     output_buffer->Set("height", height);
-    output_buffer->Set("width_stride", width);
+    output_buffer->Set("width_stride", (int32_t)step);
     output_buffer->Set("height_stride", height);
     output_buffer->Set("channel", channel);
     output_buffer->Set("pix_fmt", pix_fmt);
@@ -122,8 +123,7 @@ modelbox::Status DrawBBoxFlowUnit::Process(
         "shape",
         std::vector<size_t>{(size_t)height, (size_t)width, (size_t)channel});
     output_buffer->Set("type", modelbox::ModelBoxDataType::MODELBOX_UINT8);
-    output_buffer->Set("rate_den", rate_den);
-    output_buffer->Set("rate_num", rate_num);
+    output_bufs->PushBack(output_buffer);
   }
 
   MBLOG_INFO << "draw bbox finish";
@@ -25,6 +25,132 @@ ImageDecoderFlowUnit::~ImageDecoderFlowUnit(){};
 
 std::vector<std::string> CvImgPixelFormat{"bgr", "rgb", "nv12"};
 
+// BT.601 coefficients in 20 bit fixed point, same as opencv BGR2YUV_I420
+constexpr int YUV_SHIFT = 20;
+constexpr int YUV_CRY = 269484;
+constexpr int YUV_CGY = 528482;
+constexpr int YUV_CBY = 102760;
+constexpr int YUV_CRU = -155188;
+constexpr int YUV_CGU = -305135;
+constexpr int YUV_CBU = 460324;
+constexpr int YUV_CGV = -385875;
+constexpr int YUV_CBV = -74448;
+
+static bool ParseJpegSize(const u_char *data, size_t size, int32_t &width,
+                          int32_t &height) {
+  if (size < 4 || data[0] != 0xFF || data[1] != 0xD8) {
+    return false;
+  }
+
+  size_t pos = 2;
+  while (pos + 4 <= size) {
+    if (data[pos] != 0xFF) {
+      return false;
+    }
+
+    auto marker = data[pos + 1];
+    if (marker == 0xFF) {
+      pos++;
+      continue;
+    }
+
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) {
+      pos += 2;
+      continue;
+    }
+
+    if (marker == 0xD9 || marker == 0xDA) {
+      return false;
+    }
+
+    // SOF0 - SOF15, except DHT, JPG and DAC
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+        marker != 0xC8 && marker != 0xCC) {
+      if (pos + 9 > size) {
+        return false;
+      }
+
+      height = (data[pos + 5] << 8) | data[pos + 6];
+      width = (data[pos + 7] << 8) | data[pos + 8];
+      return width > 0 && height > 0;
+    }
+
+    size_t len = (data[pos + 2] << 8) | data[pos + 3];
+    if (len < 2) {
+      return false;
+    }
+
+    pos += 2 + len;
+  }
+
+  return false;
+}
+
+static bool ParsePngSize(const u_char *data, size_t size, int32_t &width,
+                         int32_t &height) {
+  const u_char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  if (size < 24 || memcmp(data, signature, sizeof(signature)) != 0 ||
+      memcmp(data + 12, "IHDR", 4) != 0) {
+    return false;
+  }
+
+  auto read_u32 = [](const u_char *ptr) {
+    return ((uint32_t)ptr[0] << 24) | ((uint32_t)ptr[1] << 16) |
+           ((uint32_t)ptr[2] << 8) | (uint32_t)ptr[3];
+  };
+  auto png_width = read_u32(data + 16);
+  auto png_height = read_u32(data + 20);
+  if (png_width == 0 || png_height == 0 || png_width > INT32_MAX ||
+      png_height > INT32_MAX) {
+    return false;
+  }
+
+  width = (int32_t)png_width;
+  height = (int32_t)png_height;
+  return true;
+}
+
+static void SwapRB(uint8_t *data, size_t pixel_num) {
+  for (size_t i = 0; i < pixel_num; ++i) {
+    std::swap(data[i * 3], data[i * 3 + 2]);
+  }
+}
+
+/* chroma of each 2x2 block comes from its top left pixel, as opencv does */
+static void BGR2NV12(const cv::Mat &src_bgr, uint8_t *dst) {
+  const int y_round = (1 << (YUV_SHIFT - 1)) + (16 << YUV_SHIFT);
+  const int uv_round = (1 << (YUV_SHIFT - 1)) + (128 << YUV_SHIFT);
+  auto cols = src_bgr.cols;
+  auto rows = src_bgr.rows;
+  auto uv_plane = dst + (size_t)rows * cols;
+  for (int y = 0; y < rows; ++y) {
+    auto src_row = src_bgr.ptr<uint8_t>(y);
+    auto y_row = dst + (size_t)y * cols;
+    for (int x = 0; x < cols; ++x) {
+      int b = src_row[x * 3];
+      int g = src_row[x * 3 + 1];
+      int r = src_row[x * 3 + 2];
+      y_row[x] = cv::saturate_cast<uint8_t>(
+          (YUV_CRY * r + YUV_CGY * g + YUV_CBY * b + y_round) >> YUV_SHIFT);
+    }
+
+    if (y % 2 != 0) {
+      continue;
+    }
+
+    auto uv_row = uv_plane + (size_t)(y / 2) * cols;
+    for (int x = 0; x < cols; x += 2) {
+      int b = src_row[x * 3];
+      int g = src_row[x * 3 + 1];
+      int r = src_row[x * 3 + 2];
+      uv_row[x] = cv::saturate_cast<uint8_t>(
+          (YUV_CRU * r + YUV_CGU * g + YUV_CBU * b + uv_round) >> YUV_SHIFT);
+      uv_row[x + 1] = cv::saturate_cast<uint8_t>(
+          (YUV_CBU * r + YUV_CGV * g + YUV_CBV * b + uv_round) >> YUV_SHIFT);
+    }
+  }
+}
+
 modelbox::Status ImageDecoderFlowUnit::Open(
     const std::shared_ptr<modelbox::Configuration> &opts) {
   pixel_format_ = opts->GetString("pix_fmt", "bgr");
@@ -44,6 +170,18 @@ modelbox::Status ImageDecoderFlowUnit::Open(
   }
   MBLOG_DEBUG << "pixel_format " << pixel_format_;
 
+  target_width_ = opts->GetInt32("target_width", 0);
+  target_height_ = opts->GetInt32("target_height", 0);
+  if (target_width_ < 0 || target_height_ < 0) {
+    auto errMsg = "target size is invalid, configure is :" +
+                  std::to_string(target_width_) + "x" +
+                  std::to_string(target_height_);
+    MBLOG_ERROR << errMsg;
+    return {modelbox::STATUS_BADCONF, errMsg};
+  }
+
+  pool_ = std::make_shared<modelbox::ThreadPool>(0);
+  pool_->SetName("Image-Decoder");
   return modelbox::STATUS_OK;
 }
 
@@ -54,104 +192,171 @@ modelbox::Status ImageDecoderFlowUnit::DataPre(
   return modelbox::STATUS_OK;
 }
 
-modelbox::Status ImageDecoderFlowUnit::Process(
-    std::shared_ptr<modelbox::DataContext> ctx) {
-  MBLOG_DEBUG << "process image decode";
+int ImageDecoderFlowUnit::GetDecodeFlag(const u_char *data, size_t size,
+                                        int32_t &width, int32_t &height) {
+  int32_t image_width = 0;
+  int32_t image_height = 0;
+  if (ParsePngSize(data, size, image_width, image_height)) {
+    width = image_width;
+    height = image_height;
+    return cv::IMREAD_COLOR;
+  }
 
-  // get input
-  auto input_bufs = ctx->Input("in_encoded_image");
-  auto output_bufs = ctx->Output("out_image");
-  if (input_bufs->Size() <= 0) {
-    auto errMsg = "input images batch is " + std::to_string(input_bufs->Size());
-    MBLOG_ERROR << errMsg;
-    return {modelbox::STATUS_FAULT, errMsg};
+  width = 0;
+  height = 0;
+  if (!ParseJpegSize(data, size, image_width, image_height)) {
+    return cv::IMREAD_COLOR;
+  }
+
+  // jpeg scales in dct domain, pick the largest scale not below target
+  int scale = 1;
+  if (target_width_ > 0 || target_height_ > 0) {
+    for (int s : {8, 4, 2}) {
+      if ((image_width + s - 1) / s >= target_width_ &&
+          (image_height + s - 1) / s >= target_height_) {
+        scale = s;
+        break;
+      }
+    }
+  }
+
+  width = (image_width + scale - 1) / scale;
+  height = (image_height + scale - 1) / scale;
+  switch (scale) {
+    case 8:
+      return cv::IMREAD_REDUCED_COLOR_8;
+    case 4:
+      return cv::IMREAD_REDUCED_COLOR_4;
+    case 2:
+      return cv::IMREAD_REDUCED_COLOR_2;
+    default:
+      return cv::IMREAD_COLOR;
+  }
+}
+
+modelbox::Status ImageDecoderFlowUnit::DecodeImage(
+    const std::shared_ptr<modelbox::Buffer> &input,
+    std::shared_ptr<modelbox::Buffer> &output) {
+  auto input_data = static_cast<const u_char *>(input->ConstData());
+  auto input_size = input->GetBytes();
+  if (input_data == nullptr || input_size == 0 || input_size > INT32_MAX) {
+    MBLOG_ERROR << "input image buffer is invalid, size " << input_size;
+    return modelbox::STATUS_FAULT;
+  }
+
+  cv::Mat input_mat(1, (int)input_size, CV_8UC1, (void *)input_data);
+  int32_t width = 0;
+  int32_t height = 0;
+  auto flag = GetDecodeFlag(input_data, input_size, width, height);
+
+  // decode into output buffer directly when the size is known from header,
+  // imdecode allocates its own mat if size differs, e.g. exif rotation
+  output = std::make_shared<modelbox::Buffer>(GetBindDevice());
+  cv::Mat img_bgr;
+  if (pixel_format_ != "nv12" && width > 0 && height > 0) {
+    auto ret = output->Build((size_t)width * height * 3);
+    if (!ret) {
+      MBLOG_ERROR << "build output buffer failed, " << ret;
+      return ret;
+    }
+
+    img_bgr = cv::Mat(height, width, CV_8UC3, output->MutableData());
+  }
+
+  auto decode_data = img_bgr.data;
+  cv::imdecode(input_mat, flag, &img_bgr);
+  if (img_bgr.data == NULL) {
+    MBLOG_ERROR << "input image buffer is invalid, imdecode failed.";
+    return modelbox::STATUS_FAULT;
   }
 
-  // decode
-  std::vector<cv::Mat> output_img_list;
-  std::vector<size_t> output_shape;
-  auto device = GetBindDevice();
-  for (auto &buffer : *input_bufs) {
-    auto input_data = static_cast<const u_char *>(buffer->ConstData());
-    std::vector<u_char> input_data2(
-        input_data, input_data + buffer->GetBytes() / sizeof(u_char));
+  MBLOG_DEBUG << "decode image clos : " << img_bgr.cols
+              << ", rows : " << img_bgr.rows << "channles : "
+              << img_bgr.channels();
 
-    cv::Mat img_bgr = cv::imdecode(input_data2, cv::IMREAD_COLOR);
-    if (img_bgr.data == NULL) {
-      MBLOG_ERROR << "input image buffer is invalid, imdecode failed.";
+  auto pixel_num = img_bgr.total();
+  int32_t dest_rows = img_bgr.rows;
+  int32_t dest_channels = img_bgr.channels();
+  if (pixel_format_ == "nv12") {
+    if (img_bgr.rows % 2 != 0 || img_bgr.cols % 2 != 0) {
+      MBLOG_ERROR << "nv12 needs even image size, image is " << img_bgr.cols
+                  << "x" << img_bgr.rows;
       return modelbox::STATUS_FAULT;
     }
-    cv::Mat img_dest;
-    if (pixel_format_ == "bgr") {
-      img_dest = img_bgr;
-    } else if (pixel_format_ == "rgb") {
-      cv::cvtColor(img_bgr, img_dest, cv::COLOR_BGR2RGB);
-    } else if (pixel_format_ == "nv12") {
-      img_dest = BGR2YUV_NV12(img_bgr);
+
+    dest_rows = img_bgr.rows * 3 / 2;
+    dest_channels = 1;
+    auto ret = output->Build(pixel_num * 3 / 2);
+    if (!ret) {
+      MBLOG_ERROR << "build output buffer failed, " << ret;
+      return ret;
     }
 
-    if (!modelbox::StatusError) {
-      MBLOG_ERROR << "dest image data is invalid, imdecode failed.";
-      return modelbox::STATUS_FAULT;
+    BGR2NV12(img_bgr, static_cast<uint8_t *>(output->MutableData()));
+  } else {
+    if (img_bgr.data != decode_data) {
+      auto ret = output->Build(pixel_num * img_bgr.elemSize());
+      if (!ret) {
+        MBLOG_ERROR << "build output buffer failed, " << ret;
+        return ret;
+      }
+
+      auto mem_ret = memcpy_s(output->MutableData(), output->GetBytes(),
+                              img_bgr.data, pixel_num * img_bgr.elemSize());
+      if (mem_ret != EOK) {
+        MBLOG_ERROR << "Cpu memcpy failed, ret " << mem_ret << ", size "
+                    << output->GetBytes();
+        return modelbox::STATUS_FAULT;
+      }
     }
 
-    MBLOG_DEBUG << "decode image clos : " << img_bgr.cols
-                << ", rows : " << img_bgr.rows << "channles : "
-                << img_bgr.channels();
-
-    // build output_bufs
-    std::vector<size_t> sub_shape{(size_t)img_dest.rows, (size_t)img_dest.cols,
-                                  (size_t)img_dest.channels()};
-    auto output_buffer = std::make_shared<modelbox::Buffer>(device);
-    output_buffer->Build(modelbox::Volume(sub_shape) * sizeof(u_char));
-    auto output_data = static_cast<uchar *>(output_buffer->MutableData());
-    auto ret = memcpy_s(output_data, output_buffer->GetBytes(),
-                        img_dest.data, img_dest.total() * img_dest.elemSize());
-    if (ret != EOK) {
-      MBLOG_ERROR << "Cpu memcpy failed, ret " << ret << ", src size "
-                  << output_buffer->GetBytes() << ", dest size "
-                  << img_dest.total() * img_dest.elemSize();
-      return modelbox::STATUS_FAULT;
+    if (pixel_format_ == "rgb") {
+      SwapRB(static_cast<uint8_t *>(output->MutableData()), pixel_num);
     }
-    output_buffer->Set("width", (int32_t)img_bgr.cols);
-    output_buffer->Set("height", (int32_t)img_bgr.rows);
-    output_buffer->Set("width_stride", (int32_t)img_dest.cols);
-    output_buffer->Set("height_stride", (int32_t)img_dest.rows);
-    output_buffer->Set("channel", (int32_t)img_dest.channels());
-    output_buffer->Set("pix_fmt", pixel_format_);
-    output_buffer->Set("type", modelbox::ModelBoxDataType::MODELBOX_UINT8);
-    output_buffer->Set(
-        "shape",
-        std::vector<size_t>{(size_t)img_dest.cols, (size_t)img_dest.rows,
-                            (size_t)img_dest.channels()});
-    output_buffer->Set("layout", std::string("hwc"));
-    output_bufs->PushBack(output_buffer);
   }
 
+  output->Set("width", (int32_t)img_bgr.cols);
+  output->Set("height", (int32_t)img_bgr.rows);
+  output->Set("width_stride", (int32_t)img_bgr.cols * dest_channels);
+  output->Set("height_stride", dest_rows);
+  output->Set("channel", dest_channels);
+  output->Set("pix_fmt", pixel_format_);
+  output->Set("type", modelbox::ModelBoxDataType::MODELBOX_UINT8);
+  output->Set("shape",
+              std::vector<size_t>{(size_t)img_bgr.cols, (size_t)dest_rows,
+                                  (size_t)dest_channels});
+  output->Set("layout", std::string("hwc"));
   return modelbox::STATUS_OK;
 }
 
-cv::Mat ImageDecoderFlowUnit::BGR2YUV_NV12(const cv::Mat &src_bgr) {
-  modelbox::StatusError = modelbox::STATUS_OK;
-  cv::Mat dst_nv12(src_bgr.rows * 1.5, src_bgr.cols, CV_8UC1, cv::Scalar(0));
-  cv::Mat src_yuv_i420;
-  cv::cvtColor(src_bgr, src_yuv_i420, cv::COLOR_BGR2YUV_I420);
+modelbox::Status ImageDecoderFlowUnit::Process(
+    std::shared_ptr<modelbox::DataContext> ctx) {
+  MBLOG_DEBUG << "process image decode";
+
+  // get input
+  auto input_bufs = ctx->Input("in_encoded_image");
+  auto output_bufs = ctx->Output("out_image");
+  if (input_bufs->Size() <= 0) {
+    auto errMsg = "input images batch is " + std::to_string(input_bufs->Size());
+    MBLOG_ERROR << errMsg;
+    return {modelbox::STATUS_FAULT, errMsg};
+  }
 
-  size_t len_y = src_bgr.rows * src_bgr.cols;
-  size_t len_u = len_y / 4;
-  auto ret = memcpy_s(dst_nv12.data, len_y, src_yuv_i420.data, len_y);
-  if (ret != EOK) {
-    MBLOG_ERROR << "Cpu memcpy failed, ret " << ret << ", size " << len_y;
-    dst_nv12.release();
-    modelbox::StatusError = {modelbox::STATUS_FAULT};
-    return dst_nv12;
+  // decode images of batch in parallel, the first one on current thread
+  auto batch_size = input_bufs->Size();
+  std::vector<std::shared_ptr<modelbox::Buffer>> output_list(batch_size);
+  auto ret = pool_->ParallelFor(batch_size, [&](size_t i) {
+    return DecodeImage((*input_bufs)[i], output_list[i]);
+  });
+  if (!ret) {
+    return ret;
   }
-  for (size_t i = 0; i < len_u; ++i) {
-    dst_nv12.data[len_y + 2 * i] = src_yuv_i420.data[len_y + i];
-    dst_nv12.data[len_y + 2 * i + 1] = src_yuv_i420.data[len_y + len_u + i];
+
+  for (auto &output : output_list) {
+    output_bufs->PushBack(output);
   }
 
-  return dst_nv12;
+  return modelbox::STATUS_OK;
 }
 
 modelbox::Status ImageDecoderFlowUnit::DataPost(
@@ -177,6 +382,12 @@ MODELBOX_FLOWUNIT(ImageDecoderFlowUnit, desc) {
 
   desc.AddFlowUnitOption(modelbox::FlowUnitOption(
       "pix_fmt", "string", true, "bgr", "the output pixel format"));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "target_width", "int", false, "0",
+      "decode jpeg at reduced scale, output width is not less than this"));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "target_height", "int", false, "0",
+      "decode jpeg at reduced scale, output height is not less than this"));
 
   desc.SetFlowType(modelbox::NORMAL);
   desc.SetInputContiguous(false);
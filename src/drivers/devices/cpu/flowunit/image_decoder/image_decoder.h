@@ -18,6 +18,7 @@
 #define MODELBOX_FLOWUNIT_HTTPSERVER_CPU_H_
 
 #include <modelbox/base/device.h>
+#include <modelbox/base/thread_pool.h>
 #include <modelbox/flow.h>
 #include <modelbox/flowunit.h>
 
@@ -55,10 +56,17 @@ class ImageDecoderFlowUnit : public modelbox::FlowUnit {
   modelbox::Status DataGroupPost(std::shared_ptr<modelbox::DataContext> ct);
 
  private:
-  cv::Mat BGR2YUV_NV12(const cv::Mat &src_bgr);
+  int GetDecodeFlag(const u_char *data, size_t size, int32_t &width,
+                    int32_t &height);
+
+  modelbox::Status DecodeImage(const std::shared_ptr<modelbox::Buffer> &input,
+                               std::shared_ptr<modelbox::Buffer> &output);
 
  private:
   std::string pixel_format_{"bgr"};
+  int32_t target_width_{0};
+  int32_t target_height_{0};
+  std::shared_ptr<modelbox::ThreadPool> pool_;
 };
 
 #endif  // MODELBOX_FLOWUNIT_HTTPSERVER_CPU_H_
@@ -17,6 +17,7 @@
 
 #include <securec.h>
 
+#include <fstream>
 #include <functional>
 #include <future>
 #include <opencv2/opencv.hpp>
@@ -245,6 +246,19 @@ Status ImageDecoderFlowUnitTest::AddMockFlowUnit() {
                 auto input_data =
                     static_cast<const uchar*>(input_buf->ConstBufferData(i));
 
+                // nv12 is saved as raw data
+                std::string pix_fmt;
+                input_buf->At(i)->Get("pix_fmt", pix_fmt);
+                if (pix_fmt == "nv12") {
+                  std::string name = std::string(TEST_DATA_DIR) +
+                                     "/decode_result_" + std::to_string(i) +
+                                     ".nv12";
+                  std::ofstream raw_file(name, std::ios::binary);
+                  raw_file.write(reinterpret_cast<const char*>(input_data),
+                                 input_buf->At(i)->GetBytes());
+                  continue;
+                }
+
                 cv::Mat img_data(cv::Size(cols, rows), CV_8UC3);
                 memcpy_s(img_data.data, img_data.total() * img_data.elemSize(),
                          input_data, input_buf->At(i)->GetBytes());
@@ -328,4 +342,115 @@ TEST_F(ImageDecoderFlowUnitTest, DecodeTest) {
   }
 }
 
+TEST_F(ImageDecoderFlowUnitTest, DecodeTargetSizeTest) {
+  const std::string test_lib_dir = TEST_DRIVER_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"([graph]
+    graphconf = '''digraph demo {
+          test_0_1_decode[type=flowunit, flowunit=test_0_1_decode, device=cpu, deviceid=0, label="<Out_1>"]
+          image_decoder[type=flowunit, flowunit=image_decoder, device=cpu, deviceid=0, label="<in_encoded_image> | <out_image>", batch_size=3, target_width=100, target_height=70]
+          test_1_0_decode[type=flowunit, flowunit=test_1_0_decode, device=cpu, deviceid=0, label="<In_1>",batch_size=3]
+          test_0_1_decode:Out_1 -> image_decoder:in_encoded_image
+          image_decoder:out_image -> test_1_0_decode:In_1
+        }'''
+    format = "graphviz"
+  )";
+
+  auto driver_flow = GetDriverFlow();
+  auto ret = driver_flow->BuildAndRun("DecodeTargetSizeTest", toml_content);
+  EXPECT_EQ(ret, STATUS_STOP);
+
+  for (size_t i = 0; i < 3; ++i) {
+    std::string expected_file_path = std::string(TEST_DATA_DIR) +
+                                     "/decode_ori_" + std::to_string(i) +
+                                     ".jpg";
+    cv::Mat expected_img = cv::imread(expected_file_path);
+
+    std::string decode_result_file_path = std::string(TEST_DATA_DIR) +
+                                          "/decode_result_" +
+                                          std::to_string(i) + ".jpg";
+    cv::Mat decode_result_img = cv::imread(decode_result_file_path);
+
+    // only jpeg is decoded at reduced scale, never below target size
+    if (i == 0) {
+      EXPECT_LT(decode_result_img.cols, expected_img.cols);
+      EXPECT_GE(decode_result_img.cols, 100);
+      EXPECT_GE(decode_result_img.rows, 70);
+    } else {
+      EXPECT_EQ(decode_result_img.cols, expected_img.cols);
+      EXPECT_EQ(decode_result_img.rows, expected_img.rows);
+    }
+
+    auto rmret = remove(expected_file_path.c_str());
+    EXPECT_EQ(rmret, 0);
+
+    auto rmret2 = remove(decode_result_file_path.c_str());
+    EXPECT_EQ(rmret2, 0);
+  }
+}
+
+TEST_F(ImageDecoderFlowUnitTest, DecodeNV12Test) {
+  const std::string test_lib_dir = TEST_DRIVER_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"([graph]
+    graphconf = '''digraph demo {
+          test_0_1_decode[type=flowunit, flowunit=test_0_1_decode, device=cpu, deviceid=0, label="<Out_1>"]
+          image_decoder[type=flowunit, flowunit=image_decoder, device=cpu, deviceid=0, label="<in_encoded_image> | <out_image>", batch_size=3, pix_fmt=nv12]
+          test_1_0_decode[type=flowunit, flowunit=test_1_0_decode, device=cpu, deviceid=0, label="<In_1>",batch_size=3]
+          test_0_1_decode:Out_1 -> image_decoder:in_encoded_image
+          image_decoder:out_image -> test_1_0_decode:In_1
+        }'''
+    format = "graphviz"
+  )";
+
+  auto driver_flow = GetDriverFlow();
+  auto ret = driver_flow->BuildAndRun("DecodeNV12Test", toml_content);
+  EXPECT_EQ(ret, STATUS_STOP);
+
+  std::string gimg_path = std::string(TEST_ASSETS) + "/test.jpg";
+  cv::Mat ori_img = cv::imread(gimg_path.c_str());
+  std::vector<std::string> encode_fmt{".jpg", ".png", ".bmp"};
+  for (size_t i = 0; i < encode_fmt.size(); ++i) {
+    // same input as test_0_1_decode, converted as before: i420, then u and v
+    // interleaved
+    std::vector<u_char> img_data;
+    std::vector<int> img_quality_param{cv::IMWRITE_JPEG_QUALITY, 100};
+    cv::imencode(encode_fmt[i], ori_img, img_data, img_quality_param);
+    cv::Mat img_bgr = cv::imdecode(img_data, cv::IMREAD_COLOR);
+    cv::Mat img_i420;
+    cv::cvtColor(img_bgr, img_i420, cv::COLOR_BGR2YUV_I420);
+    size_t len_y = img_bgr.rows * img_bgr.cols;
+    size_t len_u = len_y / 4;
+    std::vector<u_char> expected_data(img_i420.data, img_i420.data + len_y);
+    for (size_t j = 0; j < len_u; ++j) {
+      expected_data.push_back(img_i420.data[len_y + j]);
+      expected_data.push_back(img_i420.data[len_y + len_u + j]);
+    }
+
+    std::string decode_result_file_path = std::string(TEST_DATA_DIR) +
+                                          "/decode_result_" +
+                                          std::to_string(i) + ".nv12";
+    std::ifstream raw_file(decode_result_file_path, std::ios::binary);
+    std::vector<u_char> result_data((std::istreambuf_iterator<char>(raw_file)),
+                                    std::istreambuf_iterator<char>());
+    EXPECT_EQ(result_data.size(), expected_data.size());
+    EXPECT_TRUE(result_data == expected_data) << "encode fmt " << encode_fmt[i];
+
+    std::string expected_file_path = std::string(TEST_DATA_DIR) +
+                                     "/decode_ori_" + std::to_string(i) +
+                                     ".jpg";
+    auto rmret = remove(expected_file_path.c_str());
+    EXPECT_EQ(rmret, 0);
+
+    auto rmret2 = remove(decode_result_file_path.c_str());
+    EXPECT_EQ(rmret2, 0);
+  }
+}
+
 }  // namespace modelbox
\ No newline at end of file
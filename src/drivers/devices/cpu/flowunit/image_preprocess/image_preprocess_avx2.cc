@@ -0,0 +1,79 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "image_preprocess_kernel.h"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+/* byte index of each channel for 8 packed pixels, split in two loads */
+static inline __m128i ShuffleMask(size_t channel, size_t offset) {
+  int8_t mask[16];
+  for (size_t i = 0; i < 16; ++i) {
+    auto index = i < 8 ? channel + i * PREPROCESS_CHANNEL_NUM : 0;
+    mask[i] = (i < 8 && index >= offset && index < offset + 16)
+                  ? (int8_t)(index - offset)
+                  : (int8_t)0x80;
+  }
+
+  return _mm_loadu_si128((const __m128i *)mask);
+}
+
+static void PreprocessRowAVX2(const uint8_t *src, size_t width,
+                              const PreprocessParam &param,
+                              float *const dst[PREPROCESS_CHANNEL_NUM]) {
+  __m128i low_mask[PREPROCESS_CHANNEL_NUM];
+  __m128i high_mask[PREPROCESS_CHANNEL_NUM];
+  __m256 scale[PREPROCESS_CHANNEL_NUM];
+  __m256 bias[PREPROCESS_CHANNEL_NUM];
+  for (size_t c = 0; c < PREPROCESS_CHANNEL_NUM; ++c) {
+    low_mask[c] = ShuffleMask(c, 0);
+    high_mask[c] = ShuffleMask(c, 16);
+    scale[c] = _mm256_set1_ps(param.scale[c]);
+    bias[c] = _mm256_set1_ps(param.bias[c]);
+  }
+
+  size_t x = 0;
+  for (; x + 8 <= width; x += 8) {
+    /* 8 pixels are 24 bytes, load 16 + 8 to stay inside the row */
+    auto pixel = src + x * PREPROCESS_CHANNEL_NUM;
+    auto low = _mm_loadu_si128((const __m128i *)pixel);
+    auto high = _mm_loadl_epi64((const __m128i *)(pixel + 16));
+    for (size_t c = 0; c < PREPROCESS_CHANNEL_NUM; ++c) {
+      auto value = _mm_or_si128(_mm_shuffle_epi8(low, low_mask[c]),
+                                _mm_shuffle_epi8(high, high_mask[c]));
+      auto value_f32 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(value));
+      _mm256_storeu_ps(dst[c] + x,
+                       _mm256_fmadd_ps(value_f32, scale[c], bias[c]));
+    }
+  }
+
+  float *const tail_dst[PREPROCESS_CHANNEL_NUM] = {dst[0] + x, dst[1] + x,
+                                                   dst[2] + x};
+  PreprocessRowScalar(src + x * PREPROCESS_CHANNEL_NUM, width - x, param,
+                      tail_dst);
+}
+
+PreprocessRowFunc GetPreprocessRowAVX2() {
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+    return nullptr;
+  }
+
+  return PreprocessRowAVX2;
+}
+#else
+PreprocessRowFunc GetPreprocessRowAVX2() { return nullptr; }
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "image_preprocess_flowunit.h"
+
+#include "image_process.h"
+#include "modelbox/flowunit.h"
+#include "modelbox/flowunit_api_helper.h"
+
+ImagePreprocessFlowUnit::ImagePreprocessFlowUnit(){};
+ImagePreprocessFlowUnit::~ImagePreprocessFlowUnit(){};
+
+modelbox::Status ImagePreprocessFlowUnit::GetChannelParam(
+    const std::shared_ptr<modelbox::Configuration> &opts,
+    const std::string &key, double default_value,
+    std::vector<double> *values) {
+  if (!opts->Contain(key)) {
+    values->assign(PREPROCESS_CHANNEL_NUM, default_value);
+    return modelbox::STATUS_OK;
+  }
+
+  *values = opts->GetDoubles(key);
+  if (values->size() != PREPROCESS_CHANNEL_NUM) {
+    auto msg = key + " param should have " +
+               std::to_string(PREPROCESS_CHANNEL_NUM) + " values";
+    MBLOG_ERROR << msg;
+    return {modelbox::STATUS_BADCONF, msg};
+  }
+
+  return modelbox::STATUS_OK;
+}
+
+modelbox::Status ImagePreprocessFlowUnit::Open(
+    const std::shared_ptr<modelbox::Configuration> &opts) {
+  std::vector<double> means;
+  std::vector<double> normalizes;
+  auto ret = GetChannelParam(opts, "mean", 0.0, &means);
+  if (!ret) {
+    return ret;
+  }
+
+  ret = GetChannelParam(opts, "standard_deviation_inverse", 1.0, &normalizes);
+  if (!ret) {
+    return ret;
+  }
+
+  /* (in - mean) * normalize, folded to in * scale + bias */
+  for (size_t c = 0; c < PREPROCESS_CHANNEL_NUM; ++c) {
+    param_.scale[c] = (float)normalizes[c];
+    param_.bias[c] = (float)(-means[c] * normalizes[c]);
+  }
+
+  return modelbox::STATUS_OK;
+}
+
+modelbox::Status ImagePreprocessFlowUnit::Close() {
+  return modelbox::STATUS_OK;
+}
+
+modelbox::Status ImagePreprocessFlowUnit::CheckInput(
+    const std::shared_ptr<modelbox::Buffer> &buffer, int32_t *width,
+    int32_t *height, size_t *step) {
+  int32_t channel = 0;
+  std::string pix_fmt;
+  std::string layout;
+  modelbox::ModelBoxDataType type = modelbox::MODELBOX_TYPE_INVALID;
+  bool metaresult = true;
+  metaresult = buffer->Get("width", *width) ? metaresult : false;
+  metaresult = buffer->Get("height", *height) ? metaresult : false;
+  metaresult = buffer->Get("channel", channel) ? metaresult : false;
+  metaresult = buffer->Get("pix_fmt", pix_fmt) ? metaresult : false;
+  metaresult = buffer->Get("type", type) ? metaresult : false;
+  metaresult = buffer->Get("layout", layout) ? metaresult : false;
+  if (metaresult == false) {
+    return {modelbox::STATUS_BADCONF, "buffer meta is invalid."};
+  }
+
+  if (type != modelbox::ModelBoxDataType::MODELBOX_UINT8) {
+    return {modelbox::STATUS_INVALID, "type must be uint8"};
+  }
+
+  if (pix_fmt != "rgb" && pix_fmt != "bgr") {
+    return {modelbox::STATUS_INVALID, "pix_fmt should be [rgb, bgr]"};
+  }
+
+  if (layout != "hwc" || channel != (int32_t)PREPROCESS_CHANNEL_NUM) {
+    return {modelbox::STATUS_INVALID, "layout must be hwc with 3 channels"};
+  }
+
+  if (*width <= 0 || *height <= 0) {
+    return {modelbox::STATUS_INVALID, "image size is invalid"};
+  }
+
+  return imageprocess::GetImageRowStep(
+      buffer, (size_t)*width * PREPROCESS_CHANNEL_NUM, *height, *step);
+}
+
+modelbox::Status ImagePreprocessFlowUnit::Process(
+    std::shared_ptr<modelbox::DataContext> ctx) {
+  auto input_bufs = ctx->Input("in_image");
+  auto output_bufs = ctx->Output("out_data");
+
+  std::vector<int32_t> widths(input_bufs->Size());
+  std::vector<int32_t> heights(input_bufs->Size());
+  std::vector<size_t> steps(input_bufs->Size());
+  std::vector<size_t> shape_vector;
+  for (size_t i = 0; i < input_bufs->Size(); ++i) {
+    auto ret =
+        CheckInput(input_bufs->At(i), &widths[i], &heights[i], &steps[i]);
+    if (!ret) {
+      MBLOG_ERROR << "input buffer meta invalid, detail: " << ret;
+      return ret;
+    }
+
+    shape_vector.push_back((size_t)widths[i] * heights[i] *
+                           PREPROCESS_CHANNEL_NUM * sizeof(float));
+  }
+
+  output_bufs->Build(shape_vector);
+  for (size_t i = 0; i < input_bufs->Size(); ++i) {
+    auto input_data =
+        static_cast<const uint8_t *>(input_bufs->ConstBufferData(i));
+    auto output_data = static_cast<float *>(output_bufs->MutableBufferData(i));
+    if (input_data == nullptr || output_data == nullptr) {
+      return {modelbox::STATUS_NOMEM};
+    }
+
+    PreprocessHWC2CHW(input_data, steps[i], widths[i], heights[i], param_,
+                      output_data);
+
+    auto buffer = output_bufs->At(i);
+    buffer->CopyMeta(input_bufs->At(i));
+    buffer->Set("width_stride", (int32_t)(widths[i] * sizeof(float)));
+    buffer->Set("height_stride", heights[i]);
+    buffer->Set("layout", std::string("chw"));
+    buffer->Set("shape", std::vector<size_t>{PREPROCESS_CHANNEL_NUM,
+                                             (size_t)heights[i],
+                                             (size_t)widths[i]});
+    buffer->Set("type", modelbox::ModelBoxDataType::MODELBOX_FLOAT);
+  }
+
+  return modelbox::STATUS_OK;
+}
+
+MODELBOX_FLOWUNIT(ImagePreprocessFlowUnit, desc) {
+  desc.SetFlowUnitName(FLOWUNIT_NAME);
+  desc.SetFlowUnitGroupType("Image");
+  desc.AddFlowUnitInput(modelbox::FlowUnitInput("in_image", FLOWUNIT_TYPE));
+  desc.AddFlowUnitOutput(modelbox::FlowUnitOutput("out_data", FLOWUNIT_TYPE));
+  desc.SetFlowType(modelbox::NORMAL);
+  desc.SetDescription(FLOWUNIT_DESC);
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "mean", "string", false, "0.0,0.0,0.0", "the mean param"));
+  desc.AddFlowUnitOption(
+      modelbox::FlowUnitOption("standard_deviation_inverse", "string", false,
+                               "1.0,1.0,1.0", "the normalize param"));
+  desc.SetInputContiguous(false);
+}
+
+MODELBOX_DRIVER_FLOWUNIT(desc) {
+  desc.Desc.SetName(FLOWUNIT_NAME);
+  desc.Desc.SetClass(modelbox::DRIVER_CLASS_FLOWUNIT);
+  desc.Desc.SetType(FLOWUNIT_TYPE);
+  desc.Desc.SetDescription(FLOWUNIT_DESC);
+  desc.Desc.SetVersion("1.0.0");
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_CPU_H_
+#define MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_CPU_H_
+
+#include <modelbox/base/device.h>
+#include <modelbox/base/status.h>
+#include <modelbox/flow.h>
+
+#include "image_preprocess_kernel.h"
+#include "modelbox/buffer.h"
+#include "modelbox/flowunit.h"
+
+constexpr const char *FLOWUNIT_NAME = "image_preprocess";
+constexpr const char *FLOWUNIT_TYPE = "cpu";
+constexpr const char *FLOWUNIT_DESC =
+    "\n\t@Brief: Fused image preprocess, convert uint8 packed image to float "
+    "planar tensor, subtract mean and multiply standard deviation inverse "
+    "for each channel in one pass. Same as packed_planar_transpose, mean and "
+    "normalize in sequence. \n"
+    "\t@Port parameter: The input port 'in_image' buffer type is image, the "
+    "output port 'out_data' buffer type is tensor. \n"
+    "\t  The image type buffer contain the following meta fields:\n"
+    "\t\tField Name: width,         Type: int32_t\n"
+    "\t\tField Name: height,        Type: int32_t\n"
+    "\t\tField Name: width_stride,  Type: int32_t\n"
+    "\t\tField Name: channel,       Type: int32_t\n"
+    "\t\tField Name: pix_fmt,       Type: string\n"
+    "\t\tField Name: layout,        Type: string\n"
+    "\t\tField Name: type,          Type: ModelBoxDataType::MODELBOX_UINT8\n"
+    "\t@Constraint: The field value range of this flowunit support: "
+    "'pix_fmt': [rgb,bgr], 'layout': [hwc], 'type': [uint8]";
+
+class ImagePreprocessFlowUnit : public modelbox::FlowUnit {
+ public:
+  ImagePreprocessFlowUnit();
+  virtual ~ImagePreprocessFlowUnit();
+
+  modelbox::Status Open(const std::shared_ptr<modelbox::Configuration> &opts);
+
+  modelbox::Status Close();
+
+  /* run when processing data */
+  modelbox::Status Process(std::shared_ptr<modelbox::DataContext> data_ctx);
+
+ private:
+  modelbox::Status GetChannelParam(
+      const std::shared_ptr<modelbox::Configuration> &opts,
+      const std::string &key, double default_value,
+      std::vector<double> *values);
+
+  modelbox::Status CheckInput(const std::shared_ptr<modelbox::Buffer> &buffer,
+                              int32_t *width, int32_t *height,
+                              size_t *step);
+
+  PreprocessParam param_;
+};
+
+#endif  // MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_CPU_H_
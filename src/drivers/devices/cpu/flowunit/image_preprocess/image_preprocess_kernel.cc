@@ -0,0 +1,93 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "image_preprocess_kernel.h"
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+void PreprocessRowScalar(const uint8_t *src, size_t width,
+                         const PreprocessParam &param,
+                         float *const dst[PREPROCESS_CHANNEL_NUM]) {
+  for (size_t x = 0; x < width; ++x) {
+    for (size_t c = 0; c < PREPROCESS_CHANNEL_NUM; ++c) {
+      dst[c][x] = src[x * PREPROCESS_CHANNEL_NUM + c] * param.scale[c] +
+                  param.bias[c];
+    }
+  }
+}
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+static inline void StoreChannelNEON(uint8x8_t value, float32x4_t scale,
+                                    float32x4_t bias, float *dst) {
+  auto value_u16 = vmovl_u8(value);
+  auto low = vcvtq_f32_u32(vmovl_u16(vget_low_u16(value_u16)));
+  auto high = vcvtq_f32_u32(vmovl_u16(vget_high_u16(value_u16)));
+  vst1q_f32(dst, vmlaq_f32(bias, low, scale));
+  vst1q_f32(dst + 4, vmlaq_f32(bias, high, scale));
+}
+
+static void PreprocessRowNEON(const uint8_t *src, size_t width,
+                              const PreprocessParam &param,
+                              float *const dst[PREPROCESS_CHANNEL_NUM]) {
+  float32x4_t scale[PREPROCESS_CHANNEL_NUM];
+  float32x4_t bias[PREPROCESS_CHANNEL_NUM];
+  for (size_t c = 0; c < PREPROCESS_CHANNEL_NUM; ++c) {
+    scale[c] = vdupq_n_f32(param.scale[c]);
+    bias[c] = vdupq_n_f32(param.bias[c]);
+  }
+
+  size_t x = 0;
+  for (; x + 8 <= width; x += 8) {
+    /* vld3 splits 8 packed pixels into 3 channels */
+    auto pixels = vld3_u8(src + x * PREPROCESS_CHANNEL_NUM);
+    StoreChannelNEON(pixels.val[0], scale[0], bias[0], dst[0] + x);
+    StoreChannelNEON(pixels.val[1], scale[1], bias[1], dst[1] + x);
+    StoreChannelNEON(pixels.val[2], scale[2], bias[2], dst[2] + x);
+  }
+
+  float *const tail_dst[PREPROCESS_CHANNEL_NUM] = {dst[0] + x, dst[1] + x,
+                                                   dst[2] + x};
+  PreprocessRowScalar(src + x * PREPROCESS_CHANNEL_NUM, width - x, param,
+                      tail_dst);
+}
+#endif
+
+static PreprocessRowFunc SelectPreprocessRow() {
+#if defined(__aarch64__) || defined(__ARM_NEON)
+  return PreprocessRowNEON;
+#else
+  auto avx2 = GetPreprocessRowAVX2();
+  if (avx2 != nullptr) {
+    return avx2;
+  }
+
+  return PreprocessRowScalar;
+#endif
+}
+
+void PreprocessHWC2CHW(const uint8_t *src, size_t src_step, size_t width,
+                       size_t height, const PreprocessParam &param,
+                       float *dst) {
+  static const PreprocessRowFunc row_func = SelectPreprocessRow();
+  size_t plane_size = width * height;
+  for (size_t y = 0; y < height; ++y) {
+    float *const row_dst[PREPROCESS_CHANNEL_NUM] = {
+        dst + y * width, dst + plane_size + y * width,
+        dst + 2 * plane_size + y * width};
+    row_func(src + y * src_step, width, param, row_dst);
+  }
+}
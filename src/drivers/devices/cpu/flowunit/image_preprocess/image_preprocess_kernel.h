@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_KERNEL_H_
+#define MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_KERNEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+constexpr size_t PREPROCESS_CHANNEL_NUM = 3;
+
+/**
+ * @brief Per channel affine param, out = in * scale + bias
+ */
+struct PreprocessParam {
+  float scale[PREPROCESS_CHANNEL_NUM];
+  float bias[PREPROCESS_CHANNEL_NUM];
+};
+
+/**
+ * @brief Convert one packed uint8 row to three float planes
+ * @param src packed input row, width * 3 bytes
+ * @param width pixel number of row
+ * @param param per channel param
+ * @param dst output row of each plane
+ */
+using PreprocessRowFunc = void (*)(const uint8_t *src, size_t width,
+                                   const PreprocessParam &param,
+                                   float *const dst[PREPROCESS_CHANNEL_NUM]);
+
+void PreprocessRowScalar(const uint8_t *src, size_t width,
+                         const PreprocessParam &param,
+                         float *const dst[PREPROCESS_CHANNEL_NUM]);
+
+/**
+ * @brief Avx2 row kernel, only valid when cpu supports avx2 and fma
+ * @return nullptr when not built for x86_64
+ */
+PreprocessRowFunc GetPreprocessRowAVX2();
+
+/**
+ * @brief Convert packed uint8 hwc image to float chw with mean and scale
+ * @param src input image
+ * @param src_step bytes of one input row
+ * @param width image width
+ * @param height image height
+ * @param param per channel param
+ * @param dst output data, 3 * width * height floats
+ */
+void PreprocessHWC2CHW(const uint8_t *src, size_t src_step, size_t width,
+                       size_t height, const PreprocessParam &param,
+                       float *dst);
+
+#endif  // MODELBOX_FLOWUNIT_IMAGE_PREPROCESS_KERNEL_H_
@@ -24,7 +24,8 @@
 #include "modelbox/flowunit.h"
 #include "modelbox/flowunit_api_helper.h"
 
-#define CASTER_IMPL(code) [](std::stringstream &ss, modelbox::Any *any) { code; }
+#define CASTER_IMPL(code) \
+  [](std::stringstream &ss, const modelbox::Any *any) { code; }
 
 #define SETTER_IMPL(code)                                                   \
   [this](std::shared_ptr<modelbox::Buffer> &buffer, const std::string &str) { \
@@ -134,8 +135,8 @@ modelbox::Status MetaMappingFlowUnit::ParseRules(
 
 modelbox::Status MetaMappingFlowUnit::Close() { return modelbox::STATUS_OK; }
 
-modelbox::Status MetaMappingFlowUnit::ToString(modelbox::Any *any,
-                                             std::string &val) {
+modelbox::Status MetaMappingFlowUnit::ToString(const modelbox::Any *any,
+                                               std::string &val) {
   auto &type = any->type();
   auto caster_item = to_string_casters_.find(type.hash_code());
   if (caster_item == to_string_casters_.end()) {
@@ -179,7 +180,7 @@ modelbox::Status MetaMappingFlowUnit::Process(
   auto output_buffer_list = ctx->Output(OUTPUT_DATA);
   for (auto &buffer : *input_buffer_list) {
     output_buffer_list->PushBack(buffer);
-    modelbox::Any *src_val = nullptr;
+    const modelbox::Any *src_val = nullptr;
     bool exist = false;
     std::tie(src_val, exist) = buffer->Get(src_meta_name_);
     if (!exist) {
@@ -41,7 +41,7 @@ constexpr const char *OUTPUT_DATA = "out_data";
 
 using MappingRules = std::map<std::string, std::string>;
 using AnyToStringCaster =
-    std::function<void(std::stringstream &, modelbox::Any *)>;
+    std::function<void(std::stringstream &, const modelbox::Any *)>;
 using BufferSetter = std::function<void(std::shared_ptr<modelbox::Buffer> &,
                                         const std::string &)>;
 class MetaMappingFlowUnit : public modelbox::FlowUnit {
@@ -77,7 +77,7 @@ class MetaMappingFlowUnit : public modelbox::FlowUnit {
 
   modelbox::Status ParseRules(const std::vector<std::string> &rules);
 
-  modelbox::Status ToString(modelbox::Any *any, std::string &val);
+  modelbox::Status ToString(const modelbox::Any *any, std::string &val);
 
   modelbox::Status SetValue(std::shared_ptr<modelbox::Buffer> &buffer,
                             std::string &str, const std::type_info &type);
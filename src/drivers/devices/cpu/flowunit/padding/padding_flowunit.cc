@@ -179,7 +179,8 @@ modelbox::Status PaddingFlowUnit::PaddingOneImage(
   });
   out_image->Set("width", width_);
   out_image->Set("height", height_);
-  out_image->Set("width_stride", width_);
+  out_image->Set("width_stride",
+                 (int32_t)img_dest->cols * img_dest->channels());
   out_image->Set("height_stride", height_);
   out_image->Set("pix_fmt", pix_fmt);
   out_image->Set("channel", src_roi.channels());
@@ -15,7 +15,10 @@
  */
 
 #include "resize_flowunit.h"
-#include <securec.h>
+
+#include <atomic>
+
+#include "image_process.h"
 #include "modelbox/flowunit.h"
 #include "modelbox/flowunit_api_helper.h"
 
@@ -94,65 +97,46 @@ modelbox::Status CVResizeFlowUnit::Process(
       input_bufs->Size(), modelbox::Volume(sub_shape) * sizeof(u_char));
   output_bufs->Build(tensor_shape);
 
+  std::vector<cv::Mat> src_imgs(input_bufs->Size());
+  std::vector<std::string> pix_fmts(input_bufs->Size());
+  std::vector<void *> dest_datas(input_bufs->Size());
   for (size_t i = 0; i < input_bufs->Size(); ++i) {
-    int32_t width;
-    int32_t height;
-    int32_t channel;
-    std::string pix_fmt;
-    bool exists = false;
-    exists = input_bufs->At(i)->Get("height", height);
-    if (!exists) {
-      MBLOG_ERROR << "meta don't have key height";
-      return {modelbox::STATUS_NOTSUPPORT, "meta don't have key height"};
-    }
-
-    exists = input_bufs->At(i)->Get("width", width);
-    if (!exists) {
-      MBLOG_ERROR << "meta don't have key width";
-      return {modelbox::STATUS_NOTSUPPORT, "meta don't have key width"};
-    }
-
-    exists = input_bufs->At(i)->Get("pix_fmt", pix_fmt);
-    if (!exists && !input_bufs->At(i)->Get("channel", channel)) {
-      MBLOG_ERROR << "meta don't have key pix_fmt or channel";
-      return {modelbox::STATUS_NOTSUPPORT,
-              "meta don't have key pix_fmt or channel"};
-    }
-
-    if (exists && pix_fmt != "rgb" && pix_fmt != "bgr") {
-      MBLOG_ERROR << "unsupport pix format.";
-      return {modelbox::STATUS_NOTSUPPORT, "unsupport pix format."};
+    auto ret = GetInputImage(input_bufs->At(i), &src_imgs[i], &pix_fmts[i]);
+    if (!ret) {
+      return ret;
     }
 
-    channel = RGB_CHANNELS;
-    MBLOG_DEBUG << "get " << width << " rows " << height << " channel "
-                << channel;
-
-    auto input_data =
-        static_cast<const u_char *>(input_bufs->ConstBufferData(i));
-
-    cv::Mat img_data(cv::Size(width, height), CV_8UC3);
-    memcpy_s(img_data.data, img_data.total() * img_data.elemSize(), input_data,
-             input_bufs->At(i)->GetBytes());
-
-    MBLOG_DEBUG << "ori image : cols " << img_data.cols << " rows "
-                << img_data.rows << " channel " << img_data.channels();
+    dest_datas[i] = output_bufs->MutableBufferData(i);
+  }
 
-    // resize image
-    cv::Size destSize = cv::Size(dest_width_, dest_height_);
-    cv::Mat img_dest;
-    cv::resize(img_data, img_dest, destSize, 0, 0, interpolation_);
+  // resize directly from input buffer to output buffer, image by image
+  std::atomic<bool> resize_failed{false};
+  cv::Size dest_size = cv::Size(dest_width_, dest_height_);
+  cv::parallel_for_(cv::Range(0, input_bufs->Size()),
+                    [&](const cv::Range &range) {
+                      for (int i = range.start; i < range.end; ++i) {
+                        cv::Mat img_dest(dest_size, CV_8UC3, dest_datas[i]);
+                        try {
+                          cv::resize(src_imgs[i], img_dest, dest_size, 0, 0,
+                                     interpolation_);
+                        } catch (const cv::Exception &e) {
+                          MBLOG_ERROR << "resize image failed, " << e.what();
+                          resize_failed = true;
+                        }
+                      }
+                    });
+  if (resize_failed) {
+    return {modelbox::STATUS_FAULT, "resize image failed"};
+  }
 
-    // output resize image
-    auto output = static_cast<uchar *>(output_bufs->MutableBufferData(i));
-    memcpy_s(output, output_bufs->At(i)->GetBytes(), img_dest.data,
-             img_dest.total() * img_dest.elemSize());
+  for (size_t i = 0; i < output_bufs->Size(); ++i) {
     output_bufs->At(i)->Set("width", (int32_t)dest_width_);
     output_bufs->At(i)->Set("height", (int32_t)dest_height_);
-    output_bufs->At(i)->Set("width_stride", (int32_t)dest_width_);
+    output_bufs->At(i)->Set("width_stride",
+                            (int32_t)(dest_width_ * RGB_CHANNELS));
     output_bufs->At(i)->Set("height_stride", (int32_t)dest_height_);
-    output_bufs->At(i)->Set("channel", channel);
-    output_bufs->At(i)->Set("pix_fmt", pix_fmt);
+    output_bufs->At(i)->Set("channel", (int32_t)channel);
+    output_bufs->At(i)->Set("pix_fmt", pix_fmts[i]);
     output_bufs->At(i)->Set("type", modelbox::ModelBoxDataType::MODELBOX_UINT8);
     output_bufs->At(i)->Set(
         "shape",
@@ -163,6 +147,58 @@ modelbox::Status CVResizeFlowUnit::Process(
   return modelbox::STATUS_OK;
 }
 
+modelbox::Status CVResizeFlowUnit::GetInputImage(
+    const std::shared_ptr<modelbox::Buffer> &buffer, cv::Mat *img,
+    std::string *pix_fmt) {
+  int32_t width;
+  int32_t height;
+  int32_t channel;
+  bool exists = false;
+  exists = buffer->Get("height", height);
+  if (!exists) {
+    MBLOG_ERROR << "meta don't have key height";
+    return {modelbox::STATUS_NOTSUPPORT, "meta don't have key height"};
+  }
+
+  exists = buffer->Get("width", width);
+  if (!exists) {
+    MBLOG_ERROR << "meta don't have key width";
+    return {modelbox::STATUS_NOTSUPPORT, "meta don't have key width"};
+  }
+
+  exists = buffer->Get("pix_fmt", *pix_fmt);
+  if (!exists && !buffer->Get("channel", channel)) {
+    MBLOG_ERROR << "meta don't have key pix_fmt or channel";
+    return {modelbox::STATUS_NOTSUPPORT,
+            "meta don't have key pix_fmt or channel"};
+  }
+
+  if (exists && *pix_fmt != "rgb" && *pix_fmt != "bgr") {
+    MBLOG_ERROR << "unsupport pix format.";
+    return {modelbox::STATUS_NOTSUPPORT, "unsupport pix format."};
+  }
+
+  if (width <= 0 || height <= 0) {
+    auto errMsg = "input image size " + std::to_string(width) + "x" +
+                  std::to_string(height) + " is invalid";
+    MBLOG_ERROR << errMsg;
+    return {modelbox::STATUS_INVALID, errMsg};
+  }
+
+  size_t step = 0;
+  auto ret = imageprocess::GetImageRowStep(
+      buffer, (size_t)width * RGB_CHANNELS, height, step);
+  if (!ret) {
+    MBLOG_ERROR << "input image is invalid, " << ret.WrapErrormsgs();
+    return ret;
+  }
+
+  MBLOG_DEBUG << "get " << width << " rows " << height << " step " << step;
+  auto input_data = const_cast<void *>(buffer->ConstData());
+  *img = cv::Mat(cv::Size(width, height), CV_8UC3, input_data, step);
+  return modelbox::STATUS_OK;
+}
+
 MODELBOX_FLOWUNIT(CVResizeFlowUnit, desc) {
   desc.SetFlowUnitName(FLOWUNIT_NAME);
   desc.SetFlowUnitGroupType("Image");
@@ -60,6 +60,10 @@ class CVResizeFlowUnit : public modelbox::FlowUnit {
   modelbox::Status Process(std::shared_ptr<modelbox::DataContext> data_ctx);
 
  private:
+  modelbox::Status GetInputImage(
+      const std::shared_ptr<modelbox::Buffer> &buffer, cv::Mat *img,
+      std::string *pix_fmt);
+
   uint32_t dest_width_{224};
   uint32_t dest_height_{224};
   cv::InterpolationFlags interpolation_{cv::InterpolationFlags::INTER_LINEAR};
@@ -56,134 +56,139 @@ std::shared_ptr<DriverFlowTest> CVResizeFlowUnitTest::GetDriverFlow() {
   return driver_flow_;
 }
 
-Status CVResizeFlowUnitTest::AddMockFlowUnit() {
-  auto ctl_ = driver_flow_->GetMockFlowCtl();
-  {
-    MockFlowUnitDriverDesc desc_flowunit;
-    desc_flowunit.SetClass("DRIVER-FLOWUNIT");
-    desc_flowunit.SetType("cpu");
-    desc_flowunit.SetName("test_0_1_resize");
-    desc_flowunit.SetDescription("the test in 0 out 1");
-    desc_flowunit.SetVersion("1.0.0");
-    std::string file_path_flowunit =
-        std::string(TEST_DRIVER_DIR) + "/libmodelbox-unit-cpu-test_0_1_resize.so";
-    desc_flowunit.SetFilePath(file_path_flowunit);
-    auto mock_flowunit = std::make_shared<MockFlowUnit>();
-    auto mock_flowunit_desc = std::make_shared<FlowUnitDesc>();
-    mock_flowunit_desc->SetFlowUnitName("test_0_1_resize");
-    mock_flowunit_desc->AddFlowUnitOutput(modelbox::FlowUnitOutput("Out_1"));
-    mock_flowunit_desc->SetFlowType(STREAM);
-    mock_flowunit->SetFlowUnitDesc(mock_flowunit_desc);
-    std::weak_ptr<MockFlowUnit> mock_flowunit_wp;
-    mock_flowunit_wp = mock_flowunit;
-
-    EXPECT_CALL(*mock_flowunit, Open(_))
-        .WillRepeatedly(testing::Invoke(
-            [=](const std::shared_ptr<modelbox::Configuration>& flow_option) {
-              auto spt = mock_flowunit_wp.lock();
-              auto ext_data = spt->CreateExternalData();
-              if (!ext_data) {
-                auto err_msg = "can not get external data.";
-                modelbox::Status ret = {modelbox::STATUS_NODATA, err_msg};
-                MBLOG_ERROR << err_msg;
-                return ret;
+/* source of test images, each row is padded with row_padding bytes */
+static void AddResizeSourceFlowUnit(std::shared_ptr<MockDriverCtl> ctl,
+                                    const std::string& name,
+                                    size_t row_padding) {
+  MockFlowUnitDriverDesc desc_flowunit;
+  desc_flowunit.SetClass("DRIVER-FLOWUNIT");
+  desc_flowunit.SetType("cpu");
+  desc_flowunit.SetName(name);
+  desc_flowunit.SetDescription("the test in 0 out 1");
+  desc_flowunit.SetVersion("1.0.0");
+  std::string file_path_flowunit = std::string(TEST_DRIVER_DIR) +
+                                   "/libmodelbox-unit-cpu-" + name + ".so";
+  desc_flowunit.SetFilePath(file_path_flowunit);
+  auto mock_flowunit = std::make_shared<MockFlowUnit>();
+  auto mock_flowunit_desc = std::make_shared<FlowUnitDesc>();
+  mock_flowunit_desc->SetFlowUnitName(name);
+  mock_flowunit_desc->AddFlowUnitOutput(modelbox::FlowUnitOutput("Out_1"));
+  mock_flowunit_desc->SetFlowType(STREAM);
+  mock_flowunit->SetFlowUnitDesc(mock_flowunit_desc);
+  std::weak_ptr<MockFlowUnit> mock_flowunit_wp;
+  mock_flowunit_wp = mock_flowunit;
+
+  EXPECT_CALL(*mock_flowunit, Open(_))
+      .WillRepeatedly(testing::Invoke(
+          [=](const std::shared_ptr<modelbox::Configuration>& flow_option) {
+            auto spt = mock_flowunit_wp.lock();
+            auto ext_data = spt->CreateExternalData();
+            if (!ext_data) {
+              auto err_msg = "can not get external data.";
+              modelbox::Status ret = {modelbox::STATUS_NODATA, err_msg};
+              MBLOG_ERROR << err_msg;
+              return ret;
+            }
+
+            std::string gimg_path = std::string(TEST_ASSETS) + "/test.jpg";
+
+            auto output_buf = ext_data->CreateBufferList();
+            modelbox::TensorList output_tensor_list(output_buf);
+            output_tensor_list.BuildFromHost<uchar>(
+                {1, {gimg_path.size() + 1}}, (void*)gimg_path.data(),
+                gimg_path.size() + 1);
+
+            auto status = ext_data->Send(output_buf);
+            if (!status) {
+              MBLOG_ERROR << "external data send buffer list failed:"
+                          << status;
+              return status;
+            }
+
+            status = ext_data->Close();
+            if (!status) {
+              MBLOG_ERROR << "external data close failed:" << status;
+              return status;
+            }
+
+            return modelbox::STATUS_OK;
+          }));
+
+  EXPECT_CALL(*mock_flowunit, DataPre(_))
+      .WillRepeatedly(
+          testing::Invoke([&](std::shared_ptr<DataContext> data_ctx) {
+            MBLOG_INFO << "stream_info "
+                       << "DataPre";
+            return modelbox::STATUS_OK;
+          }));
+
+  EXPECT_CALL(*mock_flowunit, DataPost(_))
+      .WillRepeatedly(
+          testing::Invoke([&](std::shared_ptr<DataContext> data_ctx) {
+            MBLOG_INFO << "stream_info "
+                       << "DataPost";
+            return modelbox::STATUS_OK;
+          }));
+
+  EXPECT_CALL(*mock_flowunit,
+              Process(testing::An<std::shared_ptr<modelbox::DataContext>>()))
+      .WillRepeatedly(
+          testing::Invoke([=](std::shared_ptr<DataContext> data_ctx) {
+            auto output_bufs = data_ctx->Output("Out_1");
+            auto external = data_ctx->External();
+            std::string gimg_path =
+                std::string((char*)(*external)[0]->ConstData());
+
+            cv::Mat gimg_data = cv::imread(gimg_path.c_str());
+
+            MBLOG_INFO << "gimage col " << gimg_data.cols << "  grow "
+                       << gimg_data.rows
+                       << " gchannel:" << gimg_data.channels();
+
+            size_t step = gimg_data.cols * gimg_data.elemSize() + row_padding;
+            uint32_t batch_size = 5;
+            std::vector<size_t> shape_vector(batch_size,
+                                             step * gimg_data.rows);
+            output_bufs->Build(shape_vector);
+
+            for (size_t i = 0; i < 5; ++i) {
+              std::string img_path = gimg_path;
+              cv::Mat img_data = cv::imread(img_path.c_str());
+              MBLOG_INFO << "image col " << img_data.cols << "  row "
+                         << img_data.rows
+                         << " channel:" << img_data.channels();
+
+              int32_t cols = img_data.cols;
+              int32_t rows = img_data.rows;
+              int32_t channels = img_data.channels();
+
+              output_bufs->At(i)->Set("width", cols);
+              output_bufs->At(i)->Set("height", rows);
+              output_bufs->At(i)->Set("channel", channels);
+              if (row_padding > 0) {
+                output_bufs->At(i)->Set("width_stride", (int32_t)step);
               }
 
-              std::string gimg_path = std::string(TEST_ASSETS) + "/test.jpg";
-
-              auto output_buf = ext_data->CreateBufferList();
-              modelbox::TensorList output_tensor_list(output_buf);
-              output_tensor_list.BuildFromHost<uchar>(
-                  {1, {gimg_path.size() + 1}}, (void*)gimg_path.data(),
-                  gimg_path.size() + 1);
-
-              auto status = ext_data->Send(output_buf);
-              if (!status) {
-                MBLOG_ERROR << "external data send buffer list failed:"
-                            << status;
-                return status;
-              }
-
-              status = ext_data->Close();
-              if (!status) {
-                MBLOG_ERROR << "external data close failed:" << status;
-                return status;
-              }
-
-              return modelbox::STATUS_OK;
-            }));
-
-    EXPECT_CALL(*mock_flowunit, DataPre(_))
-        .WillRepeatedly(
-            testing::Invoke([&](std::shared_ptr<DataContext> data_ctx) {
-              MBLOG_INFO << "stream_info "
-                         << "DataPre";
-              return modelbox::STATUS_OK;
-            }));
-
-    EXPECT_CALL(*mock_flowunit, DataPost(_))
-        .WillRepeatedly(
-            testing::Invoke([&](std::shared_ptr<DataContext> data_ctx) {
-              MBLOG_INFO << "stream_info "
-                         << "DataPost";
-              return modelbox::STATUS_OK;
-            }));
-
-    EXPECT_CALL(*mock_flowunit,
-                Process(testing::An<std::shared_ptr<modelbox::DataContext>>()))
-        .WillRepeatedly(
-            testing::Invoke([=](std::shared_ptr<DataContext> data_ctx) {
-              auto output_bufs = data_ctx->Output("Out_1");
-              auto external = data_ctx->External();
-              std::string gimg_path =
-                  std::string((char*)(*external)[0]->ConstData());
-
-              cv::Mat gimg_data = cv::imread(gimg_path.c_str());
-
-              MBLOG_INFO << "gimage col " << gimg_data.cols << "  grow "
-                         << gimg_data.rows
-                         << " gchannel:" << gimg_data.channels();
-
-              long unsigned int gcols = gimg_data.cols;
-              long unsigned int grows = gimg_data.rows;
-              long unsigned int gchannels = gimg_data.channels();
-
-              uint32_t batch_size = 5;
-              std::vector<size_t> shape_vector(
-                  batch_size,
-                  modelbox::Volume({grows, gcols, gchannels}) * sizeof(uchar));
-              output_bufs->Build(shape_vector);
-
-              for (size_t i = 0; i < 5; ++i) {
-                std::string img_path = gimg_path;
-                cv::Mat img_data = cv::imread(img_path.c_str());
-                MBLOG_INFO << "image col " << img_data.cols << "  row "
-                           << img_data.rows
-                           << " channel:" << img_data.channels();
-
-                int32_t cols = img_data.cols;
-                int32_t rows = img_data.rows;
-                int32_t channels = img_data.channels();
-
-                output_bufs->At(i)->Set("width", cols);
-                output_bufs->At(i)->Set("height", rows);
-                output_bufs->At(i)->Set("channel", channels);
-
-                auto output_data =
-                    static_cast<uchar*>(output_bufs->MutableBufferData(i));
-                memcpy_s(output_data, output_bufs->At(i)->GetBytes(),
-                         img_data.data, img_data.total() * img_data.elemSize());
-              }
-              return modelbox::STATUS_OK;
-            }));
+              auto output_data =
+                  static_cast<uchar*>(output_bufs->MutableBufferData(i));
+              cv::Mat output_img(img_data.size(), CV_8UC3, output_data, step);
+              img_data.copyTo(output_img);
+            }
+            return modelbox::STATUS_OK;
+          }));
+
+  EXPECT_CALL(*mock_flowunit, Close()).WillRepeatedly(testing::Invoke([=]() {
+    return modelbox::STATUS_OK;
+  }));
+  desc_flowunit.SetMockFlowUnit(mock_flowunit);
+  ctl->AddMockDriverFlowUnit(name, "cpu", desc_flowunit,
+                            std::string(TEST_DRIVER_DIR));
+}
 
-    EXPECT_CALL(*mock_flowunit, Close()).WillRepeatedly(testing::Invoke([=]() {
-      return modelbox::STATUS_OK;
-    }));
-    desc_flowunit.SetMockFlowUnit(mock_flowunit);
-    ctl_->AddMockDriverFlowUnit("test_0_1_resize", "cpu", desc_flowunit,
-                                std::string(TEST_DRIVER_DIR));
-  }
+Status CVResizeFlowUnitTest::AddMockFlowUnit() {
+  auto ctl_ = driver_flow_->GetMockFlowCtl();
+  AddResizeSourceFlowUnit(ctl_, "test_0_1_resize", 0);
+  AddResizeSourceFlowUnit(ctl_, "test_0_1_resize_stride", 64);
 
   {
     MockFlowUnitDriverDesc desc_flowunit;
@@ -235,11 +240,14 @@ Status CVResizeFlowUnitTest::AddMockFlowUnit() {
               int32_t cols;
               int32_t rows;
               int32_t channels;
+              int32_t width_stride = 0;
 
               for (size_t i = 0; i < input_buf->Size(); i++) {
                 input_buf->At(i)->Get("width", cols);
                 input_buf->At(i)->Get("height", rows);
                 input_buf->At(i)->Get("channel", channels);
+                input_buf->At(i)->Get("width_stride", width_stride);
+                EXPECT_EQ(width_stride, cols * channels);
                 auto input_data =
                     static_cast<const uchar*>(input_buf->ConstBufferData(i));
 
@@ -265,27 +273,28 @@ Status CVResizeFlowUnitTest::AddMockFlowUnit() {
   return STATUS_OK;
 }
 
-TEST_F(CVResizeFlowUnitTest, InitUnit) {
+static std::string ResizeGraphToml(const std::string& source) {
   const std::string test_lib_dir = TEST_DRIVER_DIR;
   std::string toml_content = R"(
     [driver]
     skip-default=true
     dir=[")" + test_lib_dir + "\"]\n    " +
                              R"([graph]
-    graphconf = '''digraph demo {                                                                            
-          test_0_1_resize[type=flowunit, flowunit=test_0_1_resize, device=cpu, deviceid=0, label="<Out_1>"]
+    graphconf = '''digraph demo {
+          )" + source + "[type=flowunit, flowunit=" + source +
+                             R"(, device=cpu, deviceid=0, label="<Out_1>"]
           cv_resize[type=flowunit, flowunit=resize, device=cpu, deviceid=0, label="<in_image> | <out_image>", width=128, height=128, interpolation="inter_nearest", batch_size=5]
-          test_1_0_resize[type=flowunit, flowunit=test_1_0_resize, device=cpu, deviceid=0, label="<In_1>",batch_size=5]                                
-          test_0_1_resize:Out_1 -> cv_resize:in_image 
-          cv_resize:out_image -> test_1_0_resize:In_1                                                                      
+          test_1_0_resize[type=flowunit, flowunit=test_1_0_resize, device=cpu, deviceid=0, label="<In_1>",batch_size=5]
+          )" + source + R"(:Out_1 -> cv_resize:in_image
+          cv_resize:out_image -> test_1_0_resize:In_1
         }'''
     format = "graphviz"
   )";
 
-  auto driver_flow = GetDriverFlow();
-  auto ret = driver_flow->BuildAndRun("InitUnit", toml_content);
-  EXPECT_EQ(ret, STATUS_STOP);
+  return toml_content;
+}
 
+static void CheckResizeResult() {
   std::vector<std::string> filePath;
   ListFiles(std::string(TEST_DATA_DIR), "*", &filePath);
   for (auto& elem : filePath) {
@@ -315,4 +324,23 @@ TEST_F(CVResizeFlowUnitTest, InitUnit) {
   }
 }
 
+TEST_F(CVResizeFlowUnitTest, InitUnit) {
+  auto driver_flow = GetDriverFlow();
+  auto ret =
+      driver_flow->BuildAndRun("InitUnit", ResizeGraphToml("test_0_1_resize"));
+  EXPECT_EQ(ret, STATUS_STOP);
+
+  CheckResizeResult();
+}
+
+TEST_F(CVResizeFlowUnitTest, StrideInput) {
+  /* rows of input image are padded, width_stride is in bytes */
+  auto driver_flow = GetDriverFlow();
+  auto ret = driver_flow->BuildAndRun(
+      "StrideInput", ResizeGraphToml("test_0_1_resize_stride"));
+  EXPECT_EQ(ret, STATUS_STOP);
+
+  CheckResizeResult();
+}
+
 }  // namespace modelbox
\ No newline at end of file
@@ -21,7 +21,8 @@
 
 using namespace modelbox;
 
-Status FfmpegVideoDecoder::Init(AVCodecID codec_id) {
+Status FfmpegVideoDecoder::Init(AVCodecID codec_id, int32_t thread_count,
+                                int32_t thread_type) {
   codec_id_ = codec_id;
   auto codec_ptr = avcodec_find_decoder(codec_id_);
   if (codec_ptr == nullptr) {
@@ -36,6 +37,8 @@ Status FfmpegVideoDecoder::Init(AVCodecID codec_id) {
     return STATUS_FAULT;
   }
 
+  av_ctx_ptr->thread_count = thread_count;
+  av_ctx_ptr->thread_type = thread_type;
   AVDictionary *opts = nullptr;
   av_dict_set(&opts, "refcounted_frames", "1", 0);
   auto ret = avcodec_open2(av_ctx_ptr, codec_ptr, &opts);
@@ -54,6 +57,14 @@ Status FfmpegVideoDecoder::Init(AVCodecID codec_id) {
   return STATUS_SUCCESS;
 }
 
+void FfmpegVideoDecoder::SetKeyFrameOnly(bool key_frame_only) {
+  if (av_ctx_ == nullptr) {
+    return;
+  }
+
+  av_ctx_->skip_frame = key_frame_only ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+}
+
 Status FfmpegVideoDecoder::Decode(
     const std::shared_ptr<const AVPacket> &av_packet,
     std::list<std::shared_ptr<AVFrame>> &av_frame_list) {
@@ -30,11 +30,26 @@ extern "C" {
 
 class FfmpegVideoDecoder {
  public:
-  modelbox::Status Init(AVCodecID codec_id);
+  /**
+   * @brief Init decoder
+   * @param codec_id codec of stream
+   * @param thread_count decode thread number, 0 means auto
+   * @param thread_type FF_THREAD_FRAME, FF_THREAD_SLICE or both
+   * @return init result
+   */
+  modelbox::Status Init(AVCodecID codec_id, int32_t thread_count = 1,
+                        int32_t thread_type = FF_THREAD_FRAME |
+                                              FF_THREAD_SLICE);
 
   modelbox::Status Decode(const std::shared_ptr<const AVPacket> &av_packet,
                         std::list<std::shared_ptr<AVFrame>> &av_frame_list);
 
+  /**
+   * @brief Let decoder skip non key frames, must be called after Init
+   * @param key_frame_only only decode key frames
+   */
+  void SetKeyFrameOnly(bool key_frame_only);
+
  private:
   AVCodecID codec_id_{AV_CODEC_ID_NONE};
   std::shared_ptr<AVCodecContext> av_ctx_;
@@ -16,6 +16,7 @@
 
 #include "video_decoder_flowunit.h"
 #include <securec.h>
+#include <algorithm>
 #include "ffmpeg_color_converter.h"
 #include "ffmpeg_video_decoder.h"
 #include "modelbox/flowunit.h"
@@ -42,7 +43,60 @@ modelbox::Status VideoDecoderFlowUnit::Open(
   }
 
   out_pix_fmt_str_ = fmt;
-  return modelbox::STATUS_OK;
+  out_width_ = opts->GetInt32("width", 0);
+  out_height_ = opts->GetInt32("height", 0);
+  if (out_width_ < 0 || out_height_ < 0) {
+    MBLOG_ERROR << "Invalid output size " << out_width_ << "x" << out_height_;
+    return modelbox::STATUS_BADCONF;
+  }
+
+  thread_count_ = opts->GetInt32("thread_count", 1);
+  if (thread_count_ < 0) {
+    MBLOG_ERROR << "Invalid thread_count " << thread_count_;
+    return modelbox::STATUS_BADCONF;
+  }
+
+  auto thread_type = opts->GetString("thread_type", "auto");
+  if (thread_type == "frame") {
+    thread_type_ = FF_THREAD_FRAME;
+  } else if (thread_type == "slice") {
+    thread_type_ = FF_THREAD_SLICE;
+  } else if (thread_type == "auto") {
+    thread_type_ = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  } else {
+    MBLOG_ERROR << "Not support thread type " << thread_type;
+    return modelbox::STATUS_BADCONF;
+  }
+
+  return sampler_.Init(opts);
+}
+
+void VideoDecoderFlowUnit::GetOutputSize(int32_t frame_width,
+                                         int32_t frame_height,
+                                         int32_t &out_width,
+                                         int32_t &out_height) {
+  out_width = out_width_;
+  out_height = out_height_;
+  if (out_width == 0 && out_height == 0) {
+    out_width = frame_width;
+    out_height = frame_height;
+    return;
+  }
+
+  /* only one side is set, keep aspect ratio */
+  if (out_width == 0) {
+    out_width = (int32_t)((int64_t)frame_width * out_height / frame_height);
+  } else if (out_height == 0) {
+    out_height = (int32_t)((int64_t)frame_height * out_width / frame_width);
+  }
+
+  if (out_pix_fmt_ == AVPixelFormat::AV_PIX_FMT_NV12) {
+    out_width = std::max(out_width & ~1, 2);
+    out_height = std::max(out_height & ~1, 2);
+  }
+
+  out_width = std::max(out_width, 1);
+  out_height = std::max(out_height, 1);
 }
 
 modelbox::Status VideoDecoderFlowUnit::Close() { return modelbox::STATUS_OK; }
@@ -73,6 +127,8 @@ modelbox::Status VideoDecoderFlowUnit::Process(
     }
   }
 
+  SampleFrames(ctx, frame_list);
+
   ret = WriteData(ctx, frame_list, decode_ret == modelbox::STATUS_NODATA);
   if (ret != modelbox::STATUS_SUCCESS) {
     MBLOG_ERROR << "Send frame data failed";
@@ -87,6 +143,47 @@ modelbox::Status VideoDecoderFlowUnit::Process(
   return modelbox::STATUS_CONTINUE;
 }
 
+void VideoDecoderFlowUnit::SampleFrames(
+    std::shared_ptr<modelbox::DataContext> &ctx,
+    std::list<std::shared_ptr<AVFrame>> &frame_list) {
+  auto sampler = std::static_pointer_cast<videodecode::FrameSampler>(
+      ctx->GetPrivate(SAMPLER_CTX));
+  if (sampler == nullptr || frame_list.empty() ||
+      sampler->GetMode() == videodecode::SampleMode::NONE) {
+    return;
+  }
+
+  auto pack_buff = ctx->Input(VIDEO_PACKET_INPUT)->At(0);
+  double time_base = 0;
+  int32_t rate_num = 0;
+  int32_t rate_den = 0;
+  pack_buff->Get("time_base", time_base);
+  pack_buff->Get("rate_num", rate_num);
+  pack_buff->Get("rate_den", rate_den);
+
+  /* drop before output buffer is built and color is converted */
+  uint64_t dropped = 0;
+  for (auto iter = frame_list.begin(); iter != frame_list.end();) {
+    auto &frame = *iter;
+    double timestamp = frame->pts * time_base;
+    if (frame->pts == AV_NOPTS_VALUE && rate_num > 0) {
+      timestamp = sampler->GetFrameCount() * 1000.0 * rate_den / rate_num;
+    }
+
+    if (sampler->Sample(frame->key_frame != 0, timestamp)) {
+      ++iter;
+      continue;
+    }
+
+    iter = frame_list.erase(iter);
+    ++dropped;
+  }
+
+  if (dropped > 0) {
+    ctx->GetStatistics()->IncreaseValue("frame_drop_count", dropped);
+  }
+}
+
 modelbox::Status VideoDecoderFlowUnit::ReadData(
     std::shared_ptr<modelbox::DataContext> ctx,
     std::vector<std::shared_ptr<AVPacket>> &pkt_list) {
@@ -198,8 +295,11 @@ modelbox::Status VideoDecoderFlowUnit::WriteData(
   pack_buff->Get("time_base", time_base);
   std::vector<size_t> shape;
   size_t buffer_size;
+  int32_t out_width = 0;
+  int32_t out_height = 0;
   for (auto &frame : frame_list) {
-    auto ret = videodecode::GetBufferSize(frame->width, frame->height,
+    GetOutputSize(frame->width, frame->height, out_width, out_height);
+    auto ret = videodecode::GetBufferSize(out_width, out_height,
                                           out_pix_fmt_str_, buffer_size);
     if (ret != modelbox::STATUS_SUCCESS) {
       return ret;
@@ -217,18 +317,27 @@ modelbox::Status VideoDecoderFlowUnit::WriteData(
     videodecode::UpdateStatsInfo(ctx, frame_ptr->width, frame_ptr->height);
     auto frame_buff = frame_buff_list->At(i);
     ++i;
-    auto ret = color_cvt->CvtColor(
-        frame_ptr, (uint8_t *)(frame_buff->MutableData()), out_pix_fmt_);
+    GetOutputSize(frame_ptr->width, frame_ptr->height, out_width, out_height);
+    auto ret = color_cvt->CvtColor(frame_ptr,
+                                   (uint8_t *)(frame_buff->MutableData()),
+                                   out_pix_fmt_, out_width, out_height);
+    if (ret != modelbox::STATUS_SUCCESS) {
+      return ret;
+    }
+
+    int32_t width_stride = 0;
+    ret = videodecode::GetWidthStride(out_width, out_pix_fmt_str_,
+                                      width_stride);
     if (ret != modelbox::STATUS_SUCCESS) {
       return ret;
     }
 
     frame_buff->Set("index", *frame_index);
     *frame_index = *frame_index + 1;
-    frame_buff->Set("width", frame_ptr->width);
-    frame_buff->Set("height", frame_ptr->height);
-    frame_buff->Set("width_stride", frame_ptr->width);
-    frame_buff->Set("height_stride", frame_ptr->height);
+    frame_buff->Set("width", out_width);
+    frame_buff->Set("height", out_height);
+    frame_buff->Set("width_stride", width_stride);
+    frame_buff->Set("height_stride", out_height);
     frame_buff->Set("rate_num", rate_num);
     frame_buff->Set("rate_den", rate_den);
     frame_buff->Set("rotate_angle", rotate_angle);
@@ -240,8 +349,8 @@ modelbox::Status VideoDecoderFlowUnit::WriteData(
       int32_t channel = 3;
       frame_buff->Set("channel", channel);
       frame_buff->Set(
-          "shape", std::vector<size_t>({static_cast<size_t>(frame_ptr->height),
-                                        static_cast<size_t>(frame_ptr->width),
+          "shape", std::vector<size_t>({static_cast<size_t>(out_height),
+                                        static_cast<size_t>(out_width),
                                         static_cast<size_t>(channel)}));
       frame_buff->Set("layout", std::string("hwc"));
     }
@@ -274,18 +383,22 @@ modelbox::Status VideoDecoderFlowUnit::DataPre(
   }
 
   auto video_decoder = std::make_shared<FfmpegVideoDecoder>();
-  auto ret = video_decoder->Init(*codec_id);
+  auto ret = video_decoder->Init(*codec_id, thread_count_, thread_type_);
   if (ret != modelbox::STATUS_SUCCESS) {
     MBLOG_ERROR << "Video decoder init failed";
     return modelbox::STATUS_FAULT;
   }
 
+  auto sampler = std::make_shared<videodecode::FrameSampler>(sampler_);
+  video_decoder->SetKeyFrameOnly(sampler->GetMode() ==
+                                 videodecode::SampleMode::KEY_FRAME);
   auto color_cvt = std::make_shared<FfmpegColorConverter>();
   auto frame_index = std::make_shared<int64_t>();
   *frame_index = 0;
   data_ctx->SetPrivate(DECODER_CTX, video_decoder);
   data_ctx->SetPrivate(CVT_CTX, color_cvt);
   data_ctx->SetPrivate(FRAME_INDEX_CTX, frame_index);
+  data_ctx->SetPrivate(SAMPLER_CTX, sampler);
   auto meta = std::make_shared<modelbox::DataMeta>();
   meta->SetMeta(SOURCE_URL_META, source_url);
   data_ctx->SetOutputMeta(FRAME_INFO_OUTPUT, meta);
@@ -314,6 +427,33 @@ MODELBOX_FLOWUNIT(VideoDecoderFlowUnit, desc) {
   }
   desc.AddFlowUnitOption(modelbox::FlowUnitOption(
       "pix_fmt", "list", true, "0", "the decoder pixel format", pix_fmt_list));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "width", "int", false, "0",
+      "the output width, 0 means same as the stream"));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "height", "int", false, "0",
+      "the output height, 0 means same as the stream"));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "thread_count", "int", false, "1",
+      "the decode thread number, 0 means auto"));
+  std::map<std::string, std::string> thread_type_list = {
+      {"auto", "auto"}, {"frame", "frame"}, {"slice", "slice"}};
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "thread_type", "list", false, "auto", "the decode thread type",
+      thread_type_list));
+  std::map<std::string, std::string> sample_mode_list = {
+      {"none", "none"},
+      {"fps", "fps"},
+      {"interval", "interval"},
+      {"key_frame", "key_frame"}};
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "sample_mode", "list", false, "none", "the frame sample mode",
+      sample_mode_list));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "sample_fps", "float", false, "0", "the output fps in fps mode"));
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "sample_interval", "int", false, "1",
+      "output one of every n frames in interval mode"));
 }
 
 MODELBOX_DRIVER_FLOWUNIT(desc) {
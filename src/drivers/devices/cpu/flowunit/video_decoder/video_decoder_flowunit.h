@@ -22,6 +22,7 @@
 #include <modelbox/flow.h>
 
 #include "ffmpeg_video_decoder.h"
+#include "frame_sampler.h"
 #include "modelbox/flowunit.h"
 
 constexpr const char *FLOWUNIT_NAME = "video_decoder";
@@ -62,6 +63,7 @@ constexpr const char *CODEC_META = "codec_meta";
 constexpr const char *DECODER_CTX = "decoder_ctx";
 constexpr const char *CVT_CTX = "converter_ctx";
 constexpr const char *FRAME_INDEX_CTX = "frame_index_ctx";
+constexpr const char *SAMPLER_CTX = "sampler_ctx";
 constexpr const char *VIDEO_PACKET_INPUT = "in_video_packet";
 constexpr const char *FRAME_INFO_OUTPUT = "out_video_frame";
 constexpr const char *SOURCE_URL_META = "source_url";
@@ -102,10 +104,19 @@ class VideoDecoderFlowUnit : public modelbox::FlowUnit {
   modelbox::Status WriteData(std::shared_ptr<modelbox::DataContext> &ctx,
                              std::list<std::shared_ptr<AVFrame>> &frame_list,
                              bool eos);
+  void GetOutputSize(int32_t frame_width, int32_t frame_height,
+                     int32_t &out_width, int32_t &out_height);
+  void SampleFrames(std::shared_ptr<modelbox::DataContext> &ctx,
+                    std::list<std::shared_ptr<AVFrame>> &frame_list);
 
  private:
   AVPixelFormat out_pix_fmt_{AV_PIX_FMT_NV12};
   std::string out_pix_fmt_str_;
+  int32_t out_width_{0};
+  int32_t out_height_{0};
+  int32_t thread_count_{1};
+  int32_t thread_type_{FF_THREAD_FRAME | FF_THREAD_SLICE};
+  videodecode::FrameSampler sampler_;
 };
 
 #endif  // MODELBOX_FLOWUNIT_VIDEO_DECODER_CPU_H_
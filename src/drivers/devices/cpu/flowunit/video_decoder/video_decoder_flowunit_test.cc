@@ -18,13 +18,16 @@
 #include <fstream>
 #include <functional>
 #include <future>
+#include <map>
 #include <thread>
+#include <vector>
 
 #include "modelbox/base/log.h"
 #include "modelbox/buffer.h"
 #include "common/video_decoder/video_decoder_mock.h"
 #include "driver_flow_test.h"
 #include "flowunit_mockflowunit/flowunit_mockflowunit.h"
+#include "frame_sampler.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -44,6 +47,12 @@ class VideoDecoderFlowUnitTest : public testing::Test {
   std::shared_ptr<MockFlow> flow_;
 
   void StartFlow(std::string& toml_content, const uint64_t millisecond);
+
+  std::shared_ptr<videodecode::FrameSampler> CreateSampler(
+      const std::map<std::string, std::string>& options);
+
+  std::vector<bool> Sample(videodecode::FrameSampler& sampler,
+                           const std::vector<double>& timestamps);
 };
 
 void VideoDecoderFlowUnitTest::StartFlow(std::string& toml_content,
@@ -56,6 +65,130 @@ void VideoDecoderFlowUnitTest::StartFlow(std::string& toml_content,
   EXPECT_EQ(ret, STATUS_SUCCESS);
 }
 
+std::shared_ptr<videodecode::FrameSampler>
+VideoDecoderFlowUnitTest::CreateSampler(
+    const std::map<std::string, std::string>& options) {
+  ConfigurationBuilder builder;
+  builder.AddProperties(options);
+  auto sampler = std::make_shared<videodecode::FrameSampler>();
+  auto ret = sampler->Init(builder.Build());
+  if (!ret) {
+    return nullptr;
+  }
+
+  return sampler;
+}
+
+std::vector<bool> VideoDecoderFlowUnitTest::Sample(
+    videodecode::FrameSampler& sampler, const std::vector<double>& timestamps) {
+  std::vector<bool> result;
+  for (auto timestamp : timestamps) {
+    result.push_back(sampler.Sample(false, timestamp));
+  }
+
+  return result;
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerConfigTest) {
+  auto sampler = CreateSampler({});
+  ASSERT_NE(sampler, nullptr);
+  EXPECT_EQ(sampler->GetMode(), videodecode::SampleMode::NONE);
+  EXPECT_TRUE(sampler->Sample(false, 0));
+
+  EXPECT_EQ(CreateSampler({{"sample_mode", "fps"}}), nullptr);
+  EXPECT_EQ(CreateSampler({{"sample_mode", "fps"}, {"sample_fps", "-1"}}),
+            nullptr);
+  EXPECT_EQ(CreateSampler({{"sample_mode", "interval"}}), nullptr);
+  EXPECT_EQ(CreateSampler({{"sample_mode", "unknown"}}), nullptr);
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerFpsTest) {
+  auto sampler = CreateSampler({{"sample_mode", "fps"}, {"sample_fps", "5"}});
+  ASSERT_NE(sampler, nullptr);
+  EXPECT_EQ(sampler->GetMode(), videodecode::SampleMode::FPS);
+
+  /* 25 fps source, keep one of every five frames */
+  std::vector<double> timestamps;
+  for (int i = 0; i < 50; i++) {
+    timestamps.push_back(i * 40.0);
+  }
+
+  auto result = Sample(*sampler, timestamps);
+  for (size_t i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result[i], i % 5 == 0) << "frame " << i;
+  }
+  EXPECT_EQ(sampler->GetFrameCount(), 50U);
+
+  /* 2 fps source is slower than target, keep every frame */
+  sampler = CreateSampler({{"sample_mode", "fps"}, {"sample_fps", "5"}});
+  ASSERT_NE(sampler, nullptr);
+  result = Sample(*sampler, {0, 500, 1000, 1500});
+  EXPECT_EQ(result, std::vector<bool>({true, true, true, true}));
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerFpsPtsJumpTest) {
+  auto sampler = CreateSampler({{"sample_mode", "fps"}, {"sample_fps", "5"}});
+  ASSERT_NE(sampler, nullptr);
+
+  /* jump forward, keep the first frame after gap without catching up */
+  auto result = Sample(*sampler, {0, 40, 80, 120, 160, 200, 10000, 10040,
+                                  10080, 10120, 10160, 10200});
+  EXPECT_EQ(result,
+            std::vector<bool>({true, false, false, false, false, true, true,
+                               false, false, false, false, true}));
+
+  /* jump backward, sampling restarts from the new timestamp */
+  result = Sample(*sampler, {5000, 5040, 5200});
+  EXPECT_EQ(result, std::vector<bool>({true, false, true}));
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerFpsPtsRolloverTest) {
+  auto sampler = CreateSampler({{"sample_mode", "fps"}, {"sample_fps", "5"}});
+  ASSERT_NE(sampler, nullptr);
+
+  /* 33 bit pts of 90khz clock wraps after about 95443717 ms */
+  const double wrap_ms = (double)((1LL << 33) / 90);
+  std::vector<double> timestamps;
+  for (int i = 10; i > 0; i--) {
+    timestamps.push_back(wrap_ms - i * 40.0);
+  }
+
+  for (int i = 0; i < 10; i++) {
+    timestamps.push_back(i * 40.0);
+  }
+
+  auto result = Sample(*sampler, timestamps);
+  std::vector<bool> expect = {true,  false, false, false, false,
+                              true,  false, false, false, false,
+                              true,  false, false, false, false,
+                              true,  false, false, false, false};
+  EXPECT_EQ(result, expect);
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerKeyFrameTest) {
+  auto sampler = CreateSampler({{"sample_mode", "key_frame"}});
+  ASSERT_NE(sampler, nullptr);
+  EXPECT_EQ(sampler->GetMode(), videodecode::SampleMode::KEY_FRAME);
+
+  std::vector<bool> key_frames = {true, false, false, false,
+                                  true, false, true,  false};
+  for (size_t i = 0; i < key_frames.size(); i++) {
+    EXPECT_EQ(sampler->Sample(key_frames[i], i * 40.0), key_frames[i]);
+  }
+  EXPECT_EQ(sampler->GetFrameCount(), key_frames.size());
+}
+
+TEST_F(VideoDecoderFlowUnitTest, FrameSamplerIntervalTest) {
+  auto sampler =
+      CreateSampler({{"sample_mode", "interval"}, {"sample_interval", "3"}});
+  ASSERT_NE(sampler, nullptr);
+  EXPECT_EQ(sampler->GetMode(), videodecode::SampleMode::INTERVAL);
+
+  auto result = Sample(*sampler, std::vector<double>(10, 0));
+  EXPECT_EQ(result, std::vector<bool>({true, false, false, true, false, false,
+                                       true, false, false, true}));
+}
+
 TEST_F(VideoDecoderFlowUnitTest, cpuDecoderNv12Test) {
   auto toml_content = videodecoder::GetTomlConfig("cpu", "nv12");
   StartFlow(toml_content, 5 * 1000);
@@ -71,4 +204,27 @@ TEST_F(VideoDecoderFlowUnitTest, cpuDecoderBgrTest) {
   StartFlow(toml_content, 5 * 1000);
 }
 
+TEST_F(VideoDecoderFlowUnitTest, cpuDecoderScaleTest) {
+  auto toml_content = videodecoder::GetTomlConfig(
+      "cpu", "rgb", ", width=240, thread_count=2, thread_type=slice");
+  flow_ = std::make_shared<MockFlow>();
+  auto ret = videodecoder::AddMockFlowUnit(flow_, false, 240, 160);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
+
+  ret = flow_->BuildAndRun("VideoDecoder", toml_content, 5 * 1000);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
+}
+
+TEST_F(VideoDecoderFlowUnitTest, cpuDecoderSampleIntervalTest) {
+  auto toml_content = videodecoder::GetTomlConfig(
+      "cpu", "nv12", ", sample_mode=interval, sample_interval=4");
+  flow_ = std::make_shared<MockFlow>();
+  /* 30 of 120 frames are kept, the rest are counted as dropped */
+  auto ret = videodecoder::AddMockFlowUnit(flow_, false, 480, 320, 30, 90);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
+
+  ret = flow_->BuildAndRun("VideoDecoder", toml_content, 5 * 1000);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
+}
+
 }  // namespace modelbox
\ No newline at end of file
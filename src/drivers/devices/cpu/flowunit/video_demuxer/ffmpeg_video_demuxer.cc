@@ -52,6 +52,7 @@ Status FfmpegVideoDemuxer::Demux(std::shared_ptr<AVPacket> &av_packet) {
   }
 
   reader_->ResetStartTime();
+  last_dropped_count_ = 0;
   auto ret = ReadPacket(av_packet);
   if (ret != STATUS_SUCCESS) {
     return ret;
@@ -111,6 +112,10 @@ int32_t FfmpegVideoDemuxer::GetFrameRotate() { return frame_rotate_; }
 
 double FfmpegVideoDemuxer::GetTimeBase() { return time_base_; }
 
+uint64_t FfmpegVideoDemuxer::GetLastDroppedCount() {
+  return last_dropped_count_;
+}
+
 int64_t FfmpegVideoDemuxer::GetDuration() {
   if (format_ctx_->duration != AV_NOPTS_VALUE) {
     return format_ctx_->duration / AV_TIME_BASE;
@@ -136,6 +141,10 @@ Status FfmpegVideoDemuxer::ReadPacket(std::shared_ptr<AVPacket> &av_packet) {
                   [](AVPacket *packet) { av_packet_free(&packet); });
   while ((ret = av_read_frame(format_ctx_.get(), av_packet.get())) >= 0) {
     if (!IsTargetPacket(av_packet)) {
+      if (av_packet->stream_index == stream_id_) {
+        ++last_dropped_count_;
+      }
+
       av_packet_unref(av_packet.get());
       continue;
     }
@@ -167,7 +176,7 @@ bool FfmpegVideoDemuxer::IsTargetPacket(std::shared_ptr<AVPacket> &av_packet) {
     return false;
   }
 
-  if (key_frame_only_ && av_packet->flags != AV_PKT_FLAG_KEY) {
+  if (key_frame_only_ && !(av_packet->flags & AV_PKT_FLAG_KEY)) {
     return false;
   }
 
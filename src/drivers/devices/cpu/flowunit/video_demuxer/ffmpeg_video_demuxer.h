@@ -57,6 +57,11 @@ class FfmpegVideoDemuxer {
 
   int64_t GetDuration();
 
+  /**
+   * @brief Packets dropped by key frame filter in last Demux call
+   */
+  uint64_t GetLastDroppedCount();
+
  private:
   void PrintCurrentOption(AVDictionary *options);
 
@@ -91,6 +96,7 @@ class FfmpegVideoDemuxer {
 
   std::string source_url_;
   bool key_frame_only_{false};
+  uint64_t last_dropped_count_{0};
   std::shared_ptr<AVFormatContext> format_ctx_;
   int32_t stream_id_{0};
   AVCodecID codec_id_{AVCodecID::AV_CODEC_ID_H264};
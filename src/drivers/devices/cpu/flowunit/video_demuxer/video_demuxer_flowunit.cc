@@ -20,11 +20,23 @@
 
 using namespace modelbox;
 
+/* packet meta is set for every frame, use precomputed keys */
+static const MetaKey kMetaPts("pts");
+static const MetaKey kMetaDts("dts");
+static const MetaKey kMetaTimeBase("time_base");
+static const MetaKey kMetaRateNum("rate_num");
+static const MetaKey kMetaRateDen("rate_den");
+static const MetaKey kMetaWidth("width");
+static const MetaKey kMetaHeight("height");
+static const MetaKey kMetaRotateAngle("rotate_angle");
+static const MetaKey kMetaDuration("duration");
+
 VideoDemuxerFlowUnit::VideoDemuxerFlowUnit(){};
 VideoDemuxerFlowUnit::~VideoDemuxerFlowUnit(){};
 
 modelbox::Status VideoDemuxerFlowUnit::Open(
     const std::shared_ptr<modelbox::Configuration> &opts) {
+  key_frame_only_ = opts->GetBool("key_frame_only", false);
   return modelbox::STATUS_OK;
 }
 modelbox::Status VideoDemuxerFlowUnit::Close() { return modelbox::STATUS_OK; }
@@ -66,6 +78,10 @@ modelbox::Status VideoDemuxerFlowUnit::Process(
   std::shared_ptr<AVPacket> pkt;
   if (video_demuxer != nullptr) {
     demux_status = video_demuxer->Demux(pkt);
+    auto dropped = video_demuxer->GetLastDroppedCount();
+    if (dropped > 0) {
+      ctx->GetStatistics()->IncreaseValue("packet_drop_count", dropped);
+    }
   }
 
   if (demux_status == modelbox::STATUS_OK) {
@@ -92,10 +108,10 @@ void VideoDemuxerFlowUnit::WriteEnd(
   int32_t rate_num;
   int32_t rate_den;
   video_demuxer->GetFrameRate(rate_num, rate_den);
-  end_packet->Set("rate_num", rate_num);
-  end_packet->Set("rate_den", rate_den);
-  end_packet->Set("duration", video_demuxer->GetDuration());
-  end_packet->Set("time_base", video_demuxer->GetTimeBase());
+  end_packet->Set(kMetaRateNum, rate_num);
+  end_packet->Set(kMetaRateDen, rate_den);
+  end_packet->Set(kMetaDuration, video_demuxer->GetDuration());
+  end_packet->Set(kMetaTimeBase, video_demuxer->GetTimeBase());
 }
 
 modelbox::Status VideoDemuxerFlowUnit::WriteData(
@@ -113,9 +129,9 @@ modelbox::Status VideoDemuxerFlowUnit::WriteData(
   }
 
   auto packet_buffer = video_packet_output->At(0);
-  packet_buffer->Set("pts", pkt->pts);
-  packet_buffer->Set("dts", pkt->dts);
-  packet_buffer->Set("time_base", video_demuxer->GetTimeBase());
+  packet_buffer->Set(kMetaPts, pkt->pts);
+  packet_buffer->Set(kMetaDts, pkt->dts);
+  packet_buffer->Set(kMetaTimeBase, video_demuxer->GetTimeBase());
   int32_t rate_num;
   int32_t rate_den;
   int32_t frame_width;
@@ -123,12 +139,12 @@ modelbox::Status VideoDemuxerFlowUnit::WriteData(
   int32_t rotate_angle = video_demuxer->GetFrameRotate();
   video_demuxer->GetFrameRate(rate_num, rate_den);
   video_demuxer->GetFrameMeta(&frame_width, &frame_height);
-  packet_buffer->Set("rate_num", rate_num);
-  packet_buffer->Set("rate_den", rate_den);
-  packet_buffer->Set("width", frame_width);
-  packet_buffer->Set("height", frame_height);
-  packet_buffer->Set("rotate_angle", rotate_angle);
-  packet_buffer->Set("duration", video_demuxer->GetDuration());
+  packet_buffer->Set(kMetaRateNum, rate_num);
+  packet_buffer->Set(kMetaRateDen, rate_den);
+  packet_buffer->Set(kMetaWidth, frame_width);
+  packet_buffer->Set(kMetaHeight, frame_height);
+  packet_buffer->Set(kMetaRotateAngle, rotate_angle);
+  packet_buffer->Set(kMetaDuration, video_demuxer->GetDuration());
   return STATUS_SUCCESS;
 }
 
@@ -259,7 +275,7 @@ modelbox::Status VideoDemuxerFlowUnit::InitDemuxer(
   }
 
   auto video_demuxer = std::make_shared<FfmpegVideoDemuxer>();
-  ret = video_demuxer->Init(reader, false);
+  ret = video_demuxer->Init(reader, key_frame_only_);
   if (ret != STATUS_SUCCESS) {
     MBLOG_INFO << "video demux init falied, set DEMUX_STATUS failed";
     return STATUS_FAULT;
@@ -306,6 +322,9 @@ MODELBOX_FLOWUNIT(VideoDemuxerFlowUnit, desc) {
   desc.SetFlowType(FlowType::STREAM);
   desc.SetStreamSameCount(false);
   desc.SetDescription(FLOWUNIT_DESC);
+  desc.AddFlowUnitOption(modelbox::FlowUnitOption(
+      "key_frame_only", "bool", false, "false",
+      "only output key frame packets, others are dropped before decode"));
 }
 
 MODELBOX_DRIVER_FLOWUNIT(desc) {
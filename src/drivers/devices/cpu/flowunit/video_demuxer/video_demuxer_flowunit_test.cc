@@ -14,11 +14,12 @@
  * limitations under the License.
  */
 
-
 #include <fstream>
 #include <functional>
 #include <future>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "modelbox/base/log.h"
 #include "modelbox/buffer.h"
@@ -26,6 +27,10 @@
 #include "flowunit_mockflowunit/flowunit_mockflowunit.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "test/mock/minimodelbox/mockflow.h"
+extern "C" {
+#include <libavformat/avformat.h>
+}
 
 using ::testing::_;
 
@@ -39,5 +44,199 @@ class VideoDemuxerFlowUnitTest : public testing::Test {
   virtual void SetUp(){};
 
   virtual void TearDown(){};
+
+  /**
+   * @brief Read all video packets of source directly
+   * @param source_url video file
+   * @param key_pts pts of key packets
+   * @param packet_count number of video packets
+   * @return read result
+   */
+  Status ReadKeyPackets(const std::string &source_url,
+                        std::vector<int64_t> *key_pts,
+                        uint64_t *packet_count);
+
+  void AddSourceFlowUnit(const std::string &source_url);
+
+  void AddReadPacketFlowUnit(uint64_t expect_drop_count);
+
+  std::string GetTomlConfig(const std::string &demuxer_options);
+
+  std::mutex packet_pts_lock_;
+  std::vector<int64_t> packet_pts_;
+  std::shared_ptr<MockFlow> flow_;
 };
-}  // namespace modelbox
\ No newline at end of file
+
+Status VideoDemuxerFlowUnitTest::ReadKeyPackets(const std::string &source_url,
+                                                std::vector<int64_t> *key_pts,
+                                                uint64_t *packet_count) {
+  AVFormatContext *ctx = nullptr;
+  if (avformat_open_input(&ctx, source_url.c_str(), nullptr, nullptr) < 0) {
+    return {STATUS_FAULT, "open " + source_url + " failed"};
+  }
+
+  std::shared_ptr<AVFormatContext> format_ctx(
+      ctx, [](AVFormatContext *ctx) { avformat_close_input(&ctx); });
+  if (avformat_find_stream_info(ctx, nullptr) < 0) {
+    return {STATUS_FAULT, "find stream info failed"};
+  }
+
+  auto stream_id =
+      av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+  if (stream_id < 0) {
+    return {STATUS_FAULT, "no video stream"};
+  }
+
+  AVPacket packet;
+  av_init_packet(&packet);
+  packet.data = nullptr;
+  packet.size = 0;
+  *packet_count = 0;
+  while (av_read_frame(ctx, &packet) >= 0) {
+    if (packet.stream_index == stream_id) {
+      ++(*packet_count);
+      if (packet.flags & AV_PKT_FLAG_KEY) {
+        key_pts->push_back(packet.pts);
+      }
+    }
+
+    av_packet_unref(&packet);
+  }
+
+  return STATUS_OK;
+}
+
+void VideoDemuxerFlowUnitTest::AddSourceFlowUnit(
+    const std::string &source_url) {
+  auto mock_desc = GenerateFlowunitDesc("start_unit", {}, {"stream_meta"});
+  mock_desc->SetFlowType(STREAM);
+  auto open_func =
+      [=](const std::shared_ptr<modelbox::Configuration> &flow_option,
+          std::shared_ptr<MockFlowUnit> mock_flowunit) -> Status {
+    auto ext_data = mock_flowunit->CreateExternalData();
+    if (ext_data == nullptr) {
+      return STATUS_FAULT;
+    }
+
+    auto output_buf = ext_data->CreateBufferList();
+    output_buf->BuildFromHost({source_url.size()}, (void *)source_url.data(),
+                              source_url.size());
+    auto status = ext_data->Send(output_buf);
+    if (!status) {
+      return status;
+    }
+
+    return ext_data->Close();
+  };
+  auto process_func = [=](std::shared_ptr<DataContext> data_ctx,
+                          std::shared_ptr<MockFlowUnit> mock_flowunit) {
+    auto output_buffers = data_ctx->Output("stream_meta");
+    for (auto &buffer : *data_ctx->External()) {
+      output_buffers->PushBack(buffer);
+    }
+
+    return STATUS_OK;
+  };
+
+  auto mock_functions = std::make_shared<MockFunctionCollection>();
+  mock_functions->RegisterOpenFunc(open_func);
+  mock_functions->RegisterProcessFunc(process_func);
+  flow_->AddFlowUnitDesc(mock_desc, mock_functions->GenerateCreateFunc(),
+                         TEST_DRIVER_DIR);
+}
+
+void VideoDemuxerFlowUnitTest::AddReadPacketFlowUnit(
+    uint64_t expect_drop_count) {
+  auto mock_desc = GenerateFlowunitDesc("read_packet", {"packet"}, {});
+  mock_desc->SetFlowType(STREAM);
+  auto process_func = [=](std::shared_ptr<DataContext> data_ctx,
+                          std::shared_ptr<MockFlowUnit> mock_flowunit) {
+    std::lock_guard<std::mutex> lock(packet_pts_lock_);
+    for (auto &buffer : *data_ctx->Input("packet")) {
+      int64_t pts = 0;
+      /* end packet carries no pts */
+      if (buffer->Get("pts", pts)) {
+        packet_pts_.push_back(pts);
+      }
+    }
+
+    return STATUS_OK;
+  };
+  auto data_post_func = [=](std::shared_ptr<DataContext> data_ctx,
+                            std::shared_ptr<MockFlowUnit> mock_flowunit) {
+    auto session_stats = data_ctx->GetStatistics(DataContextStatsType::SESSION);
+    EXPECT_NE(session_stats, nullptr);
+    if (session_stats == nullptr) {
+      return STATUS_OK;
+    }
+
+    auto drop_stats = session_stats->GetItem("videodemuxer.packet_drop_count");
+    if (expect_drop_count == 0) {
+      EXPECT_EQ(drop_stats, nullptr);
+      return STATUS_OK;
+    }
+
+    EXPECT_NE(drop_stats, nullptr);
+    if (drop_stats == nullptr) {
+      return STATUS_OK;
+    }
+
+    uint64_t drop_count = 0;
+    EXPECT_EQ(drop_stats->GetValue(drop_count), STATUS_OK);
+    EXPECT_EQ(drop_count, expect_drop_count);
+    return STATUS_OK;
+  };
+
+  auto mock_functions = std::make_shared<MockFunctionCollection>();
+  mock_functions->RegisterProcessFunc(process_func);
+  mock_functions->RegisterDataPostFunc(data_post_func);
+  flow_->AddFlowUnitDesc(mock_desc, mock_functions->GenerateCreateFunc(),
+                         TEST_DRIVER_DIR);
+}
+
+std::string VideoDemuxerFlowUnitTest::GetTomlConfig(
+    const std::string &demuxer_options) {
+  const std::string test_lib_dir = TEST_DRIVER_DIR;
+  const std::string test_data_dir = TEST_DATA_DIR;
+  std::string toml_content =
+      R"(
+      [driver]
+      skip-default = true
+      dir=[")" +
+      test_lib_dir + "\",\"" + test_data_dir + "\"]\n    " +
+      R"([graph]
+      graphconf = '''digraph demo {
+            start_unit[type=flowunit, flowunit=start_unit, device=cpu, deviceid=0, label="<stream_meta>"]
+            videodemuxer[type=flowunit, flowunit=video_demuxer, device=cpu, deviceid=0, label="<in_video_url> | <out_video_packet>")" +
+      demuxer_options + R"(]
+            read_packet[type=flowunit, flowunit=read_packet, device=cpu, deviceid=0, label="<packet>"]
+            start_unit:stream_meta -> videodemuxer:in_video_url
+            videodemuxer:out_video_packet -> read_packet:packet
+          }'''
+      format = "graphviz"
+    )";
+  return toml_content;
+}
+
+TEST_F(VideoDemuxerFlowUnitTest, KeyFrameOnlyTest) {
+  auto source_url = std::string(TEST_ASSETS) +
+                    "/video/avc1_5s_480x320_24fps_yuv420_8bit.mp4";
+  std::vector<int64_t> key_pts;
+  uint64_t packet_count = 0;
+  auto ret = ReadKeyPackets(source_url, &key_pts, &packet_count);
+  ASSERT_EQ(ret, STATUS_OK);
+  ASSERT_FALSE(key_pts.empty());
+
+  flow_ = std::make_shared<MockFlow>();
+  AddSourceFlowUnit(source_url);
+  AddReadPacketFlowUnit(packet_count - key_pts.size());
+  auto toml_content = GetTomlConfig(", key_frame_only=true");
+  ret = flow_->BuildAndRun("VideoDemuxer", toml_content, 5 * 1000);
+  EXPECT_EQ(ret, STATUS_SUCCESS);
+
+  /* non key packets are dropped before they leave the demuxer */
+  std::lock_guard<std::mutex> lock(packet_pts_lock_);
+  EXPECT_EQ(packet_pts_, key_pts);
+}
+
+}  // namespace modelbox
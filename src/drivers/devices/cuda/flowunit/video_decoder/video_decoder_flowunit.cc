@@ -192,11 +192,18 @@ modelbox::Status VideoDecoderFlowUnit::WriteData(
       return ret;
     }
 
+    int32_t width_stride = 0;
+    ret = videodecode::GetWidthStride(frame->width, out_pix_fmt_str_,
+                                      width_stride);
+    if (ret != modelbox::STATUS_SUCCESS) {
+      return ret;
+    }
+
     frame_buffer->Set("index", *frame_index);
     *frame_index = *frame_index + 1;
     frame_buffer->Set("width", frame->width);
     frame_buffer->Set("height", frame->height);
-    frame_buffer->Set("width_stride", frame->width);
+    frame_buffer->Set("width_stride", width_stride);
     frame_buffer->Set("height_stride", frame->height);
     frame_buffer->Set("rate_num", rate_num);
     frame_buffer->Set("rate_den", rate_den);
@@ -17,6 +17,8 @@
 #include "stats.h"
 
 #include <net/if.h>
+#include <pthread.h>
+#include <sched.h>
 #include <netinet/in.h>
 #include <stdlib.h>
 #include <string.h>
@@ -84,6 +86,25 @@ Status LinuxOSThread::SetThreadPriority(const std::thread::id &thread,
 
 Status LinuxOSThread::SetThreadLogicalCPUAffinity(
     const std::thread::id &thread, const std::vector<int16_t> &l_cpus) {
+  if (thread != std::this_thread::get_id()) {
+    return {STATUS_NOTSUPPORT, "only current thread is supported"};
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto cpu : l_cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return {STATUS_INVALID, "invalid cpu " + std::to_string(cpu)};
+    }
+
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    return {STATUS_FAULT, "set affinity failed, " + std::string(strerror(ret))};
+  }
+
   return STATUS_OK;
 };
 
@@ -62,6 +62,13 @@ Status DeviceManager::Initialize(std::shared_ptr<Drivers> driver,
   SetDrivers(driver);
 
   InitDeviceFactory(driver);
+  if (config != nullptr) {
+    for (auto &iter : device_factory_) {
+      auto device_config = config->GetSubConfig("device." + iter.first);
+      iter.second->SetDeviceConfig(device_config);
+    }
+  }
+
   Status status = DeviceProbe();
 
   return status;
@@ -17,6 +17,8 @@
 
 #include "modelbox/base/device_memory.h"
 
+#include <atomic>
+
 #include "modelbox/base/device.h"
 #include "modelbox/base/log.h"
 #include "modelbox/base/slab.h"
@@ -25,6 +27,11 @@ namespace modelbox {
 
 const uint64_t DeviceMemory::MEM_MAGIC_CODE = 0x446d4d654d6f5279;
 
+static std::atomic<uint64_t> kCombineContinuousCount{0};
+static std::atomic<uint64_t> kCombineBulkCopyCount{0};
+static std::atomic<uint64_t> kCombineFragmentCount{0};
+static std::atomic<uint64_t> kCombineFragmentBytes{0};
+
 DeviceMemory::DeviceMemory(const std::shared_ptr<Device> &device,
                            const std::shared_ptr<DeviceMemoryManager> &mem_mgr,
                            std::shared_ptr<void> device_mem_ptr, size_t size,
@@ -100,22 +107,28 @@ std::shared_ptr<DeviceMemory> DeviceMemory::Combine(
     return nullptr;
   }
 
-  auto contiguous =
-      ((target_device && target_device != mem_list[0]->GetDevice()) ||
-       (target_mem_flags != mem_list[0]->mem_flags_))
-          ? false
-          : IsContiguous(mem_list, true);
-  if (contiguous) {
-    return CombineContinuous(mem_list, total_size, target_device);
-  } else {
-    return CombineFragment(mem_list, total_size, target_device,
-                           target_mem_flags);
+  if (IsContiguous(mem_list, true)) {
+    return CombineContinuous(mem_list, total_size, target_device,
+                             target_mem_flags);
   }
+
+  return CombineFragment(mem_list, total_size, target_device,
+                         target_mem_flags);
+}
+
+DeviceMemoryCombineStat DeviceMemory::GetCombineStat() {
+  DeviceMemoryCombineStat stat;
+  stat.continuous_count = kCombineContinuousCount.load();
+  stat.bulk_copy_count = kCombineBulkCopyCount.load();
+  stat.fragment_count = kCombineFragmentCount.load();
+  stat.fragment_copy_bytes = kCombineFragmentBytes.load();
+  return stat;
 }
 
 std::shared_ptr<DeviceMemory> DeviceMemory::CombineContinuous(
     const std::vector<std::shared_ptr<DeviceMemory>> &mem_list,
-    size_t total_size, std::shared_ptr<Device> target_device) {
+    size_t total_size, std::shared_ptr<Device> target_device,
+    uint32_t target_mem_flags) {
   auto first_mem_ptr = std::min_element(
       mem_list.begin(), mem_list.end(),
       [](const std::shared_ptr<DeviceMemory> &mem1,
@@ -137,18 +150,31 @@ std::shared_ptr<DeviceMemory> DeviceMemory::CombineContinuous(
     return nullptr;
   }
 
-  if (target_device == nullptr || target_device == mem->device_) {
+  if ((target_device == nullptr || target_device == mem->device_) &&
+      target_mem_flags == mem->mem_flags_) {
+    kCombineContinuousCount++;
     return continuous_mem;
-  } else {
-    auto new_device_mem = target_device->MemAlloc(total_size);
-    if (new_device_mem == nullptr) {
-      MBLOG_ERROR << "Mem alloc failed, size " << total_size;
-      return nullptr;
-    }
+  }
 
-    new_device_mem->ReadFrom(continuous_mem, 0, total_size);
-    return new_device_mem;
+  // source is one block, move it to target in a single transfer
+  if (target_device == nullptr) {
+    target_device = device;
+  }
+
+  auto new_device_mem = target_device->MemAlloc(total_size, target_mem_flags);
+  if (new_device_mem == nullptr) {
+    MBLOG_ERROR << "Mem alloc failed, size " << total_size;
+    return nullptr;
   }
+
+  ret = new_device_mem->ReadFrom(continuous_mem, 0, total_size);
+  if (ret != STATUS_SUCCESS) {
+    MBLOG_ERROR << "Combine read data failed, " << ret;
+    return nullptr;
+  }
+
+  kCombineBulkCopyCount++;
+  return new_device_mem;
 }
 
 std::shared_ptr<DeviceMemory> DeviceMemory::CombineFragment(
@@ -180,6 +206,8 @@ std::shared_ptr<DeviceMemory> DeviceMemory::CombineFragment(
     dest_offset += mem->GetSize();
   }
 
+  kCombineFragmentCount++;
+  kCombineFragmentBytes += total_size;
   return new_mem;
 }
 
@@ -432,6 +460,7 @@ std::shared_ptr<DeviceMemory> DeviceMemory::PrepareAppendMem(
     new_device_mem->size_ = size_ + append_size;
     new_device_mem->capacity_ = capacity_;
     new_device_mem->memory_id_ = memory_id_;
+    new_device_mem->is_acquired_ = is_acquired_;
     new_device_mem->mem_flags_ = mem_flags_;
   }
 
@@ -471,6 +500,7 @@ std::shared_ptr<DeviceMemory> DeviceMemory::Cut(size_t offset, size_t size) {
   new_device_mem->size_ = size;
   new_device_mem->capacity_ = capacity_ - offset;
   new_device_mem->memory_id_ = memory_id_;
+  new_device_mem->is_acquired_ = is_acquired_;
   new_device_mem->mem_flags_ = mem_flags_;
   CopyExtraMetaTo(new_device_mem);
   return new_device_mem;
@@ -589,6 +619,7 @@ std::shared_ptr<DeviceMemory> DeviceMemory::Clone(bool is_copy) {
     new_device_memory->capacity_ = capacity_;
     new_device_memory->memory_id_ = memory_id_;
     new_device_memory->is_content_mutable_ = is_content_mutable_;
+    new_device_memory->is_acquired_ = is_acquired_;
     new_device_memory->mem_flags_ = mem_flags_;
     CopyExtraMetaTo(new_device_memory);
   }
@@ -611,6 +642,7 @@ Status DeviceMemory::MemAcquire(std::shared_ptr<void> mem_ptr, size_t size) {
   offset_ = 0;
   size_ = size;
   capacity_ = size;
+  is_acquired_ = true;
   UpdateMemID(device_mem_ptr_.get());
   return STATUS_SUCCESS;
 }
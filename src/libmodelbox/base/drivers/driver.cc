@@ -28,12 +28,15 @@
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include <regex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "modelbox/base/config.h"
 #include "modelbox/base/driver_utils.h"
 #include "modelbox/base/log.h"
+#include "modelbox/base/utils.h"
 
 namespace modelbox {
 
@@ -270,6 +273,7 @@ const bool DriverDesc::GetNoDelete() { return driver_no_delete_; }
 
 const bool DriverDesc::GetGlobal() { return global_; }
 const bool DriverDesc::GetDeepBind() { return deep_bind_; }
+const std::string DriverDesc::GetScanInfo() { return driver_scan_info_; }
 
 void DriverDesc::SetClass(const std::string &classname) {
   driver_class_ = classname;
@@ -289,6 +293,9 @@ void DriverDesc::SetNodelete(const bool &no_delete) {
 
 void DriverDesc::SetGlobal(const bool &global) { global_ = global; }
 void DriverDesc::SetDeepBind(const bool &deep_bind) { deep_bind_ = deep_bind; }
+void DriverDesc::SetScanInfo(const std::string &scan_info) {
+  driver_scan_info_ = scan_info;
+}
 
 Status DriverDesc::SetVersion(const std::string &version) {
   if (version.empty()) {
@@ -343,11 +350,46 @@ void DriverDesc::SetFilePath(const std::string &file_path) {
 }
 
 // Drivers
+static std::map<std::string, DriverScanInfoCollector> &ScanInfoCollectors() {
+  static std::map<std::string, DriverScanInfoCollector> collectors;
+  return collectors;
+}
+
+static Status DumpScanInfoFile(const std::string &scan_info_path,
+                               const nlohmann::json &dump_json) {
+  // write to temporary file and rename, other process may read it
+  auto tmp_path = scan_info_path + ".tmp." + std::to_string(getpid());
+  std::ofstream scan_info_file(tmp_path);
+  if (!scan_info_file.is_open()) {
+    return {STATUS_FAULT, "Open file " + tmp_path + " for write failed"};
+  }
+
+  scan_info_file << dump_json;
+  scan_info_file.close();
+  if (scan_info_file.fail()) {
+    unlink(tmp_path.c_str());
+    return {STATUS_FAULT, "Write file " + tmp_path + " failed"};
+  }
+
+  if (rename(tmp_path.c_str(), scan_info_path.c_str()) != 0) {
+    auto err_msg = "rename " + tmp_path + " failed, " + strerror(errno);
+    unlink(tmp_path.c_str());
+    return {STATUS_FAULT, err_msg};
+  }
+
+  return STATUS_OK;
+}
+
 std::shared_ptr<Drivers> Drivers::GetInstance() {
   static std::shared_ptr<Drivers> drivers = std::make_shared<Drivers>();
   return drivers;
 };
 
+void Drivers::RegisterScanInfoCollector(const std::string &driver_class,
+                                        DriverScanInfoCollector collector) {
+  ScanInfoCollectors()[driver_class] = collector;
+}
+
 void Drivers::PrintScanResult(
     const std::list<std::string> &load_success_info,
     const std::map<std::string, std::string> &load_failed_info) {
@@ -372,8 +414,10 @@ void Drivers::PrintScanResult(
   }
 }
 
-Status Drivers::Scan(const std::string &path, const std::string &filter) {
-  std::vector<std::string> drivers_list;
+Status Drivers::ListDriverFiles(const std::string &path,
+                                const std::string &filter,
+                                std::vector<std::string> *driver_files,
+                                int64_t *check_sum) {
   struct stat s;
   auto ret = lstat(path.c_str(), &s);
   if (ret) {
@@ -382,27 +426,18 @@ Status Drivers::Scan(const std::string &path, const std::string &filter) {
   }
 
   if (!S_ISDIR(s.st_mode)) {
-    last_modify_time_sum_ += s.st_mtim.tv_sec;
-    auto status = Add(path);
-    if (status == STATUS_OK) {
-      drivers_scan_result_info_->GetLoadSuccessInfo().push_back(path);
-    } else {
-      drivers_scan_result_info_->GetLoadFailedInfo().emplace(path,
-                                                             status.Errormsg());
-    }
-    return status;
+    *check_sum += s.st_mtim.tv_sec;
+    driver_files->push_back(path);
+    return STATUS_OK;
   }
 
+  std::vector<std::string> drivers_list;
   Status status = ListFiles(path, filter, &drivers_list);
   if (status != STATUS_OK) {
     auto err_msg = "list directory:  " + path + "/" + filter + " failed, ";
     return {status, err_msg};
   }
 
-  if (drivers_list.size() == 0) {
-    return {STATUS_NOTFOUND, "directory is empty"};
-  }
-
   for (auto &driver_file : drivers_list) {
     struct stat buf;
     auto ret = lstat(driver_file.c_str(), &buf);
@@ -413,8 +448,28 @@ Status Drivers::Scan(const std::string &path, const std::string &filter) {
     if (S_ISLNK(buf.st_mode)) {
       continue;
     }
-    last_modify_time_sum_ += buf.st_mtim.tv_sec;
 
+    *check_sum += buf.st_mtim.tv_sec;
+    driver_files->push_back(driver_file);
+  }
+
+  return STATUS_OK;
+}
+
+Status Drivers::Scan(const std::string &path, const std::string &filter) {
+  std::vector<std::string> drivers_list;
+  int64_t check_sum = 0;
+  auto status = ListDriverFiles(path, filter, &drivers_list, &check_sum);
+  if (status != STATUS_OK) {
+    return status;
+  }
+
+  if (drivers_list.size() == 0) {
+    return {STATUS_NOTFOUND, "directory is empty"};
+  }
+
+  last_modify_time_sum_ += check_sum;
+  for (auto &driver_file : drivers_list) {
     auto result = Add(driver_file);
     if (result == STATUS_OK) {
       drivers_scan_result_info_->GetLoadSuccessInfo().push_back(driver_file);
@@ -422,6 +477,11 @@ Status Drivers::Scan(const std::string &path, const std::string &filter) {
       drivers_scan_result_info_->GetLoadFailedInfo().emplace(driver_file,
                                                              result.Errormsg());
     }
+
+    if (driver_file == path) {
+      // path is a driver file
+      return result;
+    }
   }
 
   return STATUS_OK;
@@ -446,26 +506,8 @@ Status Drivers::Initialize(std::shared_ptr<Configuration> config) {
   return STATUS_OK;
 }
 
-Status Drivers::WriteScanInfo(const std::string &scan_info_path,
-                              const std::string &check_code) {
-  std::ofstream scan_info_file(scan_info_path);
-  if (!scan_info_file.is_open()) {
-    return {STATUS_FAULT, "Open file " + scan_info_path + " for write failed"};
-  }
-
+Status Drivers::WriteScanInfo(const std::string &scan_info_path) {
   nlohmann::json dump_json;
-
-  struct stat buffer;
-  if (stat(DEFAULT_LD_CACHE, &buffer) == -1) {
-    dump_json["ld_cache_time"] = 0;
-  } else {
-    dump_json["ld_cache_time"] = buffer.st_mtim.tv_sec;
-  }
-
-  dump_json["check_code"] = check_code;
-  std::time_t tt =
-      std::chrono::system_clock::to_time_t(std::chrono::system_clock().now());
-  dump_json["version_record"] = std::ctime(&tt);
   nlohmann::json dump_driver_json_arr = nlohmann::json::array();
 
   MBLOG_DEBUG << "write info begin";
@@ -490,6 +532,7 @@ Status Drivers::WriteScanInfo(const std::string &scan_info_path,
     dump_driver_json["no_delete"] = no_delete;
     dump_driver_json["global"] = global;
     dump_driver_json["deep_bind"] = deep_bind;
+    dump_driver_json["scan_info"] = desc->GetScanInfo();
     dump_driver_json["load_success"] = true;
     dump_driver_json_arr.push_back(dump_driver_json);
   }
@@ -505,11 +548,75 @@ Status Drivers::WriteScanInfo(const std::string &scan_info_path,
   }
 
   dump_json["scan_drivers"] = dump_driver_json_arr;
-  scan_info_file << dump_json;
+  auto ret = DumpScanInfoFile(scan_info_path, dump_json);
   MBLOG_DEBUG << "write info end";
+  return ret;
+}
 
-  scan_info_file.close();
-  return STATUS_OK;
+Status Drivers::MergeScanInfo(const std::vector<std::string> &part_paths,
+                              const std::string &check_code) {
+  nlohmann::json dump_json;
+  nlohmann::json success_json_arr = nlohmann::json::array();
+  nlohmann::json failed_json_arr = nlohmann::json::array();
+  std::set<std::string> driver_keys;
+
+  for (const auto &part_path : part_paths) {
+    std::ifstream part_file(part_path);
+    if (!part_file.is_open()) {
+      return {STATUS_FAULT, "Open file " + part_path + " for read failed"};
+    }
+
+    nlohmann::json part_json;
+    try {
+      part_file >> part_json;
+    } catch (const std::exception &e) {
+      return {STATUS_FAULT, "parse " + part_path + " failed, " + e.what()};
+    }
+
+    // drivers in former part win, keep the same result as serial scan
+    for (auto &driver_info : part_json["scan_drivers"]) {
+      if (!driver_info["load_success"]) {
+        failed_json_arr.push_back(driver_info);
+        continue;
+      }
+
+      std::string key = driver_info["class"].get<std::string>() + "/" +
+                        driver_info["type"].get<std::string>() + "/" +
+                        driver_info["name"].get<std::string>() + "/" +
+                        driver_info["version"].get<std::string>();
+      if (driver_keys.insert(key).second == false) {
+        nlohmann::json failed_json;
+        failed_json["file_path"] = driver_info["file_path"];
+        failed_json["err_msg"] =
+            driver_info["file_path"].get<std::string>() +
+            " : driver is already registered.";
+        failed_json["load_success"] = false;
+        failed_json_arr.push_back(failed_json);
+        continue;
+      }
+
+      success_json_arr.push_back(driver_info);
+    }
+  }
+
+  struct stat buffer;
+  if (stat(DEFAULT_LD_CACHE, &buffer) == -1) {
+    dump_json["ld_cache_time"] = 0;
+  } else {
+    dump_json["ld_cache_time"] = buffer.st_mtim.tv_sec;
+  }
+
+  dump_json["check_code"] = check_code;
+  dump_json["scan_info_version"] = DRIVER_SCAN_INFO_VERSION;
+  std::time_t tt =
+      std::chrono::system_clock::to_time_t(std::chrono::system_clock().now());
+  dump_json["version_record"] = std::ctime(&tt);
+  for (auto &failed_json : failed_json_arr) {
+    success_json_arr.push_back(failed_json);
+  }
+  dump_json["scan_drivers"] = success_json_arr;
+
+  return DumpScanInfoFile(DEFAULT_SCAN_INFO, dump_json);
 }
 
 Status Drivers::GatherScanInfo(const std::string &scan_path) {
@@ -539,6 +646,7 @@ Status Drivers::GatherScanInfo(const std::string &scan_path) {
     desc->SetNodelete(driver_info["no_delete"]);
     desc->SetGlobal(driver_info["global"]);
     desc->SetDeepBind(driver_info["deep_bind"]);
+    desc->SetScanInfo(driver_info.value("scan_info", std::string()));
     auto tmp_driver = GetDriver(driver_info["class"], driver_info["type"],
                                 driver_info["name"], driver_info["version"]);
     if (tmp_driver == nullptr) {
@@ -551,12 +659,23 @@ Status Drivers::GatherScanInfo(const std::string &scan_path) {
   return STATUS_OK;
 }
 
-void Drivers::FillCheckInfo(std::string &file_check_node,
+bool Drivers::FillCheckInfo(std::string &file_check_node,
                             std::unordered_map<std::string, bool> &file_map,
                             int64_t &ld_cache_time) {
   std::ifstream scan_info(DEFAULT_SCAN_INFO);
   nlohmann::json dump_json;
-  scan_info >> dump_json;
+  try {
+    scan_info >> dump_json;
+  } catch (const std::exception &e) {
+    MBLOG_WARN << "parse " << DEFAULT_SCAN_INFO << " failed, " << e.what();
+    return false;
+  }
+
+  if (dump_json.value("scan_info_version", 0) != DRIVER_SCAN_INFO_VERSION) {
+    MBLOG_DEBUG << DEFAULT_SCAN_INFO << " version mismatch.";
+    return false;
+  }
+
   file_check_node = dump_json["check_code"];
   ld_cache_time = dump_json["ld_cache_time"];
   auto driver_json_arr = dump_json["scan_drivers"];
@@ -566,6 +685,8 @@ void Drivers::FillCheckInfo(std::string &file_check_node,
     }
     file_map[driver_info["file_path"]] = true;
   }
+
+  return true;
 }
 
 bool Drivers::CheckPathAndMagicCode() {
@@ -583,60 +704,33 @@ bool Drivers::CheckPathAndMagicCode() {
   std::string file_check_node;
   std::unordered_map<std::string, bool> file_map;
   int64_t ld_cache_time;
-  FillCheckInfo(file_check_node, file_map, ld_cache_time);
+  if (!FillCheckInfo(file_check_node, file_map, ld_cache_time)) {
+    return false;
+  }
 
   if (ld_cache_time != buffer.st_mtim.tv_sec) {
     return false;
   }
 
+  std::vector<std::string> driver_files;
   int64_t check_sum = 0;
   for (const auto &dir : driver_dirs_) {
-    std::vector<std::string> drivers_list;
-    std::string filter = "libmodelbox-*.so*";
-    struct stat s;
-    auto ret = lstat(dir.c_str(), &s);
-    if (ret) {
-      MBLOG_ERROR << "lstat " << dir << " failed, errno:" << strerror(errno);
-      return false;
-    }
-
-    if (!S_ISDIR(s.st_mode)) {
-      check_sum += s.st_mtim.tv_sec;
-      continue;
-    }
-
-    Status status = ListFiles(dir, filter, &drivers_list);
+    auto status =
+        ListDriverFiles(dir, DRIVER_FILE_FILTER, &driver_files, &check_sum);
     if (status != STATUS_OK) {
-      auto err_msg = "list directory:  " + dir + "/" + filter + " failed, ";
       if (status != STATUS_NOTFOUND) {
-        MBLOG_ERROR << err_msg << status.WrapErrormsgs();
+        MBLOG_ERROR << status.WrapErrormsgs();
       }
       return false;
     }
+  }
 
-    if (drivers_list.size() == 0) {
-      continue;
-    }
-
-    for (auto &driver_file : drivers_list) {
-      struct stat buf;
-      auto ret = lstat(driver_file.c_str(), &buf);
-      if (ret) {
-        MBLOG_DEBUG << "lstat " << dir << " failed, errno:" << strerror(errno);
-        continue;
-      }
-
-      if (S_ISLNK(buf.st_mode)) {
-        continue;
-      }
-
-      if (file_map.count(driver_file) == 0) {
-        return false;
-      }
-
-      check_sum += buf.st_mtim.tv_sec;
+  for (const auto &driver_file : driver_files) {
+    if (file_map.count(driver_file) == 0) {
+      return false;
     }
   }
+
   auto check_code = GenerateKey(check_sum);
   if (file_check_node != check_code) {
     return false;
@@ -645,21 +739,59 @@ bool Drivers::CheckPathAndMagicCode() {
   return true;
 }
 
-Status Drivers::InnerScan() {
-  Status ret = STATUS_NOTFOUND;
+Status Drivers::ListDriverFiles(std::vector<std::string> *driver_files,
+                                int64_t *check_sum) {
+  *check_sum = 0;
   for (const auto &dir : driver_dirs_) {
-    ret = Scan(dir, "libmodelbox-*.so*");
-    if (!ret && ret != STATUS_NOTFOUND) {
-      MBLOG_WARN << "scan " << dir << " failed";
+    auto status =
+        ListDriverFiles(dir, DRIVER_FILE_FILTER, driver_files, check_sum);
+    if (status != STATUS_OK && status != STATUS_NOTFOUND) {
+      MBLOG_WARN << "scan " << dir << " failed, " << status.WrapErrormsgs();
     }
-    ret = STATUS_OK;
   }
 
-  auto check_code = GenerateKey(last_modify_time_sum_);
+  return STATUS_OK;
+}
+
+void Drivers::CollectScanInfo(std::shared_ptr<Driver> driver) {
+  auto desc = driver->GetDriverDesc();
+  auto &collectors = ScanInfoCollectors();
+  auto iter = collectors.find(desc->GetClass());
+  if (iter == collectors.end() || iter->second == nullptr) {
+    return;
+  }
 
-  ret = WriteScanInfo(DEFAULT_SCAN_INFO, check_code);
+  std::string info;
+  auto ret = iter->second(driver, &info);
+  if (!ret) {
+    MBLOG_DEBUG << "collect scan info of " << desc->GetFilePath()
+                << " failed, " << ret;
+    return;
+  }
+
+  desc->SetScanInfo(info);
+}
+
+Status Drivers::InnerScan(const std::vector<std::string> &driver_files,
+                          const std::string &scan_info_path,
+                          bool collect_info) {
+  for (const auto &driver_file : driver_files) {
+    auto result = Add(driver_file);
+    if (result != STATUS_OK) {
+      drivers_scan_result_info_->GetLoadFailedInfo().emplace(driver_file,
+                                                             result.Errormsg());
+      continue;
+    }
+
+    drivers_scan_result_info_->GetLoadSuccessInfo().push_back(driver_file);
+    if (collect_info) {
+      CollectScanInfo(drivers_list_.back());
+    }
+  }
+
+  auto ret = WriteScanInfo(scan_info_path);
   if (ret != STATUS_OK) {
-    auto err_msg = "write scan info failed";
+    auto err_msg = "write scan info failed, " + ret.WrapErrormsgs();
     MBLOG_ERROR << err_msg;
     return {STATUS_FAULT, err_msg};
   }
@@ -667,6 +799,66 @@ Status Drivers::InnerScan() {
   return ret;
 }
 
+Status Drivers::ParallelScan(const std::vector<std::string> &driver_files,
+                             const std::string &check_code) {
+  // each subprocess has its own loader lock, so dlopen runs in parallel.
+  size_t process_num = std::thread::hardware_concurrency();
+  process_num = std::min(process_num, DRIVER_SCAN_MAX_PROCESS);
+  process_num = std::min(process_num, driver_files.size() /
+                                          DRIVER_SCAN_MIN_FILES_PER_PROCESS);
+  if (process_num == 0) {
+    process_num = 1;
+  }
+
+  auto part_size = (driver_files.size() + process_num - 1) / process_num;
+  std::vector<std::vector<std::string>> part_files;
+  std::vector<std::string> part_paths;
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < process_num; i++) {
+    auto begin = std::min(i * part_size, driver_files.size());
+    auto end = std::min(begin + part_size, driver_files.size());
+    part_files.emplace_back(driver_files.begin() + begin,
+                            driver_files.begin() + end);
+    part_paths.push_back(std::string(DEFAULT_SCAN_INFO) + ".part." +
+                         std::to_string(getpid()) + "." + std::to_string(i));
+  }
+
+  Defer {
+    for (const auto &part_path : part_paths) {
+      unlink(part_path.c_str());
+    }
+  };
+
+  for (size_t i = 0; i < process_num; i++) {
+    pids.push_back(SubProcessStart([&, i]() {
+      return InnerScan(part_files[i], part_paths[i], true);
+    }));
+  }
+
+  MBLOG_INFO << "wait for " << process_num << " scan subprocess finished";
+  for (size_t i = 0; i < process_num; i++) {
+    struct stat buf;
+    Status status = STATUS_FAULT;
+    if (pids[i] != -1) {
+      status = SubProcessWait(pids[i]);
+    }
+
+    if (status == STATUS_OK && stat(part_paths[i].c_str(), &buf) == 0) {
+      continue;
+    }
+
+    // driver may crash when collect info, scan again without collecting.
+    MBLOG_WARN << "scan subprocess " << i << " failed, scan without info";
+    status = SubProcessRun(
+        [&, i]() { return InnerScan(part_files[i], part_paths[i], false); });
+    if (status != STATUS_OK) {
+      return {status, "fork subprocess run scan so failed"};
+    }
+  }
+
+  return MergeScanInfo(part_paths, check_code);
+}
+
 void Drivers::PrintScanResults(const std::string &scan_path) {
   std::ifstream scan_info_file(scan_path);
   if (!scan_info_file.is_open()) {
@@ -696,15 +888,22 @@ void Drivers::PrintScanResults(const std::string &scan_path) {
 
 Status Drivers::Scan() {
   Status status = STATUS_FAULT;
+  auto begin_time = GetTickCount();
+  auto scan_time = begin_time;
+  size_t driver_file_num = 0;
   if (!CheckPathAndMagicCode()) {
-    auto exec_func = std::bind(&Drivers::InnerScan, this);
-    auto status = SubProcessRun(exec_func);
+    std::vector<std::string> driver_files;
+    int64_t check_sum = 0;
+    ListDriverFiles(&driver_files, &check_sum);
+    driver_file_num = driver_files.size();
+    auto status = ParallelScan(driver_files, GenerateKey(check_sum));
     if (status != STATUS_OK) {
       auto err_msg =
           "fork subprocess run scan so failed, " + status.WrapErrormsgs();
       MBLOG_ERROR << err_msg;
       return {STATUS_FAULT, err_msg};
     }
+    scan_time = GetTickCount();
   }
 
   status = GatherScanInfo(DEFAULT_SCAN_INFO);
@@ -715,10 +914,24 @@ Status Drivers::Scan() {
   }
 
   PrintScanResults(DEFAULT_SCAN_INFO);
+  auto gather_time = GetTickCount();
   MBLOG_INFO << "begin scan virtual drivers";
   status = VirtualDriverScan();
   MBLOG_INFO << "end scan virtual drivers";
 
+  auto end_time = GetTickCount();
+  if (driver_file_num > 0) {
+    MBLOG_INFO << "scan drivers cost " << end_time - begin_time
+               << "ms, scan " << driver_file_num << " files "
+               << scan_time - begin_time << "ms, gather "
+               << gather_time - scan_time << "ms, virtual drivers "
+               << end_time - gather_time << "ms";
+  } else {
+    MBLOG_INFO << "scan drivers cost " << end_time - begin_time
+               << "ms, use cache, gather " << gather_time - scan_time
+               << "ms, virtual drivers " << end_time - gather_time << "ms";
+  }
+
   return status;
 }
 
@@ -20,6 +20,30 @@
 
 namespace modelbox {
 
+Status SubProcessWait(pid_t pid) {
+  int status;
+  auto ret = waitpid(pid, &status, 0);
+  if (ret < 0) {
+    auto err_msg =
+        "subprocess run failed, wait error, ret:" + std::to_string(errno) +
+        ", msg: " + strerror(errno);
+    MBLOG_ERROR << err_msg;
+    return {STATUS_FAULT, err_msg};
+  }
+
+  if (WIFSIGNALED(status)) {
+    auto err_msg = "killed by signal " + std::to_string(WTERMSIG(status));
+    MBLOG_ERROR << err_msg;
+    return {STATUS_FAULT, err_msg};
+  } else if (WIFSTOPPED(status)) {
+    auto err_msg = "stopped by signal " + std::to_string(WSTOPSIG(status));
+    MBLOG_ERROR << err_msg;
+    return {STATUS_FAULT, err_msg};
+  }
+
+  return STATUS_OK;
+}
+
 std::string GenerateKey(int64_t check_sum) {
   std::vector<unsigned char> output;
   auto status = HmacEncode("sha256", &check_sum, sizeof(uint64_t), &output);
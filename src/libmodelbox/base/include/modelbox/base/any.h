@@ -22,9 +22,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <string>
+#include <tuple>
 #include <type_traits>
 #include <typeinfo>
+#include <vector>
 
 static std::map<size_t, size_t> type_hash_code_map = {
     {typeid(int).hash_code(), typeid(int64_t).hash_code()},
@@ -38,7 +41,7 @@ class Any {
  public:
   Any() noexcept : value_ptr_(nullptr) {}
 
-  virtual ~Any() noexcept { delete value_ptr_; }
+  virtual ~Any() noexcept { reset(); }
 
   template <
       typename ValueType,
@@ -46,20 +49,22 @@ class Any {
           !std::is_same<typename std::decay<ValueType>::type, Any>::value &&
           std::is_copy_constructible<
               typename std::decay<ValueType>::type>::value>::type>
-  explicit Any(ValueType&& value)
-      : value_ptr_(new AnyImpl<typename std::decay<ValueType>::type>(
-            std::forward<ValueType>(value))) {}
+  explicit Any(ValueType&& value) : value_ptr_(nullptr) {
+    using ImplType = AnyImpl<typename std::decay<ValueType>::type>;
+    using IsInlineType = std::integral_constant<bool, ImplType::kInline>;
+    value_ptr_ =
+        Create<ImplType>(std::forward<ValueType>(value), IsInlineType());
+  }
 
-  Any(const Any& other)
-      : value_ptr_(other.value_ptr_ ? other.value_ptr_->clone() : nullptr) {}
+  Any(const Any& other) : value_ptr_(nullptr) { CopyFrom(other); }
 
-  Any(Any&& other) noexcept : value_ptr_(other.value_ptr_) {
-    other.value_ptr_ = nullptr;
-  }
+  Any(Any&& other) noexcept : value_ptr_(nullptr) { MoveFrom(other); }
 
  public:
   Any& swap(Any& rhs) noexcept {
-    std::swap(value_ptr_, rhs.value_ptr_);
+    Any tmp(std::move(rhs));
+    rhs = std::move(*this);
+    *this = std::move(tmp);
     return *this;
   }
 
@@ -75,9 +80,12 @@ class Any {
   }
 
   Any& operator=(Any&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+
     reset();
-    value_ptr_ = rhs.value_ptr_;
-    rhs.value_ptr_ = nullptr;
+    MoveFrom(rhs);
     return *this;
   }
 
@@ -98,7 +106,11 @@ class Any {
   }
 
   void reset() noexcept {
-    delete value_ptr_;
+    if (IsInline()) {
+      value_ptr_->~AnyImplBase();
+    } else {
+      delete value_ptr_;
+    }
     value_ptr_ = nullptr;
   }
 
@@ -117,16 +129,24 @@ class Any {
   }
 
  protected:
+  /* scalar values live in storage_, no heap allocation */
+  static constexpr size_t kInlineSize = 2 * sizeof(void*);
+
   struct AnyImplBase {
     virtual ~AnyImplBase() noexcept {}
 
     virtual const std::type_info& type() const noexcept = 0;
 
     virtual AnyImplBase* clone() const = 0;
+
+    virtual AnyImplBase* clone_to(void* storage) const = 0;
   };
 
   template <typename ValueType>
   struct AnyImpl : public AnyImplBase {
+    static constexpr bool kInline =
+        std::is_scalar<ValueType>::value && sizeof(ValueType) <= sizeof(void*);
+
     AnyImpl(const ValueType& value) : value_(value) {}
 
     AnyImpl(ValueType&& value) : value_(std::move(value)) {}
@@ -137,11 +157,50 @@ class Any {
 
     virtual AnyImplBase* clone() const { return new AnyImpl(value_); }
 
+    virtual AnyImplBase* clone_to(void* storage) const {
+      return new (storage) AnyImpl(value_);
+    }
+
     ValueType value_;
   };
 
+  template <typename ImplType, typename ValueType>
+  AnyImplBase* Create(ValueType&& value, std::true_type) {
+    return new (&storage_) ImplType(std::forward<ValueType>(value));
+  }
+
+  template <typename ImplType, typename ValueType>
+  AnyImplBase* Create(ValueType&& value, std::false_type) {
+    return new ImplType(std::forward<ValueType>(value));
+  }
+
+  bool IsInline() const noexcept {
+    return value_ptr_ == reinterpret_cast<const AnyImplBase*>(&storage_);
+  }
+
+  void CopyFrom(const Any& other) {
+    if (other.IsInline()) {
+      value_ptr_ = other.value_ptr_->clone_to(&storage_);
+    } else if (other.value_ptr_) {
+      value_ptr_ = other.value_ptr_->clone();
+    }
+  }
+
+  void MoveFrom(Any& other) noexcept {
+    if (other.IsInline()) {
+      /* inline values are scalar, copy is cheap and can not throw */
+      value_ptr_ = other.value_ptr_->clone_to(&storage_);
+      other.reset();
+      return;
+    }
+
+    value_ptr_ = other.value_ptr_;
+    other.value_ptr_ = nullptr;
+  }
+
  private:
   AnyImplBase* value_ptr_;
+  typename std::aligned_storage<kInlineSize, alignof(void*)>::type storage_;
 };
 
 template <typename ValueType>
@@ -165,6 +224,62 @@ ValueType any_cast(Any& any) {
   return static_cast<ValueType>(*result);
 }
 
+template <typename ValueType>
+ValueType any_cast(const Any& any) {
+  auto const result = any_cast<typename std::decay<ValueType>::type>(&any);
+
+  if (!result) {
+    throw std::bad_cast();
+  }
+
+  return static_cast<ValueType>(*result);
+}
+
+/**
+ * @brief Interned meta key, precompute it for keys used on hot path.
+ *        static const MetaKey kWidth("width");
+ */
+class MetaKey {
+ public:
+  explicit MetaKey(const std::string& name);
+
+  virtual ~MetaKey() = default;
+
+  /**
+   * @brief Get interned id of key.
+   * @return key id.
+   */
+  uint32_t Id() const { return id_; }
+
+  /**
+   * @brief Get name of key.
+   * @return key name.
+   */
+  const std::string& Name() const { return name_; }
+
+  /**
+   * @brief Intern key name, same name always get the same id.
+   * @param name key name.
+   * @return key id.
+   */
+  static uint32_t Intern(const std::string& name);
+
+  /**
+   * @brief Find id of interned key, without interning it.
+   * @param name key name.
+   * @param id key id.
+   * @return whether key is interned.
+   */
+  static bool Find(const std::string& name, uint32_t* id);
+
+ private:
+  uint32_t id_;
+  std::string name_;
+};
+
+/**
+ * @brief Flat key value store, copies share entries until one is modified.
+ */
 class Collection {
  public:
   Collection() = default;
@@ -173,48 +288,82 @@ class Collection {
 
   template <typename T>
   void Set(const std::string& key, T&& value) {
-    entrys_[key] = Any(value);
+    Assign(MetaKey::Intern(key)) = Any(value);
   }
 
   void Set(const std::string& key, const char* value) {
-    entrys_[key] = Any(std::string(value));
+    Assign(MetaKey::Intern(key)) = Any(std::string(value));
+  }
+
+  template <typename T>
+  void Set(const MetaKey& key, T&& value) {
+    Assign(key.Id()) = Any(value);
+  }
+
+  void Set(const MetaKey& key, const char* value) {
+    Assign(key.Id()) = Any(std::string(value));
   }
 
   template <typename T>
   bool Get(const std::string& key, T&& value) {
-    if (entrys_.find(key) == entrys_.end()) {
+    uint32_t id = 0;
+    if (!MetaKey::Find(key, &id)) {
       // could be a normal condition
       MBLOG_DEBUG << "Key " << key << " not found";
       return false;
     }
 
-    if (!CanConvert(typeid(T).hash_code(), entrys_[key].type().hash_code())) {
-      // always a bad condition
-      MBLOG_ERROR << "Get value for " << key
-                  << "failed, type mismatch, param type " << typeid(T).name()
-                  << ", stored value type " << entrys_[key].type().name();
-      return false;
+    return GetValue(id, key, value);
+  }
+
+  template <typename T>
+  bool Get(const MetaKey& key, T&& value) {
+    return GetValue(key.Id(), key.Name(), value);
+  }
+
+  std::tuple<const Any*, bool> Get(const std::string& key) const {
+    uint32_t id = 0;
+    if (!MetaKey::Find(key, &id)) {
+      return std::make_tuple(nullptr, false);
     }
 
-    value = any_cast<T>(entrys_[key]);
-    return true;
+    const auto* any = Find(id);
+    return std::make_tuple(any, any != nullptr);
+  }
+
+  std::tuple<const Any*, bool> Get(const MetaKey& key) const {
+    const auto* any = Find(key.Id());
+    return std::make_tuple(any, any != nullptr);
   }
 
-  std::tuple<Any*, bool> Get(const std::string& key) {
-    auto iter = entrys_.find(key);
-    if (iter != entrys_.end()) {
-      return std::make_tuple(&(iter->second), true);
+  /* lookup for writing, entries shared with other collections are copied */
+  std::tuple<Any*, bool> GetMutable(const std::string& key) {
+    uint32_t id = 0;
+    if (!MetaKey::Find(key, &id)) {
+      return std::make_tuple(nullptr, false);
     }
 
-    return std::make_tuple(nullptr, false);
+    return GetAny(id);
   }
 
   void Merge(const Collection& other, bool is_override = false) {
-    if (!is_override) {
-      entrys_.insert(other.entrys_.begin(), other.entrys_.end());
-    } else {
-      for (auto& iter : entrys_) {
-        entrys_[iter.first] = iter.second;
+    if (other.entrys_ == nullptr || other.entrys_->empty() ||
+        other.entrys_ == entrys_) {
+      return;
+    }
+
+    if (entrys_ == nullptr || entrys_->empty()) {
+      entrys_ = other.entrys_;
+      return;
+    }
+
+    Detach();
+    for (const auto& entry : *other.entrys_) {
+      auto* value = Find(entry.id);
+      if (value == nullptr) {
+        entrys_->push_back(entry);
+      } else if (is_override) {
+        *value = entry.value;
       }
     }
   }
@@ -239,9 +388,104 @@ class Collection {
   }
 
  private:
-  std::map<std::string, Any> entrys_;
+  struct Entry {
+    uint32_t id;
+    Any value;
+  };
+
+  template <typename T>
+  bool GetValue(uint32_t id, const std::string& key, T&& value) {
+    auto* any = Find(id);
+    if (any == nullptr) {
+      // could be a normal condition
+      MBLOG_DEBUG << "Key " << key << " not found";
+      return false;
+    }
+
+    using ValueType = typename std::decay<T>::type;
+    if (any->type() == typeid(ValueType)) {
+      value = *any_cast<ValueType>(any);
+      return true;
+    }
+
+    if (!CanConvert(typeid(T).hash_code(), any->type().hash_code())) {
+      // always a bad condition
+      MBLOG_ERROR << "Get value for " << key
+                  << "failed, type mismatch, param type " << typeid(T).name()
+                  << ", stored value type " << any->type().name();
+      return false;
+    }
+
+    CastValue(any, value, std::is_arithmetic<ValueType>());
+    return true;
+  }
+
+  template <typename T>
+  static void CastValue(Any* any, T& value, std::true_type) {
+    const auto& type = any->type();
+    if (type == typeid(int)) {
+      value = static_cast<T>(*any_cast<int>(any));
+    } else if (type == typeid(int64_t)) {
+      value = static_cast<T>(*any_cast<int64_t>(any));
+    } else if (type == typeid(float)) {
+      value = static_cast<T>(*any_cast<float>(any));
+    } else if (type == typeid(double)) {
+      value = static_cast<T>(*any_cast<double>(any));
+    }
+  }
+
+  template <typename T>
+  static void CastValue(Any* any, T& value, std::false_type) {
+    value = *any_cast<T>(any);
+  }
+
+  std::tuple<Any*, bool> GetAny(uint32_t id) {
+    if (Find(id) == nullptr) {
+      return std::make_tuple(nullptr, false);
+    }
+
+    Detach();
+    return std::make_tuple(Find(id), true);
+  }
+
+  Any* Find(uint32_t id) const {
+    if (entrys_ == nullptr) {
+      return nullptr;
+    }
+
+    for (auto& entry : *entrys_) {
+      if (entry.id == id) {
+        return &entry.value;
+      }
+    }
+
+    return nullptr;
+  }
+
+  Any& Assign(uint32_t id) {
+    Detach();
+    auto* value = Find(id);
+    if (value != nullptr) {
+      return *value;
+    }
+
+    entrys_->push_back(Entry{id, Any()});
+    return entrys_->back().value;
+  }
+
+  void Detach() {
+    if (entrys_ == nullptr) {
+      entrys_ = std::make_shared<std::vector<Entry>>();
+      entrys_->reserve(kInitEntryNum);
+    } else if (entrys_.use_count() > 1) {
+      entrys_ = std::make_shared<std::vector<Entry>>(*entrys_);
+    }
+  }
+
+  static constexpr size_t kInitEntryNum = 8;
+  std::shared_ptr<std::vector<Entry>> entrys_;
 };
 
 }  // namespace modelbox
 
-#endif
\ No newline at end of file
+#endif
@@ -18,8 +18,12 @@
 #ifndef MODELBOX_BLOCKINGQUEUE_H_
 #define MODELBOX_BLOCKINGQUEUE_H_
 
+#include <atomic>
+#include <cerrno>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -918,5 +922,699 @@ class PriorityBlockingQueue
   Compare comp_;
 };
 
+/**
+ * @brief Bounded lock-free blocking queue, multi-producer and multi-consumer.
+ * Elements are stored in a power-of-two ring, producers and consumers claim
+ * slots by CAS on head/tail, so the fast path never takes the mutex.
+ * When the queue is empty or full, callers spin for a short while, then park
+ * on condition variables.
+ * It has the same Push/Pop interface as BlockingQueue, but is not derived
+ * from it, so BlockingQueue calls stay non-virtual. The ring is allocated at
+ * construction and never grows, capacity must be between 1 and kMaxRingSize.
+ */
+template <typename T, typename Sequence = std::vector<T>>
+class RingBlockingQueue {
+ public:
+  /// @brief max ring size, larger capacity is not supported
+  static constexpr size_t kMaxRingSize = 65536;
+
+  /**
+   * @brief Whether capacity can be served by a ring queue
+   * @param capacity queue capacity
+   * @return supported or not
+   */
+  static bool IsCapacitySupported(size_t capacity) {
+    return capacity > 0 && capacity <= kMaxRingSize;
+  }
+
+  /**
+   * @brief A lock-free blocking queue.
+   * @param capacity queue capacity, between 1 and kMaxRingSize, ring size is
+   * capacity rounded up to power of two. Unsupported capacity is clamped,
+   * check it with IsCapacitySupported first.
+   */
+  explicit RingBlockingQueue(size_t capacity) {
+    if (capacity <= 0 || capacity > kMaxRingSize) {
+      capacity = kMaxRingSize;
+    }
+
+    ring_size_ = kRingMinSize;
+    while (ring_size_ < capacity) {
+      ring_size_ <<= 1;
+    }
+
+    mask_ = ring_size_ - 1;
+    cells_.reset(new RingCell[ring_size_]);
+    for (size_t i = 0; i < ring_size_; i++) {
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    capacity_.store(capacity, std::memory_order_relaxed);
+  }
+
+  virtual ~RingBlockingQueue() { Close(); }
+
+  /**
+   * @brief Get ring size
+   * @return ring slot number
+   */
+  size_t RingSize() const { return ring_size_; }
+
+  /**
+   * @brief Return element size
+   * @return element size
+   */
+  size_t Size() {
+    auto head = head_.load(std::memory_order_acquire);
+    auto tail = tail_.load(std::memory_order_acquire);
+    if (tail <= head) {
+      return 0;
+    }
+
+    return tail - head;
+  }
+
+  /**
+   * @brief Set queue capacity
+   * @param capacity queue capacity, larger than 0 and not larger than ring
+   * size.
+   * @return false if ring can not hold capacity, capacity is unchanged.
+   */
+  bool SetCapacity(size_t capacity) {
+    if (capacity <= 0 || capacity > ring_size_) {
+      return false;
+    }
+
+    capacity_.store(capacity, std::memory_order_release);
+    NotifyWaiters(&not_full_, &not_full_waiters_, true);
+    return true;
+  }
+
+  /**
+   * @brief Get queue capacity
+   */
+  size_t GetCapacity() const {
+    return capacity_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get remain capacity
+   */
+  size_t RemainCapacity() {
+    size_t queue_size = Size();
+    size_t capacity = GetCapacity();
+    if (queue_size > capacity) {
+      return 0;
+    }
+
+    return capacity - queue_size;
+  }
+
+  /**
+   * @brief Clear queue
+   */
+  void Clear() {
+    T elem;
+    while (TryPop(&elem)) {
+    }
+
+    NotifyWaiters(&not_full_, &not_full_waiters_, true);
+  }
+
+  /**
+   * @brief Close queue
+   */
+  void Close() {
+    Shutdown();
+    Clear();
+  }
+
+  /**
+   * @brief Is queue full
+   * @return true of false
+   */
+  bool Full() { return Size() >= GetCapacity(); }
+
+  /**
+   * @brief Is queue empty
+   * @return true of false
+   */
+  bool Empty() { return Size() == 0; }
+
+  /**
+   * @brief Wake up waiters, if nobody is waiting, the next wait returns
+   */
+  void Wakeup() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    need_wakeup_.store(true, std::memory_order_release);
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  /**
+   * @brief Push item into queue, blocking if queue is full.
+   * @param elem item reference.
+   * @return true or false
+   */
+  bool Push(const T& elem) { return Push(elem, 0); }
+
+  /**
+   * @brief Push item into queue
+   * @param elem item reference
+   * @param timeout same as BlockingQueue::Push
+   * @return true or false
+   */
+  bool Push(const T& elem, int timeout) {
+    if (IsShutdown()) {
+      errno = ESHUTDOWN;
+      return false;
+    }
+
+    auto push_func = [&]() { return !IsShutdown() && TryPush(elem, false); };
+    if (WaitFor(&not_full_, &not_full_waiters_, timeout, push_func) ==
+        false) {
+      return false;
+    }
+
+    NotifyWaiters(&not_empty_, &not_empty_waiters_, false);
+    return true;
+  }
+
+  /**
+   * @brief Push a sequence into queue one by one
+   * @param elems sequence reference, pushed elements are removed.
+   * @param timeout same as BlockingQueue::Push
+   * @return number of pushed elems.
+   */
+  size_t Push(Sequence* elems, int timeout = 0) {
+    size_t push_num = 0;
+    for (auto it = elems->begin(); it != elems->end(); it++) {
+      if (Push(*it, timeout) == false) {
+        break;
+      }
+
+      push_num++;
+      /* when get first element, stop waiting */
+      if (timeout >= 0) {
+        timeout = -1;
+      }
+    }
+
+    elems->erase(elems->begin(), elems->begin() + push_num);
+    return push_num;
+  }
+
+  /**
+   * @brief Push a sequence at once, wait until queue has space for all.
+   * Slots for the whole sequence are reserved together, so the batch is
+   * never split by other producers and never exceeds capacity. A sequence
+   * larger than ring size can not be reserved and is pushed one by one.
+   * @param elems sequence reference, pushed elements are removed.
+   * @param timeout same as BlockingQueue::PushBatch
+   * @return number of pushed elems.
+   */
+  size_t PushBatch(Sequence* elems, int timeout = 0) {
+    auto expect_space = elems->size();
+    if (expect_space > ring_size_) {
+      return PushBatchOneByOne(elems, timeout);
+    }
+
+    size_t pos = 0;
+    auto reserve_func = [&]() {
+      return !IsShutdown() && TryReserve(expect_space, &pos);
+    };
+
+    if (IsShutdown() ||
+        WaitFor(&not_full_, &not_full_waiters_, timeout, reserve_func) ==
+            false) {
+      if (IsShutdown()) {
+        errno = ESHUTDOWN;
+      }
+      return 0;
+    }
+
+    for (auto it = elems->begin(); it != elems->end(); it++, pos++) {
+      auto* cell = &cells_[pos & mask_];
+      cell->data = *it;
+      cell->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    elems->clear();
+    if (expect_space > 0) {
+      NotifyWaiters(&not_empty_, &not_empty_waiters_, true);
+    }
+
+    return expect_space;
+  }
+
+  /**
+   * @brief Push a sequence at once, ignore capacity.
+   * @param elems sequence reference, pushed elements are removed.
+   * @param wait_when_full wait until queue is not full before push.
+   * @param timeout same as BlockingQueue::PushBatchForce
+   * @return number of pushed elems.
+   */
+  size_t PushBatchForce(Sequence* elems, bool wait_when_full = false,
+                        int timeout = 0) {
+    if (wait_when_full) {
+      auto space_func = [&]() { return IsShutdown() || !Full(); };
+      if (WaitFor(&not_full_, &not_full_waiters_, timeout, space_func) ==
+          false) {
+        return 0;
+      }
+    }
+
+    if (IsShutdown()) {
+      errno = ESHUTDOWN;
+      return 0;
+    }
+
+    return PushAllForce(elems);
+  }
+
+  /**
+   * @brief Force push item into queue, capacity is ignored, ring size is not.
+   * @param elem item reference.
+   * @return true or false
+   */
+  bool PushForce(const T& elem) {
+    if (IsShutdown()) {
+      errno = ESHUTDOWN;
+      return false;
+    }
+
+    auto push_func = [&]() { return !IsShutdown() && TryPush(elem, true); };
+    if (WaitFor(&not_full_, &not_full_waiters_, 0, push_func) == false) {
+      return false;
+    }
+
+    NotifyWaiters(&not_empty_, &not_empty_waiters_, false);
+    return true;
+  }
+
+  /**
+   * @brief Get an item from queue, blocking if queue is empty.
+   * @param elem item data.
+   * @return true or false
+   */
+  bool Pop(T* elem) { return Pop(elem, 0); }
+
+  /**
+   * @brief Get an item from queue, never blocking.
+   * @param elem item data.
+   * @return true or false
+   */
+  bool Poll(T* elem) { return Pop(elem, -1); }
+
+  /**
+   * @brief Get an item from queue
+   * @param elem item
+   * @param timeout same as BlockingQueue::Pop
+   * @return is pop success
+   */
+  bool Pop(T* elem, int timeout) {
+    auto pop_func = [&]() { return TryPop(elem); };
+    if (WaitFor(&not_empty_, &not_empty_waiters_, timeout, pop_func) ==
+        false) {
+      return false;
+    }
+
+    NotifyWaiters(&not_full_, &not_full_waiters_, true);
+    return true;
+  }
+
+  /**
+   * @brief Get a sequence from queue
+   * @param elems item
+   * @param timeout same as BlockingQueue::Pop
+   * @param maxsize max pop items number, 0 means all.
+   * @return number of poped elemets.
+   */
+  size_t Pop(Sequence* elems, int timeout = 0, size_t maxsize = 0) {
+    if (maxsize == 0) {
+      maxsize = SIZE_MAX;
+    }
+
+    return PopMany(elems, timeout, maxsize);
+  }
+
+  /**
+   * @brief Pop a sequence of elems from queue at once
+   * @param elems sequence reference
+   * @param timeout same as BlockingQueue::PopBatch
+   * @param max_elems max elements number returned.
+   * @return: return number of elems.
+   */
+  size_t PopBatch(Sequence* elems, int timeout = 0, uint32_t max_elems = -1) {
+    if (max_elems == 0) {
+      return 0;
+    }
+
+    return PopMany(elems, timeout, max_elems);
+  }
+
+  /**
+   * @brief Shutdown queue, push will wakeup and return false
+   */
+  void Shutdown() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    shutdown_.store(true, std::memory_order_seq_cst);
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  /**
+   * @brief Queue is shutdown or not
+   * @return is queue shutdown
+   */
+  bool IsShutdown() { return shutdown_.load(std::memory_order_acquire); }
+
+ protected:
+  /**
+   * @brief Try push one element without blocking
+   * @param elem element
+   * @param force ignore capacity, only limited by ring size
+   * @return push result
+   */
+  bool TryPush(const T& elem, bool force) {
+    RingCell* cell = nullptr;
+    auto pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      if (!force) {
+        auto head = head_.load(std::memory_order_acquire);
+        auto capacity = capacity_.load(std::memory_order_relaxed);
+        if (pos >= head && pos - head >= capacity) {
+          return false;
+        }
+      }
+
+      cell = &cells_[pos & mask_];
+      auto seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        /* ring is full */
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->data = elem;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Try reserve continuous slots for a batch without blocking, the
+   * batch is allowed to exceed capacity when queue is empty
+   * @param num slot number, not larger than ring size
+   * @param reserved first reserved position
+   * @return reserve result
+   */
+  bool TryReserve(size_t num, size_t* reserved) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      auto head = head_.load(std::memory_order_acquire);
+      auto used = pos >= head ? pos - head : 0;
+      if (used > 0 && used + num > capacity_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+
+      /* every slot must be released by consumers */
+      bool ready = true;
+      for (size_t i = 0; i < num; i++) {
+        auto* cell = &cells_[(pos + i) & mask_];
+        if (cell->seq.load(std::memory_order_acquire) != pos + i) {
+          ready = false;
+          break;
+        }
+      }
+
+      if (!ready) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail == pos) {
+          return false;
+        }
+
+        pos = tail;
+        continue;
+      }
+
+      if (tail_.compare_exchange_weak(pos, pos + num,
+                                      std::memory_order_relaxed)) {
+        *reserved = pos;
+        return true;
+      }
+    }
+  }
+
+  /**
+   * @brief Push a sequence larger than ring size, wait for empty queue, then
+   * push elements one by one
+   * @param elems sequence reference, pushed elements are removed.
+   * @param timeout same as BlockingQueue::PushBatch
+   * @return number of pushed elems.
+   */
+  size_t PushBatchOneByOne(Sequence* elems, int timeout) {
+    auto space_func = [&]() { return !IsShutdown() && Size() == 0; };
+    if (IsShutdown() ||
+        WaitFor(&not_full_, &not_full_waiters_, timeout, space_func) ==
+            false) {
+      if (IsShutdown()) {
+        errno = ESHUTDOWN;
+      }
+      return 0;
+    }
+
+    return PushAllForce(elems);
+  }
+
+  /**
+   * @brief Try pop one element without blocking
+   * @param elem element poped
+   * @return pop result
+   */
+  bool TryPop(T* elem) {
+    RingCell* cell = nullptr;
+    auto pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & mask_];
+      auto seq = cell->seq.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        /* ring is empty */
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    *elem = std::move(cell->data);
+    /* release resources held by the slot */
+    cell->data = T();
+    cell->seq.store(pos + ring_size_, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Spin and then park until func returns true.
+   * A pending Wakeup interrupts the wait with EINTR, it is kept until all
+   * current waiters have seen it, like BlockingQueue.
+   * @param cond condition to park on
+   * @param waiters waiter counter of cond
+   * @param timeout same as Push/Pop
+   * @param func try function, return true when done
+   * @return wait success, errno is set when failed
+   */
+  bool WaitFor(std::condition_variable* cond, std::atomic<int>* waiters,
+               int timeout, const std::function<bool()>& func) {
+    if (func()) {
+      return true;
+    }
+
+    if (timeout < 0) {
+      if (IsShutdown()) {
+        errno = ESHUTDOWN;
+      }
+      return false;
+    }
+
+    for (int i = 0; i < kRingSpinCount; i++) {
+      CpuRelax();
+      if (func()) {
+        return true;
+      }
+
+      if (IsShutdown() || need_wakeup_.load(std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters->fetch_add(1, std::memory_order_relaxed);
+    waiter_number_++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool ret = false;
+    bool interrupted = false;
+    while (true) {
+      if (func()) {
+        ret = true;
+        break;
+      }
+
+      if (IsShutdown()) {
+        errno = ESHUTDOWN;
+        break;
+      }
+
+      if (need_wakeup_.load(std::memory_order_acquire)) {
+        interrupted = true;
+        break;
+      }
+
+      if (timeout == 0) {
+        cond->wait(lock);
+      } else if (cond->wait_until(lock, deadline) ==
+                 std::cv_status::timeout) {
+        ret = func();
+        if (ret == false) {
+          errno = ETIMEDOUT;
+        }
+        break;
+      }
+    }
+
+    waiters->fetch_sub(1, std::memory_order_relaxed);
+    waiter_number_--;
+    if (interrupted) {
+      /* if all waiters have been woken up */
+      if (waiter_number_ == 0) {
+        need_wakeup_.store(false, std::memory_order_release);
+      }
+      errno = EINTR;
+    }
+
+    return ret;
+  }
+
+  /**
+   * @brief Wake up parked waiters after queue state changed
+   * @param cond condition to notify
+   * @param waiters waiter counter of cond
+   * @param all notify all waiters, needed when waiters wait for different
+   * amount of space
+   */
+  void NotifyWaiters(std::condition_variable* cond, std::atomic<int>* waiters,
+                     bool all) {
+    /* pairs with the fence in WaitFor, no lost wakeup */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters->load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (all) {
+      cond->notify_all();
+    } else {
+      cond->notify_one();
+    }
+  }
+
+ private:
+  size_t PushAllForce(Sequence* elems) {
+    size_t push_num = 0;
+    for (auto it = elems->begin(); it != elems->end(); it++) {
+      auto push_func = [&]() { return !IsShutdown() && TryPush(*it, true); };
+      if (WaitFor(&not_full_, &not_full_waiters_, 0, push_func) == false) {
+        break;
+      }
+
+      push_num++;
+    }
+
+    elems->erase(elems->begin(), elems->begin() + push_num);
+    if (push_num > 0) {
+      NotifyWaiters(&not_empty_, &not_empty_waiters_, true);
+    }
+
+    return push_num;
+  }
+
+  size_t PopMany(Sequence* elems, int timeout, size_t maxsize) {
+    T elem;
+    if (Pop(&elem, timeout) == false) {
+      return 0;
+    }
+
+    size_t num = 1;
+    elems->emplace_back(std::move(elem));
+    while (num < maxsize && TryPop(&elem)) {
+      elems->emplace_back(std::move(elem));
+      num++;
+    }
+
+    if (num > 1) {
+      NotifyWaiters(&not_full_, &not_full_waiters_, true);
+    }
+
+    return num;
+  }
+
+  static inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+  struct RingCell {
+    std::atomic<size_t> seq;
+    T data;
+  };
+
+  static constexpr size_t kRingMinSize = 256;
+  static constexpr int kRingSpinCount = 128;
+  static constexpr size_t kCacheLineSize = 64;
+
+  size_t ring_size_{0};
+  size_t mask_{0};
+  std::unique_ptr<RingCell[]> cells_;
+  std::atomic<size_t> capacity_{0};
+  std::atomic<bool> shutdown_{false};
+  std::atomic<bool> need_wakeup_{false};
+  std::atomic<int> not_empty_waiters_{0};
+  std::atomic<int> not_full_waiters_{0};
+  int waiter_number_{0};
+  std::mutex mutex_;
+  /* push waiters wait for different space, always notify all of them */
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  /* keep head and tail on different cache lines */
+  char pad0_[kCacheLineSize];
+  std::atomic<size_t> head_{0};
+  char pad1_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail_{0};
+  char pad2_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
+template <typename T, typename Sequence>
+constexpr size_t RingBlockingQueue<T, Sequence>::kMaxRingSize;
+
 }  // namespace modelbox
 #endif
@@ -270,6 +270,12 @@ class DeviceFactory : public DriverFactory {
     return std::vector<std::string>();
   };
 
+  /**
+   * @brief Set configuration of this device type, called before CreateDevice
+   * @param config sub configuration under device.<type>
+   */
+  virtual void SetDeviceConfig(const std::shared_ptr<Configuration> &config){};
+
  private:
 };
 
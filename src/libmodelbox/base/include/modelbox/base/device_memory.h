@@ -38,6 +38,20 @@ inline bool IsMemAligned(uintptr_t addr, uintptr_t align) {
 
 enum class DeviceMemoryCopyKind { FromHost, ToHost, SameDeviceType };
 
+/**
+ * @brief Counters of DeviceMemory::Combine, accumulated process wide
+ */
+struct DeviceMemoryCombineStat {
+  /// combines served by the source block without copy
+  uint64_t continuous_count{0};
+  /// combines of one contiguous source copied in a single transfer
+  uint64_t bulk_copy_count{0};
+  /// combines that copied every fragment into a new block
+  uint64_t fragment_count{0};
+  /// bytes copied by fragment combines
+  uint64_t fragment_copy_bytes{0};
+};
+
 class Device;
 class DeviceMemoryManager;
 
@@ -132,6 +146,24 @@ class DeviceMemory : public std::enable_shared_from_this<DeviceMemory> {
    */
   inline bool IsHost() const { return is_host_mem_; }
 
+  /**
+   * @brief Get flags the memory created with
+   * @return memory flags
+   */
+  inline uint32_t GetMemFlags() const { return mem_flags_; }
+
+  /**
+   * @brief Check no other device memory refers to the same mem block
+   * @return Exclusive or not
+   */
+  inline bool IsExclusive() const { return device_mem_ptr_.use_count() == 1; }
+
+  /**
+   * @brief Check mem block is acquired from caller instead of allocated
+   * @return Acquired or not
+   */
+  inline bool IsAcquired() const { return is_acquired_; }
+
   /**
    * @brief Check memory on same device
    * @param dev_mem other device memory
@@ -169,6 +201,13 @@ class DeviceMemory : public std::enable_shared_from_this<DeviceMemory> {
       std::shared_ptr<Device> target_device = nullptr,
       uint32_t target_mem_flags = 0);
 
+  /**
+   * @brief Get combine counters, fragment_copy_bytes tells how much data
+   *  was copied because producers did not allocate a batch in one block
+   * @return snapshot of counters
+   */
+  static DeviceMemoryCombineStat GetCombineStat();
+
   /**
    * @brief Count mem total size
    * @param mem_list to count
@@ -294,6 +333,7 @@ class DeviceMemory : public std::enable_shared_from_this<DeviceMemory> {
   size_t capacity_{0};
   std::string memory_id_;
   bool is_content_mutable_{true};
+  bool is_acquired_{false};
   uint32_t mem_flags_{0};
 
   /**
@@ -371,7 +411,8 @@ class DeviceMemory : public std::enable_shared_from_this<DeviceMemory> {
 
   static std::shared_ptr<DeviceMemory> CombineContinuous(
       const std::vector<std::shared_ptr<DeviceMemory>> &mem_list,
-      size_t total_size, std::shared_ptr<Device> target_device);
+      size_t total_size, std::shared_ptr<Device> target_device,
+      uint32_t target_mem_flags);
 
   static std::shared_ptr<DeviceMemory> CombineFragment(
       const std::vector<std::shared_ptr<DeviceMemory>> &mem_list,
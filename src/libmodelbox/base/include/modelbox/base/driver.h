@@ -20,7 +20,10 @@
 #include <modelbox/base/configuration.h>
 #include <modelbox/base/status.h>
 
+#include <functional>
 #include <iostream>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -33,6 +36,10 @@ constexpr const char *DRIVER_CLASS_INFERENCE = "DRIVER-INFERENCE";
 constexpr const char *DRIVER_TYPE_VIRTUAL = "virtual";
 constexpr const char *DEFAULT_SCAN_INFO = "/tmp/modelbox-driver-info";
 constexpr const char *DEFAULT_LD_CACHE = "/etc/ld.so.cache";
+constexpr const char *DRIVER_FILE_FILTER = "libmodelbox-*.so*";
+constexpr int DRIVER_SCAN_INFO_VERSION = 2;
+constexpr size_t DRIVER_SCAN_MAX_PROCESS = 8;
+constexpr size_t DRIVER_SCAN_MIN_FILES_PER_PROCESS = 4;
 
 class Driver;
 class DriverFactory {
@@ -63,6 +70,7 @@ class DriverDesc {
   const bool GetNoDelete();
   const bool GetGlobal();
   const bool GetDeepBind();
+  const std::string GetScanInfo();
 
   void SetClass(const std::string &classname);
   void SetType(const std::string &type);
@@ -73,6 +81,7 @@ class DriverDesc {
   void SetNodelete(const bool &no_delete);
   void SetGlobal(const bool &global);
   void SetDeepBind(const bool &deep_bind);
+  void SetScanInfo(const std::string &scan_info);
 
  protected:
   bool driver_no_delete_;
@@ -84,6 +93,7 @@ class DriverDesc {
   std::string driver_description_;
   std::string driver_version_;
   std::string driver_file_path_;
+  std::string driver_scan_info_;
 
  private:
   Status CheckVersion(const std::string &version);
@@ -193,6 +203,14 @@ class DriversScanResultInfo {
   std::list<std::string> load_success_info_;
   std::map<std::string, std::string> load_failed_info_;
 };
+/**
+ * @brief Collect extra info of a driver in scan process, the info is saved in
+ * scan info cache, and can be got by DriverDesc::GetScanInfo without loading
+ * the driver.
+ */
+using DriverScanInfoCollector =
+    std::function<Status(std::shared_ptr<Driver> driver, std::string *info)>;
+
 class Drivers {
  public:
   Drivers()
@@ -219,12 +237,30 @@ class Drivers {
                                     const std::string &driver_version = "");
   static std::shared_ptr<Drivers> GetInstance();
 
+  /**
+   * @brief Register scan info collector for driver class
+   * @param driver_class driver class
+   * @param collector collector called for each driver of the class in scan
+   */
+  static void RegisterScanInfoCollector(const std::string &driver_class,
+                                        DriverScanInfoCollector collector);
+
  private:
-  Status InnerScan();
-  Status WriteScanInfo(const std::string &scan_info_path,
+  Status ListDriverFiles(const std::string &path, const std::string &filter,
+                         std::vector<std::string> *driver_files,
+                         int64_t *check_sum);
+  Status ListDriverFiles(std::vector<std::string> *driver_files,
+                         int64_t *check_sum);
+  Status ParallelScan(const std::vector<std::string> &driver_files,
+                      const std::string &check_code);
+  Status InnerScan(const std::vector<std::string> &driver_files,
+                   const std::string &scan_info_path, bool collect_info);
+  void CollectScanInfo(std::shared_ptr<Driver> driver);
+  Status WriteScanInfo(const std::string &scan_info_path);
+  Status MergeScanInfo(const std::vector<std::string> &part_paths,
                        const std::string &check_code);
   Status GatherScanInfo(const std::string &scan_path);
-  void FillCheckInfo(std::string &file_check_node,
+  bool FillCheckInfo(std::string &file_check_node,
                      std::unordered_map<std::string, bool> &file_map,
                      int64_t &ld_cache_time);
   bool CheckPathAndMagicCode();
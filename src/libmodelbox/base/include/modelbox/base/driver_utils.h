@@ -25,11 +25,11 @@
 
 namespace modelbox {
 /**
- * @brief fork a process to Run func
- * @return func result
+ * @brief fork a process to run func, not wait for it
+ * @return pid of subprocess, -1 when fork failed
  */
 template <typename func, typename... ts>
-Status SubProcessRun(func &&fun, ts &&...params) {
+pid_t SubProcessStart(func &&fun, ts &&...params) {
   auto pid = fork();
   if (pid == 0) {
     Status ret = fun(params...);
@@ -42,31 +42,31 @@ Status SubProcessRun(func &&fun, ts &&...params) {
 
   if (pid == -1) {
     MBLOG_ERROR << "fork subprocess failed";
-    return STATUS_FAULT;
   }
 
-  MBLOG_INFO << "wait for subprocess " << pid << " process finished";
-  int status;
-  auto ret = waitpid(pid, &status, 0);
-  if (ret < 0) {
-    auto err_msg =
-        "subprocess run failed, wait error, ret:" + std::to_string(errno) +
-        ", msg: " + strerror(errno);
-    MBLOG_ERROR << err_msg;
-    return {STATUS_FAULT, err_msg};
-  }
+  return pid;
+}
+
+/**
+ * @brief wait for subprocess started by SubProcessStart
+ * @param pid pid of subprocess
+ * @return wait result
+ */
+Status SubProcessWait(pid_t pid);
 
-  if (WIFSIGNALED(status)) {
-    auto err_msg = "killed by signal " + WTERMSIG(status);
-    MBLOG_ERROR << err_msg;
-    return {STATUS_FAULT, err_msg};
-  } else if(WIFSTOPPED(status)) {
-    auto err_msg = "stopped by signal " + WSTOPSIG(status);
-    MBLOG_ERROR << err_msg;
-    return {STATUS_FAULT, err_msg};
+/**
+ * @brief fork a process to Run func
+ * @return func result
+ */
+template <typename func, typename... ts>
+Status SubProcessRun(func &&fun, ts &&...params) {
+  auto pid = SubProcessStart(fun, params...);
+  if (pid == -1) {
+    return STATUS_FAULT;
   }
 
-  return STATUS_OK;
+  MBLOG_INFO << "wait for subprocess " << pid << " process finished";
+  return SubProcessWait(pid);
 };
 
 /**
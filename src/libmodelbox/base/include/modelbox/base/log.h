@@ -17,13 +17,18 @@
 #ifndef MODELBOX_LOG_H_
 #define MODELBOX_LOG_H_
 
+#include <modelbox/base/blocking_queue.h>
 #include <modelbox/base/utils.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 
 namespace modelbox {
 
@@ -88,6 +93,11 @@ class Logger {
    * @return level log level
    */
   virtual LogLevel GetLogLevel() = 0;
+
+  /**
+   * @brief Flush buffered logs to output
+   */
+  virtual void Flush();
 };
 
 using LoggerVprint =
@@ -198,11 +208,135 @@ class LoggerConsole : public Logger {
    */
   LogLevel GetLogLevel();
 
+  /**
+   * @brief Flush stdout
+   */
+  void Flush();
+
  private:
   void SetLogLevelFromEnv();
   LogLevel level_ = LOG_OFF;
 };
 
+constexpr size_t DEFAULT_LOG_ASYNC_QUEUE_SIZE = 8192;
+constexpr uint32_t DEFAULT_LOG_RATE_LIMIT = 100;
+
+struct LogRecord;
+struct LogSiteState;
+
+/**
+ * @brief Asynchronous logger, format log in caller thread and write to
+ * backend logger in background thread. Logs from the same call site are
+ * rate limited and optionally deduplicated, fatal logs are written
+ * synchronously.
+ */
+class LoggerAsync : public Logger {
+ public:
+  /**
+   * @brief Create async logger
+   * @param backend logger to write logs, Print of backend will be called
+   * @param queue_size max logs waiting for writing, not larger than
+   * RingBlockingQueue::kMaxRingSize
+   */
+  explicit LoggerAsync(std::shared_ptr<Logger> backend,
+                       size_t queue_size = DEFAULT_LOG_ASYNC_QUEUE_SIZE);
+  virtual ~LoggerAsync();
+
+  /**
+   * @brief Output log with va-arg
+   * @param level log level
+   * @param file log file
+   * @param lineno log file line number
+   * @param func log function
+   * @param format log format
+   * @param ap va_list
+   */
+  void Vprint(LogLevel level, const char *file, int lineno, const char *func,
+              const char *format, va_list ap) override;
+
+  /**
+   * @brief Output log
+   * @param level log level
+   * @param file log file
+   * @param lineno log file line number
+   * @param func log function
+   * @param msg log message
+   */
+  void Print(LogLevel level, const char *file, int lineno, const char *func,
+             const char *msg) override;
+
+  /**
+   * @brief Set log level of backend
+   * @param level log level
+   */
+  void SetLogLevel(LogLevel level) override;
+
+  /**
+   * @brief Get log level of backend
+   * @return level log level
+   */
+  LogLevel GetLogLevel() override;
+
+  /**
+   * @brief Wait until queued logs are written to backend
+   */
+  void Flush() override;
+
+  /**
+   * @brief Set max logs of each call site in one second
+   * @param limit max logs, 0 means no limit
+   */
+  void SetRateLimit(uint32_t limit);
+
+  /**
+   * @brief Suppress same message repeated from one call site in one second
+   * @param enable enable or disable, disabled by default
+   */
+  void SetDedup(bool enable);
+
+  /**
+   * @brief Get number of logs dropped because queue is full
+   * @return drop count
+   */
+  uint64_t GetDropCount();
+
+  /**
+   * @brief Get number of logs suppressed by rate limit or dedup
+   * @return suppress count
+   */
+  uint64_t GetSuppressCount();
+
+  /**
+   * @brief Get backend logger
+   * @return backend logger
+   */
+  std::shared_ptr<Logger> GetBackend();
+
+ private:
+  bool CheckRateLimit(LogLevel level, const char *file, int lineno,
+                      LogSiteState **site);
+  bool CheckDedup(LogSiteState *site, const char *msg);
+  void Enqueue(LogLevel level, const char *file, int lineno, const char *func,
+               const char *msg);
+  void WriteLogs();
+  void WriteLoop();
+
+  std::shared_ptr<Logger> backend_;
+  std::unique_ptr<RingBlockingQueue<LogRecord>> queue_;
+  std::unique_ptr<LogSiteState[]> sites_;
+  std::atomic<uint32_t> rate_limit_{DEFAULT_LOG_RATE_LIMIT};
+  std::atomic<bool> dedup_{false};
+  std::atomic<uint64_t> drop_count_{0};
+  std::atomic<uint64_t> suppress_count_{0};
+  uint64_t reported_drop_count_{0};
+
+  std::mutex write_lock_;
+  std::mutex wait_lock_;
+  std::condition_variable cond_;
+  std::atomic<bool> running_{true};
+  std::thread writer_;
+};
+
 class Log {
   using Stream = std::ostringstream;
   using Buffer_p = std::unique_ptr<Stream, std::function<void(Stream *)>>;
@@ -65,6 +65,18 @@ class MemoryPoolBase : public MemoryAllocFree,
    */
   uint32_t GetAllActiveObjectNum();
 
+  /**
+   * @brief Get all allocations served by per thread magazines
+   * @return return total magazine hit number
+   */
+  uint64_t GetAllMagazineHitNum();
+
+  /**
+   * @brief Get all allocations refilled from shared slab lists
+   * @return return total magazine miss number
+   */
+  uint64_t GetAllMagazineMissNum();
+
   /**
    * @brief Destroy slab cache.
    */
@@ -10,8 +10,10 @@
 #include <modelbox/base/timer.h>
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
 #include <vector>
 
@@ -26,8 +28,29 @@ struct SlabObject {
   unsigned long index;
 };
 
+class Slab;
 class SlabCache;
 
+/**
+ * @brief Per thread group object magazine in front of slab cache
+ */
+struct SlabMagazine {
+  /// lock, only contended by threads sharing the same magazine
+  std::mutex lock;
+
+  /// cached objects
+  std::vector<std::pair<void *, Slab *>> objs;
+
+  /// objects served from magazine
+  uint64_t hit{0};
+
+  /// objects refilled from shared slab list
+  uint64_t miss{0};
+
+  /// last time object returned to magazine
+  time_t last_free{0};
+};
+
 /// Memeory allocator interface
 class MemoryAllocFree {
  public:
@@ -176,6 +199,35 @@ class SlabCache {
    */
   std::shared_ptr<void> AllocSharedPtr();
 
+  /**
+   * @brief Alloc a raw object from slab, release with FreeObject
+   * @param obj object allocated
+   * @param slab which slab
+   */
+  void AllocObject(void **obj, Slab **slab);
+
+  /**
+   * @brief Free a object into slab
+   * @param obj object allocated
+   * @param slab which slab
+   */
+  void FreeObject(void *obj, Slab *slab);
+
+  /**
+   * @brief Enable magazines, must be called before first alloc. Threads are
+   * spread over magazines, each magazine is locked and shared by its threads.
+   * @param magazine_num magazine number, 0 for cpu number.
+   * @param capacity objects per magazine, 0 for auto by object size.
+   */
+  void EnableMagazine(uint32_t magazine_num = 0, uint32_t capacity = 0);
+
+  /**
+   * @brief Return objects in magazines to slabs.
+   * @param before only drain magazines no object returned to for seconds,
+   * 0 for all magazines.
+   */
+  void DrainMagazine(time_t before = 0);
+
   /**
    * @brief Shrink slab
    * @param keep number to keep.
@@ -225,6 +277,24 @@ class SlabCache {
    */
   uint32_t GetActiveObjNumber();
 
+  /**
+   * @brief Get number of allocations served by magazines.
+   * @return magazine hit number.
+   */
+  uint64_t GetMagazineHitNumber();
+
+  /**
+   * @brief Get number of allocations refilled from slabs.
+   * @return magazine miss number.
+   */
+  uint64_t GetMagazineMissNumber();
+
+  /**
+   * @brief Get number of free objects cached in magazines.
+   * @return cached object number.
+   */
+  uint32_t GetMagazineObjNumber();
+
  protected:
   /**
    * @brief Remove slabs
@@ -270,18 +340,39 @@ class SlabCache {
   friend class Slab;
 
   /**
-   * @brief Alloc a object from slab
+   * @brief Alloc a object from slab lists, lock_ must be held
+   * @param lock lock of slab lists
    * @param obj object allocated
    * @param slab which slab
    */
-  void AllocObject(void **obj, Slab **slab);
+  void AllocObjectLocked(std::unique_lock<std::mutex> *lock, void **obj,
+                         Slab **slab);
 
   /**
-   * @brief Free a object into slab
-   * @param obj object allocated
+   * @brief Free a object into slab lists, lock_ must be held
+   * @param obj object to free
    * @param slab which slab
    */
-  void FreeObject(void *obj, Slab *slab);
+  void FreeObjectLocked(void *obj, Slab *slab);
+
+  /**
+   * @brief Get magazine of current thread
+   * @return magazine
+   */
+  SlabMagazine *CurrentMagazine();
+
+  /**
+   * @brief Refill magazine from slab lists in batch, magazine lock held
+   * @param mag magazine to refill
+   */
+  void RefillMagazine(SlabMagazine *mag);
+
+  /**
+   * @brief Flush objects of magazine to slab lists, magazine lock held
+   * @param mag magazine to flush
+   * @param keep number of objects keep in magazine
+   */
+  void FlushMagazine(SlabMagazine *mag, size_t keep);
 
   size_t obj_size_{0};
   size_t slab_size_{0};
@@ -294,6 +385,9 @@ class SlabCache {
 
   std::mutex lock_;
 
+  std::vector<std::unique_ptr<SlabMagazine>> magazines_;
+  uint32_t magazine_capacity_{0};
+
   ListHead full_;
   ListHead partial_;
   ListHead empty_;
@@ -325,5 +419,74 @@ class SlabCacheReclaimer {
   std::atomic<uint32_t> slab_cache_num_;
 };
 
+/**
+ * @brief Allocator backed by a per type slab cache, for std::allocate_shared.
+ * Object and shared_ptr control block are allocated together from slab.
+ */
+template <typename T>
+class SlabObjectAllocator {
+ public:
+  using value_type = T;
+
+  SlabObjectAllocator() = default;
+
+  template <typename U>
+  SlabObjectAllocator(const SlabObjectAllocator<U> &other) {}
+
+  T *allocate(size_t n) {
+    if (n != 1) {
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void *obj = nullptr;
+    Slab *slab = nullptr;
+    GetCache()->AllocObject(&obj, &slab);
+    if (obj == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    *static_cast<Slab **>(obj) = slab;
+    return reinterpret_cast<T *>(static_cast<char *>(obj) + kHeaderSize);
+  }
+
+  void deallocate(T *ptr, size_t n) {
+    if (n != 1) {
+      ::operator delete(ptr);
+      return;
+    }
+
+    void *obj = reinterpret_cast<char *>(ptr) - kHeaderSize;
+    GetCache()->FreeObject(obj, *static_cast<Slab **>(obj));
+  }
+
+  template <typename U>
+  bool operator==(const SlabObjectAllocator<U> &other) const {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const SlabObjectAllocator<U> &other) const {
+    return false;
+  }
+
+ private:
+  static constexpr size_t kAlign = alignof(std::max_align_t);
+  static constexpr size_t kHeaderSize =
+      (sizeof(Slab *) + kAlign - 1) / kAlign * kAlign;
+  static constexpr size_t kObjectSize =
+      (kHeaderSize + sizeof(T) + kAlign - 1) / kAlign * kAlign;
+  static constexpr size_t kSlabSize = 256 * 1024;
+
+  static SlabCache *GetCache() {
+    // never freed, objects may be released during static destruction
+    static SlabCache *cache = []() {
+      auto *cache = new SlabCache(kObjectSize, kSlabSize);
+      cache->EnableMagazine();
+      return cache;
+    }();
+    return cache;
+  }
+};
+
 }  // namespace modelbox
 #endif
\ No newline at end of file
@@ -25,6 +25,7 @@
 #include <unistd.h>
 
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <map>
@@ -40,6 +41,44 @@ struct ThreadFunction {
   std::function<void()> func;
 };
 
+/**
+ * @brief Task queue of thread pool, mutex-based or lock-free ring.
+ */
+class ThreadTaskQueue {
+ public:
+  /**
+   * @brief Create task queue
+   * @param capacity queue capacity.
+   * @param lockfree use lock-free ring, fall back to mutex-based queue when
+   * ring can not hold capacity.
+   */
+  ThreadTaskQueue(size_t capacity, bool lockfree);
+
+  virtual ~ThreadTaskQueue();
+
+  bool Push(const ThreadFunction &task, int timeout);
+
+  bool Pop(ThreadFunction *task, int timeout);
+
+  bool Full();
+
+  size_t Size();
+
+  size_t GetCapacity();
+
+  void SetCapacity(size_t capacity);
+
+  void Wakeup();
+
+  void Shutdown();
+
+  bool IsLockFree();
+
+ private:
+  std::shared_ptr<BlockingQueue<ThreadFunction>> queue_;
+  std::shared_ptr<RingBlockingQueue<ThreadFunction>> ring_;
+};
+
 class ThreadPool;
 class ThreadWorker {
  public:
@@ -93,6 +132,14 @@ class ThreadWorker {
   void ChangeNameNow();
 
   void SetCore(bool is_core);
+
+  void PushLocal(const ThreadFunction &task);
+
+  bool PopLocal(ThreadFunction *task);
+
+  bool StealLocal(ThreadFunction *task);
+
+  size_t LocalSize();
  private:
   std::atomic<bool> running_{false};
   std::mutex lock_;
@@ -103,6 +150,8 @@ class ThreadWorker {
   bool is_core_worker_;
   std::string name_;
   std::atomic<bool> name_changed_{false};
+  std::mutex local_lock_;
+  std::deque<ThreadFunction> local_queue_;
 };
 
 class ThreadPool {
@@ -114,9 +163,12 @@ class ThreadPool {
    * be created.
    * @param queue_size task queue size, default equal thread size.
    * @param keep_alive non core thread keep alive time, minimum time is 100ms.
+   * @param lockfree_queue use lock-free ring as task queue, ignored when
+   * queue_size is larger than RingBlockingQueue::kMaxRingSize.
    */
   ThreadPool(int thread_size = -1, int max_thread_size = -1,
-             int queue_size = -1, int keep_alive = 60000);
+             int queue_size = -1, int keep_alive = 60000,
+             bool lockfree_queue = false);
 
   virtual ~ThreadPool();
 
@@ -145,6 +197,15 @@ class ThreadPool {
    */
   void SetTaskQueueSize(size_t size);
 
+  /**
+   * @brief Enable work stealing, each worker owns a local task queue, tasks
+   * submitted from a worker thread go to its local queue when some worker is
+   * idle to steal them, otherwise to the shared queue. Must be called before
+   * submitting tasks.
+   * @param pin_cpu pin core workers to cpu by worker id.
+   */
+  void EnableWorkStealing(bool pin_cpu = false);
+
   /**
    * @brief Change none core thread keep alive time.
    * @param timeout
@@ -200,6 +261,17 @@ class ThreadPool {
     return result;
   }
 
+  /**
+   * @brief Run func for index 0 to count - 1 and wait for all of them. Index 0
+   * runs on current thread, others are submitted to pool, and run on current
+   * thread when submit failed.
+   * @param count task number.
+   * @param func task function, called with task index.
+   * @return first failed status in index order, exception of a task is
+   * returned as STATUS_FAULT.
+   */
+  Status ParallelFor(size_t count, const std::function<Status(size_t)> &func);
+
   /**
    * @brief Get running thread number.
    * @return thread number.
@@ -234,8 +306,16 @@ class ThreadPool {
 
   bool SubmitTask(ThreadFunction &task);
 
+  bool SubmitLocalTask(ThreadFunction &task);
+
+  bool StealTask(ThreadWorker *worker, ThreadFunction &task);
+
+  void PinWorker(ThreadWorker *worker);
+
+  void UpdateStealVictims();
+
  private:
-  std::shared_ptr<BlockingQueue<ThreadFunction>> work_queue_;
+  std::shared_ptr<ThreadTaskQueue> work_queue_;
   bool quit_{false};
   std::vector<std::shared_ptr<ThreadWorker>> workers_;
   int thread_size_{0};
@@ -243,6 +323,10 @@ class ThreadPool {
   int keep_alive_{60000};
   std::atomic<int> worker_num_{0};
   std::atomic<int> available_num_{0};
+  bool work_stealing_{false};
+  bool pin_cpu_{false};
+  std::atomic<uint32_t> steal_index_{0};
+  std::shared_ptr<std::vector<std::shared_ptr<ThreadWorker>>> steal_victims_;
   std::mutex lock_;
   std::condition_variable exit_cond_;
   std::string name_;
@@ -18,19 +18,20 @@
 #ifndef MODELBOX_TIMER_H_
 #define MODELBOX_TIMER_H_
 
+#include <modelbox/base/thread_pool.h>
+
 #include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace modelbox {
 
 using TimerTaskFunction = std::function<void()>;
 class Timer;
-class TimerCompare;
 
 static inline uint64_t GetTickDiff(uint64_t prev, uint64_t cur) {
   return ((prev) >= (cur)) ? ((prev) - (cur))
@@ -126,7 +127,6 @@ class TimerTask : public std::enable_shared_from_this<TimerTask> {
 
  private:
   friend class Timer;
-  friend class TimerCompare;
 
   bool IsWeakPtrTimerTask();
   std::shared_ptr<TimerTask> MakeSchedWeakTimer();
@@ -147,23 +147,9 @@ class TimerTask : public std::enable_shared_from_this<TimerTask> {
   std::weak_ptr<TimerTask> weak_timer_;
 };
 
-class TimerCompare {
- public:
-  bool operator()(std::shared_ptr<TimerTask> lhs,
-                  std::shared_ptr<TimerTask> rhs) {
-    auto hit_time_lhs = lhs->GetHitTime();
-    auto hit_time_rhs = rhs->GetHitTime();
-    if (hit_time_lhs == hit_time_rhs) {
-      return lhs->GetDelay() + lhs->GetPeriod() >
-             rhs->GetDelay() + rhs->GetPeriod();
-    }
-
-    return hit_time_lhs > hit_time_rhs;
-  }
-};
-
 /**
- * @brief Timer thread.
+ * @brief Timer thread, tasks are kept in a hierarchical timing wheel with
+ * millisecond tick, insert and cancel are O(1).
  */
 class Timer {
  public:
@@ -181,6 +167,13 @@ class Timer {
    */
   void Shutdown();
 
+  /**
+   * @brief Run timer task callbacks in executor instead of timer thread,
+   * periodic task will be rescheduled after its callback returns.
+   * @param executor thread pool, nullptr to run in timer thread.
+   */
+  void SetExecutor(std::shared_ptr<ThreadPool> executor);
+
   /**
    * @brief Set timer name
    */
@@ -198,7 +191,9 @@ class Timer {
   virtual void Run();
 
   /**
-   * @brief Stop main timer
+   * @brief Stop main timer, wait for running callbacks. When called from a
+   * callback of this timer, return without waiting, other callbacks may
+   * still be finishing.
    */
   void Stop();
 
@@ -216,7 +211,7 @@ class Timer {
    * @brief Get current tick
    * @return tick count
    */
-  uint64_t GetCurrentTick();
+  virtual uint64_t GetCurrentTick();
 
   /**
    * @brief Get current timer task
@@ -229,6 +224,12 @@ class Timer {
    */
   void RunTimer();
 
+  /**
+   * @brief Run timer tasks expired at tick
+   * @param now current tick
+   */
+  void RunExpiredTimer(uint64_t now);
+
   /**
    * @brief Start main thread async
    */
@@ -241,6 +242,8 @@ class Timer {
 
  private:
   friend class TimerTask;
+  using TimerWheelSlot = std::vector<std::shared_ptr<TimerTask>>;
+
   void RunTimerTask(std::shared_ptr<TimerTask> timer,
                     std::shared_ptr<TimerTask> timer_call);
 
@@ -248,19 +251,26 @@ class Timer {
 
   void InsertTimerTask(std::shared_ptr<TimerTask> timer_task, uint64_t now);
 
-  void RemoveTopTimerTask();
+  void AddWheelTask(std::shared_ptr<TimerTask> timer_task);
+
+  void CascadeWheelTask();
+
+  void ExpireTimerTask(uint64_t now,
+                       std::vector<std::shared_ptr<TimerTask>> *expired);
+
+  uint64_t NextExpireTick();
 
-  void StopTimerTask(TimerTask *timer_task);
+  void RemoveStoppedTimer();
 
-  void WaitTimerTask(std::unique_lock<std::mutex> &lock,
-                     std::shared_ptr<TimerTask> &timer);
+  bool WaitTimerTask(std::unique_lock<std::mutex> &lock);
 
-  bool GetTimerTask(std::unique_lock<std::mutex> &lock,
-                    std::shared_ptr<TimerTask> &timer);
+  void DispatchTimerTask(std::shared_ptr<TimerTask> timer,
+                         std::shared_ptr<ThreadPool> executor);
 
-  bool RemoveStoppedTimer();
+  void FinishTimerTask(std::shared_ptr<TimerTask> timer);
 
   thread_local static std::shared_ptr<TimerTask> current_timer_task_;
+  thread_local static Timer *current_timer_;
   bool is_shutdown_{false};
   uint64_t start_tick_{0};
   std::mutex lock_;
@@ -269,9 +279,14 @@ class Timer {
   bool thread_running_{false};
   std::string name_{"Timer"};
   std::condition_variable cond_;
-  std::priority_queue<std::shared_ptr<TimerTask>,
-                      std::vector<std::shared_ptr<TimerTask>>, TimerCompare>
-      timer_queue_;
+  std::shared_ptr<ThreadPool> executor_;
+
+  std::vector<std::vector<TimerWheelSlot>> wheel_;
+  std::vector<size_t> wheel_task_num_;
+  uint64_t wheel_tick_{0};
+  uint64_t next_tick_{0};
+  size_t timer_num_{0};
+  size_t running_num_{0};
 };
 
 /**
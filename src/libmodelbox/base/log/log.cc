@@ -33,6 +33,13 @@
 namespace modelbox {
 
 constexpr int LOG_BUFF_SIZE = 4096;
+constexpr int LOG_SUMMARY_BUFF_SIZE = 128;
+constexpr int LOG_ASYNC_FLUSH_INTERVAL = 20;
+constexpr size_t LOG_ASYNC_NOTIFY_MASK = 63;
+constexpr size_t LOG_SITE_TABLE_SIZE = 1024;
+constexpr size_t LOG_SITE_TABLE_WAYS = 4;
+constexpr uint64_t LOG_RATE_WINDOW_MS = 1000;
+constexpr uint64_t LOG_HASH_SEED = 14695981039346656037ULL;
 
 Log klogger;
 std::shared_ptr<LoggerCallback> kloggercallback =
@@ -110,6 +117,8 @@ void Logger::Print(LogLevel level, const char *file, int lineno,
 
 void Logger::SetLogLevel(LogLevel level) { UNUSED_VAR(level); };
 
+void Logger::Flush(){};
+
 LoggerCallback::LoggerCallback() : level_(LOG_DEBUG){};
 
 LoggerCallback::~LoggerCallback(){};
@@ -213,6 +222,269 @@ void LoggerConsole::SetLogLevel(LogLevel level) { level_ = level; }
 
 LogLevel LoggerConsole::GetLogLevel() { return level_; }
 
+void LoggerConsole::Flush() { fflush(stdout); }
+
+struct LogRecord {
+  LogLevel level{LOG_INFO};
+  int lineno{0};
+  std::string file;
+  std::string func;
+  std::string msg;
+};
+
+struct LogSiteState {
+  std::atomic<uint64_t> key{0};
+  std::atomic<uint64_t> window{0};
+  std::atomic<uint32_t> count{0};
+  std::atomic<uint32_t> suppressed{0};
+  std::atomic<uint64_t> last_hash{0};
+};
+
+static inline uint64_t LogHash(const char *str, uint64_t hash) {
+  constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+  for (; str != nullptr && *str != '\0'; str++) {
+    hash ^= (unsigned char)*str;
+    hash *= FNV_PRIME;
+  }
+
+  return hash;
+}
+
+static inline uint64_t LogNowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+LoggerAsync::LoggerAsync(std::shared_ptr<Logger> backend, size_t queue_size)
+    : backend_(std::move(backend)),
+      queue_(new RingBlockingQueue<LogRecord>(queue_size)),
+      sites_(new LogSiteState[LOG_SITE_TABLE_SIZE]) {
+  if (backend_ == nullptr) {
+    backend_ = std::make_shared<LoggerConsole>();
+  }
+
+  writer_ = std::thread(&LoggerAsync::WriteLoop, this);
+}
+
+LoggerAsync::~LoggerAsync() {
+  running_ = false;
+  {
+    std::unique_lock<std::mutex> lock(wait_lock_);
+    cond_.notify_all();
+  }
+
+  if (writer_.joinable()) {
+    writer_.join();
+  }
+
+  Flush();
+}
+
+bool LoggerAsync::CheckRateLimit(LogLevel level, const char *file, int lineno,
+                                 LogSiteState **site) {
+  *site = nullptr;
+  auto limit = rate_limit_.load(std::memory_order_relaxed);
+  if (level >= LOG_FATAL || (limit == 0 && dedup_ == false)) {
+    return true;
+  }
+
+  // call site is file and line, state table is set associative, a site
+  // keeps its slot once claimed. When all slots of a set are taken, logs of
+  // the new site are not limited.
+  auto key = LogHash(file, LOG_HASH_SEED) ^ (uint64_t)lineno;
+  key = key == 0 ? 1 : key;
+  auto set = key & (LOG_SITE_TABLE_SIZE / LOG_SITE_TABLE_WAYS - 1);
+  LogSiteState *state = nullptr;
+  for (size_t i = 0; i < LOG_SITE_TABLE_WAYS; i++) {
+    auto *way = &sites_[set * LOG_SITE_TABLE_WAYS + i];
+    uint64_t way_key = way->key.load(std::memory_order_relaxed);
+    if (way_key == 0 && way->key.compare_exchange_strong(way_key, key)) {
+      state = way;
+      break;
+    }
+
+    if (way_key == key) {
+      state = way;
+      break;
+    }
+  }
+
+  if (state == nullptr) {
+    return true;
+  }
+
+  auto now = LogNowMs();
+  *site = state;
+  auto window = state->window.load(std::memory_order_relaxed);
+  if (now - window >= LOG_RATE_WINDOW_MS &&
+      state->window.compare_exchange_strong(window, now)) {
+    state->count.store(0, std::memory_order_relaxed);
+    state->last_hash.store(0, std::memory_order_relaxed);
+    auto suppressed = state->suppressed.exchange(0);
+    if (suppressed > 0) {
+      char msg[LOG_SUMMARY_BUFF_SIZE];
+      auto ret = snprintf_s(msg, sizeof(msg), sizeof(msg) - 1,
+                            "%u logs from this call site suppressed",
+                            suppressed);
+      if (ret > 0) {
+        Enqueue(level, file, lineno, "", msg);
+      }
+    }
+  }
+
+  if (limit > 0 && state->count.fetch_add(1, std::memory_order_relaxed) >=
+                       limit) {
+    state->suppressed++;
+    suppress_count_++;
+    return false;
+  }
+
+  return true;
+}
+
+bool LoggerAsync::CheckDedup(LogSiteState *site, const char *msg) {
+  if (site == nullptr || dedup_ == false) {
+    return true;
+  }
+
+  auto hash = LogHash(msg, LOG_HASH_SEED);
+  if (site->last_hash.exchange(hash, std::memory_order_relaxed) != hash) {
+    return true;
+  }
+
+  site->suppressed++;
+  suppress_count_++;
+  return false;
+}
+
+void LoggerAsync::Vprint(LogLevel level, const char *file, int lineno,
+                         const char *func, const char *format, va_list ap) {
+  LogSiteState *site = nullptr;
+  if (CheckRateLimit(level, file, lineno, &site) == false) {
+    return;
+  }
+
+  // format in per thread buffer, long message is truncated.
+  thread_local char buff[LOG_BUFF_SIZE];
+  auto ret = vsnprintf_s(buff, sizeof(buff), sizeof(buff) - 1, format, ap);
+  if (ret < 0) {
+    buff[LOG_BUFF_SIZE - 1] = '\0';
+  }
+
+  if (CheckDedup(site, buff) == false) {
+    return;
+  }
+
+  Enqueue(level, file, lineno, func, buff);
+}
+
+void LoggerAsync::Print(LogLevel level, const char *file, int lineno,
+                        const char *func, const char *msg) {
+  LogSiteState *site = nullptr;
+  if (CheckRateLimit(level, file, lineno, &site) == false) {
+    return;
+  }
+
+  if (CheckDedup(site, msg) == false) {
+    return;
+  }
+
+  Enqueue(level, file, lineno, func, msg);
+}
+
+void LoggerAsync::Enqueue(LogLevel level, const char *file, int lineno,
+                          const char *func, const char *msg) {
+  if (level >= LOG_FATAL) {
+    // process may exit soon, write all logs now.
+    std::unique_lock<std::mutex> lock(write_lock_);
+    WriteLogs();
+    backend_->Print(level, file, lineno, func, msg);
+    backend_->Flush();
+    return;
+  }
+
+  // reuse string buffers of the record in caller thread
+  thread_local LogRecord record;
+  record.level = level;
+  record.lineno = lineno;
+  record.file.assign(file == nullptr ? "" : file);
+  record.func.assign(func == nullptr ? "" : func);
+  record.msg.assign(msg);
+  if (queue_->Push(record, -1) == false) {
+    drop_count_++;
+    return;
+  }
+
+  if ((queue_->Size() & LOG_ASYNC_NOTIFY_MASK) == 0) {
+    cond_.notify_one();
+  }
+}
+
+void LoggerAsync::WriteLogs() {
+  LogRecord record;
+  size_t count = 0;
+
+  while (queue_->Poll(&record)) {
+    backend_->Print(record.level, record.file.c_str(), record.lineno,
+                    record.func.c_str(), record.msg.c_str());
+    count++;
+  }
+
+  auto drop_count = drop_count_.load();
+  if (drop_count != reported_drop_count_) {
+    char msg[LOG_SUMMARY_BUFF_SIZE];
+    auto ret = snprintf_s(msg, sizeof(msg), sizeof(msg) - 1,
+                          "%lu logs dropped, log queue is full",
+                          (unsigned long)(drop_count - reported_drop_count_));
+    if (ret > 0) {
+      backend_->Print(LOG_WARN, BASE_FILE_NAME, __LINE__, __func__, msg);
+      count++;
+    }
+    reported_drop_count_ = drop_count;
+  }
+
+  if (count > 0) {
+    backend_->Flush();
+  }
+}
+
+void LoggerAsync::WriteLoop() {
+  while (running_) {
+    {
+      std::unique_lock<std::mutex> lock(wait_lock_);
+      if (running_ == false) {
+        break;
+      }
+
+      cond_.wait_for(lock,
+                     std::chrono::milliseconds(LOG_ASYNC_FLUSH_INTERVAL));
+    }
+
+    std::unique_lock<std::mutex> lock(write_lock_);
+    WriteLogs();
+  }
+}
+
+void LoggerAsync::Flush() {
+  std::unique_lock<std::mutex> lock(write_lock_);
+  WriteLogs();
+}
+
+void LoggerAsync::SetLogLevel(LogLevel level) { backend_->SetLogLevel(level); }
+
+LogLevel LoggerAsync::GetLogLevel() { return backend_->GetLogLevel(); }
+
+void LoggerAsync::SetRateLimit(uint32_t limit) { rate_limit_ = limit; }
+
+void LoggerAsync::SetDedup(bool enable) { dedup_ = enable; }
+
+uint64_t LoggerAsync::GetDropCount() { return drop_count_; }
+
+uint64_t LoggerAsync::GetSuppressCount() { return suppress_count_; }
+
+std::shared_ptr<Logger> LoggerAsync::GetBackend() { return backend_; }
+
 Log::Log() {}
 
 Log::~Log() {}
@@ -101,6 +101,24 @@ uint32_t MemoryPoolBase::GetAllActiveObjectNum() {
   return total_number;
 }
 
+uint64_t MemoryPoolBase::GetAllMagazineHitNum() {
+  uint64_t total_number = 0;
+  for (auto &cache : slab_caches_) {
+    total_number += cache->GetMagazineHitNumber();
+  }
+
+  return total_number;
+}
+
+uint64_t MemoryPoolBase::GetAllMagazineMissNum() {
+  uint64_t total_number = 0;
+  for (auto &cache : slab_caches_) {
+    total_number += cache->GetMagazineMissNumber();
+  }
+
+  return total_number;
+}
+
 std::vector<std::shared_ptr<SlabCache>> MemoryPoolBase::GetSlabCaches() {
   return slab_caches_;
 }
@@ -122,7 +140,9 @@ Collector<MemoryPoolBase> *MemoryPoolBase::GetInstance() {
 
 std::shared_ptr<SlabCache> MemoryPoolBase::MakeSlabCache(size_t obj_size,
                                                          size_t slab_size) {
-  return std::make_shared<SlabCache>(obj_size, slab_size, this);
+  auto slab_cache = std::make_shared<SlabCache>(obj_size, slab_size, this);
+  slab_cache->EnableMagazine();
+  return slab_cache;
 }
 
 void MemoryPoolBase::AddSlabCache(std::shared_ptr<SlabCache> slab_cache) {
@@ -24,11 +24,16 @@
 #include <functional>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "modelbox/base/log.h"
 
 namespace modelbox {
 
+constexpr uint32_t kMagazineMaxNumber = 64;
+constexpr uint32_t kMagazineMaxObjects = 32;
+constexpr size_t kMagazineMaxBytes = 1024 * 1024;
+
 Slab::Slab(SlabCache *cache, size_t obj_size, size_t mem_size) {
   if (obj_size <= 0) {
     Abort("object size is invalid.");
@@ -204,6 +209,7 @@ SlabCache::SlabCache(size_t obj_size, size_t slab_size,
 
 SlabCache::~SlabCache() {
   SlabCacheReclaimer::Instance().RmvSlabCache(this);
+  DrainMagazine();
   RemoveSlabs(&full_);
   RemoveSlabs(&partial_);
   RemoveSlabs(&empty_);
@@ -224,20 +230,142 @@ std::shared_ptr<void> SlabCache::AllocSharedPtr() {
   return ret;
 }
 
+void SlabCache::EnableMagazine(uint32_t magazine_num, uint32_t capacity) {
+  if (!magazines_.empty()) {
+    return;
+  }
+
+  if (magazine_num == 0) {
+    magazine_num = std::thread::hardware_concurrency();
+  }
+
+  if (magazine_num == 0) {
+    magazine_num = 1;
+  } else if (magazine_num > kMagazineMaxNumber) {
+    magazine_num = kMagazineMaxNumber;
+  }
+
+  if (capacity == 0) {
+    capacity = kMagazineMaxBytes / obj_size_;
+    if (capacity > kMagazineMaxObjects) {
+      capacity = kMagazineMaxObjects;
+    }
+  }
+
+  /* too large object to cache, go to slab directly */
+  if (capacity < 2) {
+    return;
+  }
+
+  magazine_capacity_ = capacity;
+  for (uint32_t i = 0; i < magazine_num; i++) {
+    auto mag = std::unique_ptr<SlabMagazine>(new SlabMagazine());
+    mag->objs.reserve(capacity);
+    magazines_.push_back(std::move(mag));
+  }
+}
+
+SlabMagazine *SlabCache::CurrentMagazine() {
+  static std::atomic<uint32_t> thread_seq{0};
+  static thread_local uint32_t thread_index = thread_seq++;
+  return magazines_[thread_index % magazines_.size()].get();
+}
+
+void SlabCache::RefillMagazine(SlabMagazine *mag) {
+  size_t refill_num = magazine_capacity_ / 2;
+  void *obj = nullptr;
+  Slab *s = nullptr;
+
+  std::unique_lock<std::mutex> lock(lock_);
+  while (mag->objs.size() < refill_num) {
+    AllocObjectLocked(&lock, &obj, &s);
+    if (obj == nullptr) {
+      break;
+    }
+
+    mag->objs.emplace_back(obj, s);
+  }
+}
+
+void SlabCache::FlushMagazine(SlabMagazine *mag, size_t keep) {
+  if (mag->objs.size() <= keep) {
+    return;
+  }
+
+  /* flush cold objects, keep recently freed objects in magazine */
+  auto flush_end = mag->objs.begin() + (mag->objs.size() - keep);
+  std::unique_lock<std::mutex> lock(lock_);
+  for (auto itr = mag->objs.begin(); itr != flush_end; itr++) {
+    auto *s = itr->second;
+    FreeObjectLocked(itr->first, s);
+    /* slab is idle since object returned to magazine, not since flush */
+    if (s->IsEmpty() && s->last_alive_ > mag->last_free) {
+      s->last_alive_ = mag->last_free;
+    }
+  }
+  lock.unlock();
+
+  mag->objs.erase(mag->objs.begin(), flush_end);
+}
+
+void SlabCache::DrainMagazine(time_t before) {
+  time_t now = time(0);
+  for (auto &mag : magazines_) {
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    if (before > 0 && mag->last_free > now - before) {
+      continue;
+    }
+
+    FlushMagazine(mag.get(), 0);
+  }
+}
+
 void SlabCache::AllocObject(void **obj, Slab **slab) {
+  *obj = nullptr;
+  *slab = nullptr;
+
+  if (!magazines_.empty()) {
+    auto *mag = CurrentMagazine();
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    if (mag->objs.empty()) {
+      mag->miss++;
+      RefillMagazine(mag);
+      if (mag->objs.empty()) {
+        return;
+      }
+    } else {
+      mag->hit++;
+    }
+
+    auto &item = mag->objs.back();
+    *obj = item.first;
+    *slab = item.second;
+    mag->objs.pop_back();
+    active_obj_num_++;
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(lock_);
+  AllocObjectLocked(&lock, obj, slab);
+  if (*obj != nullptr) {
+    active_obj_num_++;
+  }
+}
+
+void SlabCache::AllocObjectLocked(std::unique_lock<std::mutex> *lock,
+                                  void **obj, Slab **slab) {
   Slab *s = nullptr;
   bool is_stop = false;
   void *ret = nullptr;
   ListHead *from_list = nullptr;
 
-  std::unique_lock<std::mutex> lock(lock_);
   while (ret == nullptr && is_stop == false) {
     if (!ListEmpty(&partial_)) {
       from_list = &partial_;
     } else if (!ListEmpty(&empty_)) {
       from_list = &empty_;
     } else {
-      is_stop = !GrowLocked(&lock);
+      is_stop = !GrowLocked(lock);
       continue;
     }
 
@@ -248,7 +376,7 @@ void SlabCache::AllocObject(void **obj, Slab **slab) {
 
     ret = s->Alloc();
     if (ret == nullptr) {
-      is_stop = !GrowLocked(&lock);
+      is_stop = !GrowLocked(lock);
       continue;
     }
 
@@ -275,15 +403,30 @@ void SlabCache::AllocObject(void **obj, Slab **slab) {
     return;
   }
 
-  active_obj_num_++;
   *obj = ret;
   *slab = s;
 }
 
 void SlabCache::FreeObject(void *obj, Slab *slab) {
+  active_obj_num_--;
+
+  if (!magazines_.empty()) {
+    auto *mag = CurrentMagazine();
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    if (mag->objs.size() >= magazine_capacity_) {
+      FlushMagazine(mag, magazine_capacity_ / 2);
+    }
+
+    mag->objs.emplace_back(obj, slab);
+    mag->last_free = time(0);
+    return;
+  }
+
   std::unique_lock<std::mutex> lock(lock_);
+  FreeObjectLocked(obj, slab);
+}
 
-  active_obj_num_--;
+void SlabCache::FreeObjectLocked(void *obj, Slab *slab) {
   slab->Free(obj);
   if (slab->IsEmpty()) {
     ListDel(&slab->list);
@@ -297,6 +440,7 @@ void SlabCache::FreeObject(void *obj, Slab *slab) {
 
 void SlabCache::Shrink(int keep, time_t before) {
   size_t shrink_num = 0;
+  DrainMagazine();
   int empty_number = slab_empty_num_;
 
   if (empty_number <= 0) {
@@ -317,6 +461,8 @@ void SlabCache::Reclaim(time_t before) {
     return;
   }
 
+  /* keep magazines in use warm, only return objects of idle ones */
+  DrainMagazine(before);
   const int free_percent_threshold = 10;
   auto free_obj_percent =
       (slab_empty_num_ * batch_object_num_ * 100) / (obj_num_ * 100);
@@ -351,6 +497,36 @@ uint32_t SlabCache::GetFreeObjNumber() { return obj_num_ - active_obj_num_; }
 
 uint32_t SlabCache::GetActiveObjNumber() { return active_obj_num_; }
 
+uint64_t SlabCache::GetMagazineHitNumber() {
+  uint64_t total_number = 0;
+  for (auto &mag : magazines_) {
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    total_number += mag->hit;
+  }
+
+  return total_number;
+}
+
+uint64_t SlabCache::GetMagazineMissNumber() {
+  uint64_t total_number = 0;
+  for (auto &mag : magazines_) {
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    total_number += mag->miss;
+  }
+
+  return total_number;
+}
+
+uint32_t SlabCache::GetMagazineObjNumber() {
+  uint32_t total_number = 0;
+  for (auto &mag : magazines_) {
+    std::unique_lock<std::mutex> mag_lock(mag->lock);
+    total_number += mag->objs.size();
+  }
+
+  return total_number;
+}
+
 void SlabCache::RemoveSlabs(ListHead *head) { RemoveSlabs(head, -1, 0); }
 
 void SlabCache::RemoveSlabLocked(Slab *s) {
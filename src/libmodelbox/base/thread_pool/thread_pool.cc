@@ -25,6 +25,9 @@ namespace modelbox {
 
 constexpr int MIN_KEEP_ALIVE_TIME = 100;
 
+/* worker of current thread, used by work stealing */
+static thread_local ThreadWorker *current_worker = nullptr;
+
 ThreadWorker::ThreadWorker(ThreadPool *pool, int thread_id, bool core_worker) {
   pool_ = pool;
   is_core_worker_ = core_worker;
@@ -53,7 +56,43 @@ bool ThreadWorker::IsCore() { return is_core_worker_; }
 
 void ThreadWorker::SetCore(bool is_core) { is_core_worker_ = is_core; }
 
+void ThreadWorker::PushLocal(const ThreadFunction &task) {
+  std::unique_lock<std::mutex> lock(local_lock_);
+  local_queue_.push_back(task);
+}
+
+bool ThreadWorker::PopLocal(ThreadFunction *task) {
+  std::unique_lock<std::mutex> lock(local_lock_);
+  if (local_queue_.empty()) {
+    return false;
+  }
+
+  /* owner takes the newest task, its data is still in cache */
+  *task = std::move(local_queue_.back());
+  local_queue_.pop_back();
+  return true;
+}
+
+bool ThreadWorker::StealLocal(ThreadFunction *task) {
+  std::unique_lock<std::mutex> lock(local_lock_);
+  if (local_queue_.empty()) {
+    return false;
+  }
+
+  /* thief takes the oldest task */
+  *task = std::move(local_queue_.front());
+  local_queue_.pop_front();
+  return true;
+}
+
+size_t ThreadWorker::LocalSize() {
+  std::unique_lock<std::mutex> lock(local_lock_);
+  return local_queue_.size();
+}
+
 void ThreadWorker::Run(ThreadWorker *worker) {
+  current_worker = worker;
+  worker->pool_->PinWorker(worker);
   while (worker->running_) {
     worker->ChangeNameNow();
     worker->pool_->RunWorker(worker);
@@ -69,6 +108,7 @@ void ThreadWorker::Run(ThreadWorker *worker) {
   }
 
   lock.unlock();
+  current_worker = nullptr;
   pool->ExitWorker(worker);
   // thread may be detached, leave nothing here.
 }
@@ -105,8 +145,86 @@ void ThreadWorker::Join() {
   }
 }
 
+ThreadTaskQueue::ThreadTaskQueue(size_t capacity, bool lockfree) {
+  if (lockfree && RingBlockingQueue<ThreadFunction>::IsCapacitySupported(
+                      capacity) == false) {
+    MBLOG_WARN << "task queue size " << capacity
+               << " is not supported by lock-free queue, max "
+               << RingBlockingQueue<ThreadFunction>::kMaxRingSize
+               << ", use mutex-based queue";
+    lockfree = false;
+  }
+
+  if (lockfree) {
+    ring_ = std::make_shared<RingBlockingQueue<ThreadFunction>>(capacity);
+  } else {
+    queue_ = std::make_shared<BlockingQueue<ThreadFunction>>(capacity);
+  }
+}
+
+ThreadTaskQueue::~ThreadTaskQueue() {}
+
+bool ThreadTaskQueue::Push(const ThreadFunction &task, int timeout) {
+  if (ring_) {
+    return ring_->Push(task, timeout);
+  }
+
+  return queue_->Push(task, timeout);
+}
+
+bool ThreadTaskQueue::Pop(ThreadFunction *task, int timeout) {
+  if (ring_) {
+    return ring_->Pop(task, timeout);
+  }
+
+  return queue_->Pop(task, timeout);
+}
+
+bool ThreadTaskQueue::Full() { return ring_ ? ring_->Full() : queue_->Full(); }
+
+size_t ThreadTaskQueue::Size() {
+  return ring_ ? ring_->Size() : queue_->Size();
+}
+
+size_t ThreadTaskQueue::GetCapacity() {
+  return ring_ ? ring_->GetCapacity() : queue_->GetCapacity();
+}
+
+void ThreadTaskQueue::SetCapacity(size_t capacity) {
+  if (ring_ == nullptr) {
+    queue_->SetCapacity(capacity);
+    return;
+  }
+
+  if (ring_->SetCapacity(capacity) == false) {
+    MBLOG_WARN << "lock-free task queue can not grow beyond "
+               << ring_->RingSize() << ", keep capacity "
+               << ring_->GetCapacity();
+  }
+}
+
+void ThreadTaskQueue::Wakeup() {
+  if (ring_) {
+    ring_->Wakeup();
+    return;
+  }
+
+  queue_->Wakeup();
+}
+
+void ThreadTaskQueue::Shutdown() {
+  if (ring_) {
+    ring_->Shutdown();
+    return;
+  }
+
+  queue_->Shutdown();
+}
+
+bool ThreadTaskQueue::IsLockFree() { return ring_ != nullptr; }
+
 ThreadPool::ThreadPool(int thread_size, int max_thread_size, int queue_size,
-                       int keep_alive) {
+                       int keep_alive, bool lockfree_queue) {
   if (thread_size < 0) {
     thread_size = std::thread::hardware_concurrency();
   }
@@ -135,7 +253,7 @@ ThreadPool::ThreadPool(int thread_size, int max_thread_size, int queue_size,
   keep_alive_ = keep_alive;
   worker_num_ = 0;
   quit_ = false;
-  work_queue_ = std::make_shared<BlockingQueue<ThreadFunction>>(queue_size);
+  work_queue_ = std::make_shared<ThreadTaskQueue>(queue_size, lockfree_queue);
 }
 
 ThreadPool::~ThreadPool() { Shutdown(); };
@@ -174,7 +292,13 @@ bool ThreadPool::Park(ThreadWorker *worker, ThreadFunction &task) {
     }
   }
 
+  /* count as available before checking, so no steal hint is missed */
   available_num_++;
+  if (work_stealing_ && (worker->PopLocal(&task) || StealTask(worker, task))) {
+    available_num_--;
+    return true;
+  }
+
   auto ret = work_queue_->Pop(&task, wait_time);
   available_num_--;
   if (ret == false) {
@@ -182,13 +306,61 @@ bool ThreadPool::Park(ThreadWorker *worker, ThreadFunction &task) {
       return false;
     }
 
+    /* do not exit before local tasks are finished */
+    if (work_stealing_ &&
+        (worker->PopLocal(&task) || StealTask(worker, task))) {
+      return true;
+    }
+
     worker->Stop();
     return false;
   }
 
+  if (!task.func) {
+    /* steal hint from SubmitLocalTask */
+    return StealTask(worker, task);
+  }
+
   return true;
 }
 
+bool ThreadPool::StealTask(ThreadWorker *worker, ThreadFunction &task) {
+  auto victims = std::atomic_load(&steal_victims_);
+  if (victims == nullptr || victims->size() == 0) {
+    return false;
+  }
+
+  auto num = victims->size();
+  auto start = steal_index_++ % num;
+  for (size_t i = 0; i < num; i++) {
+    auto &victim = (*victims)[(start + i) % num];
+    if (victim.get() == worker) {
+      continue;
+    }
+
+    if (victim->StealLocal(&task)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::PinWorker(ThreadWorker *worker) {
+  auto cpu_num = std::thread::hardware_concurrency();
+  if (!pin_cpu_ || !worker->IsCore() || cpu_num == 0) {
+    return;
+  }
+
+  int16_t cpu = worker->Id() % cpu_num;
+  auto ret = os->Thread->SetThreadLogicalCPUAffinity(
+      std::this_thread::get_id(), {cpu});
+  if (!ret) {
+    MBLOG_WARN << "pin worker " << worker->Id() << " to cpu " << cpu
+               << " failed, " << ret;
+  }
+}
+
 void ThreadPool::RunWorker(ThreadWorker *worker) {
   ThreadFunction task;
   bool is_set_name = false;
@@ -223,6 +395,10 @@ void ThreadPool::RmvWorker(ThreadWorker *worker) {
     }
   }
 
+  if (work_stealing_) {
+    UpdateStealVictims();
+  }
+
   if (workers_.size() == 0) {
     exit_cond_.notify_one();
   }
@@ -237,13 +413,56 @@ Status ThreadPool::AddWorker(bool core_worker) {
   worker->SetName(name_);
   lock_.lock();
   workers_.push_back(worker);
+  if (work_stealing_) {
+    UpdateStealVictims();
+  }
   lock_.unlock();
   worker->Start();
   worker->SetCore(core_worker);
   return STATUS_OK;
 }
 
+void ThreadPool::UpdateStealVictims() {
+  auto victims =
+      std::make_shared<std::vector<std::shared_ptr<ThreadWorker>>>(workers_);
+  std::atomic_store(&steal_victims_, victims);
+}
+
+bool ThreadPool::SubmitLocalTask(ThreadFunction &task) {
+  auto worker = current_worker;
+  /* when shutting down, workers drain local queue before exit */
+  if (worker == nullptr || worker->pool_ != this || !worker->running_) {
+    return false;
+  }
+
+  if (available_num_ > 0) {
+    worker->PushLocal(task);
+    /* wake up an idle worker to steal */
+    ThreadFunction steal_hint;
+    work_queue_->Push(steal_hint, -1);
+    return true;
+  }
+
+  /* all workers are busy and no one would steal the task, the submitter may
+   * wait on it, so queue it to shared queue and expand the pool. Never block
+   * a worker on a full shared queue, keep the task local then */
+  if (!work_queue_->Push(task, -1)) {
+    worker->PushLocal(task);
+  }
+
+  auto num = worker_num_++;
+  if (num < max_thread_size_) {
+    AddWorker(num < thread_size_);
+  }
+  worker_num_--;
+  return true;
+}
+
 bool ThreadPool::SubmitTask(ThreadFunction &task) {
+  if (work_stealing_ && SubmitLocalTask(task)) {
+    return true;
+  }
+
   bool is_queued = false;
   if (worker_num_++ < thread_size_) {
     AddWorker(true);
@@ -326,17 +545,78 @@ void ThreadPool::SetTaskQueueSize(size_t size) {
   work_queue_->SetCapacity(size);
 }
 
+void ThreadPool::EnableWorkStealing(bool pin_cpu) {
+  std::unique_lock<std::mutex> lock(lock_);
+  work_stealing_ = true;
+  pin_cpu_ = pin_cpu;
+  UpdateStealVictims();
+}
+
 void ThreadPool::SetKeepAlive(uint32_t timeout) {
   keep_alive_ = timeout;
   work_queue_->Wakeup();
 }
 
+static Status RunParallelTask(const std::function<Status(size_t)> &func,
+                              size_t index) {
+  try {
+    return func(index);
+  } catch (const std::exception &e) {
+    return {STATUS_FAULT, "task " + std::to_string(index) +
+                              " exception: " + e.what()};
+  }
+}
+
+Status ThreadPool::ParallelFor(size_t count,
+                               const std::function<Status(size_t)> &func) {
+  if (count == 0) {
+    return STATUS_OK;
+  }
+
+  std::vector<Status> status_list(count);
+  std::vector<std::pair<size_t, std::future<Status>>> results;
+  for (size_t i = 1; i < count; ++i) {
+    auto result = Submit([&func, i]() { return RunParallelTask(func, i); });
+    if (!result.valid()) {
+      status_list[i] = RunParallelTask(func, i);
+      continue;
+    }
+
+    results.emplace_back(i, std::move(result));
+  }
+
+  status_list[0] = RunParallelTask(func, 0);
+  for (auto &result : results) {
+    try {
+      status_list[result.first] = result.second.get();
+    } catch (const std::exception &e) {
+      status_list[result.first] = {STATUS_FAULT, e.what()};
+    }
+  }
+
+  for (auto &status : status_list) {
+    if (!status) {
+      return status;
+    }
+  }
+
+  return STATUS_OK;
+}
+
 int ThreadPool::GetThreadsNum() { return worker_num_; }
 
 int ThreadPool::GetMaxThreadsNum() { return max_thread_size_; }
 
 int ThreadPool::GetWaitingWorkCount() {
-  return work_queue_ ? work_queue_->Size() : 0;
+  int count = work_queue_ ? work_queue_->Size() : 0;
+  auto victims = std::atomic_load(&steal_victims_);
+  if (victims != nullptr) {
+    for (auto &worker : *victims) {
+      count += worker->LocalSize();
+    }
+  }
+
+  return count;
 }
 
 }  // namespace modelbox
@@ -19,9 +19,32 @@
 #include <modelbox/base/timer.h>
 #include <modelbox/base/utils.h>
 
+#include <algorithm>
+
 namespace modelbox {
 
 constexpr int TIMER_MAX_RUNNING_TIME = 50;
+constexpr size_t TIMER_WHEEL_LEVELS = 5;
+constexpr size_t TIMER_WHEEL_ROOT_BITS = 8;
+constexpr size_t TIMER_WHEEL_LEVEL_BITS = 6;
+constexpr uint64_t TIMER_WHEEL_ROOT_SIZE = 1ULL << TIMER_WHEEL_ROOT_BITS;
+constexpr uint64_t TIMER_WHEEL_LEVEL_SIZE = 1ULL << TIMER_WHEEL_LEVEL_BITS;
+constexpr uint64_t TIMER_WHEEL_ROOT_MASK = TIMER_WHEEL_ROOT_SIZE - 1;
+constexpr uint64_t TIMER_WHEEL_LEVEL_MASK = TIMER_WHEEL_LEVEL_SIZE - 1;
+
+/* tick shift of the slot in each wheel level, level 0 slot is 1ms */
+static inline size_t TimerWheelShift(size_t level) {
+  if (level == 0) {
+    return 0;
+  }
+
+  return TIMER_WHEEL_ROOT_BITS + (level - 1) * TIMER_WHEEL_LEVEL_BITS;
+}
+
+/* ticks beyond this are parked in the last level and cascaded again */
+constexpr uint64_t TIMER_WHEEL_MAX_RANGE =
+    1ULL << (TIMER_WHEEL_ROOT_BITS +
+             (TIMER_WHEEL_LEVELS - 1) * TIMER_WHEEL_LEVEL_BITS);
 
 Timer TimerGlobal::timer_;
 int TimerGlobal::refcnt_;
@@ -97,11 +120,18 @@ bool TimerTask::IsRunning() { return is_running_; }
 Timer::Timer() {
   // make sure tick may not overflow for a long long time.
   start_tick_ = GetTickCount();
+  wheel_.resize(TIMER_WHEEL_LEVELS);
+  wheel_task_num_.resize(TIMER_WHEEL_LEVELS, 0);
+  wheel_[0].resize(TIMER_WHEEL_ROOT_SIZE);
+  for (size_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+    wheel_[level].resize(TIMER_WHEEL_LEVEL_SIZE);
+  }
 };
 
 Timer::~Timer() { Stop(); };
 
 thread_local std::shared_ptr<TimerTask> Timer::current_timer_task_ = nullptr;
+thread_local Timer *Timer::current_timer_ = nullptr;
 
 std::shared_ptr<TimerTask> Timer::CurrentTimerTask() {
   return current_timer_task_;
@@ -115,6 +145,11 @@ void Timer::SetName(const std::string &name) {
   name_ = name;
 }
 
+void Timer::SetExecutor(std::shared_ptr<ThreadPool> executor) {
+  std::unique_lock<std::mutex> lock(lock_);
+  executor_ = executor;
+}
+
 void Timer::Start(bool lazy) {
   if (timer_running_) {
     return;
@@ -134,9 +169,11 @@ void Timer::Shutdown() {
 
   std::unique_lock<std::mutex> lock(lock_);
   is_shutdown_ = true;
+  RemoveStoppedTimer();
+  next_tick_ = 0;
   lock.unlock();
 
-  cond_.notify_one();
+  cond_.notify_all();
   if (thread_.joinable()) {
     thread_.join();
   }
@@ -168,7 +205,7 @@ void Timer::StartAsync() {
 void Timer::StopAsync() {
   std::unique_lock<std::mutex> lock(lock_);
   timer_running_ = false;
-  cond_.notify_one();
+  cond_.notify_all();
 }
 
 void Timer::Stop() {
@@ -181,16 +218,32 @@ void Timer::Stop() {
   cond_.notify_all();
   lock.unlock();
 
+  // called from a callback, the caller itself is one of the running tasks
+  bool in_callback = (current_timer_ == this);
   if (thread_.joinable()) {
-    thread_.join();
+    if (thread_.get_id() == std::this_thread::get_id()) {
+      // timer thread exits after the callback returns
+      thread_.detach();
+    } else {
+      thread_.join();
+    }
   }
 
+  // wait for callbacks still running in executor
   lock.lock();
-  while (!timer_queue_.empty()) {
-    auto timer = timer_queue_.top();
-    timer->Stop();
-    timer_queue_.pop();
+  if (!in_callback) {
+    cond_.wait(lock, [this]() { return running_num_ == 0; });
+  }
+  for (size_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+    for (auto &slot : wheel_[level]) {
+      for (auto &timer : slot) {
+        timer->Stop();
+      }
+      slot.clear();
+    }
+    wheel_task_num_[level] = 0;
   }
+  timer_num_ = 0;
 };
 
 void Timer::StartTimerThread() {
@@ -223,13 +276,8 @@ void Timer::Schedule(const std::shared_ptr<TimerTask> timer_task,
     StartTimerThread();
   }
 
-  InsertTimerTask(timer_task_sched, now);
   timer_task_sched->SetTimerRunning(true);
-  auto top = timer_queue_.top();
-  if (timer_task_sched.get() == top.get()) {
-    cond_.notify_one();
-  }
-
+  InsertTimerTask(timer_task_sched, now);
   return;
 }
 
@@ -244,124 +292,188 @@ uint64_t Timer::GetCurrentTick() {
 
 void Timer::InsertTimerTask(std::shared_ptr<TimerTask> timer_task,
                             uint64_t now) {
+  if (timer_num_ == 0) {
+    // wheel is empty, move it to current tick directly.
+    wheel_tick_ = GetCurrentTick();
+  }
+
   timer_task->SetHitTime(now + timer_task->GetPeriod() +
                          timer_task->GetDelay());
-  timer_queue_.push(timer_task);
+  AddWheelTask(timer_task);
+
+  // wake up timer thread if new task expires earlier.
+  if (timer_task->GetHitTime() < next_tick_) {
+    next_tick_ = timer_task->GetHitTime();
+    cond_.notify_all();
+  }
 }
 
-void Timer::RemoveTopTimerTask() {
-  auto top = timer_queue_.top();
-  timer_queue_.pop();
+void Timer::AddWheelTask(std::shared_ptr<TimerTask> timer_task) {
+  uint64_t expire = timer_task->GetHitTime();
+  size_t level = 0;
+  size_t index = 0;
+
+  if (expire < wheel_tick_) {
+    // already expired, run at next tick
+    index = wheel_tick_ & TIMER_WHEEL_ROOT_MASK;
+  } else if (expire - wheel_tick_ < TIMER_WHEEL_ROOT_SIZE) {
+    index = expire & TIMER_WHEEL_ROOT_MASK;
+  } else {
+    uint64_t diff = expire - wheel_tick_;
+    if (diff >= TIMER_WHEEL_MAX_RANGE) {
+      // cascade will put it to the right slot again.
+      expire = wheel_tick_ + TIMER_WHEEL_MAX_RANGE - 1;
+    }
+
+    for (level = 1; level < TIMER_WHEEL_LEVELS - 1; level++) {
+      if (diff < (1ULL << TimerWheelShift(level + 1))) {
+        break;
+      }
+    }
+
+    index = (expire >> TimerWheelShift(level)) & TIMER_WHEEL_LEVEL_MASK;
+  }
+
+  wheel_[level][index].push_back(timer_task);
+  wheel_task_num_[level]++;
+  timer_num_++;
 }
 
-void Timer::StopTimerTask(TimerTask *timer_task) {
-  std::unique_lock<std::mutex> lock(lock_);
-  auto timer = timer_queue_.top();
-  if (timer->IsRunning() == false) {
-    cond_.notify_one();
+void Timer::CascadeWheelTask() {
+  for (size_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+    auto index = (wheel_tick_ >> TimerWheelShift(level)) &
+                 TIMER_WHEEL_LEVEL_MASK;
+    TimerWheelSlot slot;
+    slot.swap(wheel_[level][index]);
+    wheel_task_num_[level] -= slot.size();
+    timer_num_ -= slot.size();
+    for (auto &timer : slot) {
+      if (timer->IsRunning()) {
+        AddWheelTask(timer);
+      }
+    }
+
+    if (index != 0) {
+      break;
+    }
   }
 }
 
-bool Timer::RemoveStoppedTimer() {
-  bool removed = false;
-  while (timer_queue_.size() > 0) {
-    auto timer = timer_queue_.top();
-    if (timer->IsRunning()) {
-      return removed;
+void Timer::ExpireTimerTask(uint64_t now,
+                            std::vector<std::shared_ptr<TimerTask>> *expired) {
+  while (wheel_tick_ <= now && timer_num_ > 0) {
+    auto index = wheel_tick_ & TIMER_WHEEL_ROOT_MASK;
+    if (index == 0) {
+      CascadeWheelTask();
+    }
+
+    if (wheel_task_num_[0] == 0) {
+      // nothing in root wheel, skip to next cascade tick
+      auto next = (wheel_tick_ | TIMER_WHEEL_ROOT_MASK) + 1;
+      wheel_tick_ = next <= now ? next : now + 1;
+      continue;
     }
 
-    RemoveTopTimerTask();
-    removed = true;
+    auto &slot = wheel_[0][index];
+    wheel_task_num_[0] -= slot.size();
+    timer_num_ -= slot.size();
+    for (auto &timer : slot) {
+      if (timer->IsRunning()) {
+        expired->push_back(timer);
+      }
+    }
+    slot.clear();
+    wheel_tick_++;
   }
 
-  if (timer_queue_.size() == 0) {
-    return true;
+  if (timer_num_ == 0) {
+    wheel_tick_ = now + 1;
   }
 
-  return removed;
+  running_num_ += expired->size();
 }
 
-void Timer::WaitTimerTask(std::unique_lock<std::mutex> &lock,
-                          std::shared_ptr<TimerTask> &timer) {
-  // wait for first timer task timeout
-  timer = timer_queue_.top();
-  uint64_t now = GetCurrentTick();
-  uint64_t time_diff = GetTickDiff(timer->GetHitTime(), now);
-  if (time_diff <= timer->GetPeriod() + timer->GetDelay()) {
-    auto wait_time = std::chrono::milliseconds(time_diff);
-    cond_.wait_for(lock, wait_time, [this, timer]() {
-      // return true when timer stop, top timer stop, top timer changed.
-      return timer_running_ == false || timer_queue_.size() == 0 ||
-             (timer_queue_.top()->IsRunning() == false) ||
-             timer_queue_.top().get() != timer.get();
-    });
+uint64_t Timer::NextExpireTick() {
+  if (wheel_task_num_[0] > 0) {
+    for (uint64_t i = 0; i < TIMER_WHEEL_ROOT_SIZE; i++) {
+      auto tick = wheel_tick_ + i;
+      if (wheel_[0][tick & TIMER_WHEEL_ROOT_MASK].size() > 0) {
+        return tick;
+      }
+    }
+  }
 
-    if (timer_queue_.size() == 0 || timer_running_ == false) {
-      timer = nullptr;
-      return;
+  // upper level slot is cascaded when lower levels wrap around.
+  uint64_t next = UINT64_MAX;
+  for (size_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+    if (wheel_task_num_[level] == 0) {
+      continue;
     }
 
-    timer = timer_queue_.top();
-  } else if (time_diff != 0) {
-    // timer stall, force reset hit time
-    timer = timer_queue_.top();
-    time_diff = GetTickDiff(now, timer->GetHitTime());
-    if (time_diff > (timer->GetPeriod() + timer->GetDelay()) * 5 &&
-        timer->GetPeriod() + timer->GetDelay() > 0) {
-      MBLOG_WARN << "timer stall too long, update timer task";
-      MBLOG_WARN << "timer name: " << timer->GetName();
-      MBLOG_WARN << "timer period: " << timer->GetPeriod();
-      timer->SetHitTime(now);
-    } else if (time_diff > timer->GetPeriod() + timer->GetDelay()) {
-      MBLOG_WARN << "timer [" << timer->GetName() << "] stall for " << time_diff
-                 << "ms";
+    auto shift = TimerWheelShift(level);
+    uint64_t tick = ((wheel_tick_ + (1ULL << shift) - 1) >> shift) << shift;
+    for (size_t i = 0; i < TIMER_WHEEL_LEVEL_SIZE; i++) {
+      if (wheel_[level][(tick >> shift) & TIMER_WHEEL_LEVEL_MASK].size() > 0) {
+        next = tick < next ? tick : next;
+        break;
+      }
+      tick += 1ULL << shift;
     }
   }
 
-  return;
+  return next;
 }
 
-bool Timer::GetTimerTask(std::unique_lock<std::mutex> &lock,
-                         std::shared_ptr<TimerTask> &timer) {
-  // wait for timer task
-  if (timer_queue_.size() <= 0) {
-    cond_.wait(lock, [this]() {
-      return timer_queue_.size() > 0 || timer_running_ == false ||
-             is_shutdown_ == true;
-    });
-    if (timer_running_ == false || is_shutdown_ == true) {
-      return false;
+void Timer::RemoveStoppedTimer() {
+  for (size_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+    for (auto &slot : wheel_[level]) {
+      auto size = slot.size();
+      slot.erase(std::remove_if(slot.begin(), slot.end(),
+                                [](const std::shared_ptr<TimerTask> &timer) {
+                                  return timer->IsRunning() == false;
+                                }),
+                 slot.end());
+      wheel_task_num_[level] -= size - slot.size();
+      timer_num_ -= size - slot.size();
     }
   }
+}
 
-  // skip timer task already stopped
-  if (RemoveStoppedTimer() == true) {
-    return false;
-  }
-
-  // wait timer task timeout
-  WaitTimerTask(lock, timer);
+bool Timer::WaitTimerTask(std::unique_lock<std::mutex> &lock) {
+  if (timer_num_ == 0) {
+    // wait for timer task
+    if (is_shutdown_ == true && running_num_ == 0) {
+      timer_running_ = false;
+      return false;
+    }
 
-  // stop, return.
-  if (timer_running_ == false || timer_queue_.size() <= 0) {
+    next_tick_ = UINT64_MAX;
+    cond_.wait(lock, [this]() {
+      return timer_num_ > 0 || timer_running_ == false ||
+             (is_shutdown_ == true && running_num_ == 0);
+    });
     return false;
   }
 
-  if (timer->IsRunning() == false) {
-    RemoveTopTimerTask();
+  // wait for first timer task timeout
+  uint64_t now = GetCurrentTick();
+  uint64_t next = NextExpireTick();
+  if (next > now) {
+    next_tick_ = next;
+    auto wait_time = std::chrono::milliseconds(next - now);
+    cond_.wait_for(lock, wait_time, [this, next]() {
+      // return true when timer stop, or earlier task added.
+      return timer_running_ == false || next_tick_ < next;
+    });
     return false;
   }
 
-  // get a timer task
-  uint64_t now = GetCurrentTick();
-  uint64_t time_diff = GetTickDiff(timer->GetHitTime(), now);
-  if ((time_diff <= timer->GetPeriod() + timer->GetDelay() && time_diff != 0) ||
-      timer_running_ == false) {
-    return false;
+  auto time_diff = now - next;
+  if (time_diff > TIMER_MAX_RUNNING_TIME) {
+    MBLOG_WARN << "timer [" << name_ << "] stall for " << time_diff << "ms";
   }
 
-  RemoveTopTimerTask();
-  return true;
+  return timer_running_;
 }
 
 void Timer::RunTimerTask(std::shared_ptr<TimerTask> timer,
@@ -369,8 +481,10 @@ void Timer::RunTimerTask(std::shared_ptr<TimerTask> timer,
   try {
     uint64_t start = GetCurrentTick();
     current_timer_task_ = timer_call;
+    current_timer_ = this;
     timer_call->Run();
     current_timer_task_ = nullptr;
+    current_timer_ = nullptr;
     uint64_t end = GetCurrentTick();
 
     auto elapsed = end - start;
@@ -385,50 +499,59 @@ void Timer::RunTimerTask(std::shared_ptr<TimerTask> timer,
       }
     }
   } catch (const std::bad_function_call &ex) {
+    current_timer_task_ = nullptr;
+    current_timer_ = nullptr;
     MBLOG_WARN << "timer '" << timer->GetName()
                << "' is invalid, function is not set, disable";
     timer->SetTimerRunning(false);
   } catch (const std::exception &ex) {
+    current_timer_task_ = nullptr;
+    current_timer_ = nullptr;
     MBLOG_WARN << "timer '" << timer->GetName()
                << "'caght exception: " << ex.what();
   }
 }
 
-void Timer::RunTimer() {
-  // get a timer
-  std::shared_ptr<TimerTask> timer;
+void Timer::DispatchTimerTask(std::shared_ptr<TimerTask> timer,
+                              std::shared_ptr<ThreadPool> executor) {
   std::shared_ptr<TimerTask> timer_call;
-
-  std::unique_lock<std::mutex> lock(lock_);
-
-  if (timer_queue_.size() == 0) {
-    // reset tick
-    start_tick_ = GetTickCount();
-  }
-
-  if (GetTimerTask(lock, timer) == false) {
-    if (is_shutdown_ == true && timer_queue_.size() <= 0) {
-      timer_running_ = false;
-    }
-    return;
-  }
-
-  lock.unlock();
-
   if (timer->IsWeakPtrTimerTask()) {
     timer_call = timer->weak_timer_.lock();
     if (timer_call == nullptr) {
       timer->SetTimerRunning(false);
+      FinishTimerTask(timer);
       return;
     }
   } else {
     timer_call = timer;
   }
 
-  // run timer
+  if (executor != nullptr) {
+    auto result = executor->Submit([this, timer, timer_call]() {
+      RunTimerTask(timer, timer_call);
+      FinishTimerTask(timer);
+    });
+    if (result.valid()) {
+      return;
+    }
+
+    MBLOG_WARN << "submit timer '" << timer->GetName()
+               << "' to executor failed, run in timer thread";
+  }
+
   RunTimerTask(timer, timer_call);
+  FinishTimerTask(timer);
+}
 
-  if (timer->GetPeriod() == 0 || timer->IsRunning() == false) {
+void Timer::FinishTimerTask(std::shared_ptr<TimerTask> timer) {
+  std::unique_lock<std::mutex> lock(lock_);
+  running_num_--;
+  if (running_num_ == 0) {
+    cond_.notify_all();
+  }
+
+  if (timer->GetPeriod() == 0 || timer->IsRunning() == false ||
+      timer_running_ == false) {
     timer->SetTimerRunning(false);
     return;
   }
@@ -438,9 +561,43 @@ void Timer::RunTimer() {
     timer->SetDelay(0);
   }
 
+  uint64_t now = GetCurrentTick();
+  uint64_t hit_time = timer->GetHitTime();
+  if (now > hit_time && now - hit_time > timer->GetPeriod() * 5) {
+    // timer stall, force reset hit time
+    MBLOG_WARN << "timer stall too long, update timer task";
+    MBLOG_WARN << "timer name: " << timer->GetName();
+    MBLOG_WARN << "timer period: " << timer->GetPeriod();
+    hit_time = now;
+  }
+
   // reschedue task
-  lock.lock();
-  InsertTimerTask(timer, timer->GetHitTime());
+  InsertTimerTask(timer, hit_time);
+}
+
+void Timer::RunTimer() {
+  std::unique_lock<std::mutex> lock(lock_);
+  if (WaitTimerTask(lock) == false) {
+    return;
+  }
+
+  lock.unlock();
+  RunExpiredTimer(GetCurrentTick());
+}
+
+void Timer::RunExpiredTimer(uint64_t now) {
+  std::vector<std::shared_ptr<TimerTask>> expired;
+  std::shared_ptr<ThreadPool> executor;
+
+  std::unique_lock<std::mutex> lock(lock_);
+  ExpireTimerTask(now, &expired);
+  executor = executor_;
+  lock.unlock();
+
+  // run timer
+  for (auto &timer : expired) {
+    DispatchTimerTask(timer, executor);
+  }
 }
 
 void TimerGlobal::Stop() {
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <modelbox/base/any.h>
+
+#include <unordered_map>
+
+namespace modelbox {
+
+static std::mutex &MetaKeyLock() {
+  static std::mutex lock;
+  return lock;
+}
+
+static std::unordered_map<std::string, uint32_t> &MetaKeyIds() {
+  static std::unordered_map<std::string, uint32_t> ids;
+  return ids;
+}
+
+/* ids never change once interned, cache them per thread to avoid the lock */
+static std::unordered_map<std::string, uint32_t> &MetaKeyCache() {
+  static thread_local std::unordered_map<std::string, uint32_t> cache;
+  return cache;
+}
+
+MetaKey::MetaKey(const std::string &name) : id_(Intern(name)), name_(name) {}
+
+uint32_t MetaKey::Intern(const std::string &name) {
+  auto &cache = MetaKeyCache();
+  auto iter = cache.find(name);
+  if (iter != cache.end()) {
+    return iter->second;
+  }
+
+  std::unique_lock<std::mutex> lock(MetaKeyLock());
+  auto &ids = MetaKeyIds();
+  auto id = ids.emplace(name, ids.size()).first->second;
+  lock.unlock();
+
+  cache[name] = id;
+  return id;
+}
+
+bool MetaKey::Find(const std::string &name, uint32_t *id) {
+  auto &cache = MetaKeyCache();
+  auto iter = cache.find(name);
+  if (iter != cache.end()) {
+    *id = iter->second;
+    return true;
+  }
+
+  std::unique_lock<std::mutex> lock(MetaKeyLock());
+  auto &ids = MetaKeyIds();
+  auto ids_iter = ids.find(name);
+  if (ids_iter == ids.end()) {
+    return false;
+  }
+
+  *id = ids_iter->second;
+  lock.unlock();
+
+  cache[name] = *id;
+  return true;
+}
+
+}  // namespace modelbox
@@ -218,6 +218,31 @@ std::shared_ptr<Buffer> Buffer::DeepCopy() const {
   return buffer;
 }
 
+std::shared_ptr<Buffer> Buffer::CopyOnWrite() const {
+  if (dev_mem_ == nullptr || data_shared_ || dev_mem_.use_count() != 1 ||
+      !dev_mem_->IsExclusive()) {
+    return DeepCopy();
+  }
+
+  // memory from Build(data, size, func) belongs to the caller, only reuse it
+  // when the caller left it writable
+  if (dev_mem_->IsAcquired() && !dev_mem_->IsContentMutable()) {
+    return DeepCopy();
+  }
+
+  auto buffer = Copy();
+  buffer->dev_mem_ = dev_mem_->Clone();
+  if (buffer->dev_mem_ == nullptr) {
+    MBLOG_ERROR << "Buffer clone device memory failed";
+    return nullptr;
+  }
+
+  buffer->dev_mem_->SetContentMutable(true);
+  return buffer;
+}
+
+void Buffer::SetDataShared() { data_shared_ = true; }
+
 std::shared_ptr<Buffer> Buffer::CopyTo(
     const std::shared_ptr<Device>& dest_device) const {
   if (dest_device == nullptr) {
@@ -233,37 +233,26 @@ Status BufferList::CopyToNewBufferList(std::shared_ptr<DeviceMemory>& dev_mem) {
 
 Status BufferList::GenerateDeviceMemory(
     const std::vector<std::shared_ptr<DeviceMemory>>& buffer_dev_mems) {
-  bool is_contiguous = false;
-  if (dev_mem_ && dev_mem_->IsSameDevice(buffer_dev_mems[0])) {
-    is_contiguous = DeviceMemory::IsContiguous(buffer_dev_mems);
-  }
-
-  if (is_contiguous) {
-    is_contiguous_ = true;
-    auto device =
-        dev_mem_ ? dev_mem_->GetDevice() : buffer_dev_mems[0]->GetDevice();
-    auto dev_mem =
-        DeviceMemory::Combine(buffer_dev_mems, device, dev_mem_flags_);
-    if (!dev_mem) {
-      MBLOG_ERROR << "DeviceMemory Combine failed.";
-      return STATUS_NOMEM;
-    }
-
-    dev_mem_ = dev_mem;
-    return STATUS_OK;
-  }
-
   auto device =
       dev_mem_ ? dev_mem_->GetDevice() : buffer_dev_mems[0]->GetDevice();
-  auto dev_mem = DeviceMemory::Combine(buffer_dev_mems, device, dev_mem_flags_);
+  auto mem_flags =
+      dev_mem_ ? dev_mem_flags_ : buffer_dev_mems[0]->GetMemFlags();
+  auto dev_mem = DeviceMemory::Combine(buffer_dev_mems, device, mem_flags);
   if (!dev_mem) {
     MBLOG_ERROR << "DeviceMemory Combine failed.";
     return STATUS_NOMEM;
   }
 
-  auto ret = CopyToNewBufferList(dev_mem);
-  if (ret != STATUS_OK) {
-    return ret;
+  // buffers in a batch built by producer in one block, in order, are reused
+  // as is, the combined memory is a view of that block
+  bool is_contiguous = DeviceMemory::IsContiguous(buffer_dev_mems, true) &&
+                       buffer_dev_mems[0]->GetDevice() == device &&
+                       buffer_dev_mems[0]->GetMemFlags() == mem_flags;
+  if (!is_contiguous) {
+    auto ret = CopyToNewBufferList(dev_mem);
+    if (ret != STATUS_OK) {
+      return ret;
+    }
   }
 
   dev_mem_ = dev_mem;
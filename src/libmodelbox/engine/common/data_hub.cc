@@ -30,6 +30,8 @@ PriorityPort::PriorityPort(const std::shared_ptr<IPort>& port)
   } else {
     priority_ = std::numeric_limits<int>::min();
   }
+
+  dynamic_priority_ = priority_;
 }
 
 const std::shared_ptr<IPort>& PriorityPort::GetPort() const { return port_; }
@@ -40,7 +42,11 @@ void PriorityPort::UpdateActiveTime() { active_time_ = GetCurrentTime(); }
 int32_t PriorityPort::GetPriority() const { return priority_; }
 void PriorityPort::SetPriority(int32_t priority) { priority_ = priority; }
 // TODO port update dynamic priority
-void PriorityPort::UpdatePriority() { priority_ = port_->GetPriority(); }
+void PriorityPort::UpdatePriority() {
+  dynamic_priority_ = port_->GetPriority();
+  priority_ = dynamic_priority_;
+}
+int32_t PriorityPort::GetDynamicPriority() const { return dynamic_priority_; }
 
 void PriorityPort::SetPushEventCallBack(const PushCallBack& func) {
   port_->SetPushEventCallBack(func);
@@ -57,6 +63,12 @@ bool PriorityPort::IsRunning() { return is_running_; }
 
 bool PriorityPort::IsActivated() { return port_->IsActivated(); }
 
+size_t PriorityPort::GetShard() const { return shard_; }
+void PriorityPort::SetShard(size_t shard) { shard_ = shard; }
+
+void PriorityPort::UpdateReadyTime() { ready_time_ = GetCurrentTime(); }
+int64_t PriorityPort::GetReadyTime() const { return ready_time_; }
+
 std::shared_ptr<NodeBase> PriorityPort::GetNode() const {
   auto port = GetPort();
   if (!port) {
@@ -83,6 +95,95 @@ bool PortCompare::operator()(const std::shared_ptr<PriorityPort>& left,
   return left->port_ < right->port_;
 }
 
+const std::vector<std::shared_ptr<PriorityPort>>&
+PriorityPolicy::GetAffectedPorts(const std::shared_ptr<PriorityPort>& port) {
+  static const std::vector<std::shared_ptr<PriorityPort>> empty_ports;
+  return empty_ports;
+}
+
+/* keep dynamic priority order inside each backpressure level */
+constexpr int32_t BACKPRESSURE_PRIORITY_STEP = 1 << 24;
+
+BackpressurePriorityPolicy::BackpressurePriorityPolicy(double high_watermark,
+                                                       double low_watermark)
+    : high_watermark_(high_watermark), low_watermark_(low_watermark) {}
+
+void BackpressurePriorityPolicy::AddPort(
+    const std::shared_ptr<PriorityPort>& port) {
+  auto node = port->GetNode();
+  if (node == nullptr) {
+    return;
+  }
+
+  auto iter = downstream_ports_.find(node.get());
+  if (iter == downstream_ports_.end()) {
+    std::vector<std::shared_ptr<InPort>> in_ports;
+    for (const auto& out_port : node->GetOutputPorts()) {
+      for (const auto& in_port : out_port->GetConnectInPort()) {
+        in_ports.push_back(in_port);
+      }
+    }
+
+    iter = downstream_ports_.emplace(node.get(), std::move(in_ports)).first;
+  }
+
+  for (const auto& in_port : iter->second) {
+    upstream_ports_[in_port.get()].push_back(port);
+  }
+}
+
+double BackpressurePriorityPolicy::GetDownstreamFill(NodeBase* node) {
+  auto iter = downstream_ports_.find(node);
+  if (iter == downstream_ports_.end()) {
+    return 0;
+  }
+
+  double max_fill = 0;
+  for (const auto& in_port : iter->second) {
+    auto queue = in_port->GetQueue();
+    auto capacity = queue->GetCapacity();
+    if (capacity == 0 || capacity == SIZE_MAX) {
+      continue;
+    }
+
+    auto fill = (double)queue->Size() / capacity;
+    max_fill = fill > max_fill ? fill : max_fill;
+  }
+
+  return max_fill;
+}
+
+int32_t BackpressurePriorityPolicy::GetPriority(
+    const std::shared_ptr<PriorityPort>& port) {
+  auto priority = port->GetDynamicPriority();
+  auto node = port->GetNode();
+  if (node == nullptr) {
+    return priority;
+  }
+
+  auto fill = GetDownstreamFill(node.get());
+  if (fill >= high_watermark_) {
+    return priority - BACKPRESSURE_PRIORITY_STEP;
+  }
+
+  if (fill <= low_watermark_) {
+    return priority + BACKPRESSURE_PRIORITY_STEP;
+  }
+
+  return priority;
+}
+
+const std::vector<std::shared_ptr<PriorityPort>>&
+BackpressurePriorityPolicy::GetAffectedPorts(
+    const std::shared_ptr<PriorityPort>& port) {
+  auto iter = upstream_ports_.find(port->GetPort().get());
+  if (iter == upstream_ports_.end()) {
+    return PriorityPolicy::GetAffectedPorts(port);
+  }
+
+  return iter->second;
+}
+
 DefaultDataHub::DefaultDataHub()
     : priority_ports_(), active_ports_(), active_mutex_(), cv_() {}
 
@@ -96,6 +197,24 @@ DefaultDataHub::~DefaultDataHub() {
   }
 
   priority_ports_.clear();
+  policy_ = nullptr;
+}
+
+void DefaultDataHub::SetPriorityPolicy(
+    const std::shared_ptr<PriorityPolicy>& policy) {
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  policy_ = policy;
+}
+
+void DefaultDataHub::SetRankNotify(
+    const std::function<void(const std::shared_ptr<PriorityPort>&)>& notify) {
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  rank_notify_ = notify;
+}
+
+void DefaultDataHub::AddPendingRank(const std::shared_ptr<PriorityPort>& port) {
+  std::lock_guard<std::mutex> lock(rank_mutex_);
+  pending_rank_ports_.insert(port);
 }
 
 Status DefaultDataHub::AddPort(const std::shared_ptr<PriorityPort>& port) {
@@ -112,6 +231,9 @@ Status DefaultDataHub::AddPort(const std::shared_ptr<PriorityPort>& port) {
   }
 
   priority_ports_.push_back(port);
+  if (policy_) {
+    policy_->AddPort(port);
+  }
 
   auto push_call_back = std::bind(&DefaultDataHub::PortEventCallback, this,
                                   port, std::placeholders::_1);
@@ -140,7 +262,7 @@ Status DefaultDataHub::AddToActivePort(
 
   port->SetRuning(false);
   if (port->HasData() && port->IsActivated()) {
-    active_ports_.insert(port);
+    InsertActivePort(port);
     cv_.notify_one();
   }
 
@@ -158,7 +280,7 @@ Status DefaultDataHub::AddToActivePort(
 
     port->SetRuning(false);
     if (port->HasData() && port->IsActivated()) {
-      active_ports_.insert(port);
+      InsertActivePort(port);
     }
   }
 
@@ -171,6 +293,13 @@ void DefaultDataHub::UpdateActivePort(std::shared_ptr<PriorityPort> port,
   auto it = active_ports_.find(port);
   if (active_ports_.end() != it) {
     active_ports_.erase(it);
+    if (update_active_time) {
+      port->UpdateActiveTime();
+    }
+
+    UpdatePortPriority(port);
+    active_ports_.insert(port);
+    return;
   }
 
   if (update_active_time) {
@@ -178,20 +307,107 @@ void DefaultDataHub::UpdateActivePort(std::shared_ptr<PriorityPort> port,
   }
 
   port->UpdatePriority();
-  active_ports_.insert(port);
+  InsertActivePort(port);
 };
 
+void DefaultDataHub::UpdatePortPriority(
+    const std::shared_ptr<PriorityPort>& port) {
+  port->UpdatePriority();
+  if (policy_) {
+    port->SetPriority(policy_->GetPriority(port));
+  }
+}
+
+void DefaultDataHub::InsertActivePort(
+    const std::shared_ptr<PriorityPort>& port) {
+  // priority must not change while port is in the set
+  if (active_ports_.find(port) != active_ports_.end()) {
+    return;
+  }
+
+  if (policy_) {
+    port->SetPriority(policy_->GetPriority(port));
+  }
+
+  active_ports_.insert(port);
+  port->UpdateReadyTime();
+  if (active_ports_.size() > stats_.max_active_port_num) {
+    stats_.max_active_port_num = active_ports_.size();
+  }
+}
+
 void DefaultDataHub::PortEventCallback(std::shared_ptr<PriorityPort> port,
                                        bool update_active_time) {
-  std::lock_guard<std::mutex> lock(active_mutex_);
   if (!port) {
     MBLOG_WARN << "port is nullptr";
     return;
   }
 
-  if (port->HasData() && !port->IsRunning() && port->IsActivated()) {
-    UpdateActivePort(port, update_active_time);
-    cv_.notify_one();
+  std::shared_ptr<PriorityPolicy> policy;
+  std::function<void(const std::shared_ptr<PriorityPort>&)> rank_notify;
+  {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    if (port->HasData() && !port->IsRunning() && port->IsActivated()) {
+      UpdateActivePort(port, update_active_time);
+      cv_.notify_one();
+    }
+
+    policy = policy_;
+    rank_notify = rank_notify_;
+  }
+
+  if (policy == nullptr) {
+    return;
+  }
+
+  // affected ports are ranked by the dispatcher of their data hub
+  for (const auto& affected_port : policy->GetAffectedPorts(port)) {
+    if (rank_notify) {
+      rank_notify(affected_port);
+    } else {
+      AddPendingRank(affected_port);
+    }
+  }
+}
+
+void DefaultDataHub::RankPendingPorts() {
+  std::unordered_set<std::shared_ptr<PriorityPort>> ports;
+  {
+    std::lock_guard<std::mutex> lock(rank_mutex_);
+    if (pending_rank_ports_.empty()) {
+      return;
+    }
+
+    ports.swap(pending_rank_ports_);
+  }
+
+  std::shared_ptr<PriorityPolicy> policy;
+  {
+    std::lock_guard<std::mutex> lock(active_mutex_);
+    policy = policy_;
+  }
+
+  if (policy == nullptr) {
+    return;
+  }
+
+  // policy reads downstream queues, do not hold active_mutex_ meanwhile
+  std::vector<std::pair<std::shared_ptr<PriorityPort>, int32_t>> ranks;
+  ranks.reserve(ports.size());
+  for (const auto& port : ports) {
+    ranks.emplace_back(port, policy->GetPriority(port));
+  }
+
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  for (const auto& rank : ranks) {
+    auto it = active_ports_.find(rank.first);
+    if (it == active_ports_.end() || rank.first->GetPriority() == rank.second) {
+      continue;
+    }
+
+    active_ports_.erase(it);
+    rank.first->SetPriority(rank.second);
+    active_ports_.insert(rank.first);
   }
 }
 
@@ -207,7 +423,8 @@ void DefaultDataHub::PortEventCallback(std::shared_ptr<PriorityPort> port,
  */
 Status DefaultDataHub::SelectActivePort(
     std::shared_ptr<PriorityPort>* active_port, int64_t timeout) {
-  auto pred = [this] { return !active_ports_.empty(); };
+  auto pred = [this] { return !active_ports_.empty() || wakeup_; };
+  RankPendingPorts();
   std::unique_lock<std::mutex> lock(active_mutex_);
 
   if (timeout > 0) {
@@ -216,10 +433,15 @@ Status DefaultDataHub::SelectActivePort(
     }
   } else if (0 == timeout) {
     cv_.wait(lock, pred);
-  } else {
-    if (active_ports_.empty()) {
-      return STATUS_NODATA;
-    }
+  }
+
+  if (wakeup_) {
+    wakeup_ = false;
+    return STATUS_NODATA;
+  }
+
+  if (active_ports_.empty()) {
+    return STATUS_NODATA;
   }
 
   auto it = active_ports_.begin();
@@ -227,9 +449,30 @@ Status DefaultDataHub::SelectActivePort(
   (*active_port)->SetRuning(true);
   active_ports_.erase(it);
 
+  auto latency = GetCurrentTime() - (*active_port)->GetReadyTime();
+  latency = latency > 0 ? latency : 0;
+  stats_.dispatch_count++;
+  stats_.dispatch_latency_us += latency;
+  if ((uint64_t)latency > stats_.max_dispatch_latency_us) {
+    stats_.max_dispatch_latency_us = latency;
+  }
+
   return STATUS_OK;
 }
 
+void DefaultDataHub::Wakeup() {
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  wakeup_ = true;
+  cv_.notify_all();
+}
+
+DataHubStats DefaultDataHub::GetStats() {
+  std::lock_guard<std::mutex> lock(active_mutex_);
+  auto stats = stats_;
+  stats.active_port_num = active_ports_.size();
+  return stats;
+}
+
 void DefaultDataHub::RemoveFromActivePort(
     std::vector<std::shared_ptr<PriorityPort>>& ports) {
   std::unique_lock<std::mutex> lock(active_mutex_);
@@ -247,4 +490,155 @@ size_t DefaultDataHub::GetPortNum() const { return priority_ports_.size(); }
 
 size_t DefaultDataHub::GetActivePortNum() const { return active_ports_.size(); }
 
+ShardedDataHub::ShardedDataHub(size_t shard_num) {
+  if (shard_num == 0) {
+    shard_num = 1;
+  }
+
+  for (size_t i = 0; i < shard_num; ++i) {
+    shards_.push_back(std::make_shared<DefaultDataHub>());
+  }
+}
+
+ShardedDataHub::~ShardedDataHub() {
+  shards_.clear();
+  node_shard_.clear();
+}
+
+size_t ShardedDataHub::GetNodeShard(const std::shared_ptr<PriorityPort>& port) {
+  auto node = port->GetNode();
+  if (node == nullptr) {
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> lock(shard_mutex_);
+  auto iter = node_shard_.find(node.get());
+  if (iter != node_shard_.end()) {
+    return iter->second;
+  }
+
+  auto shard = next_shard_;
+  next_shard_ = (next_shard_ + 1) % shards_.size();
+  node_shard_[node.get()] = shard;
+  return shard;
+}
+
+Status ShardedDataHub::AddPort(const std::shared_ptr<PriorityPort>& port) {
+  if (!port) {
+    MBLOG_WARN << "port is nullptr";
+    return STATUS_INVALID;
+  }
+
+  auto shard = GetNodeShard(port);
+  port->SetShard(shard);
+  return shards_[shard]->AddPort(port);
+}
+
+Status ShardedDataHub::SelectActivePort(
+    std::shared_ptr<PriorityPort>* active_port, int64_t timeout) {
+  return SelectActivePort(0, active_port, timeout);
+}
+
+Status ShardedDataHub::SelectActivePort(
+    size_t shard, std::shared_ptr<PriorityPort>* active_port,
+    int64_t timeout) {
+  if (shard >= shards_.size()) {
+    return {STATUS_RANGE, "invalid shard " + std::to_string(shard)};
+  }
+
+  return shards_[shard]->SelectActivePort(active_port, timeout);
+}
+
+size_t ShardedDataHub::GetPortNum() const {
+  size_t num = 0;
+  for (const auto& shard : shards_) {
+    num += shard->GetPortNum();
+  }
+
+  return num;
+}
+
+size_t ShardedDataHub::GetActivePortNum() const {
+  size_t num = 0;
+  for (const auto& shard : shards_) {
+    num += shard->GetActivePortNum();
+  }
+
+  return num;
+}
+
+void ShardedDataHub::RemoveFromActivePort(
+    std::vector<std::shared_ptr<PriorityPort>>& ports) {
+  std::vector<std::vector<std::shared_ptr<PriorityPort>>> shard_ports(
+      shards_.size());
+  for (auto& port : ports) {
+    shard_ports[port->GetShard()].push_back(port);
+  }
+
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    if (!shard_ports[i].empty()) {
+      shards_[i]->RemoveFromActivePort(shard_ports[i]);
+    }
+  }
+}
+
+Status ShardedDataHub::AddToActivePort(
+    std::vector<std::shared_ptr<PriorityPort>>& ports) {
+  std::vector<std::vector<std::shared_ptr<PriorityPort>>> shard_ports(
+      shards_.size());
+  for (auto& port : ports) {
+    if (!port) {
+      MBLOG_WARN << "active_port is nullptr";
+      continue;
+    }
+
+    shard_ports[port->GetShard()].push_back(port);
+  }
+
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    if (!shard_ports[i].empty()) {
+      shards_[i]->AddToActivePort(shard_ports[i]);
+    }
+  }
+
+  return STATUS_OK;
+}
+
+Status ShardedDataHub::AddToActivePort(
+    const std::shared_ptr<PriorityPort>& port) {
+  if (!port) {
+    return {STATUS_INVALID, "active_port is nullptr"};
+  }
+
+  return shards_[port->GetShard()]->AddToActivePort(port);
+}
+
+void ShardedDataHub::Wakeup() {
+  for (auto& shard : shards_) {
+    shard->Wakeup();
+  }
+}
+
+size_t ShardedDataHub::GetShardNum() const { return shards_.size(); }
+
+void ShardedDataHub::SetPriorityPolicy(
+    const std::shared_ptr<PriorityPolicy>& policy) {
+  auto rank_notify = [this](const std::shared_ptr<PriorityPort>& port) {
+    shards_[port->GetShard()]->AddPendingRank(port);
+  };
+
+  for (auto& shard : shards_) {
+    shard->SetPriorityPolicy(policy);
+    shard->SetRankNotify(rank_notify);
+  }
+}
+
+DataHubStats ShardedDataHub::GetStats(size_t shard) {
+  if (shard >= shards_.size()) {
+    return DataHubStats();
+  }
+
+  return shards_[shard]->GetStats();
+}
+
 }  // namespace modelbox
@@ -24,9 +24,13 @@
 #include <modelbox/buffer.h>
 #include <modelbox/port.h>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace modelbox {
 
@@ -50,6 +54,12 @@ class PriorityPort {
   // TODO port优先级更新
   void UpdatePriority();
 
+  /**
+   * @brief Priority of port data read by last UpdatePriority, before any
+   * adjustment of priority policy
+   */
+  int32_t GetDynamicPriority() const;
+
   void SetPushEventCallBack(const PushCallBack& func);
   void SetPopEventCallBack(const PopCallBack& func);
 
@@ -61,15 +71,41 @@ class PriorityPort {
 
   bool IsActivated();
 
+  /**
+   * @brief Shard of data hub this port belongs to
+   */
+  size_t GetShard() const;
+  void SetShard(size_t shard);
+
+  /**
+   * @brief Time when port enters active set, for dispatch latency
+   */
+  void UpdateReadyTime();
+  int64_t GetReadyTime() const;
+
   friend PortCompare;
 
  private:
   int32_t priority_{0};
+  std::atomic<int32_t> dynamic_priority_{0};
   int64_t active_time_{0};
+  int64_t ready_time_{0};
+  size_t shard_{0};
   bool is_running_{false};
   std::shared_ptr<IPort> port_;
 };
 
+/**
+ * @brief Dispatch statistics of one data hub shard
+ */
+struct DataHubStats {
+  uint64_t dispatch_count{0};
+  uint64_t dispatch_latency_us{0};
+  uint64_t max_dispatch_latency_us{0};
+  size_t active_port_num{0};
+  size_t max_active_port_num{0};
+};
+
 /**
  * @brief DataHub Class interface
  * Pure virtual class, can not instantiable
@@ -91,6 +127,11 @@ class DataHub {
   virtual Status AddToActivePort(
       std::vector<std::shared_ptr<PriorityPort>>& ports) = 0;
   virtual Status AddToActivePort(const std::shared_ptr<PriorityPort>& port) = 0;
+
+  /**
+   * @brief Wake up blocking SelectActivePort, it returns STATUS_NODATA
+   */
+  virtual void Wakeup(){};
 };
 
 class PortCompare {
@@ -99,6 +140,63 @@ class PortCompare {
                   const std::shared_ptr<PriorityPort>& right);
 };
 
+/**
+ * @brief Policy to compute priority of port when it is ranked in data hub
+ */
+class PriorityPolicy {
+ public:
+  virtual ~PriorityPolicy() = default;
+
+  /**
+   * @brief Called when port is added to data hub
+   */
+  virtual void AddPort(const std::shared_ptr<PriorityPort>& port){};
+
+  /**
+   * @brief Compute priority of port from its dynamic priority
+   */
+  virtual int32_t GetPriority(const std::shared_ptr<PriorityPort>& port) = 0;
+
+  /**
+   * @brief Ports whose priority depends on state of port
+   * @param port port has data pushed or popped
+   * @return ports need to be ranked again
+   */
+  virtual const std::vector<std::shared_ptr<PriorityPort>>& GetAffectedPorts(
+      const std::shared_ptr<PriorityPort>& port);
+};
+
+/**
+ * @brief Priority adjusted by fill level of downstream input queues.
+ * Ports feeding full queues are demoted, ports whose downstream queues are
+ * draining are boosted, dynamic priority orders ports in the same level.
+ * One policy may be shared by several data hubs, all ports must be added
+ * before they are scheduled.
+ */
+class BackpressurePriorityPolicy : public PriorityPolicy {
+ public:
+  BackpressurePriorityPolicy(double high_watermark = 0.8,
+                             double low_watermark = 0.2);
+  virtual ~BackpressurePriorityPolicy() = default;
+
+  void AddPort(const std::shared_ptr<PriorityPort>& port) override;
+
+  int32_t GetPriority(const std::shared_ptr<PriorityPort>& port) override;
+
+  const std::vector<std::shared_ptr<PriorityPort>>& GetAffectedPorts(
+      const std::shared_ptr<PriorityPort>& port) override;
+
+ private:
+  double GetDownstreamFill(NodeBase* node);
+
+  double high_watermark_;
+  double low_watermark_;
+  std::unordered_map<NodeBase*, std::vector<std::shared_ptr<InPort>>>
+      downstream_ports_;
+  std::unordered_map<IPort*, std::vector<std::shared_ptr<PriorityPort>>>
+      upstream_ports_;
+};
+
 /**
  * @brief DataHub default implementation class
  *
@@ -122,17 +220,98 @@ class DefaultDataHub : public DataHub {
       std::vector<std::shared_ptr<PriorityPort>>& ports) override;
   Status AddToActivePort(const std::shared_ptr<PriorityPort>& port) override;
 
+  void Wakeup() override;
+
+  DataHubStats GetStats();
+
+  /**
+   * @brief Set policy to rank ports, must be called before AddPort
+   */
+  void SetPriorityPolicy(const std::shared_ptr<PriorityPolicy>& policy);
+
+  /**
+   * @brief Rank port again in next SelectActivePort
+   */
+  void AddPendingRank(const std::shared_ptr<PriorityPort>& port);
+
+  /**
+   * @brief Route ports affected by port events to the data hub owning them,
+   * default is AddPendingRank of this data hub
+   */
+  void SetRankNotify(
+      const std::function<void(const std::shared_ptr<PriorityPort>&)>& notify);
+
  private:
   void PortEventCallback(std::shared_ptr<PriorityPort> port,
                          bool update_active_time);
   void UpdateActivePort(std::shared_ptr<PriorityPort> port,
                         bool update_active_time = true);
+  void InsertActivePort(const std::shared_ptr<PriorityPort>& port);
+  void UpdatePortPriority(const std::shared_ptr<PriorityPort>& port);
+  void RankPendingPorts();
 
   std::vector<std::shared_ptr<PriorityPort>> priority_ports_;
   std::set<std::shared_ptr<PriorityPort>, PortCompare> active_ports_;
 
   std::mutex active_mutex_;
   std::condition_variable cv_;
+  bool wakeup_{false};
+  DataHubStats stats_;
+  std::shared_ptr<PriorityPolicy> policy_;
+  std::function<void(const std::shared_ptr<PriorityPort>&)> rank_notify_;
+  std::mutex rank_mutex_;
+  std::unordered_set<std::shared_ptr<PriorityPort>> pending_rank_ports_;
+};
+
+/**
+ * @brief DataHub split into shards, each shard is selected by its own
+ * dispatcher. All ports of a node are in the same shard, priority is kept
+ * inside a shard.
+ */
+class ShardedDataHub : public DataHub {
+ public:
+  ShardedDataHub(size_t shard_num);
+  virtual ~ShardedDataHub() override;
+
+  Status AddPort(const std::shared_ptr<PriorityPort>& port) override;
+
+  /* select from shard 0 */
+  Status SelectActivePort(std::shared_ptr<PriorityPort>* active_port,
+                          int64_t timeout = 0) override;
+
+  Status SelectActivePort(size_t shard,
+                          std::shared_ptr<PriorityPort>* active_port,
+                          int64_t timeout = 0);
+
+  size_t GetPortNum() const override;
+
+  size_t GetActivePortNum() const override;
+
+  void RemoveFromActivePort(
+      std::vector<std::shared_ptr<PriorityPort>>& ports) override;
+  Status AddToActivePort(
+      std::vector<std::shared_ptr<PriorityPort>>& ports) override;
+  Status AddToActivePort(const std::shared_ptr<PriorityPort>& port) override;
+
+  void Wakeup() override;
+
+  size_t GetShardNum() const;
+
+  DataHubStats GetStats(size_t shard);
+
+  /**
+   * @brief Set policy shared by all shards, so backpressure of a port is
+   * seen by upstream ports in other shards
+   */
+  void SetPriorityPolicy(const std::shared_ptr<PriorityPolicy>& policy);
+
+ private:
+  size_t GetNodeShard(const std::shared_ptr<PriorityPort>& port);
+
+  std::vector<std::shared_ptr<DefaultDataHub>> shards_;
+  std::mutex shard_mutex_;
+  std::unordered_map<NodeBase*, size_t> node_shard_;
+  size_t next_shard_{0};
 };
 
 }  // namespace modelbox
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "engine/common/dynamic_batcher.h"
+
+#include <algorithm>
+
+#include "modelbox/base/log.h"
+#include "modelbox/base/utils.h"
+
+namespace modelbox {
+
+/* runs between two tunes of target batch size */
+constexpr uint32_t BATCH_TUNE_INTERVAL = 16;
+/* per buffer latency must be better by this ratio to move target */
+constexpr double BATCH_TUNE_GAIN = 0.95;
+
+DynamicBatcher::DynamicBatcher(const std::string &name,
+                               const std::vector<std::shared_ptr<InPort>> &ports,
+                               uint32_t max_batch_size, uint32_t max_wait_ms,
+                               std::shared_ptr<FlowUnitPerfCtx> perf_ctx)
+    : name_(name),
+      ports_(ports),
+      max_batch_size_(max_batch_size),
+      max_wait_us_((int64_t)max_wait_ms * 1000),
+      perf_ctx_(perf_ctx) {
+  // batch can not be larger than queue
+  for (const auto &port : ports_) {
+    auto capacity = port->GetQueue()->GetCapacity();
+    if (capacity > 0 && capacity < max_batch_size_) {
+      max_batch_size_ = capacity;
+    }
+  }
+
+  max_batch_size_ = max_batch_size_ > 0 ? max_batch_size_ : 1;
+  target_batch_size_ = max_batch_size_;
+  if (perf_ctx_ == nullptr) {
+    perf_ctx_ = std::make_shared<FlowUnitPerfCtx>(name);
+  }
+
+  // deadline relies on timer, hold it running
+  TimerGlobal::Start();
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  if (wait_timer_ != nullptr) {
+    wait_timer_->Stop();
+    wait_timer_ = nullptr;
+  }
+
+  TimerGlobal::Stop();
+}
+
+void DynamicBatcher::Init() {
+  std::weak_ptr<DynamicBatcher> batcher_ref = shared_from_this();
+  for (auto &port : ports_) {
+    port->SetActivateGate([batcher_ref]() {
+      auto batcher = batcher_ref.lock();
+      return batcher == nullptr || batcher->IsPortReady();
+    });
+  }
+
+  wait_timer_ = std::make_shared<TimerTask>([batcher_ref]() {
+    auto batcher = batcher_ref.lock();
+    if (batcher != nullptr) {
+      batcher->OnDeadline();
+    }
+  });
+  wait_timer_->SetName(name_ + "_BatchWait");
+
+  MBLOG_INFO << "node " << name_ << " dynamic batch, max batch size "
+             << max_batch_size_ << ", max wait " << max_wait_us_ / 1000
+             << "ms";
+}
+
+size_t DynamicBatcher::GetPendingCount() {
+  size_t pending = SIZE_MAX;
+  for (const auto &port : ports_) {
+    pending = std::min(pending, (size_t)port->GetDataCount());
+  }
+
+  return pending == SIZE_MAX ? 0 : pending;
+}
+
+bool DynamicBatcher::IsPortReady() {
+  if (!waiting_) {
+    return true;
+  }
+
+  return GetPendingCount() >= target_batch_size_;
+}
+
+bool DynamicBatcher::Ready() {
+  auto pending = GetPendingCount();
+  if (pending == 0 || pending >= target_batch_size_) {
+    StopWait();
+    return true;
+  }
+
+  auto now = GetCurrentTime();
+  if (wait_begin_ == 0) {
+    wait_begin_ = now;
+  }
+
+  auto waited = now - wait_begin_;
+  if (waited >= max_wait_us_) {
+    StopWait();
+    deadline_count_++;
+    return true;
+  }
+
+  StartWait(max_wait_us_ - waited);
+  return false;
+}
+
+void DynamicBatcher::StartWait(int64_t remain_us) {
+  // deadline is fixed when the wait begins, timer armed for it still holds
+  if (wait_timer_ == nullptr || waiting_.exchange(true)) {
+    return;
+  }
+
+  TimerGlobal::Schedule(wait_timer_, (remain_us + 999) / 1000, 0);
+}
+
+void DynamicBatcher::StopWait() {
+  waiting_ = false;
+  wait_begin_ = 0;
+  if (wait_timer_ != nullptr) {
+    wait_timer_->Stop();
+  }
+}
+
+void DynamicBatcher::OnDeadline() {
+  waiting_ = false;
+  for (auto &port : ports_) {
+    port->NotifyPushEvent(false);
+  }
+}
+
+void DynamicBatcher::Update(uint32_t batch_size, int64_t latency_us) {
+  if (batch_size == 0) {
+    return;
+  }
+
+  perf_ctx_->UpdateBatchProcessLatency(batch_size, (int32_t)latency_us);
+  run_count_++;
+  batch_total_ += batch_size;
+  if (run_count_ < BATCH_TUNE_INTERVAL) {
+    return;
+  }
+
+  Tune();
+  run_count_ = 0;
+  deadline_count_ = 0;
+  batch_total_ = 0;
+}
+
+void DynamicBatcher::Tune() {
+  uint32_t target = target_batch_size_;
+  uint32_t new_target = target;
+
+  if (deadline_count_ * 2 > run_count_) {
+    // data arrives too slow to fill target before deadline, waiting longer
+    // only adds latency, follow the batch size actually reached
+    auto avg_batch = (batch_total_ + run_count_ - 1) / run_count_;
+    new_target = (uint32_t)std::min<uint64_t>(avg_batch, target);
+  } else {
+    // move towards batch size with lower latency per buffer
+    auto step = std::max<uint32_t>(1, target / 4);
+    auto latency = perf_ctx_->GetBatchProcessLatency(target);
+    auto cost = latency > 0 ? (double)latency / target : 0;
+    auto up = std::min(max_batch_size_, target + step);
+    auto down = target > step ? target - step : 1;
+    auto up_latency = perf_ctx_->GetBatchProcessLatency(up);
+    auto down_latency = perf_ctx_->GetBatchProcessLatency(down);
+    if (up != target &&
+        (up_latency == 0 || (double)up_latency / up < cost * BATCH_TUNE_GAIN)) {
+      new_target = up;
+    } else if (down != target && down_latency > 0 &&
+               (double)down_latency / down < cost * BATCH_TUNE_GAIN) {
+      new_target = down;
+    }
+  }
+
+  new_target = std::max<uint32_t>(1, std::min(new_target, max_batch_size_));
+  if (new_target != target) {
+    MBLOG_DEBUG << "node " << name_ << " dynamic batch size " << target
+                << " -> " << new_target;
+    target_batch_size_ = new_target;
+  }
+}
+
+uint32_t DynamicBatcher::GetTargetBatchSize() { return target_batch_size_; }
+
+std::shared_ptr<FlowUnitPerfCtx> DynamicBatcher::GetPerfCtx() {
+  return perf_ctx_;
+}
+
+}  // namespace modelbox
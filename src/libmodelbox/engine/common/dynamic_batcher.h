@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MODELBOX_DYNAMIC_BATCHER_H_
+#define MODELBOX_DYNAMIC_BATCHER_H_
+
+#include <modelbox/base/timer.h>
+#include <modelbox/port.h>
+#include <modelbox/profiler.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace modelbox {
+
+constexpr const uint32_t DEFAULT_MAX_BATCH_WAIT_MS = 10;
+
+/**
+ * @brief Hold a node until enough data is queued for a batch, or the wait
+ * deadline is reached. Target batch size is tuned from process latency of
+ * each batch size.
+ */
+class DynamicBatcher : public std::enable_shared_from_this<DynamicBatcher> {
+ public:
+  /**
+   * @brief Construct dynamic batcher
+   * @param name node name
+   * @param ports input ports of node
+   * @param max_batch_size max batch size, batch_size of node
+   * @param max_wait_ms max time to wait for a batch
+   * @param perf_ctx perf context to keep batch latency, nullptr to create one
+   */
+  DynamicBatcher(const std::string &name,
+                 const std::vector<std::shared_ptr<InPort>> &ports,
+                 uint32_t max_batch_size, uint32_t max_wait_ms,
+                 std::shared_ptr<FlowUnitPerfCtx> perf_ctx = nullptr);
+
+  virtual ~DynamicBatcher();
+
+  /**
+   * @brief Install activate gate to input ports and create wait timer
+   */
+  void Init();
+
+  /**
+   * @brief Whether node should run now, if not, ports are held until batch
+   * is ready or deadline.
+   * @return true to run node
+   */
+  bool Ready();
+
+  /**
+   * @brief Record process latency of a batch and tune target batch size
+   * @param batch_size number of buffers processed
+   * @param latency_us process latency in us
+   */
+  void Update(uint32_t batch_size, int64_t latency_us);
+
+  /**
+   * @brief Called by port, whether port could be scheduled
+   */
+  bool IsPortReady();
+
+  uint32_t GetTargetBatchSize();
+
+  std::shared_ptr<FlowUnitPerfCtx> GetPerfCtx();
+
+ private:
+  size_t GetPendingCount();
+  void StartWait(int64_t remain_us);
+  void StopWait();
+  void OnDeadline();
+  void Tune();
+
+  std::string name_;
+  std::vector<std::shared_ptr<InPort>> ports_;
+  uint32_t max_batch_size_;
+  int64_t max_wait_us_;
+  std::atomic<uint32_t> target_batch_size_;
+  std::atomic<bool> waiting_{false};
+  int64_t wait_begin_{0};
+  std::shared_ptr<TimerTask> wait_timer_;
+  std::shared_ptr<FlowUnitPerfCtx> perf_ctx_;
+
+  // tune window
+  uint32_t run_count_{0};
+  uint32_t deadline_count_{0};
+  uint64_t batch_total_{0};
+};
+
+}  // namespace modelbox
+
+#endif  // MODELBOX_DYNAMIC_BATCHER_H_
@@ -654,9 +654,39 @@ Status FlowUnitDataContext::AppendOutputMap(OutputIndexBuffer *map) {
   if (output_data_->IsEmpty()) {
     return {STATUS_FAULT, "output data is empty."};
   }
+  MarkSharedOutput();
   return output_data_->AppendOutputMap(map);
 }
 
+void FlowUnitDataContext::MarkSharedOutput() {
+  if (node_ == nullptr) {
+    return;
+  }
+
+  // one buffer may be put to several ports, and each port may feed several
+  // receivers, count the receivers per buffer over the whole node
+  std::unordered_map<Buffer *, size_t> receiver_count;
+  for (auto &item : output_) {
+    auto port = node_->GetOutputPort(item.first);
+    if (port == nullptr || item.second == nullptr) {
+      continue;
+    }
+
+    auto port_receiver_num = port->GetConnectInPort().size();
+    for (auto &buffer : *item.second) {
+      if (buffer != nullptr) {
+        receiver_count[buffer.get()] += port_receiver_num;
+      }
+    }
+  }
+
+  for (auto &item : receiver_count) {
+    if (item.second > 1) {
+      item.first->SetDataShared();
+    }
+  }
+}
+
 void FlowUnitDataContext::SetStatus(Status status) {
   process_status_ = status;
   last_process_status_ = status;
@@ -16,8 +16,12 @@
 
 #include "modelbox/flowunit_balancer.h"
 
+#include <algorithm>
+
 namespace modelbox {
 
+constexpr double CAPABILITY_COST_WEIGHT = 0.2;
+
 static std::unordered_map<FlowUnitBalanceStrategy, std::string,
                           FUBalanceStrategyHash>
     g_strategy_name_map = {
@@ -30,6 +34,28 @@ std::ostream& operator<<(std::ostream& os, const FlowUnitBalanceStrategy& s) {
   return os;
 }
 
+Status GetFlowUnitBalanceStrategy(const std::string& name,
+                                  FlowUnitBalanceStrategy* strategy) {
+  auto lower_name = name;
+  std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(),
+                 ::tolower);
+  for (const auto& item : g_strategy_name_map) {
+    if (item.first == FlowUnitBalanceStrategy::FU_NULL) {
+      continue;
+    }
+
+    auto strategy_name = item.second;
+    std::transform(strategy_name.begin(), strategy_name.end(),
+                   strategy_name.begin(), ::tolower);
+    if (strategy_name == lower_name) {
+      *strategy = item.first;
+      return STATUS_OK;
+    }
+  }
+
+  return {STATUS_BADCONF, "unsupported balance strategy " + name};
+}
+
 Status FlowUnitBalancer::Init(
     const std::vector<std::shared_ptr<FlowUnit>>& flowunits) {
   if (flowunits.empty()) {
@@ -78,8 +104,19 @@ std::shared_ptr<FlowUnit> FlowUnitBalancer::FirstBind(
 }
 
 void FlowUnitBalancer::UnbindFlowUnit(const FlowUnitDataContext* data_ctx_ptr) {
-  std::lock_guard<std::mutex> lock(ctx_to_flowunit_map_lock_);
-  ctx_to_flowunit_map_.erase(data_ctx_ptr);
+  std::shared_ptr<FlowUnit> fu;
+  {
+    std::lock_guard<std::mutex> lock(ctx_to_flowunit_map_lock_);
+    auto item = ctx_to_flowunit_map_.find(data_ctx_ptr);
+    if (item == ctx_to_flowunit_map_.end()) {
+      return;
+    }
+
+    fu = item->second;
+    ctx_to_flowunit_map_.erase(item);
+  }
+
+  OnUnbindFlowUnit(fu);
 }
 
 FlowUnitBalancerFactory& FlowUnitBalancerFactory::GetInstance() {
@@ -196,4 +233,123 @@ std::shared_ptr<FlowUnit> FURoundRobinBalancer::GetNextFU() {
   return fu;
 }
 
-}  // namespace modelbox
\ No newline at end of file
+REGIST_FLOWUNIT_BALANCER(FUCapabilityBalancer);
+
+FlowUnitBalanceStrategy FUCapabilityBalancer::GetType() {
+  return FlowUnitBalanceStrategy::FU_CAPABILITY;
+}
+
+bool FUCapabilityBalancer::NeedProcessCost() { return true; }
+
+void FUCapabilityBalancer::UpdateProcessCost(const FlowUnit* flowunit,
+                                             size_t data_num,
+                                             int64_t cost_us) {
+  if (data_num == 0 || cost_us < 0) {
+    return;
+  }
+
+  auto cost_per_data = (double)cost_us / data_num;
+  std::lock_guard<std::mutex> lock(capability_lock_);
+  auto item = capability_.find(flowunit);
+  if (item == capability_.end()) {
+    return;
+  }
+
+  auto& capability = item->second;
+  if (capability.cost_per_data_us <= 0) {
+    capability.cost_per_data_us = cost_per_data;
+    return;
+  }
+
+  capability.cost_per_data_us =
+      capability.cost_per_data_us * (1 - CAPABILITY_COST_WEIGHT) +
+      cost_per_data * CAPABILITY_COST_WEIGHT;
+}
+
+Status FUCapabilityBalancer::OnInit() {
+  for (auto& fu : flowunits_) {
+    if (fu == nullptr) {
+      continue;
+    }
+
+    device_to_fu_list_[fu->GetBindDevice().get()].push_back(fu);
+    capability_[fu.get()] = FUCapability();
+  }
+
+  return STATUS_OK;
+}
+
+std::shared_ptr<FlowUnit> FUCapabilityBalancer::BindFlowUnit(
+    const std::shared_ptr<FlowUnitDataContext>& data_ctx) {
+  // prefer flowunits on the device of input to avoid memory copy
+  std::vector<std::shared_ptr<FlowUnit>> candidates;
+  auto devices = util.GetInputDevices(data_ctx);
+  for (auto& device : devices) {
+    auto item = device_to_fu_list_.find(device.get());
+    if (item == device_to_fu_list_.end()) {
+      continue;
+    }
+
+    candidates.insert(candidates.end(), item->second.begin(),
+                      item->second.end());
+  }
+
+  if (candidates.empty()) {
+    return SelectFlowUnit(flowunits_);
+  }
+
+  return SelectFlowUnit(candidates);
+}
+
+void FUCapabilityBalancer::OnUnbindFlowUnit(
+    const std::shared_ptr<FlowUnit>& flowunit) {
+  std::lock_guard<std::mutex> lock(capability_lock_);
+  auto item = capability_.find(flowunit.get());
+  if (item == capability_.end() || item->second.bound_ctx_num == 0) {
+    return;
+  }
+
+  item->second.bound_ctx_num--;
+}
+
+std::shared_ptr<FlowUnit> FUCapabilityBalancer::SelectFlowUnit(
+    const std::vector<std::shared_ptr<FlowUnit>>& candidates) {
+  std::lock_guard<std::mutex> lock(capability_lock_);
+  // flowunit not measured yet uses the lowest known cost, so it will be tried
+  double default_cost = 0;
+  for (auto& fu : candidates) {
+    auto cost = capability_[fu.get()].cost_per_data_us;
+    if (cost > 0 && (default_cost <= 0 || cost < default_cost)) {
+      default_cost = cost;
+    }
+  }
+
+  if (default_cost <= 0) {
+    default_cost = 1;
+  }
+
+  std::shared_ptr<FlowUnit> best_fu;
+  FUCapability* best_capability = nullptr;
+  double best_load = 0;
+  auto start = fu_index_++;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    auto& fu = candidates[(start + i) % candidates.size()];
+    auto& capability = capability_[fu.get()];
+    auto cost = capability.cost_per_data_us > 0 ? capability.cost_per_data_us
+                                                : default_cost;
+    auto load = (capability.bound_ctx_num + 1) * cost;
+    if (best_fu == nullptr || load < best_load) {
+      best_fu = fu;
+      best_capability = &capability;
+      best_load = load;
+    }
+  }
+
+  if (best_capability != nullptr) {
+    best_capability->bound_ctx_num++;
+  }
+
+  return best_fu;
+}
+
+}  // namespace modelbox
@@ -16,6 +16,8 @@
 
 #include "modelbox/flowunit_data_executor.h"
 
+#include <chrono>
+
 #include "modelbox/node.h"
 
 namespace modelbox {
@@ -903,6 +905,21 @@ Status FlowUnitExecDataView::DevideExecCtxByFlowunit() {
   return STATUS_SUCCESS;
 }
 
+static size_t GetExecDataNum(
+    const std::shared_ptr<ExecutorDataContext> &data_ctx) {
+  auto inputs = data_ctx->Input();
+  if (inputs != nullptr) {
+    for (auto &item : *inputs) {
+      if (item.second != nullptr && item.second->Size() > 0) {
+        return item.second->Size();
+      }
+    }
+  }
+
+  // event and source flowunit process once without input
+  return 1;
+}
+
 FlowUnitDataExecutor::FlowUnitDataExecutor(std::weak_ptr<Node> node_ref,
                                            size_t batch_size)
     : node_ref_(node_ref), batch_size_(batch_size) {}
@@ -913,6 +930,7 @@ Status FlowUnitDataExecutor::DataCtxExecuteFunc(
   auto &batched_fu_data_ctx = process_data[data_ctx_idx];
   for (auto &data_ctx : batched_fu_data_ctx) {
     Status status = STATUS_FAULT;
+    auto begin = std::chrono::steady_clock::now();
     try {
       status = flowunit->Process(data_ctx);
     } catch (const std::exception &e) {
@@ -922,6 +940,13 @@ Status FlowUnitDataExecutor::DataCtxExecuteFunc(
       status = {STATUS_SHUTDOWN, msg};
     }
 
+    if (process_cost_callback_) {
+      auto cost = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - begin)
+                      .count();
+      process_cost_callback_(flowunit, GetExecDataNum(data_ctx), cost);
+    }
+
     data_ctx->SetStatus(status);
     /** Only STOP and SHUTDOWN will be transparent
      * STOP means to stop scheduling, SHUTDOWN means that a fatal error
@@ -939,6 +964,11 @@ void FlowUnitDataExecutor::SetNeedCheckOutput(bool need_check) {
   need_check_output_ = need_check;
 }
 
+void FlowUnitDataExecutor::SetProcessCostCallback(
+    const FUProcessCostCallback &callback) {
+  process_cost_callback_ = callback;
+}
+
 Status FlowUnitDataExecutor::Process(const FUExecContextList &exec_ctx_list) {
   /**
    * for event type data ctx list, all inputs is 0. (videodemuxer event input)
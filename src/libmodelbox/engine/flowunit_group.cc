@@ -28,7 +28,8 @@ void FlowUnitGroup::InitTrace() {
   }
 
   auto trace = profiler_->GetTrace();
-  if (trace == nullptr) {
+  auto trace_recorder = profiler_->GetTraceRecorder();
+  if (trace == nullptr && trace_recorder == nullptr) {
     return;
   }
 
@@ -39,6 +40,15 @@ void FlowUnitGroup::InitTrace() {
     return;
   }
 
+  if (trace_recorder != nullptr) {
+    trace_name_id_ = trace_recorder->RegisterName(node->GetName());
+    trace_recorder_ = trace_recorder;
+  }
+
+  if (trace == nullptr) {
+    return;
+  }
+
   flowunit_trace_ = trace->FlowUnit(node->GetName());
   if (flowunit_trace_ == nullptr) {
     MBLOG_WARN << "create trace for node " << node->GetName() << " failed";
@@ -46,10 +56,10 @@ void FlowUnitGroup::InitTrace() {
 }
 
 std::shared_ptr<TraceSlice> FlowUnitGroup::StartTrace(
-    FUExecContextList &exec_ctx_list) {
+    FUExecContextList &exec_ctx_list, TraceRecordSpan &span) {
   std::call_once(trace_init_flag_, &FlowUnitGroup::InitTrace, this);
 
-  if (flowunit_trace_ == nullptr) {
+  if (flowunit_trace_ == nullptr && trace_recorder_ == nullptr) {
     return nullptr;
   }
 
@@ -67,16 +77,28 @@ std::shared_ptr<TraceSlice> FlowUnitGroup::StartTrace(
         return sum + input_count;
       });
 
+  if (trace_recorder_ != nullptr) {
+    span.Begin(trace_recorder_.get(), trace_name_id_, TraceSliceType::PROCESS,
+               total_input_count);
+  }
+
+  if (flowunit_trace_ == nullptr) {
+    return nullptr;
+  }
+
   auto slice = flowunit_trace_->Slice(TraceSliceType::PROCESS, "");
   slice->SetBatchSize(total_input_count);
   slice->Begin();
   return slice;
 }
 
-void FlowUnitGroup::StopTrace(std::shared_ptr<TraceSlice> &slice) {
+void FlowUnitGroup::StopTrace(std::shared_ptr<TraceSlice> &slice,
+                              TraceRecordSpan &span) {
   if (slice != nullptr) {
     slice->End();
   }
+
+  span.End();
 }
 
 void FlowUnitGroup::PreProcess(FUExecContextList &exec_ctx_list,
@@ -153,9 +175,10 @@ Status FlowUnitGroup::Process(FUExecContextList &exec_ctx_list) {
     return STATUS_SUCCESS;
   }
 
-  auto slice = StartTrace(actual_exec_ctx_list);
+  TraceRecordSpan span;
+  auto slice = StartTrace(actual_exec_ctx_list, span);
   auto status = executor_->Process(actual_exec_ctx_list);
-  StopTrace(slice);
+  StopTrace(slice, span);
   if (!status) {
     MBLOG_WARN << "execute unit " << unit_name_ << " failed: " << status;
     return STATUS_STOP;
@@ -451,12 +474,21 @@ Status FlowUnitGroup::Open(const CreateExternalDataFunc &create_func) {
   }
 
   bool need_check_output = false;
+  auto balance_strategy = FlowUnitBalanceStrategy::FU_ROUND_ROBIN;
   if (config_) {
     batch_size_ = config_->GetProperty<uint32_t>("batch_size", 1);
     need_check_output = config_->GetProperty<bool>("need_check_output", false);
+    auto strategy_name = config_->GetString("balance_strategy");
+    if (!strategy_name.empty()) {
+      auto ret = GetFlowUnitBalanceStrategy(strategy_name, &balance_strategy);
+      if (!ret) {
+        return ret;
+      }
+    }
   }
 
-  balancer_ = FlowUnitBalancerFactory::GetInstance().CreateBalancer();
+  balancer_ =
+      FlowUnitBalancerFactory::GetInstance().CreateBalancer(balance_strategy);
   if (balancer_ == nullptr) {
     return {STATUS_FAULT, "Get flowunit balancer failed"};
   }
@@ -468,6 +500,19 @@ Status FlowUnitGroup::Open(const CreateExternalDataFunc &create_func) {
 
   executor_ = std::make_shared<FlowUnitDataExecutor>(node_, batch_size_);
   executor_->SetNeedCheckOutput(need_check_output);
+  if (balancer_->NeedProcessCost()) {
+    std::weak_ptr<FlowUnitBalancer> balancer_ref = balancer_;
+    executor_->SetProcessCostCallback(
+        [balancer_ref](FlowUnit *flowunit, size_t data_num, int64_t cost_us) {
+          auto balancer = balancer_ref.lock();
+          if (balancer == nullptr) {
+            return;
+          }
+
+          balancer->UpdateProcessCost(flowunit, data_num, cost_us);
+        });
+  }
+
   return status;
 }
 
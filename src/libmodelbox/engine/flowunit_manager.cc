@@ -15,12 +15,50 @@
  */
 
 #include <algorithm>
+#include <nlohmann/json.hpp>
 
+#include "modelbox/base/config.h"
 #include "modelbox/base/log.h"
+#include "modelbox/base/utils.h"
 #include "modelbox/flowunit.h"
 
 namespace modelbox {
 
+static Status CollectFlowUnitScanInfo(std::shared_ptr<Driver> driver,
+                                      std::string *info) {
+  auto factory =
+      std::dynamic_pointer_cast<FlowUnitFactory>(driver->CreateFactory());
+  if (factory == nullptr) {
+    return {STATUS_NOTSUPPORT, "create flowunit factory failed"};
+  }
+
+  // only names are needed to index flowunits, descs are probed on load.
+  // descs must be released before factory, the driver will be closed
+  nlohmann::json flowunits_json = nlohmann::json::array();
+  {
+    auto descs = factory->FlowUnitProbe();
+    for (auto &item : descs) {
+      nlohmann::json flowunit_json;
+      flowunit_json["name"] = item.second->GetFlowUnitName();
+      flowunits_json.push_back(flowunit_json);
+    }
+  }
+
+  nlohmann::json info_json;
+  info_json["flowunits"] = flowunits_json;
+  *info = info_json.dump();
+  return STATUS_OK;
+}
+
+static bool RegisterFlowUnitScanInfoCollector() {
+  Drivers::RegisterScanInfoCollector(DRIVER_CLASS_FLOWUNIT,
+                                     CollectFlowUnitScanInfo);
+  return true;
+}
+
+static const bool kFlowUnitScanInfoCollector =
+    RegisterFlowUnitScanInfoCollector();
+
 FlowUnitManager::FlowUnitManager(){};
 FlowUnitManager::~FlowUnitManager(){};
 
@@ -32,6 +70,10 @@ std::shared_ptr<FlowUnitManager> FlowUnitManager::GetInstance() {
 
 std::shared_ptr<FlowUnitDesc> FlowUnitManager::GetFlowUnitDesc(
     const std::string &flowunit_type, const std::string &flowunit_name) {
+  if (lazy_load_) {
+    LazyLoadFlowUnit(flowunit_type, flowunit_name);
+  }
+
   auto iter_device_type = flowunit_desc_list_.find(flowunit_type);
   if (iter_device_type == flowunit_desc_list_.end()) {
     MBLOG_ERROR << "do not find device_type " << flowunit_type
@@ -55,6 +97,11 @@ Status FlowUnitManager::Initialize(std::shared_ptr<Drivers> driver,
                                    std::shared_ptr<DeviceManager> device_mgr,
                                    std::shared_ptr<Configuration> config) {
   SetDeviceManager(device_mgr);
+  if (config != nullptr &&
+      config->GetBool(std::string("driver.") + DRIVER_LAZY_LOAD, false)) {
+    lazy_load_ = true;
+  }
+
   Status status;
   status = InitFlowUnitFactory(driver);
   if (status != STATUS_SUCCESS) {
@@ -83,33 +130,134 @@ Status FlowUnitManager::InitFlowUnitFactory(std::shared_ptr<Drivers> driver) {
     driver_list.emplace_back(infer_driver);
   }
 
-  std::shared_ptr<DriverDesc> desc;
+  size_t lazy_driver_num = 0;
   for (auto &flowunit_driver : driver_list) {
-    auto temp_factory = flowunit_driver->CreateFactory();
-    if (nullptr == temp_factory) {
+    if (lazy_load_ && AddLazyFlowUnit(flowunit_driver) == STATUS_OK) {
+      lazy_driver_num++;
       continue;
     }
-    desc = flowunit_driver->GetDriverDesc();
-    std::shared_ptr<FlowUnitFactory> flowunit_factory =
-        std::dynamic_pointer_cast<FlowUnitFactory>(temp_factory);
 
-    flowunit_factory->SetDriver(flowunit_driver);
+    LoadFlowUnitFactory(flowunit_driver);
+  }
 
-    auto names = flowunit_factory->GetFlowUnitNames();
-    if (names.empty()) {
+  if (lazy_load_) {
+    MBLOG_INFO << "flowunit lazy load enabled, " << lazy_driver_num << " of "
+               << driver_list.size() << " drivers will load on demand";
+  }
+
+  return STATUS_OK;
+}
+
+std::shared_ptr<FlowUnitFactory> FlowUnitManager::LoadFlowUnitFactory(
+    std::shared_ptr<Driver> flowunit_driver) {
+  auto temp_factory = flowunit_driver->CreateFactory();
+  if (nullptr == temp_factory) {
+    return nullptr;
+  }
+
+  auto desc = flowunit_driver->GetDriverDesc();
+  std::shared_ptr<FlowUnitFactory> flowunit_factory =
+      std::dynamic_pointer_cast<FlowUnitFactory>(temp_factory);
+
+  flowunit_factory->SetDriver(flowunit_driver);
+
+  auto names = flowunit_factory->GetFlowUnitNames();
+  if (names.empty()) {
+    flowunit_factory_.insert(std::make_pair(
+        std::make_pair(desc->GetType(), desc->GetName()), flowunit_factory));
+  } else {
+    for (const auto &name : names) {
       flowunit_factory_.insert(std::make_pair(
-          std::make_pair(desc->GetType(), desc->GetName()), flowunit_factory));
-    } else {
-      for (const auto &name : names) {
-        flowunit_factory_.insert(std::make_pair(
-            std::make_pair(desc->GetType(), name), flowunit_factory));
-      }
+          std::make_pair(desc->GetType(), name), flowunit_factory));
     }
   }
 
+  return flowunit_factory;
+}
+
+Status FlowUnitManager::AddLazyFlowUnit(
+    std::shared_ptr<Driver> flowunit_driver) {
+  auto desc = flowunit_driver->GetDriverDesc();
+  auto scan_info = desc->GetScanInfo();
+  if (scan_info.empty()) {
+    return STATUS_NOTFOUND;
+  }
+
+  std::vector<std::string> names;
+  try {
+    auto info_json = nlohmann::json::parse(scan_info);
+    for (auto &flowunit_json : info_json["flowunits"]) {
+      names.push_back(flowunit_json["name"].get<std::string>());
+    }
+  } catch (const std::exception &e) {
+    MBLOG_WARN << "parse scan info of " << desc->GetFilePath() << " failed, "
+               << e.what();
+    return STATUS_INVALID;
+  }
+
+  if (names.empty()) {
+    return STATUS_NOTFOUND;
+  }
+
+  for (const auto &name : names) {
+    lazy_flowunit_driver_.emplace(std::make_pair(desc->GetType(), name),
+                                  flowunit_driver);
+  }
+
+  return STATUS_OK;
+}
+
+Status FlowUnitManager::LazyLoadFlowUnit(const std::string &unit_type,
+                                         const std::string &unit_name) {
+  auto iter = lazy_flowunit_driver_.find(std::make_pair(unit_type, unit_name));
+  if (iter == lazy_flowunit_driver_.end()) {
+    return STATUS_NOTFOUND;
+  }
+
+  auto flowunit_driver = iter->second;
+  for (auto item = lazy_flowunit_driver_.begin();
+       item != lazy_flowunit_driver_.end();) {
+    if (item->second == flowunit_driver) {
+      item = lazy_flowunit_driver_.erase(item);
+      continue;
+    }
+
+    item++;
+  }
+
+  auto begin_time = GetTickCount();
+  auto driver_desc = flowunit_driver->GetDriverDesc();
+  auto factory = LoadFlowUnitFactory(flowunit_driver);
+  if (factory == nullptr) {
+    auto err_msg = "load flowunit driver " + driver_desc->GetFilePath() +
+                   " failed, " + StatusError.WrapErrormsgs();
+    MBLOG_ERROR << err_msg;
+    return {STATUS_FAULT, err_msg};
+  }
+
+  auto &desc_list = flowunit_desc_list_[driver_desc->GetType()];
+  for (auto &item : factory->FlowUnitProbe()) {
+    item.second->SetDriverDesc(driver_desc);
+    desc_list.insert(item);
+  }
+
+  MBLOG_INFO << "load flowunit driver " << driver_desc->GetFilePath()
+             << " for " << unit_type << ":" << unit_name << " cost "
+             << GetTickCount() - begin_time << "ms";
+  return STATUS_OK;
+}
+
+Status FlowUnitManager::LoadAllFlowUnit() {
+  while (!lazy_flowunit_driver_.empty()) {
+    auto key = lazy_flowunit_driver_.begin()->first;
+    LazyLoadFlowUnit(key.first, key.second);
+  }
+
   return STATUS_OK;
 }
 
+void FlowUnitManager::SetLazyLoad(bool lazy_load) { lazy_load_ = lazy_load; }
+
 Status FlowUnitManager::FlowUnitProbe() {
   for (auto &iter : flowunit_factory_) {
     auto tmp = iter.second->FlowUnitProbe();
@@ -156,6 +304,10 @@ std::vector<std::string> FlowUnitManager::GetFlowUnitTypes() {
   for (auto &iter : flowunit_factory_) {
     tmp_set.insert(iter.first.first);
   }
+
+  for (auto &iter : lazy_flowunit_driver_) {
+    tmp_set.insert(iter.first.first);
+  }
   std::copy(tmp_set.begin(), tmp_set.end(), std::back_inserter(flowunit_type));
 
   return flowunit_type;
@@ -175,6 +327,16 @@ std::vector<std::string> FlowUnitManager::GetFlowUnitTypes(
     unit_types.push_back(dev_type);
   }
 
+  for (auto &iter : lazy_flowunit_driver_) {
+    if (iter.first.second != unit_name ||
+        std::find(unit_types.begin(), unit_types.end(), iter.first.first) !=
+            unit_types.end()) {
+      continue;
+    }
+
+    unit_types.push_back(iter.first.first);
+  }
+
   return unit_types;
 }
 
@@ -182,12 +344,16 @@ std::vector<std::string> FlowUnitManager::GetFlowUnitList(
     const std::string &unit_type) {
   std::vector<std::string> flowunit_name;
   auto iter = flowunit_desc_list_.find(unit_type);
-  if (iter == flowunit_desc_list_.end()) {
-    return std::vector<std::string>();
+  if (iter != flowunit_desc_list_.end()) {
+    for (auto &name : iter->second) {
+      flowunit_name.push_back(name.first);
+    }
   }
 
-  for (auto &name : flowunit_desc_list_[unit_type]) {
-    flowunit_name.push_back(name.first);
+  for (auto &item : lazy_flowunit_driver_) {
+    if (item.first.first == unit_type) {
+      flowunit_name.push_back(item.first.second);
+    }
   }
 
   return flowunit_name;
@@ -365,6 +531,10 @@ std::shared_ptr<FlowUnit> FlowUnitManager::CreateSingleFlowUnit(
   std::shared_ptr<Device> device;
   std::shared_ptr<modelbox::DeviceManager> device_mgr = GetDeviceManager();
 
+  if (lazy_load_) {
+    LazyLoadFlowUnit(unit_type, unit_name);
+  }
+
   auto iter = flowunit_factory_.find(std::make_pair(unit_type, unit_name));
   if (iter == flowunit_factory_.end()) {
     StatusError = {STATUS_NOTFOUND, "can not find flowunit[type: " + unit_type +
@@ -427,15 +597,19 @@ std::shared_ptr<FlowUnit> FlowUnitManager::CreateSingleFlowUnit(
 void FlowUnitManager::Clear() {
   flowunit_desc_list_.clear();
   flowunit_factory_.clear();
+  lazy_flowunit_driver_.clear();
+  lazy_load_ = false;
 }
 
 std::map<std::pair<std::string, std::string>, std::shared_ptr<FlowUnitFactory>>
 FlowUnitManager::GetFlowUnitFactoryList() {
+  LoadAllFlowUnit();
   return flowunit_factory_;
 }
 
 std::map<std::string, std::map<std::string, std::shared_ptr<FlowUnitDesc>>>
 FlowUnitManager::GetFlowUnitDescList() {
+  LoadAllFlowUnit();
   return flowunit_desc_list_;
 }
 
@@ -462,6 +636,7 @@ Status FlowUnitManager::SetUpFlowUnitDesc() {
 
 std::vector<std::shared_ptr<FlowUnitDesc>>
 FlowUnitManager::GetAllFlowUnitDesc() {
+  LoadAllFlowUnit();
   std::vector<std::shared_ptr<FlowUnitDesc>> desc_vec;
   for (auto &iter_device : flowunit_desc_list_) {
     for (auto &iter_name : flowunit_desc_list_[iter_device.first]) {
@@ -17,8 +17,38 @@
 
 #include "modelbox/index_buffer.h"
 
+#include <algorithm>
+
+#include "modelbox/base/slab.h"
+
 namespace modelbox {
 
+static std::shared_ptr<BufferGroup> NewBufferGroup() {
+  return std::allocate_shared<BufferGroup>(SlabObjectAllocator<BufferGroup>());
+}
+
+SeqOrder::SeqOrder(size_t size, uint32_t value) : size_(size) {
+  if (size > kInlineSize) {
+    heap_.resize(size);
+  }
+
+  std::fill(Data(), Data() + size, value);
+}
+
+void SeqOrder::PushBack(uint32_t value) {
+  if (heap_.empty() && size_ < kInlineSize) {
+    inline_[size_++] = value;
+    return;
+  }
+
+  if (heap_.empty()) {
+    heap_.assign(inline_, inline_ + size_);
+  }
+
+  heap_.push_back(value);
+  size_++;
+}
+
 BufferGroup::BufferGroup()
     : start_flag_(true),
       end_flag_(true),
@@ -116,7 +146,7 @@ std::shared_ptr<BufferGroup> BufferGroup::AddSubGroup(uint32_t port_id,
     return nullptr;
   }
 
-  auto new_group = std::make_shared<BufferGroup>();
+  auto new_group = NewBufferGroup();
   new_group->port_id_ = port_id;
 
   new_group->group_ = shared_from_this();
@@ -147,7 +177,7 @@ std::shared_ptr<BufferGroup> BufferGroup::InnerAddNewSubGroup(
   }
 
   // the differnt stream has differnt port,
-  auto new_group = std::make_shared<BufferGroup>();
+  auto new_group = NewBufferGroup();
   new_group->port_id_ = port_id;
   new_group->group_ = shared_from_this();
 
@@ -267,17 +297,17 @@ bool BufferGroup::IsRoot() {
   return false;
 }
 
-std::vector<uint32_t> BufferGroup::GetSeqOrder() {
-  std::vector<uint32_t> seq;
+SeqOrder BufferGroup::GetSeqOrder() {
+  SeqOrder seq;
   auto order_bg = GetOneLevelGroup();
   while (true) {
     order_bg = order_bg->GetOneLevelGroup();
     if (order_bg->IsRoot()) {
-      seq.push_back(1);
+      seq.PushBack(1);
       break;
     }
     auto order = order_bg->GetOrder();
-    seq.push_back(order);
+    seq.PushBack(order);
   }
   return seq;
 }
@@ -305,7 +335,7 @@ bool IndexBufferList::BindToRoot() {
     }
   }
 
-  auto root = std::shared_ptr<BufferGroup>(new BufferGroup());
+  auto root = NewBufferGroup();
   // we bind buffer meta nopt to root but a new generate buffer group
   auto buffer_ptr = root->GenerateSameLevelGroup();
   auto port_ptr = buffer_ptr->GetGroup();
@@ -556,7 +586,7 @@ bool IndexBuffer::BindToRoot() {
     return false;
   }
 
-  auto root = std::shared_ptr<BufferGroup>(new BufferGroup());
+  auto root = NewBufferGroup();
   // we bind buffer meta nopt to root but a new generate buffer group
   auto buffer_ptr = root->GenerateSameLevelGroup();
 
@@ -720,13 +750,13 @@ bool IndexBuffer::IsPlaceholder() { return is_placeholder_; }
 
 void IndexBuffer::MarkAsPlaceholder() { is_placeholder_ = true; }
 
-std::vector<uint32_t> IndexBuffer::GetSeqOrder() {
-  std::vector<uint32_t> vector;
-  if (index_info_.GetBufferGroup() == nullptr) {
-    return vector;
+SeqOrder IndexBuffer::GetSeqOrder() {
+  auto group = index_info_.GetBufferGroup();
+  if (group == nullptr) {
+    return SeqOrder();
   }
-  vector = index_info_.GetBufferGroup()->GetSeqOrder();
-  return vector;
+
+  return group->GetSeqOrder();
 }
 
 }  // namespace modelbox
@@ -16,6 +16,8 @@
 
 #include "modelbox/node.h"
 
+#include "engine/common/dynamic_batcher.h"
+
 namespace modelbox {
 
 #define DEFAULT_QUEUE_SIZE 8192
@@ -848,6 +850,32 @@ Status Node::Init(const std::set<std::string>& input_port_names,
     extern_ports_[0]->Init();
   }
 
+  return InitDynamicBatch();
+}
+
+Status Node::InitDynamicBatch() {
+  if (!config_->GetBool("dynamic_batch", false)) {
+    return STATUS_OK;
+  }
+
+  auto batch_size = config_->GetUint32("batch_size", 1);
+  if (input_ports_.empty() || batch_size <= 1) {
+    MBLOG_WARN << "node " << name_
+               << " dynamic batch needs input port and batch_size > 1, skip.";
+    return STATUS_OK;
+  }
+
+  auto max_wait_ms =
+      config_->GetUint32("max_batch_wait_ms", DEFAULT_MAX_BATCH_WAIT_MS);
+  // share perf context with profiler, so batch latency is profiled too
+  std::shared_ptr<FlowUnitPerfCtx> perf_ctx;
+  if (profiler_ != nullptr && profiler_->GetPerf() != nullptr) {
+    perf_ctx = profiler_->GetPerf()->GetFlowUnitPerfCtx(unit_name_);
+  }
+
+  dynamic_batcher_ = std::make_shared<DynamicBatcher>(
+      name_, input_ports_, batch_size, max_wait_ms, perf_ctx);
+  dynamic_batcher_->Init();
   return STATUS_OK;
 }
 
@@ -1175,7 +1203,25 @@ Status Node::Recv(
   return status;
 }
 
+static uint32_t GetInputBufferCount(
+    std::list<std::shared_ptr<FlowUnitDataContext>>& data_ctx_list) {
+  uint32_t batch_size = 0;
+  for (auto& data_ctx : data_ctx_list) {
+    const auto& inputs = data_ctx->GetInputs();
+    if (!inputs.empty()) {
+      batch_size += inputs.begin()->second.size();
+    }
+  }
+
+  return batch_size;
+}
+
 Status Node::Run(RunType type) {
+  auto is_batching = (type == DATA && dynamic_batcher_ != nullptr);
+  if (is_batching && !dynamic_batcher_->Ready()) {
+    return STATUS_OK;
+  }
+
   auto data_ctx_list = std::list<std::shared_ptr<FlowUnitDataContext>>();
   Status status = Recv(type, data_ctx_list);
 
@@ -1194,8 +1240,13 @@ Status Node::Run(RunType type) {
     }
   }
 
+  uint32_t batch_size = is_batching ? GetInputBufferCount(data_ctx_list) : 0;
+  auto begin_time = GetCurrentTime();
   auto run_status = flowunit_group_->Run(data_ctx_list);
   MBLOG_DEBUG << "run node: " << name_;
+  if (is_batching) {
+    dynamic_batcher_->Update(batch_size, GetCurrentTime() - begin_time);
+  }
 
   if (run_status != STATUS_SUCCESS) {
     return {run_status, "flowunit group run failed."};
@@ -69,6 +69,22 @@ std::vector<std::weak_ptr<OutPort>> InPort::GetAllOutPort() {
   return output_ports;
 }
 
+void InPort::SetActivateGate(const std::function<bool()>& gate) {
+  activate_gate_ = gate;
+}
+
+bool InPort::IsActivated() {
+  if (!NotifyPort::IsActivated()) {
+    return false;
+  }
+
+  if (activate_gate_ == nullptr) {
+    return true;
+  }
+
+  return activate_gate_();
+}
+
 OutPort::OutPort(const std::string& name, std::shared_ptr<NodeBase> node)
     : Port(name, node) {}
 
@@ -34,6 +34,7 @@ SchedulerPort::SchedulerPort(const std::string& name, size_t event_capacity)
 FlowScheduler::FlowScheduler() {}
 
 FlowScheduler::~FlowScheduler() {
+  StopShardDispatchers();
   if (tp_) {
     tp_ = nullptr;
   }
@@ -45,13 +46,24 @@ Status FlowScheduler::Init(std::shared_ptr<Configuration> config,
     auto threads = config->GetUint32("graph.thread-num",
                                      std::thread::hardware_concurrency() * 2);
     auto max_threads = config->GetUint32("graph.max-thread-num", threads * 32);
-    auto thread_pool = std::make_shared<ThreadPool>(threads, max_threads);
+    auto lockfree_queue = config->GetBool("graph.lockfree-queue", false);
+    auto thread_pool = std::make_shared<ThreadPool>(threads, max_threads, -1,
+                                                    60000, lockfree_queue);
     thread_pool->SetName(TASK_FLOW_POOL_NAME);
+    if (config->GetBool("graph.work-stealing", false)) {
+      thread_pool->EnableWorkStealing(
+          config->GetBool("graph.thread-pin-cpu", false));
+    }
     tp_ = thread_pool;
     thread_create_ = true;
 
+    shard_num_ = config->GetUint32("graph.scheduler-shards", 1);
+    shard_num_ = shard_num_ > 0 ? shard_num_ : 1;
     if (data_hub_ == nullptr) {
-      data_hub_ = std::make_shared<DefaultDataHub>();
+      auto ret = CreateDataHub(config);
+      if (!ret) {
+        return ret;
+      }
     }
 
     if (scheduler_event_port_ == nullptr) {
@@ -67,9 +79,51 @@ Status FlowScheduler::Init(std::shared_ptr<Configuration> config,
     }
 
     MBLOG_INFO << "init scheduler with " << threads << " threads, max "
-               << max_threads;
+               << max_threads << (lockfree_queue ? ", lock-free queue" : "")
+               << ", " << shard_num_ << " dispatcher shards";
+  }
+
+  return STATUS_OK;
+}
+
+Status FlowScheduler::CreateDataHub(std::shared_ptr<Configuration> config) {
+  std::shared_ptr<PriorityPolicy> priority_policy = nullptr;
+  auto policy = config->GetString("graph.priority-policy", "static");
+  if (policy == "backpressure") {
+    auto high_watermark =
+        config->GetDouble("graph.backpressure-high-watermark", 0.8);
+    auto low_watermark =
+        config->GetDouble("graph.backpressure-low-watermark", 0.2);
+    if (low_watermark < 0 || high_watermark > 1 ||
+        low_watermark >= high_watermark) {
+      return {STATUS_BADCONF, "invalid backpressure watermark, low " +
+                                  std::to_string(low_watermark) + ", high " +
+                                  std::to_string(high_watermark)};
+    }
+
+    priority_policy = std::make_shared<BackpressurePriorityPolicy>(
+        high_watermark, low_watermark);
+  } else if (policy != "static") {
+    return {STATUS_BADCONF, "invalid priority policy " + policy};
+  }
+
+  if (shard_num_ > 1) {
+    sharded_data_hub_ = std::make_shared<ShardedDataHub>(shard_num_);
+    if (priority_policy) {
+      sharded_data_hub_->SetPriorityPolicy(priority_policy);
+    }
+
+    data_hub_ = sharded_data_hub_;
+  } else {
+    auto data_hub = std::make_shared<DefaultDataHub>();
+    if (priority_policy) {
+      data_hub->SetPriorityPolicy(priority_policy);
+    }
+
+    data_hub_ = data_hub;
   }
 
+  MBLOG_INFO << "scheduler priority policy: " << policy;
   return STATUS_OK;
 }
 
@@ -116,6 +170,7 @@ void FlowScheduler::RunAsync() {
 
   mode_ = ASYNC;
   is_stop_ = false;
+  StartShardDispatchers();
   run_fut_ =
       tp_->Submit(TASK_FLOW_SCHEDUER_NAME, &FlowScheduler::RunImpl, this);
   MBLOG_DEBUG << "flow scheduler is running.";
@@ -128,10 +183,41 @@ Status FlowScheduler::Run() {
 
   mode_ = SYNC;
   is_stop_ = false;
+  StartShardDispatchers();
   MBLOG_DEBUG << "flow scheduler is running.";
   return RunImpl();
 }
 
+void FlowScheduler::StartShardDispatchers() {
+  if (sharded_data_hub_ == nullptr) {
+    return;
+  }
+
+  // shard 0 is dispatched by RunImpl together with scheduler commands,
+  // other shards loop until stopped, so they own threads instead of taking
+  // workers from the pool that runs the nodes
+  shard_stop_ = false;
+  for (size_t i = 1; i < sharded_data_hub_->GetShardNum(); ++i) {
+    shard_threads_.emplace_back(&FlowScheduler::RunShardImpl, this, i);
+  }
+}
+
+void FlowScheduler::StopShardDispatchers() {
+  if (sharded_data_hub_ == nullptr) {
+    return;
+  }
+
+  shard_stop_ = true;
+  sharded_data_hub_->Wakeup();
+  for (auto& thread : shard_threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  shard_threads_.clear();
+}
+
 void FlowScheduler::EnableActivePort(const std::shared_ptr<NodeBase>& node) {
   auto iter = node_port_map_.find(node);
   if (iter != node_port_map_.end()) {
@@ -321,6 +407,19 @@ void FlowScheduler::ShowScheduleStatus() {
   // If no exception occurs, do not print any information to prevent excessive
   // information from being printed when the HTTP server is used.
   if (is_print_threadpool) {
+    auto shard_stats = GetShardStats();
+    for (size_t i = 0; i < shard_stats.size(); ++i) {
+      const auto& stats = shard_stats[i];
+      MBLOG_INFO << "Dispatcher shard " << i << " dispatch count: "
+                 << stats.dispatch_count << ", avg latency(us): "
+                 << (stats.dispatch_count > 0
+                         ? stats.dispatch_latency_us / stats.dispatch_count
+                         : 0)
+                 << ", max latency(us): " << stats.max_dispatch_latency_us
+                 << ", queue depth: " << stats.active_port_num
+                 << ", max queue depth: " << stats.max_active_port_num;
+    }
+
     MBLOG_INFO << "Thread Pool Status:";
     MBLOG_INFO << "                    max thread size: "
                << tp_->GetMaxThreadsNum();
@@ -375,11 +474,55 @@ Status FlowScheduler::RunImpl() {
     MBLOG_ERROR << "the scheduler caught an error : " << status;
   }
 
+  StopShardDispatchers();
   ShutdownNodes();
   WaitNodeFinish();
   return status;
 }
 
+Status FlowScheduler::RunShardImpl(size_t shard) {
+  MBLOG_DEBUG << "flow schedule shard " << shard << " is begin run.";
+  os->Thread->SetName("Flow-Sched-" + std::to_string(shard));
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  Status status = STATUS_OK;
+  while (!shard_stop_) {
+    status =
+        sharded_data_hub_->SelectActivePort(shard, &active_port, check_timeout_);
+    if (status == STATUS_TIMEDOUT || status == STATUS_NODATA) {
+      status = STATUS_OK;
+      continue;
+    }
+
+    status = RunNode(active_port);
+    if (!status) {
+      MBLOG_ERROR << "scheduler shard " << shard
+                  << " caught an error : " << status;
+      SendSchedulerCommand(SchedulerCommandType::COMMAND_ERROR, nullptr);
+      break;
+    }
+  }
+
+  return status;
+}
+
+std::vector<DataHubStats> FlowScheduler::GetShardStats() {
+  std::vector<DataHubStats> shard_stats;
+  if (sharded_data_hub_ != nullptr) {
+    for (size_t i = 0; i < sharded_data_hub_->GetShardNum(); ++i) {
+      shard_stats.push_back(sharded_data_hub_->GetStats(i));
+    }
+
+    return shard_stats;
+  }
+
+  auto default_data_hub = std::dynamic_pointer_cast<DefaultDataHub>(data_hub_);
+  if (default_data_hub != nullptr) {
+    shard_stats.push_back(default_data_hub->GetStats());
+  }
+
+  return shard_stats;
+}
+
 void FlowScheduler::ShutdownNodes() {
   for (auto& iter : node_port_map_) {
     iter.first->Shutdown();
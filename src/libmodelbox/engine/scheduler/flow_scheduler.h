@@ -106,8 +106,22 @@ class FlowScheduler : public Scheduler {
   }
   int64_t GetCheckCount() const { return check_count_; }
 
+  /**
+   * @brief Get number of dispatcher shards
+   */
+  size_t GetShardNum() const { return shard_num_; }
+
+  /**
+   * @brief Get dispatch statistics of each shard
+   */
+  std::vector<DataHubStats> GetShardStats();
+
  private:
   std::shared_ptr<DataHub> data_hub_;
+  std::shared_ptr<ShardedDataHub> sharded_data_hub_;
+  size_t shard_num_{1};
+  std::atomic<bool> shard_stop_{false};
+  std::vector<std::thread> shard_threads_;
   std::shared_ptr<ThreadPool> tp_;
   bool thread_create_ = false;
 
@@ -134,7 +148,11 @@ class FlowScheduler : public Scheduler {
   int max_check_timeout_count_{SCHED_MAX_CHECK_TIMEOUT_COUNT};
   std::atomic<int64_t> check_count_{0};
 
+  Status CreateDataHub(std::shared_ptr<Configuration> config);
   Status RunImpl();
+  Status RunShardImpl(size_t shard);
+  void StartShardDispatchers();
+  void StopShardDispatchers();
   void RunWapper(std::shared_ptr<NodeBase> node, RunType type,
                  std::shared_ptr<PriorityPort> active_port);
 
@@ -77,6 +77,13 @@ void ExternalDataMapImpl::SetSelector(
   selector_ = selector;
 }
 
+void ExternalDataMapImpl::NotifySelector() {
+  auto selector = selector_.lock();
+  if (selector != nullptr) {
+    selector->NotifySelect(this);
+  }
+}
+
 bool ExternalDataMapImpl::GetReadyFlag() {
   if (end_flag_) {
     return true;
@@ -140,6 +147,16 @@ Status ExternalDataMapImpl::Send(std::string port_name,
 };
 
 Status ExternalDataMapImpl::Recv(OutputBufferList& map_buffer_list) {
+  auto status = RecvData(map_buffer_list);
+  auto selector = selector_.lock();
+  if (selector != nullptr) {
+    selector->RearmSelect(this);
+  }
+
+  return status;
+}
+
+Status ExternalDataMapImpl::RecvData(OutputBufferList& map_buffer_list) {
   if (output_buffer_cache_ == nullptr) {
     return STATUS_NODATA;
   }
@@ -264,18 +281,12 @@ Status ExternalDataMapImpl::SendData(OriginDataMap& data) {
 }
 
 Status ExternalDataMapImpl::SetOutputBuffer(OutputBufferList& output) {
-  auto size = output_buffer_cache_->Size();
   if (!output_buffer_cache_->Push(output)) {
     return STATUS_INVALID;
   }
 
-  if (size == 0) {
-    auto selector = selector_.lock();
-    if (selector != nullptr) {
-      selector->NotifySelect();
-    }
-  }
-
+  // cheap when already queued or selected
+  NotifySelector();
   return STATUS_OK;
 }
 
@@ -283,10 +294,7 @@ void ExternalDataMapImpl::SetEndError(std::shared_ptr<FlowUnitError> error) {
   end_flag_ = true;
   MBLOG_INFO << "ExternalDataMapImpl end_flag  true";
   error_ = error;
-  auto selector = selector_.lock();
-  if (selector != nullptr) {
-    selector->NotifySelect();
-  }
+  NotifySelector();
   output_buffer_cache_->Shutdown();
 }
 
@@ -352,77 +360,107 @@ void ExternalDataSelect::RegisterExternalData(
     std::shared_ptr<ExternalDataMap> externl) {
   std::shared_ptr<ExternalDataMapImpl> externl_data =
       std::dynamic_pointer_cast<ExternalDataMapImpl>(externl);
-  external_list_.push_back(externl_data);
+  if (externl_data == nullptr) {
+    return;
+  }
+
   externl_data->SetSelector(shared_from_this());
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto& item = external_map_[externl_data.get()];
+  item.external_data = externl_data;
+  // output may arrive before selector is set
+  if (item.state == SelectState::IDLE && externl_data->GetReadyFlag()) {
+    PushReadyItem(item);
+  }
 }
 
 void ExternalDataSelect::RemoveExternalData(
     std::shared_ptr<ExternalDataMap>& externl_data) {
-  auto iter = external_list_.begin();
-  while (iter != external_list_.end()) {
-    if (*iter == std::dynamic_pointer_cast<ExternalDataMapImpl>(externl_data)) {
-      iter = external_list_.erase(iter);
-      break;
-    } else {
-      iter++;
-    }
-  }
+  auto external_impl =
+      std::dynamic_pointer_cast<ExternalDataMapImpl>(externl_data);
+  std::unique_lock<std::mutex> lck(mtx_);
+  // stale entry in ready list is skipped when selecting
+  external_map_.erase(external_impl.get());
 }
 
-bool ExternalDataSelect::IsExtenalDataReady() {
-  bool ready_flag = false;
-  for (auto external_data : external_list_) {
-    if (external_data->GetReadyFlag()) {
-      ready_flag = true;
-      break;
-    }
-  }
-  return ready_flag;
+void ExternalDataSelect::PushReadyItem(SelectItem& item) {
+  item.state = SelectState::READY;
+  ready_list_.push_back(item.external_data);
+  cv_.notify_one();
 }
 
 Status ExternalDataSelect::SelectExternalData(
     std::list<std::shared_ptr<ExternalDataMap>>& external_list,
     std::chrono::duration<long, std::milli> waittime) {
   MBLOG_DEBUG << "SelectExternalData";
+  auto deadline = std::chrono::steady_clock::now() + waittime;
   std::unique_lock<std::mutex> lck(mtx_);
-  if (external_list_.empty()) {
-    if (waittime < std::chrono::milliseconds(0)) {
-      cv_.wait(lck);
-    } else {
-      if (cv_.wait_for(lck, waittime) == std::cv_status::timeout) {
-        return STATUS_TIMEDOUT;
-      }
-    }
+  if (waittime == std::chrono::milliseconds(0) && external_map_.empty()) {
+    return STATUS_TIMEDOUT;
   }
 
-  bool ready_flag = IsExtenalDataReady();
-
-  while (!ready_flag) {
+  while (true) {
+    auto has_ready = [this]() { return !ready_list_.empty(); };
     if (waittime <= std::chrono::milliseconds(0)) {
-      cv_.wait(lck);
-    } else {
-      if (cv_.wait_for(lck, waittime) == std::cv_status::timeout) {
-        return STATUS_TIMEDOUT;
-      }
+      cv_.wait(lck, has_ready);
+    } else if (!cv_.wait_until(lck, deadline, has_ready)) {
+      return STATUS_TIMEDOUT;
     }
 
-    ready_flag = IsExtenalDataReady();
-  }
+    while (!ready_list_.empty()) {
+      auto external_data = ready_list_.front();
+      ready_list_.pop_front();
+      auto iter = external_map_.find(external_data.get());
+      if (iter == external_map_.end() ||
+          iter->second.external_data != external_data ||
+          iter->second.state != SelectState::READY) {
+        continue;
+      }
+
+      if (!external_data->GetReadyFlag()) {
+        iter->second.state = SelectState::IDLE;
+        continue;
+      }
 
-  for (auto external_data : external_list_) {
-    if (external_data->GetReadyFlag()) {
+      iter->second.state = SelectState::SELECTED;
       external_list.push_back(external_data);
     }
+
+    if (!external_list.empty()) {
+      return STATUS_SUCCESS;
+    }
   }
-  return STATUS_SUCCESS;
 }
 
-void ExternalDataSelect::NotifySelect() {
+void ExternalDataSelect::NotifySelect(
+    const ExternalDataMapImpl* external_data) {
   std::unique_lock<std::mutex> lck(mtx_);
-  cv_.notify_one();
+  auto iter = external_map_.find(external_data);
+  if (iter == external_map_.end()) {
+    return;
+  }
+
+  // selected one is rearmed by recv
+  if (iter->second.state == SelectState::IDLE) {
+    PushReadyItem(iter->second);
+  }
   MBLOG_DEBUG << "NotifySelect";
 }
 
+void ExternalDataSelect::RearmSelect(const ExternalDataMapImpl* external_data) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto iter = external_map_.find(external_data);
+  if (iter == external_map_.end() ||
+      iter->second.state != SelectState::SELECTED) {
+    return;
+  }
+
+  iter->second.state = SelectState::IDLE;
+  if (iter->second.external_data->GetReadyFlag()) {
+    PushReadyItem(iter->second);
+  }
+}
+
 InputVirtualNode::InputVirtualNode(
     const std::string& device_name, const std::string& device_id,
     std::shared_ptr<DeviceManager> device_manager)
@@ -655,31 +693,26 @@ MultiLevelCache::MultiLevelCache() : order_(1) {}
 
 MultiLevelCache::~MultiLevelCache() {}
 
-std::string GenerateKeyFromSeq(std::vector<uint32_t>& order_seq) {
-  std::string result = "";
+static std::string GenerateKeyFromSeq(const SeqOrder& order_seq) {
+  std::string result;
+  result.reserve(order_seq.Size() * 4);
   for (auto order : order_seq) {
-    result = result + std::to_string(order) + "_";
+    result += std::to_string(order);
+    result += '_';
   }
   return result;
 }
 
 void MultiLevelCache::PushBack(std::shared_ptr<IndexBuffer>& buffer) {
   auto bg = buffer->GetSameLevelGroup()->GetOneLevelGroup();
-  if (cache_.find(bg) == cache_.end()) {
-    cache_.emplace(bg, std::vector<std::shared_ptr<IndexBuffer>>());
-  }
-
   cache_[bg].emplace_back(buffer);
   auto seq_order = buffer->GetSeqOrder();
 
-  if (cur_order_seq_.size() == 0) {
-    cur_order_seq_ = std::vector<uint32_t>(seq_order.size(), 1);
+  if (cur_order_seq_.Size() == 0) {
+    cur_order_seq_ = SeqOrder(seq_order.Size(), 1);
   }
 
-  auto key = GenerateKeyFromSeq(seq_order);
-  if (key_bg_map_.find(key) == key_bg_map_.end()) {
-    key_bg_map_.emplace(key, bg);
-  }
+  key_bg_map_.emplace(GenerateKeyFromSeq(seq_order), bg);
 }
 
 bool MultiLevelCache::PopOneGroup(
@@ -106,6 +106,7 @@ Status Flow::Init(std::shared_ptr<Configuration> config) {
     Clear();
   };
 
+  auto begin_time = GetTickCount();
   ret = drivers_->Scan();
   if (!ret) {
     MBLOG_ERROR << "Scan driver failed, " << ret.WrapErrormsgs();
@@ -127,18 +128,21 @@ Status Flow::Init(std::shared_ptr<Configuration> config) {
     return StatusError;
   }
 
+  auto scan_time = GetTickCount();
   ret = device_mgr_->Initialize(drivers_, config_);
   if (!ret) {
     MBLOG_ERROR << "Inital device failed, " << ret.WrapErrormsgs();
     return {ret, "Inital device failed."};
   }
 
+  auto device_time = GetTickCount();
   ret = flowunit_mgr_->Initialize(drivers_, device_mgr_, config_);
   if (!ret) {
     MBLOG_ERROR << "Initial flowunit manager failed, " << ret.WrapErrormsgs();
     return {ret, "Initial flowunit manager failed."};
   }
 
+  auto flowunit_time = GetTickCount();
   ret = profiler_->Init();
   if (!ret) {
     MBLOG_ERROR << "Initial profiler failed, " << ret.WrapErrormsgs();
@@ -151,6 +155,12 @@ Status Flow::Init(std::shared_ptr<Configuration> config) {
     return {ret, "Initial graph failed."};
   }
 
+  auto end_time = GetTickCount();
+  MBLOG_INFO << "flow init cost " << end_time - begin_time
+             << "ms, drivers scan " << scan_time - begin_time
+             << "ms, device init " << device_time - scan_time
+             << "ms, flowunit init " << flowunit_time - device_time
+             << "ms, graph init " << end_time - flowunit_time << "ms";
   return STATUS_OK;
 }
 
@@ -325,12 +335,14 @@ Status Flow::Build() {
     return STATUS_FAULT;
   }
 
+  auto begin_time = GetTickCount();
   auto ret = graph_->Build(gcgraph);
   if (ret != STATUS_OK) {
     MBLOG_ERROR << ret;
     return STATUS_FAULT;
   }
 
+  MBLOG_INFO << "flow build cost " << GetTickCount() - begin_time << "ms";
   return STATUS_OK;
 }
 
@@ -76,6 +76,16 @@ class BufferMeta {
     custom_meta_.Set(key, value);
   }
 
+  /**
+   * @brief Set meta key pair by precomputed key
+   * @param key meta key
+   * @param value meta value
+   */
+  template <typename T>
+  void Set(const MetaKey& key, T&& value) {
+    custom_meta_.Set(key, value);
+  }
+
   /**
    * @brief Get value of key
    * @param key meta key
@@ -87,15 +97,35 @@ class BufferMeta {
     return custom_meta_.Get(key, value);
   }
 
+  /**
+   * @brief Get value of precomputed key
+   * @param key meta key
+   * @param value meta value
+   * @return whether the key exists
+   */
+  template <typename T>
+  bool Get(const MetaKey& key, T&& value) {
+    return custom_meta_.Get(key, value);
+  }
+
   /**
    * @brief Get value of key return tuple
    * @param key meta key
    * @return meta tuple
    */
-  std::tuple<Any*, bool> Get(const std::string& key) {
+  std::tuple<const Any*, bool> Get(const std::string& key) const {
     return custom_meta_.Get(key);
   }
 
+  /**
+   * @brief Get value of key for writing, shared meta is copied first
+   * @param key meta key
+   * @return meta tuple
+   */
+  std::tuple<Any*, bool> GetMutable(const std::string& key) {
+    return custom_meta_.GetMutable(key);
+  }
+
   /**
    * @brief Copy meta
    * @param other other meta
@@ -241,6 +271,16 @@ class Buffer : public std::enable_shared_from_this<Buffer> {
     meta_->Set(key, value);
   }
 
+  /**
+   * @brief Set meta key to buffer by precomputed key
+   * @param key meta key
+   * @param value meta value
+   */
+  template <typename T>
+  void Set(const MetaKey& key, T&& value) {
+    meta_->Set(key, value);
+  }
+
   /**
    * @brief Get meta key from the buffer
    * @param key meta key
@@ -252,12 +292,34 @@ class Buffer : public std::enable_shared_from_this<Buffer> {
     return meta_->Get(key, value);
   }
 
+  /**
+   * @brief Get meta of precomputed key from the buffer
+   * @param key meta key
+   * @param value meta value
+   * @return whether the key exists
+   */
+  template <typename T>
+  bool Get(const MetaKey& key, T&& value) {
+    return meta_->Get(key, value);
+  }
+
   /**
    * @brief Get value of key return tuple
    * @param key meta key
    * @return meta tuple
    */
-  std::tuple<Any*, bool> Get(const std::string& key) { return meta_->Get(key); }
+  std::tuple<const Any*, bool> Get(const std::string& key) const {
+    return meta_->Get(key);
+  }
+
+  /**
+   * @brief Get value of key for writing, shared meta is copied first
+   * @param key meta key
+   * @return meta tuple
+   */
+  std::tuple<Any*, bool> GetMutable(const std::string& key) {
+    return meta_->GetMutable(key);
+  }
 
   /**
    * @brief Get meta key from the buffer, when the key does not exist, return to
@@ -292,6 +354,20 @@ class Buffer : public std::enable_shared_from_this<Buffer> {
    */
   virtual std::shared_ptr<Buffer> DeepCopy() const;
 
+  /**
+   * @brief Copy buffer for writing, share data memory if it is not sent to
+   * more than one receiver and no other memory refers to it, otherwise copy
+   * memory. Read only memory acquired from caller is always copied
+   * @return writable buffer
+   */
+  virtual std::shared_ptr<Buffer> CopyOnWrite() const;
+
+  /**
+   * @brief Mark data memory is seen by more than one receiver, CopyOnWrite
+   * will always copy memory
+   */
+  void SetDataShared();
+
   /**
    * @brief Copy buffer, include meta and memory
    * @param dest_device copy data to other device
@@ -341,6 +417,9 @@ class Buffer : public std::enable_shared_from_this<Buffer> {
 
   uint32_t dev_mem_flags_{0};
 
+  /// @brief Data memory is sent to more than one receiver
+  std::atomic<bool> data_shared_{false};
+
   /// @brief Buffer type
   BufferEnumType type_{BufferEnumType::RAW};
 };
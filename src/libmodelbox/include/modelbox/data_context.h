@@ -329,6 +329,12 @@ class FlowUnitDataContext : public DataContext {
 
   Status AppendOutputMap(OutputIndexBuffer *output_map_index_buffer);
 
+  /**
+   * @brief Mark output buffers which more than one receiver will get as
+   * shared, across all output ports of the node
+   */
+  void MarkSharedOutput();
+
   bool IsFinished();
 
   void InitStatistic();
@@ -742,6 +742,19 @@ class FlowUnitManager {
   Status InitFlowUnitFactory(std::shared_ptr<Drivers> driver);
   Status SetUpFlowUnitDesc();
   void Clear();
+
+  /**
+   * @brief Only load flowunit drivers used by graph, must be set before
+   * Initialize, also enabled by config driver.lazy-load, reset by Clear
+   * @param lazy_load enable lazy load
+   */
+  void SetLazyLoad(bool lazy_load);
+
+  /**
+   * @brief Load all flowunit drivers not loaded in lazy load mode
+   * @return load result
+   */
+  Status LoadAllFlowUnit();
   /**
    * GetFlowUnitFactoryList(), GetFlowUnitDescList()
    * only for test
@@ -778,6 +791,11 @@ class FlowUnitManager {
                                       FlowUnitDeviceConfig &dev_cfg);
 
   void SetDeviceManager(std::shared_ptr<DeviceManager> device_mgr);
+  std::shared_ptr<FlowUnitFactory> LoadFlowUnitFactory(
+      std::shared_ptr<Driver> flowunit_driver);
+  Status AddLazyFlowUnit(std::shared_ptr<Driver> flowunit_driver);
+  Status LazyLoadFlowUnit(const std::string &unit_type,
+                          const std::string &unit_name);
   std::shared_ptr<FlowUnit> CreateSingleFlowUnit(
       const std::string &unit_name, const std::string &unit_type,
       const std::string &unit_device_id);
@@ -788,6 +806,11 @@ class FlowUnitManager {
 
   std::map<std::string, std::map<std::string, std::shared_ptr<FlowUnitDesc>>>
       flowunit_desc_list_;
+
+  bool lazy_load_{false};
+  // flowunit type and name to driver not loaded yet in lazy load mode
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<Driver>>
+      lazy_flowunit_driver_;
 };
 }  // namespace modelbox
 #endif  // MODELBOX_FLOW_UNIT_H_
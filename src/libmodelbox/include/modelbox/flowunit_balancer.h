@@ -44,6 +44,15 @@ class FUBalanceStrategyHash {
 
 std::ostream& operator<<(std::ostream& os, const FlowUnitBalanceStrategy& s);
 
+/**
+ * @brief Parse balance strategy from name, case insensitive
+ * @param name strategy name, RoundRobin or Capability
+ * @param strategy parsed strategy
+ * @return parse result
+ */
+Status GetFlowUnitBalanceStrategy(const std::string& name,
+                                  FlowUnitBalanceStrategy* strategy);
+
 class FlowUnitBalancer : public std::enable_shared_from_this<FlowUnitBalancer> {
  public:
   FlowUnitBalancer() = default;
@@ -59,12 +68,29 @@ class FlowUnitBalancer : public std::enable_shared_from_this<FlowUnitBalancer> {
 
   virtual FlowUnitBalanceStrategy GetType() = 0;
 
+  /**
+   * @brief Whether balancer needs process cost of flowunit
+   * @return true if UpdateProcessCost should be called after process
+   */
+  virtual bool NeedProcessCost() { return false; }
+
+  /**
+   * @brief Report process cost of flowunit
+   * @param flowunit flowunit processed the data
+   * @param data_num number of buffers processed
+   * @param cost_us process cost in microseconds
+   */
+  virtual void UpdateProcessCost(const FlowUnit* flowunit, size_t data_num,
+                                 int64_t cost_us) {}
+
  protected:
   virtual Status OnInit() { return STATUS_OK; }
 
   virtual std::shared_ptr<FlowUnit> BindFlowUnit(
       const std::shared_ptr<FlowUnitDataContext>& data_ctx) = 0;
 
+  virtual void OnUnbindFlowUnit(const std::shared_ptr<FlowUnit>& flowunit) {}
+
   std::vector<std::shared_ptr<FlowUnit>> flowunits_;
   std::mutex ctx_to_flowunit_map_lock_;
   std::unordered_map<const DataContext*, std::shared_ptr<FlowUnit>>
@@ -136,6 +162,45 @@ class FURoundRobinBalancer : public FlowUnitBalancer {
   size_t fu_index_{0};
 };
 
+/**
+ * @brief Bind data context to the flowunit with least estimated load,
+ * load is bound data context number multiplied by measured process cost per
+ * buffer, so slow instances get less data context.
+ */
+class FUCapabilityBalancer : public FlowUnitBalancer {
+ public:
+  FlowUnitBalanceStrategy GetType() override;
+
+  bool NeedProcessCost() override;
+
+  void UpdateProcessCost(const FlowUnit* flowunit, size_t data_num,
+                         int64_t cost_us) override;
+
+ protected:
+  Status OnInit() override;
+
+  std::shared_ptr<FlowUnit> BindFlowUnit(
+      const std::shared_ptr<FlowUnitDataContext>& data_ctx) override;
+
+  void OnUnbindFlowUnit(const std::shared_ptr<FlowUnit>& flowunit) override;
+
+ private:
+  struct FUCapability {
+    size_t bound_ctx_num{0};
+    double cost_per_data_us{0};
+  };
+
+  std::shared_ptr<FlowUnit> SelectFlowUnit(
+      const std::vector<std::shared_ptr<FlowUnit>>& candidates);
+
+  FlowUnitBalancerUtil util;
+  std::unordered_map<const Device*, std::vector<std::shared_ptr<FlowUnit>>>
+      device_to_fu_list_;
+  std::mutex capability_lock_;
+  std::unordered_map<const FlowUnit*, FUCapability> capability_;
+  size_t fu_index_{0};
+};
+
 };  // namespace modelbox
 
 #endif  // MODELBOX_FLOW_UNIT_BALANCER_H_
\ No newline at end of file
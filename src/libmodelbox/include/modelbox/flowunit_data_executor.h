@@ -254,6 +254,9 @@ class FlowUnitExecDataView {
                        std::vector<std::function<Status()>> &tasks);
 };
 
+using FUProcessCostCallback =
+    std::function<void(FlowUnit *flowunit, size_t data_num, int64_t cost_us)>;
+
 class FlowUnitDataExecutor {
  public:
   FlowUnitDataExecutor(std::weak_ptr<Node> node_ref, size_t batch_size);
@@ -268,6 +271,12 @@ class FlowUnitDataExecutor {
 
   void SetNeedCheckOutput(bool need_check);
 
+  /**
+   * @brief Set callback to receive process cost of each data context
+   * @param callback called after flowunit process, nullptr to disable
+   */
+  void SetProcessCostCallback(const FUProcessCostCallback &callback);
+
  private:
   Status LoadExecuteInput(std::shared_ptr<Node> node,
                           FlowUnitExecDataView &exec_view);
@@ -280,6 +289,7 @@ class FlowUnitDataExecutor {
   std::weak_ptr<Node> node_ref_;
   size_t batch_size_;
   bool need_check_output_{false};
+  FUProcessCostCallback process_cost_callback_;
 };
 
 }  // namespace modelbox
@@ -83,6 +83,8 @@ class FlowUnitGroup {
   std::shared_ptr<Configuration> config_;
   std::shared_ptr<Profiler> profiler_;
   std::shared_ptr<FlowUnitTrace> flowunit_trace_;
+  std::shared_ptr<TraceRecorder> trace_recorder_;
+  uint32_t trace_name_id_{0};
   std::once_flag trace_init_flag_;
 
   std::shared_ptr<FlowUnitBalancer> balancer_;
@@ -90,9 +92,10 @@ class FlowUnitGroup {
 
   void InitTrace();
 
-  std::shared_ptr<TraceSlice> StartTrace(FUExecContextList &exec_ctx_list);
+  std::shared_ptr<TraceSlice> StartTrace(FUExecContextList &exec_ctx_list,
+                                         TraceRecordSpan &span);
 
-  void StopTrace(std::shared_ptr<TraceSlice> &slice);
+  void StopTrace(std::shared_ptr<TraceSlice> &slice, TraceRecordSpan &span);
 
   void PreProcess(FUExecContextList &exec_ctx_list,
                   FUExecContextList &err_exec_ctx_list);
@@ -28,6 +28,47 @@ namespace modelbox {
 
 class FlowUnit;
 
+/**
+ * @brief Sequence order of a buffer group from current level to root,
+ * short sequences are stored inline without heap allocation
+ */
+class SeqOrder {
+ public:
+  SeqOrder() = default;
+
+  /**
+   * @brief Construct sequence with size copies of value
+   * @param size sequence size
+   * @param value init value
+   */
+  SeqOrder(size_t size, uint32_t value);
+
+  void PushBack(uint32_t value);
+
+  size_t Size() const { return size_; }
+
+  uint32_t &operator[](size_t index) { return Data()[index]; }
+
+  const uint32_t &operator[](size_t index) const { return Data()[index]; }
+
+  const uint32_t *begin() const { return Data(); }
+
+  const uint32_t *end() const { return Data() + size_; }
+
+ private:
+  static constexpr size_t kInlineSize = 8;
+
+  uint32_t *Data() { return heap_.empty() ? inline_ : heap_.data(); }
+
+  const uint32_t *Data() const {
+    return heap_.empty() ? inline_ : heap_.data();
+  }
+
+  uint32_t inline_[kInlineSize]{0};
+  std::vector<uint32_t> heap_;
+  size_t size_{0};
+};
+
 class BufferGroup : public std::enable_shared_from_this<BufferGroup> {
  public:
   /**
@@ -209,7 +250,7 @@ class BufferGroup : public std::enable_shared_from_this<BufferGroup> {
 
   bool IsRoot();
 
-  std::vector<uint32_t> GetSeqOrder();
+  SeqOrder GetSeqOrder();
 
  private:
   Status GetSum(uint32_t* sum,int port_id);
@@ -462,7 +503,7 @@ class IndexBuffer {
    *
    * @return std::vector<uint32_t>
    */
-  std::vector<uint32_t> GetSeqOrder();
+  SeqOrder GetSeqOrder();
 
  private:
   std::shared_ptr<BufferGroup> GetGroupLevelGroup();
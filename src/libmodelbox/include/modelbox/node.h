@@ -26,6 +26,7 @@
 
 namespace modelbox {
 class SchedulerEvent;
+class DynamicBatcher;
 class InPort;
 class EventPort;
 class ExternPort;
@@ -447,6 +448,8 @@ class Node : public DataMatcherNode {
 
   void InitNodeWithFlowunit();
 
+  Status InitDynamicBatch();
+
   Status Recv(RunType type,
               std::list<std::shared_ptr<FlowUnitDataContext>>& data_ctx_list);
 
@@ -461,6 +464,9 @@ class Node : public DataMatcherNode {
   // The Node FlowUnitGroup
   std::shared_ptr<FlowUnitGroup> flowunit_group_;
 
+  // Hold node until a batch is ready, only when dynamic_batch is enabled
+  std::shared_ptr<DynamicBatcher> dynamic_batcher_;
+
   bool is_fug_opened_;
 
   std::string unit_name_;
@@ -312,10 +312,21 @@ class InPort : public NotifyPort<IndexBuffer, CustomCompare> {
    */
   std::vector<std::weak_ptr<OutPort>> GetAllOutPort();
 
+  /**
+   * @brief Set gate to hold port inactive, used by dynamic batching
+   *
+   * @param gate return false to keep port inactive, must be set before
+   * scheduling
+   */
+  void SetActivateGate(const std::function<bool()>& gate);
+
+  bool IsActivated() override;
+
  private:
   bool SetOutputPort(std::shared_ptr<OutPort> output_port);
 
   std::vector<std::weak_ptr<OutPort>> output_ports;
+  std::function<bool()> activate_gate_;
 };
 
 class OutPort : public Port, public std::enable_shared_from_this<OutPort> {
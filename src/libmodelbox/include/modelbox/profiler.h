@@ -27,6 +27,8 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
 #include <functional>
 #include <map>
 #include <memory>
@@ -37,6 +39,7 @@
 #include <thread>
 #include <type_traits>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 namespace modelbox {
@@ -63,6 +66,10 @@ constexpr uint32_t DEFAULT_WRITE_PROFILE_INTERVAL = 600;
 
 constexpr uint32_t DEFAULT_WRITE_TRACE_INTERVAL = 600;
 
+constexpr uint32_t DEFAULT_TRACE_RING_SIZE = 8192;
+
+constexpr uint32_t DEFAULT_TRACE_FLUSH_INTERVAL = 1000;
+
 class ProfilerLifeCycle {
  public:
   ProfilerLifeCycle(const std::string& name);
@@ -227,6 +234,17 @@ class FlowUnitPerfCtx {
 
   int32_t GetProcessLatency();
 
+  /**
+   * @brief Update process latency of a batch size, moving average in us
+   */
+  void UpdateBatchProcessLatency(uint32_t batch_size, int32_t process_latency);
+
+  /**
+   * @brief Get process latency of a batch size
+   * @return latency in us, 0 if not observed
+   */
+  int32_t GetBatchProcessLatency(uint32_t batch_size);
+
   void UpdateDeviceMemory(std::string& device_type, std::string& device_id,
                           int32_t memory);
 
@@ -254,6 +272,7 @@ class FlowUnitPerfCtx {
   std::string flow_unit_name_;
   double process_latency_;
   int32_t process_latency_count_;
+  std::map<uint32_t, double> batch_process_latency_;
 
   // device type + id -> std::map<TimePoint int32_t>
   std::map<std::string, std::map<TimePoint, int32_t>> devices_memories_;
@@ -384,6 +403,158 @@ class Trace : public std::enable_shared_from_this<Trace>,
   std::atomic_bool session_enable_;
 };
 
+/**
+ * @brief Fixed size binary trace record
+ */
+struct TraceRecord {
+  uint64_t begin_us;
+  uint32_t duration_us;
+  uint32_t name_id;
+  uint32_t thread_index;
+  uint32_t batch_size;
+  uint32_t type;
+  uint32_t reserved;
+};
+
+/**
+ * @brief Single producer single consumer ring of trace record, producer is
+ * the owner thread, consumer is the flusher, record is dropped when full
+ */
+class TraceRecordRing {
+ public:
+  TraceRecordRing(size_t size, uint32_t thread_index);
+
+  virtual ~TraceRecordRing() = default;
+
+  bool Push(TraceRecord& record);
+
+  size_t Pop(std::vector<TraceRecord>& records);
+
+  inline uint64_t GetDropCount() { return drop_count_; }
+
+ private:
+  std::vector<TraceRecord> records_;
+  size_t mask_;
+  uint32_t thread_index_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> drop_count_{0};
+};
+
+class TraceRecorder;
+
+/**
+ * @brief Record one span on stack, no allocation
+ */
+class TraceRecordSpan {
+ public:
+  void Begin(TraceRecorder* recorder, uint32_t name_id, TraceSliceType type,
+             uint32_t batch_size);
+
+  void End();
+
+ private:
+  TraceRecorder* recorder_{nullptr};
+  uint32_t name_id_{0};
+  TraceSliceType type_{TraceSliceType::PROCESS};
+  uint32_t batch_size_{0};
+  uint64_t begin_us_{0};
+};
+
+/**
+ * @brief Always-on trace, each thread writes fixed size binary record to its
+ * own lock free ring, a background thread flushes rings to a binary file.
+ * use TraceRecorder::ConvertToChromeTrace or modelbox-tool to convert file
+ * to chrome trace json.
+ */
+class TraceRecorder : public ProfilerLifeCycle {
+ public:
+  TraceRecorder(const std::string& output_dir_path,
+                size_t ring_size = DEFAULT_TRACE_RING_SIZE);
+
+  virtual ~TraceRecorder();
+
+  Status OnStart() override;
+
+  Status OnStop() override;
+
+  Status OnPause() override;
+
+  Status OnResume() override;
+
+  /**
+   * @brief Register a name, such as flowunit name, not for hot path
+   * @param name name to register
+   * @return id of name used in record
+   */
+  uint32_t RegisterName(const std::string& name);
+
+  /**
+   * @brief Add a record, lock free, drop record when not running
+   */
+  void Record(uint32_t name_id, TraceSliceType type, uint64_t begin_us,
+              uint32_t duration_us, uint32_t batch_size);
+
+  /**
+   * @brief Flush all rings to file
+   */
+  Status Flush();
+
+  inline void SetFlushInterval(uint32_t interval_ms) {
+    flush_interval_ = interval_ms;
+  }
+
+  inline std::string GetFilePath() { return file_path_; }
+
+  /**
+   * @brief Get records dropped because ring is full
+   */
+  uint64_t GetDropCount();
+
+  /**
+   * @brief Convert binary trace file to chrome trace json
+   * @param trace_file binary trace file
+   * @param json_file output json file
+   * @return convert result
+   */
+  static Status ConvertToChromeTrace(const std::string& trace_file,
+                                     const std::string& json_file);
+
+  static uint64_t NowUs();
+
+ private:
+  TraceRecordRing* GetThreadRing();
+
+  void FlushWork();
+
+  Status WriteBlock(uint32_t block_type, const void* data, uint32_t len,
+                    const void* ext_data = nullptr, uint32_t ext_len = 0);
+
+  uint64_t id_;
+  std::string output_dir_path_;
+  std::string file_path_;
+  size_t ring_size_;
+  uint32_t flush_interval_{DEFAULT_TRACE_FLUSH_INTERVAL};
+  std::atomic_bool recording_{false};
+
+  std::mutex rings_lock_;
+  std::unordered_map<std::thread::id, std::shared_ptr<TraceRecordRing>>
+      rings_;
+
+  std::mutex names_lock_;
+  std::vector<std::string> names_;
+  size_t written_name_num_{0};
+
+  std::mutex flush_lock_;
+  std::FILE* file_{nullptr};
+  std::vector<TraceRecord> flush_buffer_;
+
+  std::mutex flush_thread_lock_;
+  std::condition_variable flush_cv_;
+  bool flush_thread_run_{false};
+  std::shared_ptr<std::thread> flush_thread_;
+};
+
 /**
  * call as following in one session:
 
@@ -421,6 +592,10 @@ class Profiler : public ProfilerLifeCycle {
 
   inline std::shared_ptr<Trace> GetTrace() { return trace_; }
 
+  inline std::shared_ptr<TraceRecorder> GetTraceRecorder() {
+    return trace_recorder_;
+  }
+
  private:
   std::shared_ptr<DeviceManager> device_mgr_;
 
@@ -431,6 +606,8 @@ class Profiler : public ProfilerLifeCycle {
   std::shared_ptr<Performance> perf_;
 
   std::shared_ptr<Trace> trace_;
+
+  std::shared_ptr<TraceRecorder> trace_recorder_;
 };
 
 }  // namespace modelbox
@@ -249,6 +249,49 @@ class StatisticsNotifyConsumers {
       cfg_map_;
 };
 
+/**
+ * @brief Integer counter for hot path, increase is lock free and only touch
+ * the shard of current thread, shards are summed on read
+ */
+class StatisticsCounter {
+ public:
+  StatisticsCounter();
+
+  virtual ~StatisticsCounter();
+
+  /**
+   * @brief Add value to counter
+   * @param value Value to add
+   */
+  inline void Add(int64_t value) {
+    shards_[GetShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Set counter, not atomic with concurrent Add
+   * @param value Value to set
+   */
+  void Set(int64_t value);
+
+  /**
+   * @brief Sum of all shards
+   * @return Counter value
+   */
+  int64_t Get();
+
+ private:
+  size_t GetShardIndex();
+
+  // padding to cache line to avoid false sharing between threads
+  struct Shard {
+    std::atomic<int64_t> value{0};
+    char padding[64 - sizeof(std::atomic<int64_t>)];
+  };
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t shard_mask_{0};
+};
+
 using StatisticsForEachFunc =
     std::function<modelbox::Status(const std::shared_ptr<StatisticsItem>& item,
                                    const std::string relative_path)>;
@@ -335,6 +378,12 @@ class StatisticsItem : public std::enable_shared_from_this<StatisticsItem> {
   modelbox::Status IncreaseValue(const std::string& sub_item_name,
                                  const T& value);
 
+  /**
+   * @brief Check item is a counter or not
+   * @return check result
+   */
+  inline bool IsCounter() { return counter_ != nullptr; }
+
   /**
    * @brief Get value
    * @param value Return value
@@ -362,6 +411,10 @@ class StatisticsItem : public std::enable_shared_from_this<StatisticsItem> {
     }
 
     StatusError = modelbox::STATUS_OK;
+    if (IsCounter()) {
+      return std::make_shared<StatisticsValue>(GetCounterValue());
+    }
+
     return std::make_shared<StatisticsValue>(value_);
   }
 
@@ -407,6 +460,21 @@ class StatisticsItem : public std::enable_shared_from_this<StatisticsItem> {
                                           const T& value,
                                           bool override_val = false);
 
+  /**
+   * @brief Add new counter item as child, increase of counter is lock free
+   * and will not notify CHANGE unless CHANGE notify is registered
+   * @param name Name of new item
+   * @param value Init value
+   * @return Status & new item, return exist item if it is a counter
+   */
+  template <typename T, typename = typename std::enable_if<
+                            std::is_same<T, int32_t>::value ||
+                            std::is_same<T, uint32_t>::value ||
+                            std::is_same<T, int64_t>::value ||
+                            std::is_same<T, uint64_t>::value>::type>
+  std::shared_ptr<StatisticsItem> AddCounter(const std::string& name,
+                                             const T& value = 0);
+
   /**
    * @brief Get item with name
    * @param child_path Target item name
@@ -494,8 +562,29 @@ class StatisticsItem : public std::enable_shared_from_this<StatisticsItem> {
   modelbox::Status ForEachInner(const StatisticsForEachFunc& func,
                                 bool recursive, const std::string& base_path);
 
-  std::shared_ptr<StatisticsItem> AddItemInner(const std::string& name,
-                                               std::shared_ptr<Any> value);
+  std::shared_ptr<StatisticsItem> AddItemInner(
+      const std::string& name, std::shared_ptr<Any> value,
+      const std::function<void(StatisticsItem* child)>& init_func = nullptr);
+
+  template <typename T>
+  std::shared_ptr<StatisticsItem> AddCounterInner(const std::string& name,
+                                                  const T& value);
+
+  std::shared_ptr<Any> GetCounterValue();
+
+  template <typename T>
+  static typename std::enable_if<std::is_arithmetic<T>::value, int64_t>::type
+  ToCounterValue(const T& value) {
+    return (int64_t)value;
+  }
+
+  template <typename T>
+  static typename std::enable_if<!std::is_arithmetic<T>::value, int64_t>::type
+  ToCounterValue(const T& value) {
+    return 0;
+  }
+
+  void UpdateChangeConsumerFlag();
 
  private:
   std::string parent_path_;
@@ -504,6 +593,9 @@ class StatisticsItem : public std::enable_shared_from_this<StatisticsItem> {
   std::string path_;  // full path : parent_path_ + "." + name_
   std::mutex value_lock_;
   std::shared_ptr<Any> value_;
+  std::shared_ptr<StatisticsCounter> counter_;
+  std::function<std::shared_ptr<Any>(int64_t)> counter_to_any_;
+  std::atomic_bool has_change_consumer_{false};
   std::mutex children_lock_;
   std::map<std::string, std::shared_ptr<StatisticsItem>> children_;
   std::set<std::string> children_name_set_;
@@ -530,6 +622,16 @@ modelbox::Status StatisticsItem::SetValue(const T& value) {
             "This is not a leaf node, set value failed."};
   }
 
+  if (IsCounter()) {
+    if (value_->type() != typeid(value)) {
+      return modelbox::STATUS_INVALID;
+    }
+
+    counter_->Set(ToCounterValue(value));
+    Notify(StatisticsNotifyType::CHANGE);
+    return modelbox::STATUS_OK;
+  }
+
   std::lock_guard<std::mutex> lck(value_lock_);
   auto old_val = value_;
   value_ = std::make_shared<Any>(value);
@@ -548,6 +650,19 @@ modelbox::Status StatisticsItem::IncreaseValue(const T& value) {
             "This is not a leaf node, increase value failed."};
   }
 
+  if (IsCounter()) {
+    if (value_->type() != typeid(value)) {
+      return modelbox::STATUS_INVALID;
+    }
+
+    counter_->Add((int64_t)value);
+    if (has_change_consumer_) {
+      Notify(StatisticsNotifyType::CHANGE);
+    }
+
+    return modelbox::STATUS_OK;
+  }
+
   std::lock_guard<std::mutex> lck(value_lock_);
   if (value_ == nullptr) {
     return modelbox::STATUS_INVALID;
@@ -580,6 +695,12 @@ modelbox::Status StatisticsItem::IncreaseValue(const std::string& sub_item_name,
     return item->second->IncreaseValue(value);
   }
 
+  // integer created by increase is a counter, keep hot path lock free
+  if (std::is_integral<T>::value) {
+    AddCounterInner(sub_item_name, value);
+    return StatusError;
+  }
+
   auto value_ptr = std::make_shared<Any>(value);
   AddItemInner(sub_item_name, value_ptr);
   return StatusError;
@@ -592,6 +713,15 @@ modelbox::Status StatisticsItem::GetValue(T& value) {
             "This is not a leaf node, get value failed."};
   }
 
+  if (IsCounter()) {
+    if (value_->type() != typeid(value)) {
+      return modelbox::STATUS_INVALID;
+    }
+
+    value = any_cast<T>(*GetCounterValue());
+    return modelbox::STATUS_OK;
+  }
+
   std::lock_guard<std::mutex> lck(value_lock_);
   if (value_ == nullptr) {
     return modelbox::STATUS_NODATA;
@@ -636,6 +766,42 @@ std::shared_ptr<StatisticsItem> StatisticsItem::AddItem(const std::string& name,
   return AddItemInner(name, value_ptr);
 }
 
+template <typename T, typename>
+std::shared_ptr<StatisticsItem> StatisticsItem::AddCounter(
+    const std::string& name, const T& value) {
+  if (!is_alive_) {
+    StatusError = {STATUS_FAULT, "This item is disposed"};
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lck(children_lock_);
+  auto item = children_.find(name);
+  if (item != children_.end()) {
+    if (!item->second->IsCounter()) {
+      StatusError = {STATUS_EXIST, "Item " + name + " is not a counter"};
+      return nullptr;
+    }
+
+    StatusError = STATUS_EXIST;
+    return item->second;
+  }
+
+  return AddCounterInner(name, value);
+}
+
+template <typename T>
+std::shared_ptr<StatisticsItem> StatisticsItem::AddCounterInner(
+    const std::string& name, const T& value) {
+  return AddItemInner(
+      name, std::make_shared<Any>(value), [value](StatisticsItem* child) {
+        child->counter_ = std::make_shared<StatisticsCounter>();
+        child->counter_->Add((int64_t)value);
+        child->counter_to_any_ = [](int64_t counter_value) {
+          return std::make_shared<Any>((T)counter_value);
+        };
+      });
+}
+
 class Statistics {
  public:
   /**
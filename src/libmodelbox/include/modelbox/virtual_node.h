@@ -19,6 +19,7 @@
 #define MODELBOX_VIRTUAL_NODE_H_
 
 #include <chrono>
+#include <deque>
 
 #include "modelbox/base/device.h"
 #include "modelbox/node.h"
@@ -91,7 +92,9 @@ class ExternalDataMapImpl
   void UpdateInputMeta(std::string port_name,
                        std::shared_ptr<IndexBufferList> index_buffer_list);
   void SetSelector(std::shared_ptr<ExternalDataSelect> selector);
+  void NotifySelector();
   bool GetReadyFlag();
+  Status RecvData(OutputBufferList& map_buffer_list);
   void UnbindSession();
 
   // lock_ protcet virtual_stream_
@@ -111,6 +114,12 @@ class ExternalDataMapImpl
   std::weak_ptr<ExternalDataSelect> selector_;
 };
 
+/**
+ * @brief Select external data which has output to receive.
+ * External data becomes ready is queued by itself, so select only visits
+ * ready ones. Selected external data will not be selected again until Recv
+ * is called on it, so several threads can select and receive in parallel.
+ */
 class ExternalDataSelect
     : public std::enable_shared_from_this<ExternalDataSelect> {
  public:
@@ -119,6 +128,13 @@ class ExternalDataSelect
   void RegisterExternalData(std::shared_ptr<ExternalDataMap> externl_data);
   void RemoveExternalData(std::shared_ptr<ExternalDataMap>& externl_data);
 
+  /**
+   * @brief Wait for external data which has output to receive
+   * @param external_list selected external data
+   * @param timeout wait time, less than or equal to 0 waits until data is
+   * ready, but 0 returns at once when no external data is registered
+   * @return STATUS_SUCCESS or STATUS_TIMEDOUT
+   */
   Status SelectExternalData(
       std::list<std::shared_ptr<ExternalDataMap>>& external_list,
       std::chrono::duration<long, std::milli> timeout =
@@ -126,9 +142,19 @@ class ExternalDataSelect
 
  private:
   friend class ExternalDataMapImpl;
-  void NotifySelect();
-  bool IsExtenalDataReady();
-  std::list<std::shared_ptr<ExternalDataMapImpl>> external_list_;
+
+  enum class SelectState { IDLE, READY, SELECTED };
+
+  struct SelectItem {
+    std::shared_ptr<ExternalDataMapImpl> external_data;
+    SelectState state{SelectState::IDLE};
+  };
+
+  void NotifySelect(const ExternalDataMapImpl* external_data);
+  void RearmSelect(const ExternalDataMapImpl* external_data);
+  void PushReadyItem(SelectItem& item);
+  std::unordered_map<const ExternalDataMapImpl*, SelectItem> external_map_;
+  std::deque<std::shared_ptr<ExternalDataMapImpl>> ready_list_;
   std::mutex mtx_;
   std::condition_variable cv_;
 };
@@ -234,7 +260,7 @@ class MultiLevelCache {
   std::map<std::shared_ptr<BufferGroup>,
            std::vector<std::shared_ptr<IndexBuffer>>>
       cache_;
-  std::vector<uint32_t> cur_order_seq_;
+  SeqOrder cur_order_seq_;
   std::unordered_map<std::string, std::shared_ptr<BufferGroup>> key_bg_map_;
   std::shared_ptr<BufferGroup> cur_buffer_group_;
   std::shared_ptr<FlowUnitError> error_;
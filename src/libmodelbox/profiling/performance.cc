@@ -338,6 +338,31 @@ int32_t FlowUnitPerfCtx::GetProcessLatency() {
   return static_cast<int32_t>(process_latency_);
 }
 
+void FlowUnitPerfCtx::UpdateBatchProcessLatency(uint32_t batch_size,
+                                                int32_t process_latency) {
+  // recent samples weigh more, latency drifts with load and device state
+  constexpr double BATCH_LATENCY_WEIGHT = 0.2;
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  auto iter = batch_process_latency_.find(batch_size);
+  if (iter == batch_process_latency_.end()) {
+    batch_process_latency_[batch_size] = process_latency;
+    return;
+  }
+
+  iter->second = iter->second * (1 - BATCH_LATENCY_WEIGHT) +
+                 process_latency * BATCH_LATENCY_WEIGHT;
+}
+
+int32_t FlowUnitPerfCtx::GetBatchProcessLatency(uint32_t batch_size) {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  auto iter = batch_process_latency_.find(batch_size);
+  if (iter == batch_process_latency_.end()) {
+    return 0;
+  }
+
+  return static_cast<int32_t>(iter->second);
+}
+
 void FlowUnitPerfCtx::UpdateDeviceMemory(std::string& device_type,
                                          std::string& device_id,
                                          int32_t memory) {
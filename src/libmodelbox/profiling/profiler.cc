@@ -140,7 +140,20 @@ Status Profiler::OnInit() {
   }
 
   if (trace_enable) {
-    trace_ = std::make_shared<Trace>(output_dir_path_, perf_, session_enable);
+    auto trace_format = config_->GetString("profile.trace-format", "json");
+    if (trace_format == "binary") {
+      auto ring_size = config_->GetUint32("profile.trace-ring-size",
+                                          DEFAULT_TRACE_RING_SIZE);
+      trace_recorder_ =
+          std::make_shared<TraceRecorder>(output_dir_path_, ring_size);
+    } else if (trace_format == "json") {
+      trace_ =
+          std::make_shared<Trace>(output_dir_path_, perf_, session_enable);
+    } else {
+      MBLOG_ERROR << "trace format " << trace_format
+                  << " is not supported, use json or binary";
+      return STATUS_BADCONF;
+    }
   }
 
   return STATUS_SUCCESS;
@@ -190,6 +203,10 @@ Status Profiler::OnStart() {
     trace_->Start();
   }
 
+  if (trace_recorder_ != nullptr) {
+    trace_recorder_->Start();
+  }
+
   return STATUS_SUCCESS;
 }
 
@@ -202,6 +219,10 @@ Status Profiler::OnStop() {
     trace_->Stop();
   }
 
+  if (trace_recorder_ != nullptr) {
+    trace_recorder_->Stop();
+  }
+
   return STATUS_SUCCESS;
 }
 
@@ -214,6 +235,10 @@ Status Profiler::OnResume() {
     trace_->Resume();
   }
 
+  if (trace_recorder_ != nullptr) {
+    trace_recorder_->Resume();
+  }
+
   return STATUS_SUCCESS;
 }
 
@@ -226,6 +251,10 @@ Status Profiler::OnPause() {
     trace_->Pause();
   }
 
+  if (trace_recorder_ != nullptr) {
+    trace_recorder_->Pause();
+  }
+
   return STATUS_SUCCESS;
 }
 
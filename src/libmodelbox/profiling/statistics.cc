@@ -168,6 +168,47 @@ void StatisticsNotifyConsumers::Clear() {
   }
 }
 
+/**
+ * StatisticsCounter
+ */
+constexpr size_t MAX_COUNTER_SHARD_NUM = 64;
+
+StatisticsCounter::StatisticsCounter() {
+  size_t shard_num = 1;
+  size_t cpu_num = std::thread::hardware_concurrency();
+  while (shard_num < cpu_num && shard_num < MAX_COUNTER_SHARD_NUM) {
+    shard_num <<= 1;
+  }
+
+  shards_.reset(new Shard[shard_num]);
+  shard_mask_ = shard_num - 1;
+}
+
+StatisticsCounter::~StatisticsCounter() {}
+
+size_t StatisticsCounter::GetShardIndex() {
+  static std::atomic<size_t> thread_seq{0};
+  thread_local size_t thread_index = thread_seq++;
+  return thread_index & shard_mask_;
+}
+
+void StatisticsCounter::Set(int64_t value) {
+  for (size_t i = 1; i <= shard_mask_; ++i) {
+    shards_[i].value.store(0, std::memory_order_relaxed);
+  }
+
+  shards_[0].value.store(value, std::memory_order_relaxed);
+}
+
+int64_t StatisticsCounter::Get() {
+  int64_t sum = 0;
+  for (size_t i = 0; i <= shard_mask_; ++i) {
+    sum += shards_[i].value.load(std::memory_order_relaxed);
+  }
+
+  return sum;
+}
+
 /**
  * StatisticsItem
  */
@@ -176,6 +217,8 @@ StatisticsItem::StatisticsItem() {
   thread_pool_->SetName("Stat-Notify");
   notify_timer_ = std::make_shared<Timer>();
   notify_timer_->SetName("Stat-Timer");
+  // value is read in notify pool, slow consumer does not delay other timers
+  notify_timer_->SetExecutor(thread_pool_);
   notify_timer_->Start();
   last_change_notify_time_ = std::chrono::steady_clock::now();
 }
@@ -210,7 +253,8 @@ std::shared_ptr<StatisticsItem> StatisticsItem::AddItem(
 }
 
 std::shared_ptr<StatisticsItem> StatisticsItem::AddItemInner(
-    const std::string& name, std::shared_ptr<Any> value) {
+    const std::string& name, std::shared_ptr<Any> value,
+    const std::function<void(StatisticsItem* child)>& init_func) {
   if (IsLeaf()) {
     StatusError = {STATUS_NOTSUPPORT, "This is a leaf node, can not add item."};
     return nullptr;
@@ -234,6 +278,10 @@ std::shared_ptr<StatisticsItem> StatisticsItem::AddItemInner(
   if (value != nullptr) {
     child->is_leaf_ = true;
   }
+
+  if (init_func) {
+    init_func(child.get());
+  }
   // Delay register
   {
     std::lock_guard<std::mutex> lck(child_notify_cfg_lock_);
@@ -441,9 +489,19 @@ modelbox::Status StatisticsItem::Notify(const StatisticsNotifyType& type) {
   return modelbox::STATUS_OK;
 }
 
+std::shared_ptr<Any> StatisticsItem::GetCounterValue() {
+  return counter_to_any_(counter_->Get());
+}
+
+void StatisticsItem::UpdateChangeConsumerFlag() {
+  has_change_consumer_ =
+      !consumers_.GetConsumers(StatisticsNotifyType::CHANGE).empty();
+}
+
 modelbox::Status StatisticsItem::AddNotify(
     const std::shared_ptr<StatisticsNotifyCfg>& cfg) {
   consumers_.AddConsumer(cfg);
+  UpdateChangeConsumerFlag();
   if (cfg->type_set_.find(StatisticsNotifyType::TIMER) ==
       cfg->type_set_.end()) {
     return modelbox::STATUS_OK;
@@ -458,12 +516,7 @@ modelbox::Status StatisticsItem::AddNotify(
   timer_task->Callback([this, cfg]() {
     auto msg = std::make_shared<StatisticsNotifyMsg>(
         path_, GetValue(), StatisticsNotifyType::TIMER);
-    if (thread_pool_ == nullptr) {
-      MBLOG_ERROR << "Thread pool is nullptr, can not submit notify action";
-      return;
-    }
-
-    thread_pool_->Submit(cfg->func_, msg);
+    cfg->func_(msg);
   });
   notify_timer_->Schedule(timer_task, cfg->delay_, cfg->interval_);
   cfg->BindTimerTask(timer_task);
@@ -473,6 +526,7 @@ modelbox::Status StatisticsItem::AddNotify(
 void StatisticsItem::DelNotify(
     const std::shared_ptr<StatisticsNotifyCfg>& cfg) {
   consumers_.DelConsumer(cfg);
+  UpdateChangeConsumerFlag();
 }
 
 modelbox::Status StatisticsItem::AddChildrenNotify(
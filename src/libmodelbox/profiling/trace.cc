@@ -15,6 +15,8 @@
  */
 
 
+#include <string.h>
+
 #include <fstream>
 #include <nlohmann/json.hpp>
 
@@ -323,4 +325,401 @@ void TraceSlice::End() {
 
   flow_unit_trace->AddTraceSlice(new_slice_ptr);
 }
-}  // namespace modelbox
\ No newline at end of file
+
+static_assert(sizeof(TraceRecord) == 32, "trace record size changed");
+
+constexpr char TRACE_FILE_MAGIC[] = "MBTRACE1";
+constexpr size_t TRACE_FILE_MAGIC_LEN = 8;
+constexpr uint32_t TRACE_FILE_VERSION = 1;
+
+enum TraceBlockType : uint32_t { TRACE_BLOCK_NAME = 1, TRACE_BLOCK_RECORD = 2 };
+
+struct TraceRingCache {
+  uint64_t recorder_id;
+  TraceRecordRing* ring;
+};
+
+static std::atomic<uint64_t> g_trace_recorder_id{1};
+static thread_local TraceRingCache g_trace_ring_cache = {0, nullptr};
+
+TraceRecordRing::TraceRecordRing(size_t size, uint32_t thread_index)
+    : thread_index_(thread_index) {
+  size_t ring_size = 1;
+  while (ring_size < size) {
+    ring_size <<= 1;
+  }
+
+  records_.resize(ring_size);
+  mask_ = ring_size - 1;
+}
+
+bool TraceRecordRing::Push(TraceRecord& record) {
+  auto head = head_.load(std::memory_order_relaxed);
+  auto tail = tail_.load(std::memory_order_acquire);
+  if (head - tail >= records_.size()) {
+    drop_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  record.thread_index = thread_index_;
+  records_[head & mask_] = record;
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+size_t TraceRecordRing::Pop(std::vector<TraceRecord>& records) {
+  auto tail = tail_.load(std::memory_order_relaxed);
+  auto head = head_.load(std::memory_order_acquire);
+  for (auto i = tail; i < head; ++i) {
+    records.push_back(records_[i & mask_]);
+  }
+
+  tail_.store(head, std::memory_order_release);
+  return head - tail;
+}
+
+void TraceRecordSpan::Begin(TraceRecorder* recorder, uint32_t name_id,
+                            TraceSliceType type, uint32_t batch_size) {
+  recorder_ = recorder;
+  if (recorder_ == nullptr) {
+    return;
+  }
+
+  name_id_ = name_id;
+  type_ = type;
+  batch_size_ = batch_size;
+  begin_us_ = TraceRecorder::NowUs();
+}
+
+void TraceRecordSpan::End() {
+  if (recorder_ == nullptr) {
+    return;
+  }
+
+  auto duration = TraceRecorder::NowUs() - begin_us_;
+  recorder_->Record(name_id_, type_, begin_us_, (uint32_t)duration,
+                    batch_size_);
+  recorder_ = nullptr;
+}
+
+TraceRecorder::TraceRecorder(const std::string& output_dir_path,
+                             size_t ring_size)
+    : ProfilerLifeCycle("TraceRecorder"),
+      id_(g_trace_recorder_id++),
+      output_dir_path_(output_dir_path),
+      ring_size_(ring_size) {}
+
+TraceRecorder::~TraceRecorder() {
+  if (IsRunning()) {
+    Stop();
+  }
+
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+uint64_t TraceRecorder::NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+Status TraceRecorder::OnStart() {
+  std::unique_lock<std::mutex> lock(flush_lock_);
+  if (file_ == nullptr) {
+    time_t current_time = time(0);
+    char buf[64] = {0};
+    auto local_tm = localtime(&current_time);
+    if (local_tm) {
+      strftime(buf, sizeof(buf), "%Y-%m-%d-%H-%M-%S", local_tm);
+    }
+
+    file_path_ = output_dir_path_ + "/" + "trace_" + std::string(buf) + "_" +
+                 std::to_string(id_) + ".mbtrace";
+    file_ = fopen(file_path_.c_str(), "wb");
+    if (file_ == nullptr) {
+      MBLOG_ERROR << "open trace file " << file_path_
+                  << " failed, error: " << strerror(errno);
+      return STATUS_FAULT;
+    }
+
+    uint32_t header[] = {TRACE_FILE_VERSION, sizeof(TraceRecord)};
+    if (fwrite(TRACE_FILE_MAGIC, TRACE_FILE_MAGIC_LEN, 1, file_) != 1 ||
+        fwrite(header, sizeof(header), 1, file_) != 1) {
+      MBLOG_ERROR << "write trace file " << file_path_ << " header failed";
+      fclose(file_);
+      file_ = nullptr;
+      return STATUS_FAULT;
+    }
+  }
+  lock.unlock();
+
+  recording_ = true;
+  std::lock_guard<std::mutex> thread_lock(flush_thread_lock_);
+  flush_thread_run_ = true;
+  flush_thread_ =
+      std::make_shared<std::thread>(&TraceRecorder::FlushWork, this);
+  return STATUS_SUCCESS;
+}
+
+Status TraceRecorder::OnResume() { return OnStart(); }
+
+Status TraceRecorder::OnPause() {
+  recording_ = false;
+  std::shared_ptr<std::thread> flush_thread;
+  {
+    std::lock_guard<std::mutex> lock(flush_thread_lock_);
+    flush_thread_run_ = false;
+    flush_thread = flush_thread_;
+    flush_thread_ = nullptr;
+  }
+
+  flush_cv_.notify_all();
+  if (flush_thread != nullptr) {
+    flush_thread->join();
+  }
+
+  return Flush();
+}
+
+Status TraceRecorder::OnStop() {
+  auto ret = OnPause();
+  std::lock_guard<std::mutex> lock(flush_lock_);
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+
+  auto drop_count = GetDropCount();
+  if (drop_count > 0) {
+    MBLOG_WARN << "trace recorder dropped " << drop_count
+               << " records, ring is full";
+  }
+
+  return ret;
+}
+
+uint32_t TraceRecorder::RegisterName(const std::string& name) {
+  std::lock_guard<std::mutex> lock(names_lock_);
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (names_[i] == name) {
+      return i;
+    }
+  }
+
+  names_.push_back(name);
+  return names_.size() - 1;
+}
+
+void TraceRecorder::Record(uint32_t name_id, TraceSliceType type,
+                           uint64_t begin_us, uint32_t duration_us,
+                           uint32_t batch_size) {
+  if (!recording_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  TraceRecord record;
+  record.begin_us = begin_us;
+  record.duration_us = duration_us;
+  record.name_id = name_id;
+  record.batch_size = batch_size;
+  record.type = (uint32_t)type;
+  record.reserved = 0;
+  GetThreadRing()->Push(record);
+}
+
+TraceRecordRing* TraceRecorder::GetThreadRing() {
+  if (g_trace_ring_cache.recorder_id == id_) {
+    return g_trace_ring_cache.ring;
+  }
+
+  std::lock_guard<std::mutex> lock(rings_lock_);
+  auto& ring = rings_[std::this_thread::get_id()];
+  if (ring == nullptr) {
+    ring = std::make_shared<TraceRecordRing>(ring_size_, rings_.size() - 1);
+  }
+
+  g_trace_ring_cache.recorder_id = id_;
+  g_trace_ring_cache.ring = ring.get();
+  return ring.get();
+}
+
+uint64_t TraceRecorder::GetDropCount() {
+  uint64_t drop_count = 0;
+  std::lock_guard<std::mutex> lock(rings_lock_);
+  for (auto& ring : rings_) {
+    drop_count += ring.second->GetDropCount();
+  }
+
+  return drop_count;
+}
+
+void TraceRecorder::FlushWork() {
+  std::unique_lock<std::mutex> lock(flush_thread_lock_);
+  while (flush_thread_run_) {
+    flush_cv_.wait_for(lock, std::chrono::milliseconds(flush_interval_),
+                       [this]() { return !flush_thread_run_; });
+    lock.unlock();
+    Flush();
+    lock.lock();
+  }
+}
+
+Status TraceRecorder::WriteBlock(uint32_t block_type, const void* data,
+                                 uint32_t len, const void* ext_data,
+                                 uint32_t ext_len) {
+  uint32_t block_header[] = {block_type, len + ext_len};
+  if (fwrite(block_header, sizeof(block_header), 1, file_) != 1 ||
+      fwrite(data, len, 1, file_) != 1) {
+    return {STATUS_FAULT, "write trace block failed"};
+  }
+
+  if (ext_len > 0 && fwrite(ext_data, ext_len, 1, file_) != 1) {
+    return {STATUS_FAULT, "write trace block failed"};
+  }
+
+  return STATUS_SUCCESS;
+}
+
+Status TraceRecorder::Flush() {
+  std::lock_guard<std::mutex> lock(flush_lock_);
+  if (file_ == nullptr) {
+    return STATUS_SUCCESS;
+  }
+
+  {
+    std::lock_guard<std::mutex> names_lock(names_lock_);
+    for (; written_name_num_ < names_.size(); ++written_name_num_) {
+      uint32_t name_id = written_name_num_;
+      const auto& name = names_[written_name_num_];
+      auto ret = WriteBlock(TRACE_BLOCK_NAME, &name_id, sizeof(name_id),
+                            name.data(), name.size());
+      if (!ret) {
+        MBLOG_ERROR << "write trace file " << file_path_ << " failed";
+        return ret;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<TraceRecordRing>> rings;
+  {
+    std::lock_guard<std::mutex> rings_lock(rings_lock_);
+    for (auto& ring : rings_) {
+      rings.push_back(ring.second);
+    }
+  }
+
+  flush_buffer_.clear();
+  for (auto& ring : rings) {
+    ring->Pop(flush_buffer_);
+  }
+
+  if (!flush_buffer_.empty()) {
+    auto ret = WriteBlock(TRACE_BLOCK_RECORD, flush_buffer_.data(),
+                          flush_buffer_.size() * sizeof(TraceRecord));
+    if (!ret) {
+      MBLOG_ERROR << "write trace file " << file_path_ << " failed";
+      return ret;
+    }
+  }
+
+  fflush(file_);
+  return STATUS_SUCCESS;
+}
+
+Status TraceRecorder::ConvertToChromeTrace(const std::string& trace_file,
+                                           const std::string& json_file) {
+  std::ifstream in(trace_file, std::ios::binary);
+  if (!in.is_open()) {
+    return {STATUS_NOTFOUND, "open trace file " + trace_file + " failed"};
+  }
+
+  char magic[TRACE_FILE_MAGIC_LEN] = {0};
+  uint32_t header[2] = {0};
+  in.read(magic, sizeof(magic));
+  in.read((char*)header, sizeof(header));
+  if (!in || memcmp(magic, TRACE_FILE_MAGIC, TRACE_FILE_MAGIC_LEN) != 0) {
+    return {STATUS_INVALID, trace_file + " is not a modelbox trace file"};
+  }
+
+  auto record_size = header[1];
+  if (header[0] != TRACE_FILE_VERSION || record_size < sizeof(TraceRecord)) {
+    return {STATUS_NOTSUPPORT,
+            "trace file version " + std::to_string(header[0]) +
+                " is not supported"};
+  }
+
+  std::map<uint32_t, std::string> names;
+  std::vector<TraceRecord> records;
+  std::vector<char> payload;
+  while (true) {
+    uint32_t block_header[2] = {0};
+    in.read((char*)block_header, sizeof(block_header));
+    if (!in) {
+      break;
+    }
+
+    payload.resize(block_header[1]);
+    in.read(payload.data(), payload.size());
+    if (!in) {
+      // last block may be incomplete when process exits while flushing
+      MBLOG_WARN << "trace file " << trace_file << " is truncated";
+      break;
+    }
+
+    if (block_header[0] == TRACE_BLOCK_NAME &&
+        payload.size() >= sizeof(uint32_t)) {
+      uint32_t name_id = 0;
+      memcpy(&name_id, payload.data(), sizeof(name_id));
+      names[name_id] = std::string(payload.data() + sizeof(name_id),
+                                   payload.size() - sizeof(name_id));
+    } else if (block_header[0] == TRACE_BLOCK_RECORD) {
+      for (size_t offset = 0; offset + record_size <= payload.size();
+           offset += record_size) {
+        TraceRecord record;
+        memcpy(&record, payload.data() + offset, sizeof(record));
+        records.push_back(record);
+      }
+    }
+  }
+
+  nlohmann::json traces_json = nlohmann::json::array();
+  for (auto& record : records) {
+    nlohmann::json trace_json;
+    nlohmann::json args;
+    args["batch_size"] = record.batch_size;
+    args["thread"] = record.thread_index;
+
+    auto type_item = TRACE_SLICE_TYPE.find((TraceSliceType)record.type);
+    auto name_item = names.find(record.name_id);
+    trace_json["name"] =
+        type_item != TRACE_SLICE_TYPE.end() ? type_item->second : "CUSTOM";
+    trace_json["dur"] = record.duration_us;
+    trace_json["ts"] = record.begin_us;
+    trace_json["tid"] = name_item != names.end()
+                            ? name_item->second
+                            : std::to_string(record.name_id);
+    trace_json["ph"] = "X";
+    trace_json["pid"] = "Graph";
+    trace_json["args"] = args;
+    traces_json.push_back(trace_json);
+  }
+
+  std::ofstream out(json_file);
+  if (!out.is_open()) {
+    return {STATUS_FAULT, "open json file " + json_file + " failed"};
+  }
+  Defer { out.close(); };
+
+  auto traces_json_str = traces_json.dump();
+  out.write(traces_json_str.c_str(), traces_json_str.size());
+  if (out.rdstate() & std::ios::failbit) {
+    return {STATUS_FAULT, "write json file " + json_file + " failed"};
+  }
+
+  return STATUS_SUCCESS;
+}
+
+}  // namespace modelbox
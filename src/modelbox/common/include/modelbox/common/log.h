@@ -48,6 +48,17 @@ class ModelboxServerLogger : public modelbox::Logger {
   void Vprint(modelbox::LogLevel level, const char *file, int lineno,
               const char *func, const char *format, va_list ap);
 
+  /**
+   * @brief Output log
+   * @param level log level
+   * @param file log file
+   * @param lineno log file line number
+   * @param func log function
+   * @param msg log message
+   */
+  void Print(modelbox::LogLevel level, const char *file, int lineno,
+             const char *func, const char *msg);
+
   /**
    * @brief Set log level
    * @param level log level
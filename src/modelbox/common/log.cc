@@ -117,6 +117,13 @@ void ModelboxServerLogger::Vprint(modelbox::LogLevel level, const char *file,
             ap);
 }
 
+void ModelboxServerLogger::Print(modelbox::LogLevel level, const char *file,
+                                 int lineno, const char *func,
+                                 const char *msg) {
+  tlog_ext(MblogLevelToTlogLevel(level), file, lineno, func, nullptr, "%s",
+           msg);
+}
+
 void ModelboxServerLogger::SetVerbose(bool logscreen) {
   tlog_setlogscreen(logscreen);
 }
@@ -173,17 +173,22 @@ void ToolCommandSlab::DisplaySlabInfo(
   uint64_t total_memory = 0;
   for (size_t i = 0; i < slabcaches.size(); ++i) {
     if (i == 0) {
-      TOOL_COUT << "object size\t\tactive_objs\t\tnum_objects\n";
+      TOOL_COUT << "object size\t\tactive_objs\t\tnum_objects\t\t"
+                   "magazine_hit\t\tmagazine_miss\n";
     }
     TOOL_COUT << modelbox::GetBytesReadable(slabcaches[i]->ObjectSize())
               << "\t\t\t" << slabcaches[i]->GetActiveObjNumber() << "\t\t\t"
-              << slabcaches[i]->GetObjNumber() << "\n";
+              << slabcaches[i]->GetObjNumber() << "\t\t\t"
+              << slabcaches[i]->GetMagazineHitNumber() << "\t\t\t"
+              << slabcaches[i]->GetMagazineMissNumber() << "\n";
     total_memory += slabcaches[i]->ObjectSize() * slabcaches[i]->GetObjNumber();
   }
   std::string name = (type == CPU_MEMPOOL_TYPE) ? type : type + "_" + id;
   TOOL_COUT << "name: " << name
             << "    total_active_objects: " << mem_pool->GetAllActiveObjectNum()
             << "    total_objects: " << mem_pool->GetAllObjectNum()
+            << "    magazine_hit: " << mem_pool->GetAllMagazineHitNum()
+            << "    magazine_miss: " << mem_pool->GetAllMagazineMissNum()
             << "    total_memory: " << modelbox::GetBytesReadable(total_memory)
             << "\n\n";
 }
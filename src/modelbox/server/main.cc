@@ -119,6 +119,10 @@ int modelbox_init_log(void) {
   auto log_path = kConfig->GetString("log.path", MODELBOX_SERVER_LOG_PATH);
   auto log_screen = kConfig->GetBool("log.screen", false);
   auto log_level = kConfig->GetString("log.level", "INFO");
+  auto log_async = kConfig->GetBool("log.async", false);
+  auto log_rate_limit =
+      kConfig->GetUint32("log.rate-limit", modelbox::DEFAULT_LOG_RATE_LIMIT);
+  auto log_dedup = kConfig->GetBool("log.dedup", false);
   if (log_screen) {
     kVerbose = true;
   }
@@ -128,8 +132,15 @@ int modelbox_init_log(void) {
     return 1;
   }
 
-  ModelBoxLogger.SetLogger(logger);
   logger->SetLogLevel(modelbox::LogLevelStrToLevel(log_level));
+  if (log_async) {
+    auto async_logger = std::make_shared<modelbox::LoggerAsync>(logger);
+    async_logger->SetRateLimit(log_rate_limit);
+    async_logger->SetDedup(log_dedup);
+    ModelBoxLogger.SetLogger(async_logger);
+  } else {
+    ModelBoxLogger.SetLogger(logger);
+  }
 
   return 0;
 }
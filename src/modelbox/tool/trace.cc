@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace.h"
+
+#include <getopt.h>
+#include <modelbox/profiler.h>
+#include <stdio.h>
+
+#include <iostream>
+
+namespace modelbox {
+
+REG_MODELBOX_TOOL_COMMAND(ToolCommandTrace)
+
+enum MODELBOX_TOOL_TRACE_COMMAND {
+  MODELBOX_TOOL_TRACE_CONVERT,
+  MODELBOX_TOOL_TRACE_OUT,
+};
+
+static struct option trace_options[] = {
+    {"convert", 1, 0, MODELBOX_TOOL_TRACE_CONVERT},
+    {"out", 1, 0, MODELBOX_TOOL_TRACE_OUT},
+    {0, 0, 0, 0},
+};
+
+ToolCommandTrace::ToolCommandTrace() {}
+ToolCommandTrace::~ToolCommandTrace() {}
+
+std::string ToolCommandTrace::GetHelp() {
+  char help[] =
+      " option:\n"
+      "   -convert [trace file]     convert binary trace file, which is "
+      "written\n"
+      "                             when profile.trace-format is binary, to "
+      "chrome trace json\n"
+      "     -out [json file]        output json file, default is trace file "
+      "with .json\n"
+      "\n";
+  return help;
+}
+
+int ToolCommandTrace::Run(int argc, char *argv[]) {
+  int cmdtype = 0;
+  std::string trace_file;
+  std::string json_file;
+
+  if (argc == 1) {
+    std::cerr << GetHelp();
+    return 1;
+  }
+
+  MODELBOX_COMMAND_GETOPT_BEGIN(cmdtype, trace_options)
+  switch (cmdtype) {
+    case MODELBOX_TOOL_TRACE_CONVERT:
+      trace_file = optarg;
+      break;
+    case MODELBOX_TOOL_TRACE_OUT:
+      json_file = optarg;
+      break;
+    default:
+      break;
+  }
+  MODELBOX_COMMAND_GETOPT_END()
+
+  if (trace_file.length() == 0) {
+    std::cerr << "please input trace file." << std::endl;
+    return 1;
+  }
+
+  if (json_file.length() == 0) {
+    json_file = trace_file + ".json";
+  }
+
+  auto ret = TraceRecorder::ConvertToChromeTrace(trace_file, json_file);
+  if (!ret) {
+    std::cerr << "convert failed, " << ret.WrapErrormsgs() << std::endl;
+    return 1;
+  }
+
+  std::cout << "chrome trace is written to " << json_file << std::endl;
+  return 0;
+}
+
+}  // namespace modelbox
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODELBOX_TOOL_TRACE_H
+#define MODELBOX_TOOL_TRACE_H
+
+#include "modelbox/common/command.h"
+namespace modelbox {
+
+constexpr const char *TRACE_DESC = "Convert binary trace file";
+
+class ToolCommandTrace : public ToolCommand {
+ public:
+  ToolCommandTrace();
+  virtual ~ToolCommandTrace();
+
+  int Run(int argc, char *argv[]);
+  std::string GetHelp();
+
+  std::string GetCommandName() { return "trace"; };
+  std::string GetCommandDesc() { return TRACE_DESC; };
+};
+
+}  // namespace modelbox
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "modelbox/base/any.h"
+#include "modelbox/base/blocking_queue.h"
+#include "modelbox/base/slab.h"
+#include "modelbox/base/thread_pool.h"
+
+namespace modelbox {
+
+constexpr int BENCH_QUEUE_THREADS = 4;
+constexpr int BENCH_QUEUE_SIZE = 1024;
+
+static void SlabAllocFree(BenchmarkState &state, bool magazine) {
+  SlabCache cache(256, 256 * 1024);
+  if (magazine) {
+    cache.EnableMagazine();
+  }
+
+  while (state.KeepRunning()) {
+    auto ptr = cache.AllocSharedPtr();
+    DoNotOptimize(ptr.get());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_SlabCacheAllocFree) { SlabAllocFree(state, false); }
+
+MODELBOX_BENCHMARK(BM_SlabCacheMagazineAllocFree) {
+  SlabAllocFree(state, true);
+}
+
+template <typename Queue>
+static void QueueContention(BenchmarkState &state, Queue *queue) {
+  auto per_thread = state.Iterations() / BENCH_QUEUE_THREADS + 1;
+  std::vector<std::thread> threads;
+
+  state.KeepRunning();
+  for (int i = 0; i < BENCH_QUEUE_THREADS; i++) {
+    threads.emplace_back([queue, per_thread]() {
+      for (uint64_t n = 0; n < per_thread; n++) {
+        queue->Push(n, 0);
+      }
+    });
+
+    threads.emplace_back([queue, per_thread]() {
+      uint64_t value;
+      for (uint64_t n = 0; n < per_thread; n++) {
+        queue->Pop(&value, 0);
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  state.SetItemsProcessed(per_thread * BENCH_QUEUE_THREADS);
+  while (state.KeepRunning()) {
+  }
+}
+
+MODELBOX_BENCHMARK(BM_BlockingQueueContention) {
+  BlockingQueue<uint64_t> queue(BENCH_QUEUE_SIZE);
+  QueueContention(state, &queue);
+}
+
+MODELBOX_BENCHMARK(BM_RingBlockingQueueContention) {
+  RingBlockingQueue<uint64_t> queue(BENCH_QUEUE_SIZE);
+  QueueContention(state, &queue);
+}
+
+static int Nop(int value) { return value; }
+
+MODELBOX_BENCHMARK(BM_ThreadPoolSubmitLatency) {
+  ThreadPool pool(BENCH_QUEUE_THREADS);
+  while (state.KeepRunning()) {
+    auto result = pool.Submit(Nop, 1);
+    DoNotOptimize(result.get());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_ThreadPoolWorkStealingSubmitLatency) {
+  ThreadPool pool(BENCH_QUEUE_THREADS);
+  pool.EnableWorkStealing();
+  while (state.KeepRunning()) {
+    auto result = pool.Submit(Nop, 1);
+    DoNotOptimize(result.get());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_CollectionSetGet) {
+  Collection collection;
+  int32_t value = 0;
+  collection.Set("width", 1920);
+  collection.Set("height", 1080);
+  collection.Set("format", "rgb");
+  while (state.KeepRunning()) {
+    collection.Set("index", value);
+    collection.Get("index", value);
+    value++;
+  }
+  DoNotOptimize(value);
+}
+
+MODELBOX_BENCHMARK(BM_CollectionMetaKeySetGet) {
+  static const MetaKey kIndex("index");
+  Collection collection;
+  int32_t value = 0;
+  collection.Set("width", 1920);
+  collection.Set("height", 1080);
+  collection.Set("format", "rgb");
+  while (state.KeepRunning()) {
+    collection.Set(kIndex, value);
+    collection.Get(kIndex, value);
+    value++;
+  }
+  DoNotOptimize(value);
+}
+
+MODELBOX_BENCHMARK(BM_CollectionCopyOnWrite) {
+  Collection collection;
+  collection.Set("width", 1920);
+  collection.Set("height", 1080);
+  collection.Set("format", "rgb");
+  collection.Set("pts", (int64_t)0);
+  while (state.KeepRunning()) {
+    Collection downstream;
+    downstream.Merge(collection);
+    downstream.Set("pts", (int64_t)1);
+  }
+}
+
+}  // namespace modelbox
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+
+#include "modelbox/base/log.h"
+
+namespace modelbox {
+
+constexpr uint64_t MAX_BENCHMARK_ITERATIONS = 1000000000;
+
+static std::map<std::string, BenchmarkFunction> &Benchmarks() {
+  static std::map<std::string, BenchmarkFunction> benchmarks;
+  return benchmarks;
+}
+
+BenchmarkState::BenchmarkState(uint64_t iterations)
+    : iterations_(iterations) {}
+
+BenchmarkState::~BenchmarkState() = default;
+
+bool BenchmarkState::KeepRunning() {
+  if (!started_) {
+    started_ = true;
+    ResumeTiming();
+  }
+
+  if (count_ < iterations_ && !skipped_) {
+    count_++;
+    return true;
+  }
+
+  PauseTiming();
+  return false;
+}
+
+void BenchmarkState::PauseTiming() {
+  if (!running_) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  elapsed_ns_ +=
+      std::chrono::duration<double, std::nano>(now - begin_).count();
+  running_ = false;
+}
+
+void BenchmarkState::ResumeTiming() {
+  if (running_) {
+    return;
+  }
+
+  running_ = true;
+  begin_ = std::chrono::steady_clock::now();
+}
+
+void BenchmarkState::SetItemsProcessed(uint64_t items) { items_ = items; }
+
+void BenchmarkState::SkipWithError(const std::string &msg) {
+  skipped_ = true;
+  error_msg_ = msg;
+}
+
+uint64_t BenchmarkState::Iterations() { return iterations_; }
+
+uint64_t BenchmarkState::ItemsProcessed() {
+  return items_ > 0 ? items_ : count_;
+}
+
+double BenchmarkState::ElapsedNs() { return elapsed_ns_; }
+
+bool BenchmarkState::Skipped() { return skipped_; }
+
+const std::string &BenchmarkState::ErrorMsg() { return error_msg_; }
+
+int RegisterBenchmark(const std::string &name, BenchmarkFunction func) {
+  Benchmarks()[name] = func;
+  return 0;
+}
+
+int RunBenchmarks(const std::string &filter, uint64_t min_time_ms) {
+  int failed = 0;
+  double min_time_ns = min_time_ms * 1000.0 * 1000.0;
+
+  printf("%-40s %14s %14s %16s\n", "Benchmark", "Iterations", "ns/op",
+         "items/s");
+  for (auto &iter : Benchmarks()) {
+    if (filter.length() > 0 && iter.first.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    /* grow iterations until run time is long enough to be stable */
+    uint64_t iterations = 1;
+    while (true) {
+      BenchmarkState state(iterations);
+      iter.second(state);
+      if (state.Skipped()) {
+        printf("%-40s SKIPPED: %s\n", iter.first.c_str(),
+               state.ErrorMsg().c_str());
+        failed++;
+        break;
+      }
+
+      auto elapsed_ns = state.ElapsedNs();
+      if (elapsed_ns >= min_time_ns ||
+          iterations >= MAX_BENCHMARK_ITERATIONS) {
+        auto items_per_sec = state.ItemsProcessed() * 1e9 / elapsed_ns;
+        printf("%-40s %14lu %14.1f %16.1f\n", iter.first.c_str(),
+               (unsigned long)iterations, elapsed_ns / iterations,
+               items_per_sec);
+        break;
+      }
+
+      auto multiplier = 10.0;
+      if (elapsed_ns > 0) {
+        multiplier = min_time_ns * 1.4 / elapsed_ns;
+        multiplier = multiplier > 10.0 ? 10.0 : multiplier;
+        multiplier = multiplier < 2.0 ? 2.0 : multiplier;
+      }
+      iterations = (uint64_t)(iterations * multiplier);
+    }
+  }
+
+  return failed;
+}
+
+}  // namespace modelbox
+
+static void Usage(const char *prog) {
+  printf("Usage: %s [OPTION]...\n", prog);
+  printf("  --filter=NAME      only run benchmarks whose name contains NAME\n");
+  printf("  --min-time-ms=MS   minimum time of each benchmark, default 500\n");
+}
+
+int main(int argc, char **argv) {
+  std::string filter;
+  uint64_t min_time_ms = 500;
+
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--filter=", strlen("--filter=")) == 0) {
+      filter = argv[i] + strlen("--filter=");
+    } else if (strncmp(argv[i], "--min-time-ms=", strlen("--min-time-ms=")) ==
+               0) {
+      min_time_ms = strtoull(argv[i] + strlen("--min-time-ms="), nullptr, 10);
+    } else {
+      Usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (getenv("MODELBOX_CONSOLE_LOGLEVEL") == nullptr) {
+    ModelBoxLogger.GetLogger()->SetLogLevel(modelbox::LOG_WARN);
+  }
+
+  return modelbox::RunBenchmarks(filter, min_time_ms);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MODELBOX_BENCHMARK_H_
+#define MODELBOX_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace modelbox {
+
+/**
+ * @brief State of one benchmark run, loop with KeepRunning().
+ */
+class BenchmarkState {
+ public:
+  BenchmarkState(uint64_t iterations);
+  virtual ~BenchmarkState();
+
+  /**
+   * @brief Whether to run next iteration, timer starts on first call.
+   * @return false when iterations are finished.
+   */
+  bool KeepRunning();
+
+  /**
+   * @brief Pause timer, for setup inside loop.
+   */
+  void PauseTiming();
+
+  /**
+   * @brief Resume timer.
+   */
+  void ResumeTiming();
+
+  /**
+   * @brief Set items processed, default is iterations.
+   * @param items item number.
+   */
+  void SetItemsProcessed(uint64_t items);
+
+  /**
+   * @brief Mark benchmark skipped.
+   * @param msg reason.
+   */
+  void SkipWithError(const std::string &msg);
+
+  uint64_t Iterations();
+
+  uint64_t ItemsProcessed();
+
+  double ElapsedNs();
+
+  bool Skipped();
+
+  const std::string &ErrorMsg();
+
+ private:
+  uint64_t iterations_{0};
+  uint64_t count_{0};
+  uint64_t items_{0};
+  bool started_{false};
+  bool running_{false};
+  bool skipped_{false};
+  std::string error_msg_;
+  double elapsed_ns_{0};
+  std::chrono::steady_clock::time_point begin_;
+};
+
+using BenchmarkFunction = std::function<void(BenchmarkState &state)>;
+
+/**
+ * @brief Register a benchmark.
+ * @param name benchmark name.
+ * @param func benchmark function.
+ * @return always 0, for static registration.
+ */
+int RegisterBenchmark(const std::string &name, BenchmarkFunction func);
+
+/**
+ * @brief Run registered benchmarks.
+ * @param filter only run benchmarks whose name contains filter.
+ * @param min_time_ms minimum run time of each benchmark.
+ * @return number of failed benchmarks.
+ */
+int RunBenchmarks(const std::string &filter, uint64_t min_time_ms);
+
+/**
+ * @brief Prevent compiler from optimizing value away.
+ */
+template <typename T>
+inline void DoNotOptimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace modelbox
+
+/**
+ * @brief Define a benchmark, state is modelbox::BenchmarkState.
+ */
+#define MODELBOX_BENCHMARK(name)                                        \
+  static void name(modelbox::BenchmarkState &state);                    \
+  static int name##_registered __attribute__((unused)) =                \
+      modelbox::RegisterBenchmark(#name, name);                         \
+  static void name(modelbox::BenchmarkState &state)
+
+#endif  // MODELBOX_BENCHMARK_H_
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "mockflow.h"
+#include "modelbox/buffer.h"
+#include "modelbox/buffer_list.h"
+#include "modelbox/index_buffer.h"
+
+namespace modelbox {
+
+constexpr int BENCH_BUFFER_SIZE = 4096;
+constexpr int BENCH_BUFFER_LIST_NUM = 16;
+constexpr int BENCH_GROUP_NUM = 16;
+constexpr int BENCH_FLOW_BATCH = 64;
+
+static std::shared_ptr<MockFlow> CreateMockFlow(BenchmarkState &state) {
+  auto mock_flow = std::make_shared<MockFlow>();
+  if (!mock_flow->Init()) {
+    state.SkipWithError("init mock flow failed");
+    return nullptr;
+  }
+
+  return mock_flow;
+}
+
+MODELBOX_BENCHMARK(BM_BufferBuild) {
+  auto mock_flow = CreateMockFlow(state);
+  auto device = mock_flow ? mock_flow->GetDevice() : nullptr;
+  while (device && state.KeepRunning()) {
+    auto buffer = std::make_shared<Buffer>(device);
+    buffer->Build(BENCH_BUFFER_SIZE);
+    DoNotOptimize(buffer->MutableData());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_BufferListBuild) {
+  auto mock_flow = CreateMockFlow(state);
+  auto device = mock_flow ? mock_flow->GetDevice() : nullptr;
+  std::vector<size_t> sizes(BENCH_BUFFER_LIST_NUM, BENCH_BUFFER_SIZE);
+  while (device && state.KeepRunning()) {
+    BufferList buffer_list(device);
+    buffer_list.Build(sizes);
+    DoNotOptimize(buffer_list.MutableData());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_BufferListMakeContiguous) {
+  auto mock_flow = CreateMockFlow(state);
+  auto device = mock_flow ? mock_flow->GetDevice() : nullptr;
+  std::vector<size_t> sizes(BENCH_BUFFER_LIST_NUM, BENCH_BUFFER_SIZE);
+  BufferList output(device);
+  if (device) {
+    output.Build(sizes);
+  }
+
+  std::vector<std::shared_ptr<Buffer>> batch(output.begin(), output.end());
+  while (device && state.KeepRunning()) {
+    BufferList input(device);
+    input.Assign(batch);
+    input.MakeContiguous();
+    DoNotOptimize(input.ConstData());
+  }
+}
+
+MODELBOX_BENCHMARK(BM_IndexBufferGroup) {
+  while (state.KeepRunning()) {
+    auto root = std::make_shared<IndexBuffer>();
+    root->BindToRoot();
+    for (int i = 0; i < BENCH_GROUP_NUM; i++) {
+      auto sub = std::make_shared<IndexBuffer>();
+      root->BindDownLevelTo(sub, i == 0, i == BENCH_GROUP_NUM - 1);
+      DoNotOptimize(sub->GetSameLevelGroup());
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * BENCH_GROUP_NUM);
+}
+
+MODELBOX_BENCHMARK(BM_IndexBufferSeqOrder) {
+  auto root = std::make_shared<IndexBuffer>();
+  root->BindToRoot();
+  auto sub = std::make_shared<IndexBuffer>();
+  root->BindDownLevelTo(sub, true, true);
+  while (state.KeepRunning()) {
+    auto seq_order = sub->GetSeqOrder();
+    DoNotOptimize(seq_order[0]);
+  }
+}
+
+MODELBOX_BENCHMARK(BM_FlowSimplePassThroughput) {
+  auto mock_flow = CreateMockFlow(state);
+  if (mock_flow == nullptr) {
+    return;
+  }
+
+  const std::string test_lib_dir = TEST_LIB_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"(
+    [graph]
+    graphconf = '''digraph demo {
+          input1[type=input, device=cpu, deviceid=0]
+          output1[type=output, device=cpu, deviceid=0]
+          pass1[type=flowunit, flowunit=simple_pass, device=cpu, deviceid=0, label="<In_1> | <Out_1>"]
+          pass2[type=flowunit, flowunit=simple_pass, device=cpu, deviceid=0, label="<In_1> | <Out_1>"]
+          input1 -> pass1:In_1
+          pass1:Out_1 -> pass2:In_1
+          pass2:Out_1 -> output1
+        }'''
+    format = "graphviz"
+  )";
+
+  auto ret = mock_flow->BuildAndRun("BM_FlowSimplePassThroughput",
+                                    toml_content, -1);
+  if (!ret) {
+    state.SkipWithError("build flow failed, " + ret.WrapErrormsgs());
+    return;
+  }
+
+  auto flow = mock_flow->GetFlow();
+  uint64_t received = 0;
+  while (state.KeepRunning()) {
+    auto ext_data = flow->CreateExternalDataMap();
+    auto buffer_list = ext_data->CreateBufferList();
+    buffer_list->Build(std::vector<size_t>(BENCH_FLOW_BATCH, sizeof(int)));
+    ext_data->Send("input1", buffer_list);
+    ext_data->Shutdown();
+
+    while (true) {
+      OutputBufferList map_buffer_list;
+      auto status = ext_data->Recv(map_buffer_list);
+      if (map_buffer_list["output1"] != nullptr) {
+        received += map_buffer_list["output1"]->Size();
+      }
+
+      if (status != STATUS_SUCCESS) {
+        break;
+      }
+    }
+  }
+
+  state.SetItemsProcessed(received);
+  flow->Stop();
+}
+
+}  // namespace modelbox
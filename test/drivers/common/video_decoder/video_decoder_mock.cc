@@ -94,7 +94,9 @@ static void AddStartFlowUnit(std::shared_ptr<MockFlow>& flow) {
 }
 
 static void CheckVideoFrame(std::shared_ptr<modelbox::Buffer> frame_buffer,
-                            std::shared_ptr<int64_t> index_counter) {
+                            std::shared_ptr<int64_t> index_counter,
+                            int32_t expect_width, int32_t expect_height,
+                            int64_t expect_frame_count) {
   int64_t index = 0;
   int32_t width = 0;
   int32_t height = 0;
@@ -114,11 +116,11 @@ static void CheckVideoFrame(std::shared_ptr<modelbox::Buffer> frame_buffer,
 
   EXPECT_EQ(index, *index_counter);
   *index_counter = *index_counter + 1;
-  EXPECT_EQ(width, 480);
-  EXPECT_EQ(height, 320);
+  EXPECT_EQ(width, expect_width);
+  EXPECT_EQ(height, expect_height);
   EXPECT_EQ(rate_num, 24);
   EXPECT_EQ(rate_den, 1);
-  if (index < 119) {
+  if (index < expect_frame_count - 1) {
     EXPECT_FALSE(eos);
   } else {
     EXPECT_TRUE(eos);
@@ -127,13 +129,32 @@ static void CheckVideoFrame(std::shared_ptr<modelbox::Buffer> frame_buffer,
   EXPECT_EQ(duration, 5);
   if (index == 0) {
     EXPECT_EQ(timestamp, 0);
-  } else if (index == 119) {
+  } else if (index == 119 && expect_frame_count == 120) {
     EXPECT_EQ(timestamp, 4958);
   }
 }
 
+static void CheckFrameDropCount(std::shared_ptr<DataContext> data_ctx,
+                                int64_t expect_frame_drop_count) {
+  auto session_stats = data_ctx->GetStatistics(DataContextStatsType::SESSION);
+  ASSERT_NE(session_stats, nullptr);
+  auto drop_stats = session_stats->GetItem("videodecoder.frame_drop_count");
+  if (expect_frame_drop_count == 0) {
+    EXPECT_EQ(drop_stats, nullptr);
+    return;
+  }
+
+  ASSERT_NE(drop_stats, nullptr);
+  uint64_t drop_count = 0;
+  EXPECT_EQ(drop_stats->GetValue(drop_count), STATUS_OK);
+  EXPECT_EQ(drop_count, (uint64_t)expect_frame_drop_count);
+}
+
 static void AddReadFrameFlowUnit(std::shared_ptr<MockFlow>& flow,
-                                 bool is_stream) {
+                                 bool is_stream, int32_t expect_width,
+                                 int32_t expect_height,
+                                 int64_t expect_frame_count,
+                                 int64_t expect_frame_drop_count) {
   auto mock_desc = GenerateFlowunitDesc("read_frame", {"frame_info"}, {});
   mock_desc->SetFlowType(STREAM);
   auto data_pre_func = [&](std::shared_ptr<DataContext> data_ctx,
@@ -159,7 +180,18 @@ static void AddReadFrameFlowUnit(std::shared_ptr<MockFlow>& flow,
         continue;
       }
 
-      CheckVideoFrame(frame_buffer, index_counter);
+      CheckVideoFrame(frame_buffer, index_counter, expect_width,
+                      expect_height, expect_frame_count);
+    }
+
+    return modelbox::STATUS_OK;
+  };
+
+  auto data_post_func = [=](std::shared_ptr<DataContext> data_ctx,
+                            std::shared_ptr<MockFlowUnit> mock_flowunit) {
+    /* decoder counts dropped frames before the stream end is sent */
+    if (!is_stream && expect_frame_drop_count >= 0) {
+      CheckFrameDropCount(data_ctx, expect_frame_drop_count);
     }
 
     return modelbox::STATUS_OK;
@@ -168,19 +200,25 @@ static void AddReadFrameFlowUnit(std::shared_ptr<MockFlow>& flow,
   auto mock_functions = std::make_shared<MockFunctionCollection>();
   mock_functions->RegisterDataPreFunc(data_pre_func);
   mock_functions->RegisterProcessFunc(process_func);
+  mock_functions->RegisterDataPostFunc(data_post_func);
   flow->AddFlowUnitDesc(mock_desc, mock_functions->GenerateCreateFunc(),
                         TEST_DRIVER_DIR);
 }
 
 modelbox::Status AddMockFlowUnit(std::shared_ptr<MockFlow>& flow,
-                                 bool is_stream) {
+                                 bool is_stream, int32_t expect_width,
+                                 int32_t expect_height,
+                                 int64_t expect_frame_count,
+                                 int64_t expect_frame_drop_count) {
   AddStartFlowUnit(flow);
-  AddReadFrameFlowUnit(flow, is_stream);
+  AddReadFrameFlowUnit(flow, is_stream, expect_width, expect_height,
+                       expect_frame_count, expect_frame_drop_count);
   return STATUS_SUCCESS;
 }
 
 std::string GetTomlConfig(const std::string& device,
-                          const std::string& pix_fmt) {
+                          const std::string& pix_fmt,
+                          const std::string& extra_options) {
   const std::string test_lib_dir = TEST_DRIVER_DIR;
   const std::string test_data_dir = TEST_DATA_DIR;
   std::string toml_content =
@@ -196,7 +234,7 @@ std::string GetTomlConfig(const std::string& device,
             videodecoder[type=flowunit, flowunit=video_decoder, device=)" +
       device +
       R"(, deviceid=0, label="<in_video_packet> | <out_video_frame>", pix_fmt=)" +
-      pix_fmt + R"(]
+      pix_fmt + extra_options + R"(]
             read_frame[type=flowunit, flowunit=read_frame, device=cpu, deviceid=0, label="<frame_info>"]
             start_unit:stream_meta -> videodemuxer:in_video_url
             videodemuxer:out_video_packet -> videodecoder:in_video_packet
@@ -707,6 +707,257 @@ TEST_F(BlockingQueueTest, ConsumerProducer) {
   EXPECT_EQ(expect_sum1 + expect_sum2, total_sum1 + total_sum2);
 }
 
+TEST_F(BlockingQueueTest, RingEnqueueDequeue) {
+  const int queue_size = 12;
+  RingBlockingQueue<TestNumber> queue(queue_size);
+  EXPECT_EQ(queue.RingSize() & (queue.RingSize() - 1), 0);
+
+  for (int i = 0; i < queue_size; i++) {
+    TestNumber value = i * i;
+    EXPECT_TRUE(queue.Push(value));
+  }
+
+  EXPECT_EQ(queue_size, queue.Size());
+  EXPECT_TRUE(queue.Full());
+  EXPECT_FALSE(queue.Push(TestNumber(1), -1));
+
+  for (int i = 0; i < queue_size; i++) {
+    TestNumber value = -1;
+    EXPECT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(value, i * i);
+  }
+
+  EXPECT_TRUE(queue.Empty());
+  TestNumber value = -1;
+  EXPECT_FALSE(queue.Poll(&value));
+}
+
+TEST_F(BlockingQueueTest, RingPushTimeout) {
+  const int queue_size = 2;
+  RingBlockingQueue<int> queue(queue_size);
+  queue.Push(1);
+  queue.Push(2);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(queue.Push(3, 100));
+  EXPECT_EQ(errno, ETIMEDOUT);
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  EXPECT_GE(elapsed.count(), 100);
+
+  /* consumer frees a slot, blocked producer continues */
+  auto result_future = std::async(std::launch::async, [&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    int value = 0;
+    queue.Pop(&value);
+  });
+  EXPECT_TRUE(queue.Push(3, 0));
+  result_future.get();
+
+  queue.SetCapacity(4);
+  EXPECT_TRUE(queue.Push(4, -1));
+  EXPECT_EQ(queue.Size(), 3);
+}
+
+TEST_F(BlockingQueueTest, RingPopBatch) {
+  const int queue_size = 16;
+  RingBlockingQueue<int> queue(queue_size);
+  std::vector<int> input;
+  for (int i = 0; i < 10; i++) {
+    input.push_back(i);
+  }
+
+  EXPECT_EQ(queue.PushBatch(&input), 10);
+  EXPECT_EQ(input.size(), 0);
+
+  std::vector<int> output;
+  EXPECT_EQ(queue.PopBatch(&output, -1, 4), 4);
+  EXPECT_EQ(queue.Pop(&output, -1), 6);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(output[i], i);
+  }
+
+  /* batch larger than free space is rejected */
+  for (int i = 0; i < 10; i++) {
+    queue.Push(i);
+  }
+  for (int i = 0; i < 10; i++) {
+    input.push_back(i);
+  }
+  EXPECT_EQ(queue.PushBatch(&input, -1), 0);
+  EXPECT_EQ(input.size(), 10);
+  EXPECT_EQ(queue.PushBatchForce(&input), 10);
+  EXPECT_EQ(queue.Size(), 20);
+}
+
+TEST_F(BlockingQueueTest, RingShutdownWakeup) {
+  RingBlockingQueue<int> queue(4);
+  auto result_future = std::async(std::launch::async, [&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    queue.Wakeup();
+  });
+
+  int value = -1;
+  EXPECT_FALSE(queue.Pop(&value));
+  EXPECT_EQ(errno, EINTR);
+  result_future.get();
+
+  queue.Push(1);
+  result_future = std::async(std::launch::async, [&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    queue.Shutdown();
+  });
+
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(queue.Pop(&value));
+  EXPECT_EQ(errno, ESHUTDOWN);
+  EXPECT_TRUE(queue.IsShutdown());
+  EXPECT_FALSE(queue.Push(2));
+}
+
+TEST_F(BlockingQueueTest, RingWakeupBeforeWait) {
+  RingBlockingQueue<int> queue(4);
+  /* wakeup without waiters is kept for the next waiter */
+  queue.Wakeup();
+  int value = -1;
+  EXPECT_FALSE(queue.Pop(&value, 1000));
+  EXPECT_EQ(errno, EINTR);
+
+  /* consumed, next wait times out */
+  EXPECT_FALSE(queue.Pop(&value, 10));
+  EXPECT_EQ(errno, ETIMEDOUT);
+}
+
+TEST_F(BlockingQueueTest, RingPushBatchWaiters) {
+  RingBlockingQueue<int> queue(4);
+  for (int i = 0; i < 4; i++) {
+    queue.Push(i);
+  }
+
+  /* two batch producers wait for 2 slots each */
+  std::vector<std::thread> producers;
+  std::atomic<int> pushed{0};
+  for (int n = 0; n < 2; n++) {
+    producers.emplace_back([&]() {
+      std::vector<int> batch{10, 11};
+      pushed += queue.PushBatch(&batch, 1000);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::vector<int> output;
+  EXPECT_EQ(queue.PopBatch(&output, -1, 2), 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(queue.PopBatch(&output, -1, 2), 2);
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_EQ(pushed, 4);
+  EXPECT_EQ(queue.Size(), 4);
+}
+
+TEST_F(BlockingQueueTest, RingCapacity) {
+  EXPECT_TRUE(RingBlockingQueue<int>::IsCapacitySupported(1));
+  EXPECT_TRUE(RingBlockingQueue<int>::IsCapacitySupported(
+      RingBlockingQueue<int>::kMaxRingSize));
+  EXPECT_FALSE(RingBlockingQueue<int>::IsCapacitySupported(0));
+  EXPECT_FALSE(RingBlockingQueue<int>::IsCapacitySupported(SIZE_MAX));
+
+  RingBlockingQueue<int> queue(12);
+  EXPECT_FALSE(queue.SetCapacity(queue.RingSize() + 1));
+  EXPECT_EQ(queue.GetCapacity(), 12);
+  EXPECT_TRUE(queue.SetCapacity(queue.RingSize()));
+  EXPECT_EQ(queue.GetCapacity(), queue.RingSize());
+}
+
+TEST_F(BlockingQueueTest, RingConsumerProducer) {
+  int queue_size = 10;
+  int loop = 100000;
+  std::atomic<int64_t> total_sum{0};
+  int64_t expect_sum = 0;
+
+  RingBlockingQueue<TestNumber> queue(queue_size);
+  std::vector<std::thread> producers;
+  std::vector<std::thread> consumers;
+  for (int n = 0; n < 4; n++) {
+    producers.emplace_back([&]() {
+      for (int i = 0; i < loop; i++) {
+        queue.Push(TestNumber(i));
+      }
+    });
+
+    consumers.emplace_back([&]() {
+      while (true) {
+        TestNumber value = -1;
+        if (queue.Pop(&value) == false) {
+          break;
+        }
+
+        total_sum += value.Get();
+      }
+    });
+    expect_sum += (int64_t)loop * (loop - 1) / 2;
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  /* consumers still drain the queue after shutdown */
+  queue.Shutdown();
+  for (auto &consumer : consumers) {
+    consumer.join();
+  }
+  EXPECT_EQ(expect_sum, total_sum);
+}
+
+TEST_F(BlockingQueueTest, RingMultiProducerPushBatch) {
+  const size_t capacity = 10;
+  const int batch_size = 3;
+  const int loop = 2000;
+  const int producer_num = 4;
+
+  RingBlockingQueue<int> queue(capacity);
+  std::vector<std::thread> producers;
+  for (int n = 0; n < producer_num; n++) {
+    producers.emplace_back([&, n]() {
+      for (int i = 0; i < loop; i++) {
+        /* producer, batch and index in batch */
+        std::vector<int> batch;
+        for (int k = 0; k < batch_size; k++) {
+          batch.push_back(n * 1000000 + i * 10 + k);
+        }
+        EXPECT_EQ(queue.PushBatch(&batch), batch_size);
+      }
+    });
+  }
+
+  int popped = 0;
+  int expect = -1;
+  while (popped < producer_num * loop * batch_size) {
+    EXPECT_LE(queue.Size(), capacity);
+    int value = -1;
+    ASSERT_TRUE(queue.Pop(&value, 1000));
+    if (expect >= 0) {
+      /* rest of a batch follows without elements from other producers */
+      EXPECT_EQ(value, expect);
+    } else {
+      EXPECT_EQ(value % 10, 0);
+    }
+
+    expect = (value % 10 == batch_size - 1) ? -1 : value + 1;
+    popped++;
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  EXPECT_EQ(queue.Size(), 0);
+}
+
 TEST_F(PriorityBlockingQueueTest, PushPriorityCheck) {
   const int queue_size = 12;
   PriorityBlockingQueue<int> queue(queue_size);
@@ -772,6 +772,36 @@ TEST_F(DeviceMemoryTest, DeviceMemoryAppend3) {
   EXPECT_EQ(mem5->GetCapacity(), 20);
 }
 
+TEST_F(DeviceMemoryTest, DeviceMemoryCombineStat) {
+  device_->SetMemQuota(1024);
+  auto mem1 = device_->MemAlloc(100, (size_t)100, 0);
+  auto sub1 = mem1->Cut(0, 10);
+  auto sub2 = mem1->Cut(10, 10);
+  auto sub3 = mem1->Cut(20, 10);
+
+  auto before = DeviceMemory::GetCombineStat();
+  auto mem2 = DeviceMemory::Combine({sub1, sub2, sub3});
+  ASSERT_NE(mem2, nullptr);
+  EXPECT_EQ(mem2->GetConstPtr<void>(), sub1->GetConstPtr<void>());
+  auto stat = DeviceMemory::GetCombineStat();
+  EXPECT_EQ(stat.continuous_count, before.continuous_count + 1);
+  EXPECT_EQ(stat.fragment_copy_bytes, before.fragment_copy_bytes);
+
+  auto mem3 = DeviceMemory::Combine({sub1, sub2}, device_, 1);
+  ASSERT_NE(mem3, nullptr);
+  EXPECT_NE(mem3->GetConstPtr<void>(), sub1->GetConstPtr<void>());
+  EXPECT_EQ(mem3->GetSize(), 20);
+  stat = DeviceMemory::GetCombineStat();
+  EXPECT_EQ(stat.bulk_copy_count, before.bulk_copy_count + 1);
+  EXPECT_EQ(stat.fragment_copy_bytes, before.fragment_copy_bytes);
+
+  auto mem4 = DeviceMemory::Combine({sub3, sub1});
+  ASSERT_NE(mem4, nullptr);
+  stat = DeviceMemory::GetCombineStat();
+  EXPECT_EQ(stat.fragment_count, before.fragment_count + 1);
+  EXPECT_EQ(stat.fragment_copy_bytes, before.fragment_copy_bytes + 20);
+}
+
 TEST_F(DeviceMemoryTest, CudaMemoryAppend) {
   auto drivers = Drivers::GetInstance();
   drivers->Scan(TEST_LIB_DIR, "libmodelbox-device-cuda.so");
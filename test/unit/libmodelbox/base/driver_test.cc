@@ -611,6 +611,59 @@ TEST_F(DriverTest, DoubleScan) {
   EXPECT_EQ(status, STATUS_OK);
 }
 
+TEST_F(DriverTest, ScanInfoCollector) {
+  MockDriverCtl ctl;
+  MockFlowUnitDriverDesc desc_flowunit;
+  desc_flowunit.SetClass("driver-flowunit");
+  desc_flowunit.SetType("cpu");
+  desc_flowunit.SetName("httpserver");
+  desc_flowunit.SetVersion("1.0.0");
+  ctl.AddMockDriverFlowUnit("httpserver", "cpu", desc_flowunit);
+  desc_flowunit.SetType("cuda");
+  desc_flowunit.SetName("resize");
+  ctl.AddMockDriverFlowUnit("resize", "cuda", desc_flowunit);
+
+  Drivers::RegisterScanInfoCollector(
+      "driver-flowunit", [](std::shared_ptr<Driver> driver, std::string *info) {
+        *info = "info-" + driver->GetDriverDesc()->GetName();
+        return STATUS_OK;
+      });
+  Defer { Drivers::RegisterScanInfoCollector("driver-flowunit", nullptr); };
+
+  ConfigurationBuilder builder;
+  builder.AddProperty(DRIVER_DIR, TEST_LIB_DIR);
+  builder.AddProperty(DRIVER_SKIP_DEFAULT, "true");
+  std::shared_ptr<Configuration> config = builder.Build();
+  std::shared_ptr<Drivers> drivers = Drivers::GetInstance();
+  drivers->Initialize(config);
+  remove(DEFAULT_SCAN_INFO);
+  Defer { remove(DEFAULT_SCAN_INFO); };
+  EXPECT_EQ(drivers->Scan(), STATUS_OK);
+
+  auto driver_list = drivers->GetDriverListByClass("driver-flowunit");
+  EXPECT_GE(driver_list.size(), 2);
+  for (auto &driver : driver_list) {
+    auto desc = driver->GetDriverDesc();
+    EXPECT_EQ(desc->GetScanInfo(), "info-" + desc->GetName());
+  }
+
+  std::ifstream ifs(DEFAULT_SCAN_INFO);
+  nlohmann::json dump_json;
+  ifs >> dump_json;
+  EXPECT_EQ(dump_json["scan_info_version"], DRIVER_SCAN_INFO_VERSION);
+
+  // cached scan info is used without scanning again
+  drivers->Clear();
+  drivers->Initialize(config);
+  EXPECT_EQ(drivers->Scan(), STATUS_OK);
+  driver_list = drivers->GetDriverListByClass("driver-flowunit");
+  EXPECT_GE(driver_list.size(), 2);
+  for (auto &driver : driver_list) {
+    auto desc = driver->GetDriverDesc();
+    EXPECT_EQ(desc->GetScanInfo(), "info-" + desc->GetName());
+  }
+}
+
 class VirtualDriverTest : public testing::Test {
  public:
   VirtualDriverTest() {}
@@ -24,6 +24,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "securec.h"
@@ -81,6 +82,27 @@ class LoggerTest : public Logger {
   bool log_a_msg_;
 };
 
+class LoggerCollect : public Logger {
+ public:
+  void Print(LogLevel level, const char *file, int lineno, const char *func,
+             const char *msg) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    msgs_.push_back(msg);
+  };
+  void SetLogLevel(LogLevel level) { level_ = level; };
+  LogLevel GetLogLevel() { return level_; };
+
+  std::vector<std::string> GetLogMsgs() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return msgs_;
+  }
+
+ private:
+  LogLevel level_ = LOG_DEBUG;
+  std::mutex mutex_;
+  std::vector<std::string> msgs_;
+};
+
 class LogTest : public testing::Test {
  public:
   LogTest() {}
@@ -188,4 +210,99 @@ TEST_F(LogTest, LoggerMultiThread) {
   }
 }
 
-}  // namespace modelbox
\ No newline at end of file
+TEST_F(LogTest, LoggerAsync) {
+  std::vector<std::thread> threads;
+  int thread_num = 10;
+  int loop = 100;
+  auto backend = std::make_shared<LoggerCollect>();
+  auto async_logger = std::make_shared<LoggerAsync>(backend);
+  async_logger->SetRateLimit(0);
+  async_logger->SetDedup(false);
+  ModelBoxLogger.SetLogger(async_logger);
+
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < loop; j++) {
+        MBLOG_INFO << i << " " << j;
+      }
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  async_logger->Flush();
+  auto msgs = backend->GetLogMsgs();
+  EXPECT_EQ(msgs.size(), thread_num * loop);
+  EXPECT_EQ(async_logger->GetDropCount(), 0);
+
+  // logs of one thread keep order
+  std::vector<int> last(thread_num, -1);
+  for (auto &msg : msgs) {
+    int i = 0;
+    int j = 0;
+    std::istringstream(msg) >> i >> j;
+    EXPECT_EQ(last[i] + 1, j);
+    last[i] = j;
+  }
+
+  MBLOG_FATAL << "fatal log";
+  msgs = backend->GetLogMsgs();
+  EXPECT_EQ(msgs.back(), "fatal log");
+}
+
+TEST_F(LogTest, LoggerAsyncRateLimit) {
+  auto backend = std::make_shared<LoggerCollect>();
+  auto async_logger = std::make_shared<LoggerAsync>(backend);
+  ModelBoxLogger.SetLogger(async_logger);
+
+  async_logger->SetRateLimit(5);
+  async_logger->SetDedup(false);
+  for (int i = 0; i < 100; i++) {
+    MBLOG_ERROR << "error " << i;
+  }
+  async_logger->Flush();
+  EXPECT_EQ(backend->GetLogMsgs().size(), 5);
+  EXPECT_EQ(async_logger->GetSuppressCount(), 95);
+
+  async_logger->SetRateLimit(0);
+  for (int i = 0; i < 10; i++) {
+    MBLOG_ERROR << "same error";
+  }
+  async_logger->Flush();
+  EXPECT_EQ(backend->GetLogMsgs().size(), 15);
+
+  async_logger->SetDedup(true);
+  for (int i = 0; i < 10; i++) {
+    MBLOG_ERROR << "same error";
+  }
+  async_logger->Flush();
+  auto msgs = backend->GetLogMsgs();
+  EXPECT_EQ(msgs.size(), 16);
+  EXPECT_EQ(msgs.back(), "same error");
+  EXPECT_EQ(async_logger->GetSuppressCount(), 104);
+}
+
+TEST_F(LogTest, LoggerAsyncManySites) {
+  auto backend = std::make_shared<LoggerCollect>();
+  auto async_logger = std::make_shared<LoggerAsync>(backend);
+  async_logger->SetRateLimit(1);
+
+  async_logger->Print(LOG_ERROR, "site.cc", 1, "", "first");
+  // more sites than state table, site limited before keeps its state
+  for (int i = 0; i < 4096; i++) {
+    auto file = "other_" + std::to_string(i) + ".cc";
+    async_logger->Print(LOG_ERROR, file.c_str(), i, "", "other");
+  }
+
+  async_logger->Print(LOG_ERROR, "site.cc", 1, "", "second");
+  async_logger->Flush();
+  auto msgs = backend->GetLogMsgs();
+  EXPECT_EQ(msgs.size(), 4097);
+  EXPECT_EQ(msgs.front(), "first");
+  EXPECT_EQ(msgs.back(), "other");
+  EXPECT_EQ(async_logger->GetSuppressCount(), 1);
+}
+
+}  // namespace modelbox
@@ -104,3 +104,18 @@ TEST_F(MemoryPoolTest, MemoryPoolShrinkExpire) {
   p.ShrinkSlabCache(4, 0, 1);
   EXPECT_EQ(p.GetAllObjectNum(), 0);
 }
+
+TEST_F(MemoryPoolTest, MemoryPoolMagazine) {
+  MemoryPoolBase p;
+  int obj_size = 1024;
+  int loop = 100;
+  p.InitSlabCache(10, 10);
+  for (int i = 0; i < loop; i++) {
+    auto ptr = p.AllocSharedPtr(obj_size);
+    ASSERT_NE(ptr, nullptr);
+  }
+
+  EXPECT_EQ(p.GetAllActiveObjectNum(), 0);
+  EXPECT_EQ(p.GetAllMagazineMissNum(), 1);
+  EXPECT_EQ(p.GetAllMagazineHitNum(), loop - 1);
+}
@@ -198,9 +198,114 @@ TEST_F(SlabTest, SlabCacheReclaim) {
   EXPECT_EQ(number * 10 / 100, cache.GetEmptySlabNumber());
 }
 
-TEST_F(SlabTest, Perf) {
+TEST_F(SlabTest, SlabCacheMagazine) {
+  SlabCache cache(128, 128 * 64);
+  cache.EnableMagazine(1, 8);
+  auto ptr = cache.AllocSharedPtr();
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(1, cache.GetActiveObjNumber());
+  EXPECT_EQ(1, cache.GetMagazineMissNumber());
+  EXPECT_EQ(3, cache.GetMagazineObjNumber());
+  auto *addr = ptr.get();
+  ptr = nullptr;
+  EXPECT_EQ(0, cache.GetActiveObjNumber());
+  EXPECT_EQ(4, cache.GetMagazineObjNumber());
+  EXPECT_EQ(0, cache.GetEmptySlabNumber());
+
+  ptr = cache.AllocSharedPtr();
+  EXPECT_EQ(addr, ptr.get());
+  EXPECT_EQ(1, cache.GetMagazineHitNumber());
+  ptr = nullptr;
+
+  cache.DrainMagazine();
+  EXPECT_EQ(0, cache.GetMagazineObjNumber());
+  EXPECT_EQ(1, cache.GetEmptySlabNumber());
+  EXPECT_EQ(64, cache.GetFreeObjNumber());
+}
+
+TEST_F(SlabTest, SlabCacheMagazineReclaim) {
+  SlabCache cache(128, 128 * 64);
+  cache.EnableMagazine(1, 8);
+  auto ptr = cache.AllocSharedPtr();
+  ASSERT_NE(ptr, nullptr);
+  ptr = nullptr;
+  EXPECT_EQ(4, cache.GetMagazineObjNumber());
+
+  /* magazine just used, keep its objects */
+  cache.Reclaim(30);
+  EXPECT_EQ(4, cache.GetMagazineObjNumber());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  cache.Reclaim(1);
+  EXPECT_EQ(0, cache.GetMagazineObjNumber());
+  EXPECT_EQ(0, cache.GetActiveObjNumber());
+}
+
+TEST_F(SlabTest, SlabCacheMagazineFlush) {
+  SlabCache cache(128, 128 * 64);
+  cache.EnableMagazine(1, 8);
+  std::vector<std::shared_ptr<void>> ptrs;
+  int number = 32;
+  for (int i = 0; i < number; i++) {
+    auto ptr = cache.AllocSharedPtr();
+    ASSERT_NE(ptr, nullptr);
+    ptrs.emplace_back(ptr);
+  }
+
+  EXPECT_EQ(number, cache.GetActiveObjNumber());
+  ptrs.clear();
+  EXPECT_EQ(0, cache.GetActiveObjNumber());
+  EXPECT_LE(cache.GetMagazineObjNumber(), 8);
+
+  cache.Shrink();
+  EXPECT_EQ(0, cache.GetMagazineObjNumber());
+  EXPECT_EQ(0, cache.SlabNumber());
+}
+
+TEST_F(SlabTest, SlabCacheMagazineLargeObject) {
+  SlabCache cache(4 * 1024 * 1024, 8 * 1024 * 1024);
+  cache.EnableMagazine();
+  auto ptr = cache.AllocSharedPtr();
+  ASSERT_NE(ptr, nullptr);
+  ptr = nullptr;
+  EXPECT_EQ(0, cache.GetMagazineMissNumber());
+  EXPECT_EQ(0, cache.GetMagazineObjNumber());
+  EXPECT_EQ(1, cache.GetEmptySlabNumber());
+}
+
+TEST_F(SlabTest, SlabObjectAllocator) {
+  struct SlabObjectTest {
+    SlabObjectTest(int v) : value(v) {}
+    int value;
+    char data[100];
+  };
+
+  std::vector<std::shared_ptr<SlabObjectTest>> objs;
+  for (int i = 0; i < 1000; i++) {
+    objs.emplace_back(std::allocate_shared<SlabObjectTest>(
+        SlabObjectAllocator<SlabObjectTest>(), i));
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(objs[i]->value, i);
+    EXPECT_EQ((uintptr_t)objs[i].get() % alignof(std::max_align_t), 0);
+  }
+
+  std::weak_ptr<SlabObjectTest> weak = objs[0];
+  objs.clear();
+  EXPECT_TRUE(weak.expired());
+
+  auto obj = std::allocate_shared<SlabObjectTest>(
+      SlabObjectAllocator<SlabObjectTest>(), 1);
+  EXPECT_EQ(obj->value, 1);
+}
+
+void SlabCachePerf(bool enable_magazine) {
   int obj_size = 4;
   SlabCache cache(obj_size, 4096);
+  if (enable_magazine) {
+    cache.EnableMagazine();
+  }
   std::vector<std::thread> threads;
   std::atomic<unsigned long> number;
   bool stop = false;
@@ -243,8 +348,14 @@ TEST_F(SlabTest, Perf) {
   }
   end = GetTickCount();
 
+  MBLOG_INFO << "magazine: " << enable_magazine;
   MBLOG_INFO << "total: " << number;
   MBLOG_INFO << "ops: " << 1.0 * number / (end - begin) * 1000.0;
+  EXPECT_EQ(0, cache.GetActiveObjNumber());
 }
 
+TEST_F(SlabTest, Perf) { SlabCachePerf(false); }
+
+TEST_F(SlabTest, PerfMagazine) { SlabCachePerf(true); }
+
 }  // namespace modelbox
\ No newline at end of file
@@ -77,6 +77,31 @@ TEST_F(ThreadPoolTest, SubmitTasksMinTaskNumber) {
   EXPECT_EQ(fut5.get(), 204);
 }
 
+TEST_F(ThreadPoolTest, SubmitTasksLockFreeQueue) {
+  modelbox::ThreadPool pool(2, 4, -1, 60000, true);
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 1000; i++) {
+    futures.push_back(pool.Submit(compute, 100, i));
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(futures[i].get(), 100 + i);
+  }
+
+  EXPECT_LE(pool.GetThreadsNum(), 4);
+  pool.SetKeepAlive(100);
+}
+
+TEST_F(ThreadPoolTest, TaskQueueFallback) {
+  modelbox::ThreadTaskQueue ring_queue(16, true);
+  EXPECT_TRUE(ring_queue.IsLockFree());
+
+  /* unbounded queue can not be a ring */
+  modelbox::ThreadTaskQueue queue(SIZE_MAX, true);
+  EXPECT_FALSE(queue.IsLockFree());
+  EXPECT_EQ(queue.GetCapacity(), SIZE_MAX);
+}
+
 TEST_F(ThreadPoolTest, ThreadSize) {
   int thread_size = 4;
   modelbox::ThreadPool pool(thread_size, thread_size * 2, 2001);
@@ -172,6 +197,36 @@ TEST_F(ThreadPoolTest, KeepAlive) {
   EXPECT_EQ(pool.GetThreadsNum(), thread_size);
 }
 
+TEST_F(ThreadPoolTest, ParallelFor) {
+  modelbox::ThreadPool pool(0);
+  std::vector<int> values(16, 0);
+  auto ret = pool.ParallelFor(values.size(), [&](size_t i) {
+    values[i] = i + 1;
+    return modelbox::STATUS_OK;
+  });
+  EXPECT_EQ(ret, modelbox::STATUS_OK);
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(values[i], i + 1);
+  }
+
+  /* failed status and exception of any task are returned */
+  ret = pool.ParallelFor(4, [](size_t i) -> modelbox::Status {
+    if (i == 2) {
+      return modelbox::STATUS_INVALID;
+    }
+    return modelbox::STATUS_OK;
+  });
+  EXPECT_EQ(ret, modelbox::STATUS_INVALID);
+  ret = pool.ParallelFor(4, [](size_t i) -> modelbox::Status {
+    if (i == 3) {
+      throw std::runtime_error("task failed");
+    }
+    return modelbox::STATUS_OK;
+  });
+  EXPECT_EQ(ret, modelbox::STATUS_FAULT);
+  EXPECT_EQ(pool.ParallelFor(0, nullptr), modelbox::STATUS_OK);
+}
+
 TEST_F(ThreadPoolTest, Performance) {
   modelbox::ThreadPool pool(std::thread::hardware_concurrency());
   std::atomic<bool> is_stop_{false};
@@ -265,4 +320,113 @@ TEST_F(ThreadPoolTest, Performance) {
 
   MBLOG_INFO << "launch count: " << launch_count
              << " wait_count: " << wait_count;
-}
\ No newline at end of file
+}
+
+void SubmitFanOut(modelbox::ThreadPool *pool, std::atomic<int64_t> *sum,
+                  int depth) {
+  if (depth <= 0) {
+    (*sum)++;
+    return;
+  }
+
+  /* tasks submitted from a worker go to its local queue */
+  for (int i = 0; i < 4; i++) {
+    pool->Submit(SubmitFanOut, pool, sum, depth - 1);
+  }
+}
+
+int64_t RunFanOut(modelbox::ThreadPool *pool, int depth) {
+  std::atomic<int64_t> sum{0};
+  int64_t expect = 1;
+  for (int i = 0; i < depth; i++) {
+    expect *= 4;
+  }
+
+  pool->Submit(SubmitFanOut, pool, &sum, depth);
+  while (sum < expect) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return sum;
+}
+
+void SubmitChain(modelbox::ThreadPool *pool, std::atomic<int64_t> *sum,
+                 int length) {
+  (*sum)++;
+  if (length > 1) {
+    pool->Submit(SubmitChain, pool, sum, length - 1);
+  }
+}
+
+int64_t RunChains(modelbox::ThreadPool *pool, int chains, int length) {
+  std::atomic<int64_t> sum{0};
+  for (int i = 0; i < chains; i++) {
+    pool->Submit(SubmitChain, pool, &sum, length);
+  }
+
+  while (sum < chains * length) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return sum;
+}
+
+TEST_F(ThreadPoolTest, WorkStealing) {
+  modelbox::ThreadPool pool(4, 8);
+  pool.EnableWorkStealing(true);
+  EXPECT_EQ(RunFanOut(&pool, 6), 4096);
+
+  /* blocked owner, local tasks are stolen by others */
+  auto owner = pool.Submit([&]() {
+    auto inner = pool.Submit(compute, 1, 2);
+    return inner.get();
+  });
+  ASSERT_EQ(owner.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(owner.get(), 3);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingNestedWait) {
+  /* the only worker waits on its child, no idle worker can steal it */
+  modelbox::ThreadPool pool(1, 4);
+  pool.EnableWorkStealing();
+  auto owner = pool.Submit([&]() {
+    auto inner = pool.Submit(compute, 1, 2);
+    return inner.get();
+  });
+  ASSERT_EQ(owner.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  EXPECT_EQ(owner.get(), 3);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingShutdown) {
+  std::atomic<int64_t> sum{0};
+  {
+    modelbox::ThreadPool pool(2, 2);
+    pool.EnableWorkStealing();
+    pool.Submit(SubmitFanOut, &pool, &sum, 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  /* local queues are drained before workers exit */
+  EXPECT_EQ(sum, 256);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingPerformance) {
+  /* chains keep in-flight tasks under the queue size, shared queue can not
+   * deadlock on a full queue */
+  auto thread_num = std::thread::hardware_concurrency();
+  auto chains = thread_num * 4;
+  for (auto stealing : {false, true}) {
+    modelbox::ThreadPool pool(thread_num, thread_num, chains * 2);
+    if (stealing) {
+      pool.EnableWorkStealing();
+    }
+
+    auto begin_tick = modelbox::GetTickCount();
+    auto count = RunChains(&pool, chains, 10000);
+    auto cost = modelbox::GetTickCount() - begin_tick + 1;
+    MBLOG_INFO << (stealing ? "work stealing" : "shared queue")
+               << " pool rate: " << ((float)(count * 1000)) / cost << "/s";
+  }
+}
@@ -16,6 +16,7 @@
 
 
 #include <modelbox/base/log.h>
+#include <modelbox/base/thread_pool.h>
 #include <modelbox/base/timer.h>
 #include <modelbox/base/utils.h>
 
@@ -34,6 +35,24 @@ class TimerTest : public testing::Test {
   virtual void TearDown(){};
 };
 
+/* timer driven by test ticks instead of clock and timer thread */
+class ManualTickTimer : public Timer {
+ public:
+  uint64_t GetCurrentTick() override { return tick_; }
+
+  void Run() override {}
+
+  void Advance(uint64_t ticks) {
+    for (uint64_t i = 0; i < ticks; i++) {
+      tick_++;
+      RunExpiredTimer(tick_);
+    }
+  }
+
+ private:
+  uint64_t tick_{0};
+};
+
 TEST_F(TimerTest, Empty) {
   {
     Timer tm;
@@ -432,6 +451,111 @@ TEST_F(TimerTest, SchedBatch) {
   EXPECT_EQ(count, loop);
 }
 
+TEST_F(TimerTest, SchedWheelCascade) {
+  ManualTickTimer tm;
+  std::vector<uint64_t> delays = {5, 255, 256, 300, 700, 1100, 16384, 70000};
+  std::vector<uint64_t> hit_tick(delays.size(), 0);
+  std::vector<std::shared_ptr<TimerTask>> taskset;
+
+  tm.Start();
+  for (size_t i = 0; i < delays.size(); i++) {
+    auto task = std::make_shared<TimerTask>(
+        [&, i]() { hit_tick[i] = tm.GetCurrentTick(); });
+    tm.Schedule(task, delays[i], 0);
+    taskset.push_back(task);
+  }
+
+  tm.Advance(delays.back() + 10);
+  for (size_t i = 0; i < delays.size(); i++) {
+    EXPECT_EQ(hit_tick[i], delays[i]);
+  }
+
+  tm.Stop();
+}
+
+TEST_F(TimerTest, SchedWheelPeriod) {
+  ManualTickTimer tm;
+  std::vector<uint64_t> hit_tick;
+
+  tm.Start();
+  auto task = std::make_shared<TimerTask>(
+      [&]() { hit_tick.push_back(tm.GetCurrentTick()); });
+  tm.Schedule(task, 100, 300);
+
+  tm.Advance(1400);
+  std::vector<uint64_t> expect_tick = {400, 700, 1000, 1300};
+  EXPECT_EQ(hit_tick, expect_tick);
+  tm.Stop();
+}
+
+TEST_F(TimerTest, SchedManyStop) {
+  ManualTickTimer tm;
+  int count = 10000;
+
+  tm.Start();
+  std::vector<std::shared_ptr<TimerTask>> taskset;
+  for (int i = 0; i < count; i++) {
+    auto task = std::make_shared<TimerTask>([&]() { EXPECT_TRUE(false); });
+    tm.Schedule(task, 0, 1000 + i * 100);
+    taskset.push_back(task);
+  }
+
+  for (auto &task : taskset) {
+    task->Stop();
+  }
+
+  tm.Advance(1000 + count * 100);
+  tm.Shutdown();
+}
+
+TEST_F(TimerTest, SchedExecutor) {
+  Timer tm;
+  std::atomic<int> count{0};
+  int loop = 3;
+  auto executor = std::make_shared<ThreadPool>(2);
+
+  std::shared_ptr<TimerTask> task;
+  task = std::make_shared<TimerTask>([&]() {
+    EXPECT_EQ(task.get(), Timer::CurrentTimerTask().get());
+    count++;
+    if (count == loop) {
+      task->Stop();
+    }
+  });
+
+  tm.SetExecutor(executor);
+  tm.Start();
+  tm.Schedule(task, 0, 10, true);
+  tm.Shutdown();
+  EXPECT_EQ(count, loop);
+}
+
+TEST_F(TimerTest, StopInExecutorCallback) {
+  Timer tm;
+  std::atomic<int> count{0};
+  auto executor = std::make_shared<ThreadPool>(1);
+  std::promise<void> stopped;
+  auto stopped_future = stopped.get_future();
+
+  auto task = std::make_shared<TimerTask>([&]() {
+    if (count++ > 0) {
+      return;
+    }
+
+    /* caller is a running callback, stop must not wait for itself */
+    tm.Stop();
+    stopped.set_value();
+  });
+
+  tm.SetExecutor(executor);
+  tm.Start();
+  tm.Schedule(task, 0, 10, true);
+  EXPECT_EQ(stopped_future.wait_for(std::chrono::seconds(3)),
+            std::future_status::ready);
+  executor->Shutdown();
+  EXPECT_EQ(count, 1);
+}
+
 TEST_F(TimerTest, GlobalTimer) {
   int count = 0;
   std::shared_ptr<TimerTask> task;
@@ -171,4 +171,34 @@ TEST_F(BufferListTest, Get) {
   }
 }
 
+TEST_F(BufferListTest, MakeContiguous) {
+  const int BATCH_NUM = 4;
+  BufferList output(device_);
+  auto status = output.Build(std::vector<size_t>(BATCH_NUM, 16));
+  EXPECT_EQ(status, STATUS_OK);
+  auto block = output.ConstData();
+
+  // downstream port gets the batch in order, no copy is needed
+  auto before = DeviceMemory::GetCombineStat();
+  BufferList input(device_);
+  input.Assign({output[0], output[1], output[2], output[3]});
+  status = input.MakeContiguous();
+  EXPECT_EQ(status, STATUS_OK);
+  EXPECT_EQ(input.ConstData(), block);
+  EXPECT_EQ(input.ConstBufferData(1), output.ConstBufferData(1));
+  auto stat = DeviceMemory::GetCombineStat();
+  EXPECT_EQ(stat.fragment_copy_bytes, before.fragment_copy_bytes);
+
+  // order differs from the block, buffers are copied into a new one
+  BufferList reorder(device_);
+  reorder.Assign({output[1], output[0]});
+  status = reorder.MakeContiguous();
+  EXPECT_EQ(status, STATUS_OK);
+  EXPECT_NE(reorder.ConstData(), block);
+  EXPECT_EQ(reorder.ConstBufferData(1),
+            (const uint8_t *)reorder.ConstData() + 16);
+  stat = DeviceMemory::GetCombineStat();
+  EXPECT_EQ(stat.fragment_copy_bytes, before.fragment_copy_bytes + 32);
+}
+
 }  // namespace modelbox
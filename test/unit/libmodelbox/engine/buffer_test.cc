@@ -22,6 +22,7 @@
 #include <thread>
 
 #include "modelbox/base/log.h"
+#include "modelbox/buffer_list.h"
 #include "modelbox/device/mockdevice/device_mockdevice.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -164,6 +165,64 @@ TEST_F(BufferTest, GetCast) {
   EXPECT_EQ(weight64, 720);
 }
 
+TEST_F(BufferTest, GetMetaKey) {
+  static const MetaKey kHeight("Height");
+  Buffer buffer(device_);
+  buffer.Set(kHeight, 720);
+  buffer.Set("Format", "rgb");
+
+  int i_value = 0;
+  EXPECT_TRUE(buffer.Get("Height", i_value));
+  EXPECT_EQ(i_value, 720);
+  EXPECT_TRUE(buffer.Get(kHeight, i_value));
+  EXPECT_EQ(i_value, 720);
+
+  std::string s_value;
+  EXPECT_TRUE(buffer.Get(MetaKey("Format"), s_value));
+  EXPECT_EQ(s_value, "rgb");
+  EXPECT_FALSE(buffer.Get(MetaKey("Not_Found"), s_value));
+}
+
+TEST_F(BufferTest, CopyMetaShare) {
+  auto buffer = std::make_shared<Buffer>(device_);
+  buffer->Set("Height", 720);
+  buffer->Set("Width", 1280);
+
+  auto buffer2 = std::make_shared<Buffer>(device_);
+  auto buffer3 = std::make_shared<Buffer>(device_);
+  buffer3->Set("Height", 360);
+  buffer3->Set("PTS", 10);
+  buffer2->CopyMeta(buffer);
+  buffer3->CopyMeta(buffer);
+
+  /* modify shared meta, other buffers keep their own value */
+  buffer2->Set("Width", 640);
+  auto any = std::get<0>(buffer->GetMutable("Height"));
+  ASSERT_NE(any, nullptr);
+  *any = 1080;
+
+  int i_value = 0;
+  EXPECT_TRUE(buffer->Get("Width", i_value));
+  EXPECT_EQ(i_value, 1280);
+  EXPECT_TRUE(buffer2->Get("Width", i_value));
+  EXPECT_EQ(i_value, 640);
+  EXPECT_TRUE(buffer2->Get("Height", i_value));
+  EXPECT_EQ(i_value, 720);
+  EXPECT_TRUE(buffer->Get("Height", i_value));
+  EXPECT_EQ(i_value, 1080);
+
+  EXPECT_TRUE(buffer3->Get("Height", i_value));
+  EXPECT_EQ(i_value, 360);
+  EXPECT_TRUE(buffer3->Get("Width", i_value));
+  EXPECT_EQ(i_value, 1280);
+  EXPECT_TRUE(buffer3->Get("PTS", i_value));
+  EXPECT_EQ(i_value, 10);
+
+  buffer3->CopyMeta(buffer, true);
+  EXPECT_TRUE(buffer3->Get("Height", i_value));
+  EXPECT_EQ(i_value, 1080);
+}
+
 TEST_F(BufferTest, Buffer1) {
   Buffer buffer(device_);
   Buffer buffer2 = buffer;
@@ -217,4 +276,60 @@ TEST_F(BufferTest, DeepCopy) {
   }
 }
 
+TEST_F(BufferTest, CopyOnWrite) {
+  auto buffer = std::make_shared<Buffer>(device_);
+  buffer->Build(10 * sizeof(int));
+  buffer->Set("Height", 720);
+  auto data = buffer->ConstData();
+  buffer->GetDeviceMemory()->SetContentMutable(false);
+  EXPECT_EQ(buffer->MutableData(), nullptr);
+
+  /* memory only held by buffer, reuse it */
+  auto buffer2 = buffer->CopyOnWrite();
+  ASSERT_NE(buffer2, nullptr);
+  EXPECT_EQ(buffer2->MutableData(), data);
+  EXPECT_EQ(buffer->MutableData(), nullptr);
+  int height = 0;
+  EXPECT_TRUE(buffer2->Get("Height", height));
+  EXPECT_EQ(height, 720);
+
+  /* memory held by buffer2 now */
+  auto buffer3 = buffer->CopyOnWrite();
+  ASSERT_NE(buffer3, nullptr);
+  EXPECT_NE(buffer3->ConstData(), data);
+
+  auto shared_buffer = std::make_shared<Buffer>(device_);
+  shared_buffer->Build(10 * sizeof(int));
+  shared_buffer->SetDataShared();
+  EXPECT_NE(shared_buffer->CopyOnWrite()->ConstData(),
+            shared_buffer->ConstData());
+
+  auto copy_buffer = shared_buffer->Copy();
+  auto buffer_list = std::make_shared<BufferList>(device_);
+  buffer_list->Build({sizeof(int), sizeof(int)});
+  EXPECT_NE(buffer_list->At(0)->CopyOnWrite()->ConstData(),
+            buffer_list->At(0)->ConstData());
+
+  /* references to buffer object are not counted, only data sharing is */
+  auto held_buffer = std::make_shared<Buffer>(device_);
+  held_buffer->Build(10 * sizeof(int));
+  auto held_data = held_buffer->ConstData();
+  auto reader = held_buffer;
+  EXPECT_EQ(held_buffer->CopyOnWrite()->ConstData(), held_data);
+
+  /* read only memory owned by caller */
+  std::vector<int> user_data(10, 1);
+  auto user_buffer = std::make_shared<Buffer>(device_);
+  user_buffer->Build(user_data.data(), user_data.size() * sizeof(int),
+                     [](void *ptr) {});
+  user_buffer->GetDeviceMemory()->SetContentMutable(false);
+  auto user_copy = user_buffer->CopyOnWrite();
+  ASSERT_NE(user_copy, nullptr);
+  EXPECT_NE(user_copy->ConstData(), user_data.data());
+  EXPECT_FALSE(user_buffer->GetDeviceMemory()->IsContentMutable());
+
+  user_buffer->GetDeviceMemory()->SetContentMutable(true);
+  EXPECT_EQ(user_buffer->CopyOnWrite()->ConstData(), user_data.data());
+}
+
 }  // namespace modelbox
\ No newline at end of file
@@ -21,7 +21,9 @@
 #include <future>
 #include <thread>
 
+#include "modelbox/base/configuration.h"
 #include "modelbox/base/log.h"
+#include "modelbox/virtual_node.h"
 #include "gtest/gtest.h"
 
 namespace modelbox {
@@ -36,6 +38,17 @@ class DefaultDataHubTest : public testing::Test {
     node_ = std::make_shared<Node>("test", "cpu", "1", nullptr, nullptr);
   };
   virtual void TearDown(){};
+
+  void PushBuffer(const std::shared_ptr<InPort> &port, int32_t priority) {
+    auto buffer = std::make_shared<IndexBuffer>();
+    buffer->SetPriority(priority);
+    port->GetQueue()->Push(buffer);
+    port->NotifyPushEvent();
+  }
+
+  void PushBuffer(const std::shared_ptr<InPort> &port) {
+    PushBuffer(port, port->GetPriority());
+  }
 };
 
 TEST_F(DefaultDataHubTest, AddPort) {
@@ -195,4 +208,219 @@ TEST_F(DefaultDataHubTest, InactivePort) {
   EXPECT_EQ(data_hub.GetActivePortNum(), 0);
 }
 
-}  // namespace modelbox
\ No newline at end of file
+TEST_F(DefaultDataHubTest, Wakeup) {
+  DefaultDataHub data_hub;
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  auto fut = std::async(std::launch::async, [&]() {
+    return data_hub.SelectActivePort(&active_port);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  data_hub.Wakeup();
+  EXPECT_EQ(fut.get(), STATUS_NODATA);
+  EXPECT_EQ(active_port, nullptr);
+}
+
+TEST_F(DefaultDataHubTest, ShardedDataHub) {
+  ShardedDataHub data_hub(2);
+  auto node_1 = std::make_shared<Node>("test_1", "cpu", "1", nullptr, nullptr);
+  EXPECT_EQ(data_hub.GetShardNum(), 2);
+
+  auto port_0 = std::make_shared<InPort>("input_0", node_);
+  port_0->SetPriority(1);
+  auto priority_port_0 = std::make_shared<PriorityPort>(port_0);
+  auto port_1 = std::make_shared<InPort>("input_1", node_);
+  port_1->SetPriority(2);
+  auto priority_port_1 = std::make_shared<PriorityPort>(port_1);
+  auto port_2 = std::make_shared<InPort>("input_2", node_1);
+  port_2->SetPriority(3);
+  auto priority_port_2 = std::make_shared<PriorityPort>(port_2);
+
+  data_hub.AddPort(priority_port_0);
+  data_hub.AddPort(priority_port_1);
+  data_hub.AddPort(priority_port_2);
+  EXPECT_EQ(data_hub.GetPortNum(), 3);
+
+  // ports of one node share a shard
+  EXPECT_EQ(priority_port_0->GetShard(), 0);
+  EXPECT_EQ(priority_port_1->GetShard(), 0);
+  EXPECT_EQ(priority_port_2->GetShard(), 1);
+
+  for (auto &port : {port_0, port_1, port_2}) {
+    auto buffer = std::make_shared<IndexBuffer>();
+    buffer->SetPriority(port->GetPriority());
+    port->GetQueue()->Push(buffer);
+    port->NotifyPushEvent();
+  }
+  EXPECT_EQ(data_hub.GetActivePortNum(), 3);
+
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  auto status = data_hub.SelectActivePort(0, &active_port, -1);
+  EXPECT_EQ(status, STATUS_OK);
+  EXPECT_EQ(active_port, priority_port_1);
+
+  status = data_hub.SelectActivePort(0, &active_port, -1);
+  EXPECT_EQ(status, STATUS_OK);
+  EXPECT_EQ(active_port, priority_port_0);
+
+  status = data_hub.SelectActivePort(0, &active_port, -1);
+  EXPECT_EQ(status, STATUS_NODATA);
+
+  status = data_hub.SelectActivePort(1, &active_port, -1);
+  EXPECT_EQ(status, STATUS_OK);
+  EXPECT_EQ(active_port, priority_port_2);
+  EXPECT_EQ(data_hub.GetActivePortNum(), 0);
+
+  status = data_hub.SelectActivePort(2, &active_port, -1);
+  EXPECT_EQ(status, STATUS_RANGE);
+
+  EXPECT_EQ(data_hub.GetStats(0).dispatch_count, 2);
+  EXPECT_EQ(data_hub.GetStats(0).max_active_port_num, 2);
+  EXPECT_EQ(data_hub.GetStats(1).dispatch_count, 1);
+
+  std::vector<std::shared_ptr<PriorityPort>> ports = {priority_port_0,
+                                                      priority_port_2};
+  data_hub.AddToActivePort(ports);
+  EXPECT_EQ(data_hub.GetActivePortNum(), 2);
+  data_hub.RemoveFromActivePort(ports);
+  EXPECT_EQ(data_hub.GetActivePortNum(), 0);
+}
+
+TEST_F(DefaultDataHubTest, BackpressurePriorityPolicy) {
+  ConfigurationBuilder builder;
+  auto config = builder.Build();
+  auto input_node = std::make_shared<InputVirtualNode>("cpu", "0", nullptr);
+  EXPECT_EQ(input_node->Init({}, {"output"}, config), STATUS_OK);
+
+  // downstream queue of input node can hold 4 buffers
+  auto downstream_port = std::make_shared<InPort>("input_0", node_, 0, 4);
+  EXPECT_TRUE(input_node->GetOutputPorts()[0]->AddPort(downstream_port));
+
+  auto upstream_port = input_node->GetExternalPorts()[0];
+  upstream_port->SetPriority(5);
+  auto other_port = std::make_shared<InPort>("input_1", node_);
+  other_port->SetPriority(1);
+
+  auto priority_upstream = std::make_shared<PriorityPort>(upstream_port);
+  auto priority_other = std::make_shared<PriorityPort>(other_port);
+  auto priority_downstream = std::make_shared<PriorityPort>(downstream_port);
+
+  DefaultDataHub data_hub;
+  data_hub.SetPriorityPolicy(std::make_shared<BackpressurePriorityPolicy>());
+  data_hub.AddPort(priority_upstream);
+  data_hub.AddPort(priority_other);
+  data_hub.AddPort(priority_downstream);
+
+  PushBuffer(upstream_port);
+  PushBuffer(other_port);
+  EXPECT_GT(priority_upstream->GetPriority(), priority_other->GetPriority());
+
+  // downstream becomes full, upstream is demoted below all other ports
+  for (int i = 0; i < 4; ++i) {
+    PushBuffer(downstream_port);
+  }
+  EXPECT_EQ(data_hub.GetActivePortNum(), 3);
+
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_other);
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_downstream);
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_upstream);
+
+  // downstream drains, upstream is boosted again
+  std::vector<std::shared_ptr<PriorityPort>> ports = {priority_upstream,
+                                                      priority_other};
+  data_hub.AddToActivePort(ports);
+  auto priority = priority_upstream->GetPriority();
+  std::vector<std::shared_ptr<IndexBuffer>> buffers;
+  downstream_port->GetQueue()->PopBatch(&buffers, -1, 4);
+  downstream_port->NotifyPopEvent();
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_upstream);
+  EXPECT_GT(priority_upstream->GetPriority(), priority);
+}
+
+TEST_F(DefaultDataHubTest, BackpressureDynamicPriority) {
+  auto node_1 = std::make_shared<Node>("test_1", "cpu", "1", nullptr, nullptr);
+  auto port_0 = std::make_shared<InPort>("input_0", node_);
+  port_0->SetPriority(1);
+  auto port_1 = std::make_shared<InPort>("input_1", node_1);
+  port_1->SetPriority(2);
+  auto priority_port_0 = std::make_shared<PriorityPort>(port_0);
+  auto priority_port_1 = std::make_shared<PriorityPort>(port_1);
+
+  DefaultDataHub data_hub;
+  data_hub.SetPriorityPolicy(std::make_shared<BackpressurePriorityPolicy>());
+  data_hub.AddPort(priority_port_0);
+  data_hub.AddPort(priority_port_1);
+
+  // data priority of port_0 is above static priority of port_1
+  PushBuffer(port_0, 3);
+  PushBuffer(port_1, 2);
+  EXPECT_EQ(priority_port_0->GetDynamicPriority(), 3);
+  EXPECT_GT(priority_port_0->GetPriority(), priority_port_1->GetPriority());
+
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_port_0);
+  EXPECT_EQ(data_hub.SelectActivePort(&active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_port_1);
+}
+
+TEST_F(DefaultDataHubTest, BackpressureAcrossShards) {
+  ConfigurationBuilder builder;
+  auto config = builder.Build();
+  auto input_node = std::make_shared<InputVirtualNode>("cpu", "0", nullptr);
+  EXPECT_EQ(input_node->Init({}, {"output"}, config), STATUS_OK);
+  auto node_1 = std::make_shared<Node>("test_1", "cpu", "1", nullptr, nullptr);
+
+  auto downstream_port = std::make_shared<InPort>("input_0", node_, 0, 4);
+  EXPECT_TRUE(input_node->GetOutputPorts()[0]->AddPort(downstream_port));
+
+  auto upstream_port = input_node->GetExternalPorts()[0];
+  upstream_port->SetPriority(5);
+  auto other_port = std::make_shared<InPort>("input_1", node_1);
+  other_port->SetPriority(1);
+
+  auto priority_upstream = std::make_shared<PriorityPort>(upstream_port);
+  auto priority_downstream = std::make_shared<PriorityPort>(downstream_port);
+  auto priority_other = std::make_shared<PriorityPort>(other_port);
+
+  ShardedDataHub data_hub(2);
+  data_hub.SetPriorityPolicy(std::make_shared<BackpressurePriorityPolicy>());
+  data_hub.AddPort(priority_upstream);
+  data_hub.AddPort(priority_downstream);
+  data_hub.AddPort(priority_other);
+  EXPECT_EQ(priority_upstream->GetShard(), 0);
+  EXPECT_EQ(priority_downstream->GetShard(), 1);
+  EXPECT_EQ(priority_other->GetShard(), 0);
+
+  PushBuffer(upstream_port);
+  PushBuffer(other_port);
+  EXPECT_GT(priority_upstream->GetPriority(), priority_other->GetPriority());
+
+  // downstream in shard 1 becomes full, upstream in shard 0 is demoted
+  for (int i = 0; i < 4; ++i) {
+    PushBuffer(downstream_port);
+  }
+
+  std::shared_ptr<PriorityPort> active_port = nullptr;
+  EXPECT_EQ(data_hub.SelectActivePort(0, &active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_other);
+  EXPECT_EQ(data_hub.SelectActivePort(0, &active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_upstream);
+
+  // downstream drains, upstream is boosted again
+  std::vector<std::shared_ptr<PriorityPort>> ports = {priority_upstream,
+                                                      priority_other};
+  data_hub.AddToActivePort(ports);
+  std::vector<std::shared_ptr<IndexBuffer>> buffers;
+  downstream_port->GetQueue()->PopBatch(&buffers, -1, 4);
+  downstream_port->NotifyPopEvent();
+  EXPECT_EQ(data_hub.SelectActivePort(0, &active_port, -1), STATUS_OK);
+  EXPECT_EQ(active_port, priority_upstream);
+}
+
+}  // namespace modelbox
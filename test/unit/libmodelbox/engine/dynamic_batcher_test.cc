@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 The Modelbox Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "engine/common/dynamic_batcher.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace modelbox {
+
+class DynamicBatcherTest : public testing::Test {
+ public:
+  DynamicBatcherTest() {}
+
+ protected:
+  std::shared_ptr<InPort> port_;
+  virtual void SetUp() {
+    port_ = std::make_shared<InPort>("input", nullptr, 0, 16);
+  };
+  virtual void TearDown() { port_ = nullptr; };
+
+  void PushBuffer(size_t num) {
+    for (size_t i = 0; i < num; ++i) {
+      port_->GetQueue()->Push(std::make_shared<IndexBuffer>());
+    }
+  }
+};
+
+TEST_F(DynamicBatcherTest, WaitBatch) {
+  auto batcher = std::make_shared<DynamicBatcher>(
+      "test", std::vector<std::shared_ptr<InPort>>{port_}, 8, 1000);
+  batcher->Init();
+  EXPECT_EQ(batcher->GetTargetBatchSize(), 8);
+  EXPECT_TRUE(batcher->Ready());
+
+  PushBuffer(3);
+  EXPECT_FALSE(batcher->Ready());
+  EXPECT_FALSE(port_->IsActivated());
+
+  PushBuffer(5);
+  EXPECT_TRUE(port_->IsActivated());
+  EXPECT_TRUE(batcher->Ready());
+}
+
+TEST_F(DynamicBatcherTest, WaitDeadline) {
+  auto batcher = std::make_shared<DynamicBatcher>(
+      "test", std::vector<std::shared_ptr<InPort>>{port_}, 8, 50);
+  batcher->Init();
+
+  PushBuffer(2);
+  EXPECT_FALSE(batcher->Ready());
+  EXPECT_FALSE(port_->IsActivated());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_TRUE(port_->IsActivated());
+  EXPECT_TRUE(batcher->Ready());
+
+  // next wait reuses the timer of batcher
+  std::vector<std::shared_ptr<IndexBuffer>> buffers;
+  port_->GetQueue()->PopBatch(&buffers, -1, 2);
+  PushBuffer(2);
+  EXPECT_FALSE(batcher->Ready());
+  EXPECT_FALSE(batcher->Ready());
+  EXPECT_FALSE(port_->IsActivated());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_TRUE(port_->IsActivated());
+  EXPECT_TRUE(batcher->Ready());
+}
+
+TEST_F(DynamicBatcherTest, SharePerfCtx) {
+  auto perf_ctx = std::make_shared<FlowUnitPerfCtx>("test");
+  auto batcher = std::make_shared<DynamicBatcher>(
+      "test", std::vector<std::shared_ptr<InPort>>{port_}, 8, 10, perf_ctx);
+  EXPECT_EQ(batcher->GetPerfCtx(), perf_ctx);
+
+  batcher->Update(4, 2000);
+  EXPECT_EQ(perf_ctx->GetBatchProcessLatency(4), 2000);
+}
+
+TEST_F(DynamicBatcherTest, BatchSizeLimitedByQueue) {
+  auto batcher = std::make_shared<DynamicBatcher>(
+      "test", std::vector<std::shared_ptr<InPort>>{port_}, 64, 10);
+  EXPECT_EQ(batcher->GetTargetBatchSize(), 16);
+}
+
+TEST_F(DynamicBatcherTest, TuneByLatency) {
+  auto batcher = std::make_shared<DynamicBatcher>(
+      "test", std::vector<std::shared_ptr<InPort>>{port_}, 8, 10);
+  for (int i = 0; i < 16; ++i) {
+    batcher->Update(8, 8000);
+  }
+  EXPECT_EQ(batcher->GetTargetBatchSize(), 8);
+
+  // smaller batch costs less per buffer, move down
+  batcher->GetPerfCtx()->UpdateBatchProcessLatency(6, 3000);
+  for (int i = 0; i < 16; ++i) {
+    batcher->Update(8, 8000);
+  }
+  EXPECT_EQ(batcher->GetTargetBatchSize(), 6);
+}
+
+}  // namespace modelbox
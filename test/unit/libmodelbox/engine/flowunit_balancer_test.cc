@@ -215,6 +215,44 @@ TEST_F(FlowUnitBalancerTest, RoundRobinTest) {
   }
 }
 
+TEST_F(FlowUnitBalancerTest, CapabilityTest) {
+  auto balancer = FlowUnitBalancerFactory::GetInstance().CreateBalancer(
+      FlowUnitBalanceStrategy::FU_CAPABILITY);
+  ASSERT_NE(balancer, nullptr);
+  EXPECT_EQ(balancer->GetType(), FlowUnitBalanceStrategy::FU_CAPABILITY);
+  EXPECT_TRUE(balancer->NeedProcessCost());
+  auto devices = CreateDevices(3);
+  EXPECT_EQ(devices[2]->GetDeviceID(), "2");
+  auto flowunits = CreateFlowUnits(2, devices);
+  balancer->Init(flowunits);
+  auto mems = CreateMems(3, devices);
+  auto node = std::make_shared<Node>("test_node", "", "", nullptr, nullptr);
+  balancer->UpdateProcessCost(flowunits[0].get(), 2, 20);
+  balancer->UpdateProcessCost(flowunits[1].get(), 1, 45);
+  {
+    // no flowunit on input device, fast flowunit takes more ctx
+    std::vector<std::shared_ptr<FlowUnitDataContext>> ctx_list;
+    for (size_t i = 0; i < 4; ++i) {
+      ctx_list.push_back(BuildFlowUnitDataContext(node.get(), mems[2]));
+      EXPECT_EQ(balancer->GetFlowUnit(ctx_list.back()), flowunits[0]);
+    }
+
+    ctx_list.push_back(BuildFlowUnitDataContext(node.get(), mems[2]));
+    EXPECT_EQ(balancer->GetFlowUnit(ctx_list.back()), flowunits[1]);
+    ctx_list.push_back(BuildFlowUnitDataContext(node.get(), mems[2]));
+    EXPECT_EQ(balancer->GetFlowUnit(ctx_list.back()), flowunits[0]);
+    // bound ctx keeps its flowunit
+    EXPECT_EQ(balancer->GetFlowUnit(ctx_list[4]), flowunits[1]);
+  }
+  {
+    // load is released after ctx destroyed, input device is preferred
+    auto ctx1 = BuildFlowUnitDataContext(node.get(), mems[1]);
+    auto ctx2 = BuildFlowUnitDataContext(node.get(), mems[2]);
+    EXPECT_EQ(balancer->GetFlowUnit(ctx1), flowunits[1]);
+    EXPECT_EQ(balancer->GetFlowUnit(ctx2), flowunits[0]);
+  }
+}
+
 TEST_F(FlowUnitBalancerTest, RoundRobinPerfTest) {
   auto balancer = FlowUnitBalancerFactory::GetInstance().CreateBalancer(
       FlowUnitBalanceStrategy::FU_ROUND_ROBIN);
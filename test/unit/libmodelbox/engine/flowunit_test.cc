@@ -327,6 +327,39 @@ TEST_F(FlowUnitTest, GetAllFlowUnitDesc) {
   EXPECT_EQ(driver_desc->GetVersion(), "1.0.0");
 }
 
+TEST_F(FlowUnitTest, LazyLoad) {
+  std::shared_ptr<Drivers> drivers = Drivers::GetInstance();
+  ConfigurationBuilder configbuilder;
+  configbuilder.AddProperty(std::string("driver.") + DRIVER_LAZY_LOAD, "true");
+  auto device_mgr = DeviceManager::GetInstance();
+  auto flowunit_mgr = FlowUnitManager::GetInstance();
+
+  // stale_unit only exists in scan info, the driver is not loaded yet
+  auto driver_list = drivers->GetDriverListByClass(DRIVER_CLASS_FLOWUNIT);
+  ASSERT_EQ(driver_list.size(), 1);
+  driver_list[0]->GetDriverDesc()->SetScanInfo(
+      R"({"flowunits":[{"name":"httpserver"},{"name":"stale_unit"}]})");
+  flowunit_mgr->Initialize(drivers, device_mgr, configbuilder.Build());
+
+  auto names = flowunit_mgr->GetFlowUnitList("cpu");
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ(names, std::vector<std::string>({"httpserver", "stale_unit"}));
+  EXPECT_EQ(flowunit_mgr->GetFlowUnitTypes("httpserver"),
+            std::vector<std::string>({"cpu"}));
+
+  // driver is loaded on use, descs come from the driver
+  auto flowunit = flowunit_mgr->CreateFlowUnit("httpserver", "cpu");
+  ASSERT_EQ(flowunit.size(), 1);
+  auto flowunit_desc = flowunit[0]->GetFlowUnitDesc();
+  EXPECT_EQ(flowunit_desc->GetFlowUnitName(), "httpserver");
+  EXPECT_EQ(flowunit_desc->GetFlowUnitInput()[0].GetPortName(), "input");
+  EXPECT_EQ(flowunit_desc->GetFlowUnitOutput()[0].GetPortName(), "output");
+  EXPECT_EQ(flowunit_mgr->GetFlowUnitList("cpu"),
+            std::vector<std::string>({"httpserver"}));
+  EXPECT_EQ(flowunit_mgr->GetFlowUnitDesc("cpu", "stale_unit"), nullptr);
+  EXPECT_EQ(flowunit_mgr->GetAllFlowUnitDesc().size(), 1);
+}
+
 TEST_F(FlowUnitTest, FlowUnitDescCheckGroupType) {
   FlowUnitDesc flow_desc;
   flow_desc.SetFlowUnitGroupType("input");
@@ -209,6 +209,49 @@ TEST_F(IndexBufferTest, GenDownLevelBuffer) {
   EXPECT_EQ(4, group_sum);
 }
 
+TEST_F(IndexBufferTest, GetSeqOrder) {
+  auto root_buffer = std::make_shared<IndexBuffer>();
+  EXPECT_EQ(root_buffer->GetSeqOrder().Size(), 0);
+  EXPECT_EQ(root_buffer->BindToRoot(), true);
+  auto root_order = root_buffer->GetSeqOrder();
+  ASSERT_EQ(root_order.Size(), 1);
+  EXPECT_EQ(root_order[0], 1);
+
+  auto buffer_00 = std::make_shared<IndexBuffer>();
+  auto buffer_01 = std::make_shared<IndexBuffer>();
+  EXPECT_EQ(root_buffer->BindDownLevelTo(buffer_00, true, false), true);
+  EXPECT_EQ(root_buffer->BindDownLevelTo(buffer_01, false, true), true);
+  auto order_00 = buffer_00->GetSeqOrder();
+  auto order_01 = buffer_01->GetSeqOrder();
+  ASSERT_EQ(order_00.Size(), 2);
+  ASSERT_EQ(order_01.Size(), 2);
+  EXPECT_EQ(order_00[0], order_01[0]);
+  EXPECT_EQ(order_00[1], 1);
+}
+
+TEST_F(IndexBufferTest, SeqOrder) {
+  SeqOrder seq;
+  for (uint32_t i = 0; i < 20; i++) {
+    seq.PushBack(i);
+  }
+
+  ASSERT_EQ(seq.Size(), 20);
+  uint32_t expect = 0;
+  for (auto order : seq) {
+    EXPECT_EQ(order, expect++);
+  }
+
+  SeqOrder init(3, 1);
+  ASSERT_EQ(init.Size(), 3);
+  init[2]++;
+  EXPECT_EQ(init[0], 1);
+  EXPECT_EQ(init[2], 2);
+
+  SeqOrder large(16, 1);
+  EXPECT_EQ(large.Size(), 16);
+  EXPECT_EQ(large[15], 1);
+}
+
 TEST_F(IndexBufferTest, GenUpLevelBuffer) {
   auto root_buffer = std::make_shared<IndexBuffer>();
   auto buffer_00 = std::make_shared<IndexBuffer>();
@@ -17,8 +17,11 @@
 
 #include "modelbox/virtual_node.h"
 
+#include <atomic>
 #include <fstream>
+#include <map>
 #include <string>
+#include <thread>
 
 #include "modelbox/base/log.h"
 #include "modelbox/data_context.h"
@@ -703,6 +706,188 @@ TEST_F(VirtualNodeTest, VirtualNode_Select_Timeout) {
   flow->Wait(5 * 1000);
 }
 
+static std::string SelectGraphToml() {
+  return R"(
+    [driver]
+    skip-default=true
+    dir=[")" +
+         std::string(TEST_LIB_DIR) + "\"]\n    " +
+         R"(
+    [graph]
+    graphconf = '''digraph demo {
+          input1[type=input, device=cpu,deviceid=0]
+          output1[type=output, device=cpu, deviceid=0]
+          stream_start[type=flowunit, flowunit=virtual_stream_start, device=cpu, deviceid=0, label="<In_1> | <Out_1>"]
+          stream_mid[type=flowunit, flowunit=virtual_stream_mid, device=cpu, deviceid=0, label="<In_1> | <Out_1>", batch_size=5]
+
+          input1 ->stream_start:In_1
+          stream_start:Out_1 ->stream_mid:In_1
+          stream_mid:Out_1->output1
+
+        }'''
+    format = "graphviz"
+  )";
+}
+
+static void SendSelectData(const std::shared_ptr<ExternalDataMap>& ext_data) {
+  auto output_buf = ext_data->CreateBufferList();
+  output_buf->Build({3 * sizeof(int)});
+  auto data = (int*)output_buf->MutableData();
+  data[0] = 0;
+  data[1] = 25000;
+  data[2] = 3;
+
+  EXPECT_EQ(ext_data->Send("input1", output_buf), STATUS_SUCCESS);
+  EXPECT_EQ(ext_data->Shutdown(), STATUS_SUCCESS);
+}
+
+TEST_F(VirtualNodeTest, VirtualNode_Select_ReadyList) {
+  auto ret = mock_flow_->BuildAndRun("VirtualNode_Select_ReadyList",
+                                     SelectGraphToml(), -1);
+  auto flow = mock_flow_->GetFlow();
+
+  {
+    auto selector = std::make_shared<ExternalDataSelect>();
+    std::vector<std::shared_ptr<ExternalDataMap>> idle_list;
+    for (int i = 0; i < 3; ++i) {
+      auto ext_data = flow->CreateExternalDataMap();
+      selector->RegisterExternalData(ext_data);
+      idle_list.push_back(ext_data);
+    }
+
+    auto ext_data = flow->CreateExternalDataMap();
+    selector->RegisterExternalData(ext_data);
+    SendSelectData(ext_data);
+
+    // only external data with output is selected
+    std::list<std::shared_ptr<ExternalDataMap>> external_list;
+    auto select_status = selector->SelectExternalData(
+        external_list, std::chrono::milliseconds(1000));
+    EXPECT_EQ(select_status, STATUS_SUCCESS);
+    ASSERT_EQ(external_list.size(), 1);
+    EXPECT_EQ(external_list.front(), ext_data);
+
+    for (auto& idle_data : idle_list) {
+      idle_data->Close();
+    }
+    ext_data->Close();
+  }
+
+  flow->Wait(5 * 1000);
+}
+
+TEST_F(VirtualNodeTest, VirtualNode_Select_Rearm) {
+  auto ret =
+      mock_flow_->BuildAndRun("VirtualNode_Select_Rearm", SelectGraphToml(), -1);
+  auto flow = mock_flow_->GetFlow();
+
+  {
+    auto selector = std::make_shared<ExternalDataSelect>();
+    auto ext_data = flow->CreateExternalDataMap();
+    selector->RegisterExternalData(ext_data);
+    SendSelectData(ext_data);
+
+    // 0 waits until output is ready
+    std::list<std::shared_ptr<ExternalDataMap>> external_list;
+    auto select_status = selector->SelectExternalData(
+        external_list, std::chrono::milliseconds(0));
+    EXPECT_EQ(select_status, STATUS_SUCCESS);
+    ASSERT_EQ(external_list.size(), 1);
+
+    // not selected again before recv
+    external_list.clear();
+    select_status = selector->SelectExternalData(
+        external_list, std::chrono::milliseconds(100));
+    EXPECT_EQ(select_status, STATUS_TIMEDOUT);
+
+    int size = 0;
+    while (true) {
+      OutputBufferList map_buffer_list;
+      auto status = ext_data->Recv(map_buffer_list);
+      if (status != STATUS_SUCCESS) {
+        EXPECT_EQ(status, STATUS_EOF);
+        break;
+      }
+
+      size += map_buffer_list["output1"]->Size();
+      // recv rearms select
+      external_list.clear();
+      select_status = selector->SelectExternalData(
+          external_list, std::chrono::milliseconds(1000));
+      ASSERT_EQ(select_status, STATUS_SUCCESS);
+      ASSERT_EQ(external_list.size(), 1);
+      EXPECT_EQ(external_list.front(), ext_data);
+    }
+
+    EXPECT_EQ(size, 8334);
+  }
+
+  flow->Wait(5 * 1000);
+}
+
+TEST_F(VirtualNodeTest, VirtualNode_Select_MultiReceiver) {
+  auto ret = mock_flow_->BuildAndRun("VirtualNode_Select_MultiReceiver",
+                                     SelectGraphToml(), -1);
+  auto flow = mock_flow_->GetFlow();
+
+  {
+    const int data_num = 4;
+    auto selector = std::make_shared<ExternalDataSelect>();
+    std::map<std::shared_ptr<ExternalDataMap>, int> data_index;
+    std::atomic<int> sizes[data_num];
+    std::atomic<bool> eofs[data_num];
+    for (int i = 0; i < data_num; ++i) {
+      auto ext_data = flow->CreateExternalDataMap();
+      selector->RegisterExternalData(ext_data);
+      data_index[ext_data] = i;
+      sizes[i] = 0;
+      eofs[i] = false;
+    }
+
+    auto receiver = [&]() {
+      while (true) {
+        std::list<std::shared_ptr<ExternalDataMap>> external_list;
+        auto select_status = selector->SelectExternalData(
+            external_list, std::chrono::milliseconds(1000));
+        if (select_status == STATUS_TIMEDOUT) {
+          break;
+        }
+
+        for (auto& external : external_list) {
+          OutputBufferList map_buffer_list;
+          auto status = external->Recv(map_buffer_list);
+          auto index = data_index.find(external)->second;
+          if (status == STATUS_SUCCESS) {
+            sizes[index] += map_buffer_list["output1"]->Size();
+          } else if (status == STATUS_EOF) {
+            eofs[index] = true;
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> receivers;
+    for (int i = 0; i < 3; ++i) {
+      receivers.emplace_back(receiver);
+    }
+
+    for (auto& item : data_index) {
+      SendSelectData(item.first);
+    }
+
+    for (auto& thread : receivers) {
+      thread.join();
+    }
+
+    for (int i = 0; i < data_num; ++i) {
+      EXPECT_EQ(sizes[i], 8334);
+      EXPECT_TRUE(eofs[i]);
+    }
+  }
+
+  flow->Wait(5 * 1000);
+}
+
 TEST_F(VirtualNodeTest, VirtualNode_Muliti_Output) {
   std::string toml_content = R"(
     [driver]
@@ -117,6 +117,69 @@ TEST_F(FlowTest, All) {
   EXPECT_EQ(retval, STATUS_STOP);
 }
 
+TEST_F(FlowTest, ShardedScheduler) {
+  auto graph = std::make_shared<Graph>();
+  auto gc = std::make_shared<GCGraph>();
+  auto flowunit_mgr = FlowUnitManager::GetInstance();
+  auto device_mgr = DeviceManager::GetInstance();
+
+  std::shared_ptr<Node> node_a = nullptr, node_b = nullptr, node_c = nullptr;
+
+  {
+    ConfigurationBuilder configbuilder;
+    auto config = configbuilder.Build();
+
+    node_a =
+        std::make_shared<Node>("listen", "cpu", "0", flowunit_mgr, nullptr);
+    node_a->SetName("gendata");
+    node_a->Init({}, {"Out_1", "Out_2"}, config);
+    EXPECT_TRUE(graph->AddNode(node_a));
+  }
+
+  {
+    ConfigurationBuilder configbuilder;
+    auto config = configbuilder.Build();
+
+    node_b = std::make_shared<Node>("add", "cpu", "0", flowunit_mgr, nullptr);
+    node_b->SetName("addop");
+    node_b->Init({"In_1", "In_2"}, {"Out_1"}, config);
+    EXPECT_TRUE(graph->AddNode(node_b));
+  }
+
+  {
+    ConfigurationBuilder configbuilder;
+    auto config = configbuilder.Build();
+    config->SetProperty("max_count", 50);
+
+    node_c = std::make_shared<Node>("check_print", "cpu", "0", flowunit_mgr,
+                                    nullptr);
+    node_c->SetName("check_print");
+    node_c->Init({"IN1", "IN2", "IN3"}, {}, config);
+    EXPECT_TRUE(graph->AddNode(node_c));
+  }
+
+  graph->AddLink(node_a->GetName(), "Out_1", node_b->GetName(), "In_1");
+  graph->AddLink(node_a->GetName(), "Out_2", node_b->GetName(), "In_2");
+  graph->AddLink(node_a->GetName(), "Out_1", node_c->GetName(), "IN1");
+  graph->AddLink(node_a->GetName(), "Out_2", node_c->GetName(), "IN2");
+  graph->AddLink(node_b->GetName(), "Out_1", node_c->GetName(), "IN3");
+
+  // fewer workers than shards, dispatchers must not occupy the pool
+  ConfigurationBuilder configbuilder;
+  auto config = configbuilder.Build();
+  config->SetProperty("graph.scheduler-shards", 3);
+  config->SetProperty("graph.thread-num", 2);
+  config->SetProperty("graph.max-thread-num", 2);
+  graph->Initialize(flowunit_mgr, device_mgr, nullptr, config);
+  EXPECT_TRUE(graph->Build(gc) == STATUS_OK);
+  graph->RunAsync();
+
+  Status retval;
+  EXPECT_EQ(graph->Wait(10 * 1000, &retval), STATUS_OK);
+  EXPECT_EQ(retval, STATUS_STOP);
+  graph->Shutdown();
+}
+
 TEST_F(FlowTest, PortEnlargeQueue) {
   auto graph = std::make_shared<Graph>();
   auto gc = std::make_shared<GCGraph>();
@@ -639,4 +702,134 @@ TEST_F(FlowTest, NormalError) {
   flow->Stop();
 }
 
+static void AddCopyOnWriteSource(std::shared_ptr<MockFlow> flow) {
+  auto mock_desc = GenerateFlowunitDesc("cow_source_0_1", {}, {"Out_1"});
+  auto open_func =
+      [=](const std::shared_ptr<Configuration> &opts,
+          std::shared_ptr<MockFlowUnit> mock_flowunit) -> Status {
+    auto ext_data = mock_flowunit->CreateExternalData();
+    if (!ext_data) {
+      return STATUS_FAULT;
+    }
+
+    auto buffer_list = ext_data->CreateBufferList();
+    buffer_list->Build({sizeof(int)});
+    auto status = ext_data->Send(buffer_list);
+    if (!status) {
+      return status;
+    }
+
+    return ext_data->Close();
+  };
+
+  auto process_func =
+      [=](std::shared_ptr<DataContext> data_ctx,
+          std::shared_ptr<MockFlowUnit> mock_flowunit) -> Status {
+    // not contiguous, each output buffer owns its memory
+    auto output_bufs = data_ctx->Output("Out_1");
+    output_bufs->Build({10 * sizeof(int)}, false);
+    auto data = (int *)output_bufs->At(0)->MutableData();
+    for (size_t i = 0; i < 10; ++i) {
+      data[i] = i;
+    }
+
+    return STATUS_OK;
+  };
+
+  auto mock_functions = std::make_shared<MockFunctionCollection>();
+  mock_functions->RegisterOpenFunc(open_func);
+  mock_functions->RegisterProcessFunc(process_func);
+  flow->AddFlowUnitDesc(mock_desc, mock_functions->GenerateCreateFunc());
+}
+
+static void AddCopyOnWriteWriter(std::shared_ptr<MockFlow> flow,
+                                 bool in_place,
+                                 std::shared_ptr<std::atomic<int>> count) {
+  auto mock_desc = GenerateFlowunitDesc("cow_write_1_0", {"In_1"}, {});
+  auto process_func =
+      [=](std::shared_ptr<DataContext> data_ctx,
+          std::shared_ptr<MockFlowUnit> mock_flowunit) -> Status {
+    auto input_bufs = data_ctx->Input("In_1");
+    for (auto &buffer : *input_bufs) {
+      auto writable = buffer->CopyOnWrite();
+      if (writable == nullptr) {
+        return STATUS_FAULT;
+      }
+
+      // only receiver writes in place, others read the same buffer
+      if (in_place) {
+        EXPECT_EQ(writable->ConstData(), buffer->ConstData());
+      } else {
+        EXPECT_NE(writable->ConstData(), buffer->ConstData());
+      }
+
+      auto data = (int *)writable->MutableData();
+      auto data_size = writable->GetBytes() / sizeof(int);
+      for (size_t i = 0; i < data_size; ++i) {
+        data[i] = -1;
+      }
+
+      auto origin = (const int *)buffer->ConstData();
+      for (size_t i = 0; i < data_size; ++i) {
+        EXPECT_EQ(origin[i], in_place ? -1 : (int)i);
+      }
+    }
+
+    (*count)++;
+    return STATUS_OK;
+  };
+
+  auto mock_functions = std::make_shared<MockFunctionCollection>();
+  mock_functions->RegisterProcessFunc(process_func);
+  flow->AddFlowUnitDesc(mock_desc, mock_functions->GenerateCreateFunc());
+}
+
+TEST_F(FlowTest, CopyOnWriteInPlace) {
+  auto write_count = std::make_shared<std::atomic<int>>(0);
+  AddCopyOnWriteSource(flow_);
+  AddCopyOnWriteWriter(flow_, true, write_count);
+
+  const std::string test_lib_dir = TEST_LIB_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"([graph]
+    graphconf = '''digraph demo {
+          start[type=flowunit, flowunit=cow_source_0_1, device=cpu, deviceid=0, label="<Out_1>"]
+          writer[type=flowunit, flowunit=cow_write_1_0, device=cpu, deviceid=0, label="<In_1>"]
+          start:Out_1 -> writer:In_1
+        }'''
+    format = "graphviz"
+  )";
+
+  flow_->BuildAndRun("CopyOnWriteInPlace", toml_content, 1000 * 5);
+  EXPECT_EQ(*write_count, 1);
+}
+
+TEST_F(FlowTest, CopyOnWriteFanOut) {
+  auto write_count = std::make_shared<std::atomic<int>>(0);
+  AddCopyOnWriteSource(flow_);
+  AddCopyOnWriteWriter(flow_, false, write_count);
+
+  const std::string test_lib_dir = TEST_LIB_DIR;
+  std::string toml_content = R"(
+    [driver]
+    skip-default=true
+    dir=[")" + test_lib_dir + "\"]\n    " +
+                             R"([graph]
+    graphconf = '''digraph demo {
+          start[type=flowunit, flowunit=cow_source_0_1, device=cpu, deviceid=0, label="<Out_1>"]
+          writer_a[type=flowunit, flowunit=cow_write_1_0, device=cpu, deviceid=0, label="<In_1>"]
+          writer_b[type=flowunit, flowunit=cow_write_1_0, device=cpu, deviceid=0, label="<In_1>"]
+          start:Out_1 -> writer_a:In_1
+          start:Out_1 -> writer_b:In_1
+        }'''
+    format = "graphviz"
+  )";
+
+  flow_->BuildAndRun("CopyOnWriteFanOut", toml_content, 1000 * 5);
+  EXPECT_EQ(*write_count, 2);
+}
+
 }  // namespace modelbox
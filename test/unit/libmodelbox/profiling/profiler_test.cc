@@ -22,6 +22,10 @@
 #include <sys/stat.h>
 
 #include <atomic>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
 
 #include "modelbox/statistics.h"
 #include "gtest/gtest.h"
@@ -314,6 +318,63 @@ TEST_F(ProfilerTest, WriteTrace) {
   EXPECT_EQ(ret, modelbox::STATUS_SUCCESS);
 }
 
+TEST_F(ProfilerTest, TraceRecorder) {
+  auto deviceManager = std::make_shared<modelbox::DeviceManager>();
+  auto config = std::make_shared<modelbox::Configuration>();
+  config->SetProperty("profile.trace", "true");
+  config->SetProperty("profile.trace-format", "binary");
+  std::shared_ptr<modelbox::Profiler> profiler =
+      std::make_shared<modelbox::Profiler>(deviceManager, config);
+  ASSERT_EQ(profiler->Init(), modelbox::STATUS_OK);
+  EXPECT_EQ(profiler->GetTrace(), nullptr);
+  auto recorder = profiler->GetTraceRecorder();
+  ASSERT_NE(recorder, nullptr);
+  ASSERT_EQ(profiler->Start(), modelbox::STATUS_OK);
+
+  auto resize_id = recorder->RegisterName("resize");
+  auto crop_id = recorder->RegisterName("crop");
+  EXPECT_EQ(recorder->RegisterName("resize"), resize_id);
+  const size_t record_num = 1000;
+  std::vector<std::thread> threads;
+  for (auto name_id : {resize_id, crop_id}) {
+    threads.emplace_back([recorder, name_id, record_num]() {
+      for (size_t i = 0; i < record_num; ++i) {
+        modelbox::TraceRecordSpan span;
+        span.Begin(recorder.get(), name_id, modelbox::TraceSliceType::PROCESS,
+                   1);
+        span.End();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto trace_file = recorder->GetFilePath();
+  profiler->Stop();
+  EXPECT_EQ(recorder->GetDropCount(), 0);
+
+  auto json_file = trace_file + ".json";
+  auto ret =
+      modelbox::TraceRecorder::ConvertToChromeTrace(trace_file, json_file);
+  ASSERT_EQ(ret, modelbox::STATUS_OK);
+  std::ifstream json_in(json_file);
+  auto traces_json = nlohmann::json::parse(json_in);
+  EXPECT_EQ(traces_json.size(), 2 * record_num);
+  size_t resize_count = 0;
+  for (auto& trace_json : traces_json) {
+    EXPECT_EQ(trace_json["name"], "PROCESS");
+    if (trace_json["tid"] == "resize") {
+      ++resize_count;
+    }
+  }
+
+  EXPECT_EQ(resize_count, record_num);
+  remove(trace_file.c_str());
+  remove(json_file.c_str());
+}
+
 TEST_F(ProfilerTest, FlowUnitProfile) {
   auto deviceManager = std::make_shared<modelbox::DeviceManager>();
   auto config = std::make_shared<modelbox::Configuration>();
@@ -557,3 +618,58 @@ TEST_F(ProfilerTest, Statistics) {
   EXPECT_EQ(delete_notify_count, 1);
   EXPECT_EQ(timer_notify_count, 1);
 }
+
+TEST_F(ProfilerTest, StatisticsCounter) {
+  auto root = std::make_shared<modelbox::StatisticsItem>();
+  auto decoder_item = root->AddItem("VideoDecoder");
+  auto counter_item = decoder_item->AddCounter<uint64_t>("frame_count");
+  ASSERT_NE(counter_item, nullptr);
+  EXPECT_TRUE(counter_item->IsCounter());
+  EXPECT_EQ(decoder_item->AddCounter<uint64_t>("frame_count"), counter_item);
+
+  const size_t thread_num = 8;
+  const uint64_t loop = 10000;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads.emplace_back([counter_item, loop]() {
+      for (uint64_t n = 0; n < loop; ++n) {
+        counter_item->IncreaseValue<uint64_t>(1);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  uint64_t frame_count = 0;
+  EXPECT_EQ(counter_item->GetValue(frame_count), modelbox::STATUS_OK);
+  EXPECT_EQ(frame_count, thread_num * loop);
+  auto value = counter_item->GetValue();
+  ASSERT_NE(value, nullptr);
+  EXPECT_TRUE(value->IsUint64());
+  EXPECT_EQ(value->ToString(), std::to_string(thread_num * loop));
+
+  // Wrong type
+  EXPECT_EQ(counter_item->IncreaseValue<uint32_t>(1), modelbox::STATUS_INVALID);
+  uint32_t wrong_type_frame_count;
+  EXPECT_NE(counter_item->GetValue(wrong_type_frame_count),
+            modelbox::STATUS_OK);
+
+  EXPECT_EQ(counter_item->SetValue<uint64_t>(5), modelbox::STATUS_OK);
+  EXPECT_EQ(counter_item->GetValue(frame_count), modelbox::STATUS_OK);
+  EXPECT_EQ(frame_count, 5);
+
+  // Integer created by increase is a counter
+  decoder_item->IncreaseValue<int64_t>("drop_count", 2);
+  decoder_item->IncreaseValue<int64_t>("drop_count", 3);
+  auto drop_item = decoder_item->GetItem("drop_count");
+  ASSERT_NE(drop_item, nullptr);
+  EXPECT_TRUE(drop_item->IsCounter());
+  int64_t drop_count = 0;
+  EXPECT_EQ(drop_item->GetValue(drop_count), modelbox::STATUS_OK);
+  EXPECT_EQ(drop_count, 5);
+
+  decoder_item->AddItem("width", 1920);
+  EXPECT_EQ(decoder_item->AddCounter<int32_t>("width"), nullptr);
+}